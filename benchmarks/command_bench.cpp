@@ -0,0 +1,235 @@
+// MPV 명령 인자 구성 마이크로 벤치마크 (시크/일시정지 호출 경로)
+// libmpv를 실행하지 않고 MPV에 넘기기 직전까지의 비용과 힙 할당 횟수를 비교한다.
+//   variantCommand  - QML command(["seek", pos, "absolute", "exact"]) -> MpvObject::command()의 변환 (이전 경로)
+//   formattedString - QString("seek %1 absolute exact") 조립 후 mpv_command_string (이전 seekToPosition)
+//   typedArgs       - MpvCommand::Args 스택 mpv_node 배열 (seekAbsolute)
+// 결과는 JSON으로 stdout에 출력한다.
+//
+//   command_bench [--quick] [--filter <이름 일부>]
+
+#include "mpvcommand.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+namespace {
+
+// 전역 operator new 호출 횟수 (측정 중인 본문에서만 의미 있음)
+std::atomic<qint64> g_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+volatile qint64 g_sink = 0;
+
+struct Options {
+    bool quick = false;
+    QString filter;
+};
+
+struct Measurement {
+    qint64 iterations = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double allocationsPerOp = 0.0;
+};
+
+// body()를 반복 실행하고 1회당 시간(ns)의 중앙값/최솟값과 할당 횟수를 측정
+Measurement measure(const Options& options, const std::function<void()>& body)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto targetDuration = std::chrono::milliseconds(options.quick ? 20 : 200);
+    const int repetitions = options.quick ? 3 : 7;
+
+    qint64 iterations = 16;
+    for (;;) {
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        if (Clock::now() - start >= targetDuration / 4 || iterations >= (qint64(1) << 24)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    QVector<double> samples;
+    qint64 allocations = 0;
+    for (int r = 0; r < repetitions; ++r) {
+        const qint64 allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        allocations += g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+        samples.append(elapsedNs / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Measurement result;
+    result.iterations = iterations;
+    result.medianNs = samples[samples.size() / 2];
+    result.minNs = samples.first();
+    result.allocationsPerOp = double(allocations) / (double(iterations) * repetitions);
+    return result;
+}
+
+// MPV에 넘기는 대신 인자를 훑어 최적화로 사라지지 않게 함
+void consume(const char* const* args)
+{
+    qint64 sum = 0;
+    for (; *args; ++args) {
+        sum += (*args)[0];
+    }
+    g_sink += sum;
+}
+
+void consume(const char* command)
+{
+    g_sink += command[0];
+}
+
+void consume(mpv_node* node)
+{
+    g_sink += node->u.list->num + qint64(node->u.list->values[1].u.double_);
+}
+
+class Report
+{
+public:
+    explicit Report(const Options& options) : m_options(options) {}
+
+    bool enabled(const QString& name) const
+    {
+        return m_options.filter.isEmpty() || name.contains(m_options.filter);
+    }
+
+    void add(const QString& name, const Measurement& m)
+    {
+        QJsonObject entry;
+        entry["name"] = name;
+        entry["iterations"] = double(m.iterations);
+        entry["nsPerOp"] = m.medianNs;
+        entry["minNsPerOp"] = m.minNs;
+        entry["allocationsPerOp"] = m.allocationsPerOp;
+        m_results.append(entry);
+        fprintf(stderr, "%-20s %10.1f ns/op %6.1f allocs/op\n", qPrintable(name), m.medianNs, m.allocationsPerOp);
+    }
+
+    QJsonArray results() const { return m_results; }
+
+private:
+    const Options& m_options;
+    QJsonArray m_results;
+};
+
+void benchSeek(Report& report, const Options& options)
+{
+    double position = 12.345;
+
+    // 이전 경로: QML 배열 -> QVariantList -> QByteArray/const char* 배열
+    if (report.enabled("variantCommand")) {
+        report.add("variantCommand", measure(options, [&]() {
+            position += 0.041;
+            const QVariant params = QVariantList() << "seek" << QString::number(position) << "absolute" << "exact";
+            const QVariantList args = params.toList();
+            QVector<QByteArray> byteArrays;
+            QVector<const char*> command;
+            byteArrays.reserve(args.size());
+            command.reserve(args.size() + 1);
+            for (const QVariant& arg : args) {
+                byteArrays.append(arg.toString().toUtf8());
+                command.append(byteArrays.last().constData());
+            }
+            command.append(nullptr);
+            consume(command.constData());
+        }));
+    }
+
+    // 이전 seekToPosition: 명령 문자열 조립 (MPV에서 다시 파싱)
+    if (report.enabled("formattedString")) {
+        report.add("formattedString", measure(options, [&]() {
+            position += 0.041;
+            const QByteArray command = QString("seek %1 absolute exact").arg(position).toUtf8();
+            consume(command.constData());
+        }));
+    }
+
+    // 새 경로: 스택 mpv_node 배열
+    if (report.enabled("typedArgs")) {
+        report.add("typedArgs", measure(options, [&]() {
+            position += 0.041;
+            MpvCommand::Args<4> args;
+            MpvCommand::fillSeek(args, position, MpvCommand::Flag::Absolute, true);
+            consume(args.node());
+        }));
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    Options options;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--quick") {
+            options.quick = true;
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            options.filter = args[++i];
+        } else {
+            fprintf(stderr, "Usage: command_bench [--quick] [--filter <name>]\n");
+            return 1;
+        }
+    }
+
+    Report report(options);
+    benchSeek(report, options);
+
+    QJsonObject root;
+    root["benchmark"] = "command";
+    root["qtVersion"] = QString(qVersion());
+    root["quick"] = options.quick;
+    root["results"] = report.results();
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    return 0;
+}
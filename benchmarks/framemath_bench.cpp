@@ -0,0 +1,285 @@
+// 프레임/타임코드 변환과 MPV 속성 분기 마이크로 벤치마크
+// GPU나 디스플레이 없이 실행되며 결과를 JSON으로 stdout에 출력한다.
+//
+//   framemath_bench [--quick] [--filter <이름 일부>]
+
+#include "framemath.h"
+#include "mpvproperties.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+struct FpsCase {
+    const char* label;
+    double fps;
+    int timecodeFormat;   // 해당 프레임레이트에서 실제로 쓰는 타임코드 형식
+};
+
+// 실제 촬영/방송 소스에서 쓰이는 프레임레이트
+const FpsCase kFpsCases[] = {
+    {"23.976", 24000.0 / 1001.0, FrameMath::SmpteNonDrop},
+    {"24", 24.0, FrameMath::SmpteNonDrop},
+    {"25", 25.0, FrameMath::SmpteNonDrop},
+    {"29.97DF", 30000.0 / 1001.0, FrameMath::SmpteDropFrame},
+    {"59.94", 60000.0 / 1001.0, FrameMath::SmpteNonDrop},
+};
+
+// 클립 길이 (시간) - 24시간 이상 녹화본 포함
+const double kClipHours[] = {0.05, 24.0, 26.5};
+
+const int kSampleCount = 4096;
+
+volatile qint64 g_sink = 0;
+
+struct Options {
+    bool quick = false;
+    QString filter;
+};
+
+struct Measurement {
+    qint64 iterations = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+};
+
+// body(i)를 반복 실행하고 1회당 시간(ns)의 중앙값/최솟값을 측정
+Measurement measure(const Options& options, const std::function<void(int)>& body)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto targetDuration = std::chrono::milliseconds(options.quick ? 20 : 200);
+    const int repetitions = options.quick ? 3 : 7;
+
+    // 반복 횟수 보정 (목표 시간을 채울 때까지 두 배씩 증가)
+    qint64 iterations = 1024;
+    for (;;) {
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body(int(i % kSampleCount));
+        }
+        if (Clock::now() - start >= targetDuration / 4 || iterations >= (qint64(1) << 30)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    QVector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body(int(i % kSampleCount));
+        }
+        const double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.append(elapsedNs / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Measurement result;
+    result.iterations = iterations;
+    result.medianNs = samples[samples.size() / 2];
+    result.minNs = samples.first();
+    return result;
+}
+
+// 재현 가능한 프레임 샘플 (클립 전체에 고르게 분포)
+QVector<int> sampleFrames(int totalFrames)
+{
+    QVector<int> frames;
+    frames.reserve(kSampleCount);
+    quint32 state = 0x12345678u;
+    for (int i = 0; i < kSampleCount; ++i) {
+        state = state * 1664525u + 1013904223u;
+        frames.append(int(quint64(state) * quint64(totalFrames) >> 32));
+    }
+    // 경계 프레임 포함
+    frames[0] = 0;
+    frames[1] = totalFrames - 1;
+    return frames;
+}
+
+// 예전 방식: 속성 이름 문자열 비교 체인 (MpvObject::handleMpvEvents 기존 구현)
+MpvProperty dispatchByStrcmpChain(const char* name)
+{
+    if (strcmp(name, "pause") == 0) return MpvProperty::Pause;
+    else if (strcmp(name, "eof-reached") == 0) return MpvProperty::EofReached;
+    else if (strcmp(name, "time-pos") == 0) return MpvProperty::TimePos;
+    else if (strcmp(name, "duration") == 0) return MpvProperty::Duration;
+    else if (strcmp(name, "estimated-vf-fps") == 0) return MpvProperty::EstimatedVfFps;
+    else if (strcmp(name, "media-title") == 0) return MpvProperty::MediaTitle;
+    else if (strcmp(name, "filename") == 0) return MpvProperty::Filename;
+    return MpvProperty::Unknown;
+}
+
+class Report
+{
+public:
+    explicit Report(const Options& options) : m_options(options) {}
+
+    bool enabled(const QString& name) const
+    {
+        return m_options.filter.isEmpty() || name.contains(m_options.filter);
+    }
+
+    void add(const QString& name, const QJsonObject& params, const Measurement& m, int mismatches = -1)
+    {
+        QJsonObject entry = params;
+        entry["name"] = name;
+        entry["iterations"] = double(m.iterations);
+        entry["nsPerOp"] = m.medianNs;
+        entry["minNsPerOp"] = m.minNs;
+        if (mismatches >= 0) {
+            entry["roundTripMismatches"] = mismatches;
+        }
+        m_results.append(entry);
+        fprintf(stderr, "%-40s %-10s %10.1f ns/op\n", qPrintable(name),
+                qPrintable(params.value("fps").toString()), m.medianNs);
+    }
+
+    QJsonArray results() const { return m_results; }
+
+private:
+    const Options& m_options;
+    QJsonArray m_results;
+};
+
+void benchFrameMath(Report& report, const Options& options)
+{
+    for (const FpsCase& fpsCase : kFpsCases) {
+        for (double hours : kClipHours) {
+            const int totalFrames = int(hours * 3600.0 * fpsCase.fps);
+            const QVector<int> frames = sampleFrames(totalFrames);
+
+            QJsonObject params;
+            params["fps"] = QString(fpsCase.label);
+            params["clipHours"] = hours;
+            params["totalFrames"] = totalFrames;
+
+            QVector<QString> timecodes;
+            QVector<double> positions;
+            timecodes.reserve(kSampleCount);
+            positions.reserve(kSampleCount);
+            for (int frame : frames) {
+                timecodes.append(FrameMath::frameToTimecode(frame, fpsCase.fps, fpsCase.timecodeFormat, QString()));
+                positions.append(FrameMath::positionFromFrame(frame, fpsCase.fps));
+            }
+
+            if (report.enabled("frameToTimecode")) {
+                const Measurement m = measure(options, [&](int i) {
+                    g_sink += FrameMath::frameToTimecode(frames[i], fpsCase.fps, fpsCase.timecodeFormat, QString()).size();
+                });
+                report.add("frameToTimecode", params, m);
+            }
+
+            if (report.enabled("timecodeToFrame")) {
+                int mismatches = 0;
+                for (int i = 0; i < kSampleCount; ++i) {
+                    if (FrameMath::timecodeToFrame(timecodes[i], fpsCase.fps) != frames[i]) {
+                        ++mismatches;
+                    }
+                }
+                const Measurement m = measure(options, [&](int i) {
+                    g_sink += FrameMath::timecodeToFrame(timecodes[i], fpsCase.fps);
+                });
+                report.add("timecodeToFrame", params, m, mismatches);
+            }
+
+            if (report.enabled("calculateFrameFromPosition")) {
+                int mismatches = 0;
+                for (int i = 0; i < kSampleCount; ++i) {
+                    if (FrameMath::frameFromPosition(positions[i], fpsCase.fps, totalFrames) != frames[i]) {
+                        ++mismatches;
+                    }
+                }
+                const Measurement m = measure(options, [&](int i) {
+                    g_sink += FrameMath::frameFromPosition(positions[i], fpsCase.fps, totalFrames);
+                });
+                report.add("calculateFrameFromPosition", params, m, mismatches);
+            }
+
+            if (report.enabled("calculatePositionFromFrame")) {
+                const Measurement m = measure(options, [&](int i) {
+                    g_sink += qint64(FrameMath::positionFromFrame(frames[i], fpsCase.fps));
+                });
+                report.add("calculatePositionFromFrame", params, m);
+            }
+        }
+    }
+}
+
+void benchPropertyDispatch(Report& report, const Options& options)
+{
+    // 재생 중 실제 이벤트 분포: 대부분 time-pos, 가끔 pause/fps/duration
+    QVector<const char*> names;
+    QVector<uint64_t> ids;
+    for (int i = 0; i < kSampleCount; ++i) {
+        const MpvObservedProperty* property = &kObservedMpvProperties[1]; // time-pos
+        if (i % 64 == 0) property = &kObservedMpvProperties[0];           // pause
+        else if (i % 97 == 0) property = &kObservedMpvProperties[5];      // estimated-vf-fps
+        else if (i % 211 == 0) property = &kObservedMpvProperties[2];     // duration
+        names.append(property->name);
+        ids.append(uint64_t(property->id));
+    }
+
+    QJsonObject params;
+    params["fps"] = QString("-");
+
+    if (report.enabled("propertyDispatch/strcmpChain")) {
+        report.add("propertyDispatch/strcmpChain", params, measure(options, [&](int i) {
+            g_sink += qint64(dispatchByStrcmpChain(names[i]));
+        }));
+    }
+    if (report.enabled("propertyDispatch/nameTable")) {
+        report.add("propertyDispatch/nameTable", params, measure(options, [&](int i) {
+            g_sink += qint64(mpvPropertyFromName(names[i]));
+        }));
+    }
+    if (report.enabled("propertyDispatch/userdataId")) {
+        report.add("propertyDispatch/userdataId", params, measure(options, [&](int i) {
+            g_sink += qint64(mpvPropertyFromUserdata(ids[i]));
+        }));
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    Options options;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--quick") {
+            options.quick = true;
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            options.filter = args[++i];
+        } else {
+            fprintf(stderr, "Usage: framemath_bench [--quick] [--filter <name>]\n");
+            return 1;
+        }
+    }
+
+    Report report(options);
+    benchFrameMath(report, options);
+    benchPropertyDispatch(report, options);
+
+    QJsonObject root;
+    root["benchmark"] = "framemath";
+    root["qtVersion"] = QString(qVersion());
+    root["quick"] = options.quick;
+    root["results"] = report.results();
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    return 0;
+}
@@ -0,0 +1,338 @@
+// 시크 지연/정확도 종단 간 벤치마크
+// TestClip으로 프레임 번호가 새겨진 클립을 만들고, TimelineSync::seekToFrame과 같은 방식으로 시크한 뒤
+// 소프트웨어 렌더러로 표시된 프레임을 읽어 요청한 프레임과 비교한다. GPU나 디스플레이가 필요 없다.
+//
+//   seek_bench [--clips <디렉토리>] [--count <시크 횟수>] [--filter <클립 이름 일부>]
+//
+// 결과(JSON)는 stdout, 진행 상황은 stderr로 출력된다.
+
+#include "framemath.h"
+#include "mpvheadless.h"
+#include "testclip.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QVector>
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <render.h>
+
+namespace {
+
+// 표시된 프레임을 읽기 위한 렌더링 크기 (바코드 한 칸 = 16픽셀)
+const int kRenderWidth = 384;
+const int kRenderHeight = 216;
+const int kSeekTimeoutMs = 5000;
+
+// 시크 명령 방식
+enum class SeekStyle {
+    Timeline,   // TimelineSync::seekToFrame과 동일: seek absolute exact + time-pos 설정
+    Single      // seek absolute+exact 한 번만
+};
+
+struct SeekResult {
+    double latencyMs = -1.0;   // 시크 명령 ~ 대상 프레임 렌더링 완료
+    int displayedFrame = -1;
+};
+
+class SeekHarness
+{
+public:
+    ~SeekHarness() { close(); }
+
+    bool open(const QString& file)
+    {
+        m_mpv = createHeadlessMpv();
+        if (!m_mpv) {
+            return false;
+        }
+
+        mpv_set_option_string(m_mpv, "vo", "libmpv");
+        mpv_set_option_string(m_mpv, "pause", "yes");
+        mpv_set_option_string(m_mpv, "keep-open", "yes");
+        mpv_set_option_string(m_mpv, "aid", "no");
+        mpv_set_option_string(m_mpv, "hr-seek", "yes");
+        mpv_set_option_string(m_mpv, "hwdec", "no");
+
+        if (mpv_initialize(m_mpv) < 0) {
+            return false;
+        }
+
+        mpv_render_param params[] = {
+            {MPV_RENDER_PARAM_API_TYPE, const_cast<char*>(MPV_RENDER_API_TYPE_SW)},
+            {MPV_RENDER_PARAM_INVALID, nullptr}
+        };
+        if (mpv_render_context_create(&m_render, m_mpv, params) < 0) {
+            fprintf(stderr, "Software render context not available\n");
+            return false;
+        }
+        // 새 프레임이 준비되면 이벤트 대기를 깨움
+        mpv_render_context_set_update_callback(m_render, [](void* handle) {
+            mpv_wakeup(static_cast<mpv_handle*>(handle));
+        }, m_mpv);
+
+        m_pixels.resize(kRenderWidth * kRenderHeight * 4);
+
+        const QByteArray path = file.toUtf8();
+        const char* cmd[] = {"loadfile", path.constData(), nullptr};
+        if (mpv_command(m_mpv, cmd) < 0) {
+            return false;
+        }
+
+        // 첫 프레임이 표시될 때까지 대기
+        return waitForDisplayedFrame() >= 0;
+    }
+
+    void close()
+    {
+        if (m_render) {
+            mpv_render_context_free(m_render);
+            m_render = nullptr;
+        }
+        if (m_mpv) {
+            mpv_terminate_destroy(m_mpv);
+            m_mpv = nullptr;
+        }
+    }
+
+    SeekResult seek(int frame, double fps, SeekStyle style)
+    {
+        // TimelineSync::calculatePositionFromFrame과 같은 변환
+        double target = FrameMath::positionFromFrame(frame, fps);
+        const QByteArray pos = QByteArray::number(target, 'f', 6);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        if (style == SeekStyle::Timeline) {
+            const char* cmd[] = {"seek", pos.constData(), "absolute", "exact", nullptr};
+            mpv_command(m_mpv, cmd);
+            mpv_set_property(m_mpv, "time-pos", MPV_FORMAT_DOUBLE, &target);
+        } else {
+            const char* cmd[] = {"seek", pos.constData(), "absolute+exact", nullptr};
+            mpv_command(m_mpv, cmd);
+        }
+
+        SeekResult result;
+        result.displayedFrame = waitForDisplayedFrame();
+        if (result.displayedFrame >= 0) {
+            result.latencyMs = timer.nsecsElapsed() / 1e6;
+        }
+        return result;
+    }
+
+private:
+    // 시크 완료(PLAYBACK_RESTART)까지 이벤트를 처리하고 표시된 프레임 번호 반환
+    // 재시작 이벤트보다 먼저 렌더링된 프레임도 버리지 않음 - 시크를 보낸 뒤 마지막으로 렌더링된 프레임을
+    // 기억해 두었다가 재시작이 오면 그 프레임을 결과로 사용 (그 뒤 새 프레임이 없어도 기다리지 않음)
+    int waitForDisplayedFrame()
+    {
+        QElapsedTimer timeout;
+        timeout.start();
+        bool restarted = false;
+        bool rendered = false;
+        int lastFrame = -1;
+
+        while (timeout.elapsed() < kSeekTimeoutMs) {
+            mpv_event* event = mpv_wait_event(m_mpv, 0.1);
+            if (event->event_id == MPV_EVENT_PLAYBACK_RESTART) {
+                // Timeline 방식의 두 시크 요청은 mpv 내부에서 하나로 합쳐져 재시작 이벤트도 한 번만 온다
+                restarted = true;
+            } else if (event->event_id == MPV_EVENT_END_FILE || event->event_id == MPV_EVENT_SHUTDOWN) {
+                return -1;
+            }
+
+            const uint64_t flags = mpv_render_context_update(m_render);
+            if (flags & MPV_RENDER_UPDATE_FRAME) {
+                render();
+                rendered = true;
+                lastFrame = TestClip::decodeFrameIndex(m_pixels.data(), kRenderWidth, kRenderHeight, kRenderWidth * 4);
+            }
+
+            if (restarted && rendered) {
+                return lastFrame;
+            }
+        }
+        return -1;
+    }
+
+    void render()
+    {
+        int size[2] = {kRenderWidth, kRenderHeight};
+        size_t stride = kRenderWidth * 4;
+        mpv_render_param params[] = {
+            {MPV_RENDER_PARAM_SW_SIZE, size},
+            {MPV_RENDER_PARAM_SW_FORMAT, const_cast<char*>("rgb0")},
+            {MPV_RENDER_PARAM_SW_STRIDE, &stride},
+            {MPV_RENDER_PARAM_SW_POINTER, m_pixels.data()},
+            {MPV_RENDER_PARAM_INVALID, nullptr}
+        };
+        mpv_render_context_render(m_render, params);
+    }
+
+    mpv_handle* m_mpv = nullptr;
+    mpv_render_context* m_render = nullptr;
+    QVector<unsigned char> m_pixels;
+};
+
+// 시크 패턴별 대상 프레임 목록
+QVector<int> buildPattern(const QString& pattern, int totalFrames, int count)
+{
+    QVector<int> frames;
+    if (pattern == "random") {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> dist(0, totalFrames - 1);
+        for (int i = 0; i < count; ++i) frames.append(dist(rng));
+    } else if (pattern == "sequential") {
+        const int start = qMax(0, totalFrames / 2 - count / 2);
+        for (int i = 0; i < count && start + i < totalFrames; ++i) frames.append(start + i);
+    } else if (pattern == "reverse") {
+        for (int i = 0; i < count && totalFrames - 1 - i >= 0; ++i) frames.append(totalFrames - 1 - i);
+    } else if (pattern == "edges") {
+        // 첫/마지막 프레임 부근 (이전 "171 프레임 트랩" 같은 경계 오류 확인용)
+        const int edges[] = {0, 1, 2, totalFrames - 3, totalFrames - 2, totalFrames - 1};
+        for (int i = 0; i < qMax(1, count / 6); ++i) {
+            for (int frame : edges) frames.append(qBound(0, frame, totalFrames - 1));
+        }
+    }
+    return frames;
+}
+
+double percentile(QVector<double> values, double p)
+{
+    if (values.isEmpty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const int index = qBound(0, int(std::ceil(p * values.size())) - 1, int(values.size()) - 1);
+    return values[index];
+}
+
+QJsonObject runPattern(SeekHarness& harness, const TestClip::Spec& spec, const QString& pattern,
+                       SeekStyle style, int count)
+{
+    const QVector<int> frames = buildPattern(pattern, spec.frameCount(), count);
+
+    QVector<double> latencies;
+    int mismatches = 0;
+    int timeouts = 0;
+    QJsonObject offsets;
+    QJsonArray firstMismatches;
+
+    for (int frame : frames) {
+        const SeekResult result = harness.seek(frame, spec.fps(), style);
+        if (result.displayedFrame < 0) {
+            ++timeouts;
+            continue;
+        }
+        latencies.append(result.latencyMs);
+
+        if (result.displayedFrame != frame) {
+            ++mismatches;
+            const QString key = QString::number(result.displayedFrame - frame);
+            offsets[key] = offsets.value(key).toInt() + 1;
+            if (firstMismatches.size() < 10) {
+                firstMismatches.append(QJsonObject{{"requested", frame}, {"displayed", result.displayedFrame}});
+            }
+        }
+    }
+
+    double sum = 0.0;
+    for (double value : latencies) sum += value;
+
+    QJsonObject entry;
+    entry["clip"] = spec.name;
+    entry["codec"] = spec.codec;
+    entry["gop"] = spec.gop;
+    entry["fps"] = spec.fps();
+    entry["pattern"] = pattern;
+    entry["seekStyle"] = style == SeekStyle::Timeline ? "timeline" : "single";
+    entry["seeks"] = int(frames.size());
+    entry["timeouts"] = timeouts;
+    entry["p50Ms"] = percentile(latencies, 0.50);
+    entry["p95Ms"] = percentile(latencies, 0.95);
+    entry["p99Ms"] = percentile(latencies, 0.99);
+    entry["maxMs"] = percentile(latencies, 1.0);
+    entry["meanMs"] = latencies.isEmpty() ? 0.0 : sum / latencies.size();
+    entry["mismatches"] = mismatches;
+    entry["mismatchOffsets"] = offsets;
+    entry["firstMismatches"] = firstMismatches;
+
+    fprintf(stderr, "%-20s %-10s %-8s p50 %7.2f ms  p99 %7.2f ms  mismatches %d/%d\n",
+            qPrintable(spec.name), qPrintable(pattern), qPrintable(entry["seekStyle"].toString()),
+            entry["p50Ms"].toDouble(), entry["p99Ms"].toDouble(), mismatches, int(frames.size()));
+    return entry;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QString clipDir = QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation)).filePath("player-seek-bench");
+    QString filter;
+    int count = 200;
+
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--clips" && i + 1 < args.size()) {
+            clipDir = args[++i];
+        } else if (args[i] == "--count" && i + 1 < args.size()) {
+            count = qMax(6, args[++i].toInt());
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            filter = args[++i];
+        } else {
+            fprintf(stderr, "Usage: seek_bench [--clips <dir>] [--count <n>] [--filter <clip>]\n");
+            return 1;
+        }
+    }
+
+    // mpv는 숫자 변환에 C 로케일이 필요
+    std::setlocale(LC_NUMERIC, "C");
+
+    QJsonArray results;
+    QJsonArray failures;
+    const QStringList patterns = {"random", "sequential", "reverse", "edges"};
+
+    for (const TestClip::Spec& spec : TestClip::defaultSpecs()) {
+        if (!filter.isEmpty() && !spec.name.contains(filter)) {
+            continue;
+        }
+
+        QString error;
+        const QString file = TestClip::ensure(spec, clipDir, &error);
+        if (file.isEmpty()) {
+            failures.append(QJsonObject{{"clip", spec.name}, {"error", error}});
+            continue;
+        }
+
+        for (SeekStyle style : {SeekStyle::Timeline, SeekStyle::Single}) {
+            SeekHarness harness;
+            if (!harness.open(file)) {
+                failures.append(QJsonObject{{"clip", spec.name}, {"error", "Failed to open clip for playback"}});
+                break;
+            }
+            for (const QString& pattern : patterns) {
+                results.append(runPattern(harness, spec, pattern, style, count));
+            }
+        }
+    }
+
+    QJsonObject root;
+    root["benchmark"] = "seek";
+    root["clipDirectory"] = clipDir;
+    root["seeksPerPattern"] = count;
+    root["results"] = results;
+    root["failures"] = failures;
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    return failures.isEmpty() ? 0 : 2;
+}
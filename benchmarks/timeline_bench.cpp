@@ -0,0 +1,273 @@
+// 타임라인 정점 생성 마이크로 벤치마크 (TimelineItem이 쓰는 TimelineLayout)
+// GPU나 디스플레이 없이 실행되며 결과를 JSON으로 stdout에 출력한다.
+// 프레임 수를 1천 ~ 1억까지 늘려도 다시 그리기 비용(눈금 정점 + 라벨 위치)이 화면 폭에만 비례하는지 확인한다.
+//
+//   timeline_bench [--quick] [--filter <이름 일부>]
+
+#include "timelinelayout.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+const double kFpsCases[] = {24.0, 60000.0 / 1001.0};
+const int kFrameCounts[] = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+const double kWidths[] = {800.0, 1920.0, 3840.0};
+const double kTickHeight = 25.0;
+
+volatile qint64 g_sink = 0;
+
+struct Options {
+    bool quick = false;
+    QString filter;
+};
+
+struct Measurement {
+    qint64 iterations = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+};
+
+// body()를 반복 실행하고 1회당 시간(ns)의 중앙값/최솟값을 측정
+Measurement measure(const Options& options, const std::function<void()>& body)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto targetDuration = std::chrono::milliseconds(options.quick ? 20 : 200);
+    const int repetitions = options.quick ? 3 : 7;
+
+    qint64 iterations = 16;
+    for (;;) {
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        if (Clock::now() - start >= targetDuration / 4 || iterations >= (qint64(1) << 24)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    QVector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        const auto start = Clock::now();
+        for (qint64 i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.append(elapsedNs / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Measurement result;
+    result.iterations = iterations;
+    result.medianNs = samples[samples.size() / 2];
+    result.minNs = samples.first();
+    return result;
+}
+
+class Report
+{
+public:
+    explicit Report(const Options& options) : m_options(options) {}
+
+    bool enabled(const QString& name) const
+    {
+        return m_options.filter.isEmpty() || name.contains(m_options.filter);
+    }
+
+    void add(const QString& name, const QJsonObject& params, const Measurement& m)
+    {
+        QJsonObject entry = params;
+        entry["name"] = name;
+        entry["iterations"] = double(m.iterations);
+        entry["nsPerOp"] = m.medianNs;
+        entry["minNsPerOp"] = m.minNs;
+        m_results.append(entry);
+        fprintf(stderr, "%-24s frames=%-10d width=%-6.0f %12.1f ns/op\n", qPrintable(name),
+                params.value("totalFrames").toInt(), params.value("width").toDouble(), m.medianNs);
+    }
+
+    void addSummary(const QJsonObject& summary) { m_summary.append(summary); }
+
+    QJsonArray results() const { return m_results; }
+    QJsonArray summary() const { return m_summary; }
+
+private:
+    const Options& m_options;
+    QJsonArray m_results;
+    QJsonArray m_summary;
+};
+
+// 눈금 간격 선택 + 눈금 정점 + 라벨 위치 (프레임 수/fps/폭이 바뀔 때 TimelineItem이 하는 일)
+void benchTicks(Report& report, const Options& options)
+{
+    const QString name = "rebuildTicks";
+    if (!report.enabled(name)) {
+        return;
+    }
+
+    std::vector<TimelineLayout::Point> minorLines;
+    std::vector<TimelineLayout::Point> majorLines;
+
+    for (double fps : kFpsCases) {
+        for (double width : kWidths) {
+            double fastest = 0.0;
+            double slowest = 0.0;
+            for (int totalFrames : kFrameCounts) {
+                size_t vertices = 0;
+                int labels = 0;
+                const Measurement m = measure(options, [&]() {
+                    minorLines.clear();
+                    majorLines.clear();
+                    const TimelineLayout::Steps steps = TimelineLayout::chooseSteps(totalFrames, fps, width);
+                    TimelineLayout::appendTicks(minorLines, majorLines, steps, totalFrames, width, 3.0, kTickHeight);
+                    const QVector<int> frames = TimelineLayout::labelFrames(steps, totalFrames);
+                    vertices = minorLines.size() + majorLines.size();
+                    labels = frames.size();
+                    g_sink += qint64(vertices) + labels;
+                });
+
+                const TimelineLayout::Steps steps = TimelineLayout::chooseSteps(totalFrames, fps, width);
+                QJsonObject params;
+                params["fps"] = fps;
+                params["width"] = width;
+                params["totalFrames"] = totalFrames;
+                params["vertices"] = double(vertices);
+                params["labels"] = labels;
+                params["minorStep"] = steps.minor;
+                params["majorStep"] = steps.major;
+                params["labelStep"] = steps.label;
+                report.add(name, params, m);
+
+                fastest = fastest == 0.0 ? m.medianNs : std::min(fastest, m.medianNs);
+                slowest = std::max(slowest, m.medianNs);
+            }
+
+            // 프레임 수가 10만 배 늘어도 비용이 비슷해야 함 (1에 가까울수록 일정)
+            QJsonObject summary;
+            summary["name"] = name;
+            summary["fps"] = fps;
+            summary["width"] = width;
+            summary["minFrames"] = kFrameCounts[0];
+            summary["maxFrames"] = kFrameCounts[std::size(kFrameCounts) - 1];
+            summary["slowestToFastest"] = slowest / fastest;
+            report.addSummary(summary);
+        }
+    }
+}
+
+// 파형 정점 (화면 폭만큼의 피크)
+void benchWaveform(Report& report, const Options& options)
+{
+    const QString name = "rebuildWaveform";
+    if (!report.enabled(name)) {
+        return;
+    }
+
+    std::vector<TimelineLayout::Point> range;
+    std::vector<TimelineLayout::Point> rms;
+    for (double width : kWidths) {
+        const int columns = int(width);
+        std::vector<float> peaks(size_t(columns) * 3);
+        quint32 state = 0x12345678u;
+        for (int i = 0; i < columns; ++i) {
+            state = state * 1664525u + 1013904223u;
+            const float level = float(state >> 8) / float(1 << 24);
+            peaks[i * 3] = -level;
+            peaks[i * 3 + 1] = level;
+            peaks[i * 3 + 2] = level * 0.7f;
+        }
+
+        const Measurement m = measure(options, [&]() {
+            range.clear();
+            rms.clear();
+            TimelineLayout::appendWaveform(range, rms, peaks.data(), columns, 3.0, kTickHeight);
+            g_sink += qint64(range.size() + rms.size());
+        });
+
+        QJsonObject params;
+        params["width"] = width;
+        params["vertices"] = double(range.size() + rms.size());
+        report.add(name, params, m);
+    }
+}
+
+// 캐시 구간 띠
+void benchRanges(Report& report, const Options& options)
+{
+    const QString name = "rebuildRanges";
+    if (!report.enabled(name)) {
+        return;
+    }
+
+    const int totalFrames = 1000000;
+    const double fps = 24.0;
+    const double duration = totalFrames / fps;
+    std::vector<TimelineLayout::Point> triangles;
+    for (int rangeCount : {1, 8, 64}) {
+        QVector<QPair<double, double>> ranges;
+        for (int i = 0; i < rangeCount; ++i) {
+            const double start = duration * i / rangeCount;
+            ranges.append(qMakePair(start, start + duration / rangeCount / 2));
+        }
+
+        const Measurement m = measure(options, [&]() {
+            triangles.clear();
+            TimelineLayout::appendRanges(triangles, ranges, fps, totalFrames, 1920.0, 38.0, 2.0);
+            g_sink += qint64(triangles.size());
+        });
+
+        QJsonObject params;
+        params["width"] = 1920.0;
+        params["totalFrames"] = totalFrames;
+        params["ranges"] = rangeCount;
+        report.add(name, params, m);
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    Options options;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--quick") {
+            options.quick = true;
+        } else if (args[i] == "--filter" && i + 1 < args.size()) {
+            options.filter = args[++i];
+        } else {
+            fprintf(stderr, "Usage: timeline_bench [--quick] [--filter <name>]\n");
+            return 1;
+        }
+    }
+
+    Report report(options);
+    benchTicks(report, options);
+    benchWaveform(report, options);
+    benchRanges(report, options);
+
+    QJsonObject root;
+    root["benchmark"] = "timeline";
+    root["qtVersion"] = QString(qVersion());
+    root["quick"] = options.quick;
+    root["results"] = report.results();
+    root["summary"] = report.summary();
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    return 0;
+}
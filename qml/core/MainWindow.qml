@@ -66,6 +66,83 @@ Window {
                 event.accepted = true
             }
             
+            // 트레이싱 시작/중지 (Ctrl+Shift+T) - 중지할 때 Chrome trace JSON으로 저장
+            else if (event.key === Qt.Key_T && event.modifiers === (Qt.ControlModifier | Qt.ShiftModifier)) {
+                if (typeof tracing !== "undefined") {
+                    if (tracing.enabled) {
+                        tracing.enabled = false
+                        console.log("Trace saved:", tracing.dump())
+                    } else {
+                        tracing.clear()
+                        tracing.enabled = true
+                        console.log("Tracing started")
+                    }
+                }
+                event.accepted = true
+            }
+            
+            // 성능 통계 패널 표시 (Ctrl+Shift+P)
+            else if (event.key === Qt.Key_P && event.modifiers === (Qt.ControlModifier | Qt.ShiftModifier)) {
+                videoPlayer.showPerformanceStats = !videoPlayer.showPerformanceStats
+                event.accepted = true
+            }
+            
+            // 리뷰 세션 패널 (Ctrl+Shift+R)
+            else if (event.key === Qt.Key_R && event.modifiers === (Qt.ControlModifier | Qt.ShiftModifier)) {
+                videoPlayer.showReviewSession = !videoPlayer.showReviewSession
+                event.accepted = true
+            }
+            
+            // A/B 비교 창 (Ctrl+Shift+C)
+            else if (event.key === Qt.Key_C && event.modifiers === (Qt.ControlModifier | Qt.ShiftModifier)) {
+                videoPlayer.toggleCompareWindow()
+                event.accepted = true
+            }
+            
+            // 재생 목록 이전/다음 항목 (Page Up / Page Down)
+            else if (event.key === Qt.Key_PageUp || event.key === Qt.Key_PageDown) {
+                if (typeof playlistModel !== "undefined" && playlistModel) {
+                    if (event.key === Qt.Key_PageUp) {
+                        playlistModel.previous()
+                    } else {
+                        playlistModel.next()
+                    }
+                }
+                event.accepted = true
+            }
+            
+            // J/K/L 셔틀 (J: 역방향 재생, K: 정지, L: 정방향 재생 - 반복해서 누르면 빨라짐)
+            else if ((event.key === Qt.Key_J || event.key === Qt.Key_K || event.key === Qt.Key_L)
+                     && event.modifiers === Qt.NoModifier) {
+                var mpv = videoPlayer.videoArea ? videoPlayer.videoArea.mpvPlayer : null
+                if (mpv && mpv.reversePlayback) {
+                    if (event.key === Qt.Key_J) {
+                        mpv.reversePlayback.shuttleReverse()
+                    } else if (event.key === Qt.Key_K) {
+                        mpv.reversePlayback.stop()
+                    } else {
+                        mpv.reversePlayback.shuttleForward()
+                    }
+                }
+                event.accepted = true
+            }
+            
+            // 반복 구간 인/아웃 (I / O), 해제 (Alt+X)
+            else if ((event.key === Qt.Key_I || event.key === Qt.Key_O) && event.modifiers === Qt.NoModifier
+                     || event.key === Qt.Key_X && event.modifiers === Qt.AltModifier) {
+                var player = videoPlayer.videoArea ? videoPlayer.videoArea.mpvPlayer : null
+                if (player && player.loopRange) {
+                    if (event.key === Qt.Key_I) {
+                        player.loopRange.markIn()
+                    } else if (event.key === Qt.Key_O) {
+                        player.loopRange.markOut()
+                    } else {
+                        player.loopRange.clear()
+                    }
+                }
+                event.accepted = true
+            }
+            
             // 재생/일시정지 (Space)
             else if (event.key === Qt.Key_Space) {
                 videoPlayer.videoArea.playPause()
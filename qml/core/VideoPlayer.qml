@@ -117,6 +117,27 @@ Item {
                 }
             });
             
+            // 리뷰 세션 연결 (진행자 재생 상태 방송 / 참가자 따라가기)
+            Qt.callLater(function() {
+                if (typeof reviewSession !== "undefined" && reviewSession && player) {
+                    reviewSession.connectMpv(player);
+                }
+            });
+            
+            // 자동화 제어 서버 연결 (--control-server로 실행한 경우)
+            Qt.callLater(function() {
+                if (typeof controlServer !== "undefined" && controlServer && player) {
+                    controlServer.connectMpv(player);
+                }
+            });
+            
+            // 재생 목록 모델 연결 (MPV 재생 목록 동기화)
+            Qt.callLater(function() {
+                if (typeof playlistModel !== "undefined" && playlistModel && player) {
+                    playlistModel.connectMpv(player);
+                }
+            });
+            
             // ControlBar에 새로운 MPV 객체 전달 (지연 후)
             Qt.callLater(function() {
                 if (controlBar) {
@@ -173,8 +194,10 @@ Item {
                         // 극단적인 불일치만 강제 동기화 (15프레임 이상 차이)
                         if (Math.abs(mpvFrame - frame) > 15) {
                             console.log("MPV Sync: Extreme mismatch detected - MPV:", mpvFrame, "UI:", frame);
-                    var pos = frame / fps;
-                    mpv.setProperty("time-pos", pos);
+                            // 프레임 시크는 재생 상태 머신 한 경로로
+                            if (mpv.playbackState) {
+                                mpv.playbackState.seekToFrame(frame);
+                            }
                         }
                     }
                 } catch (e) {
@@ -308,24 +331,136 @@ Item {
         }
     }
     
-    // Settings window
-    SettingsPanel {
-        id: settingsWindow
-        visible: false
-        mpvObject: getMpvObject()
+    // Settings window - 처음 열 때 또는 시작 후 유휴 시간에 비동기로 생성
+    Loader {
+        id: settingsWindowLoader
+        active: false
+        asynchronous: true
+        
+        property bool showWhenLoaded: false
+        
+        sourceComponent: Component {
+            SettingsPanel {
+                visible: false
+                mpvObject: getMpvObject()
+            }
+        }
+        
+        onLoaded: {
+            if (showWhenLoaded) {
+                showWhenLoaded = false;
+                item.show();
+            }
+        }
     }
     
-    // Scopes window
-    ScopeWindow {
-        id: scopeWindow
-        visible: false
-        videoArea: videoArea
+    // Scopes window - 설정 창과 같은 방식으로 지연 생성
+    Loader {
+        id: scopeWindowLoader
+        active: false
+        asynchronous: true
         
-        Component.onCompleted: {
-            console.log("ScopeWindow initialized");
+        property bool showWhenLoaded: false
+        
+        sourceComponent: Component {
+            ScopeWindow {
+                visible: false
+                videoArea: videoArea
+                
+                Component.onCompleted: {
+                    console.log("ScopeWindow initialized");
+                }
+            }
+        }
+        
+        onLoaded: {
+            if (showWhenLoaded) {
+                showWhenLoaded = false;
+                item.show();
+            }
         }
     }
     
+    // A/B 비교 창 (Ctrl+Shift+C) - 필요할 때만 생성
+    Loader {
+        id: compareWindowLoader
+        active: false
+        asynchronous: true
+        source: (typeof hasMpvSupport !== "undefined" && hasMpvSupport) ? "../widgets/CompareWindow.qml" : ""
+        
+        property bool showWhenLoaded: false
+        
+        onLoaded: {
+            if (showWhenLoaded) {
+                showWhenLoaded = false;
+                root.showCompareWindow();
+            }
+        }
+    }
+    
+    // 비교 창 열기/닫기 - 처음 열 때 현재 파일을 A 클립으로 추가
+    function toggleCompareWindow() {
+        if (compareWindowLoader.status !== Loader.Ready) {
+            compareWindowLoader.showWhenLoaded = true;
+            compareWindowLoader.active = true;
+        } else if (!compareWindowLoader.item.visible) {
+            showCompareWindow();
+        } else {
+            compareWindowLoader.item.close();
+        }
+    }
+    
+    function showCompareWindow() {
+        var window = compareWindowLoader.item;
+        if (!window) return;
+        if (window.clipCount === 0 && videoArea.mpvPlayer) {
+            var path = videoArea.mpvPlayer.getProperty("path");
+            if (path) {
+                videoArea.mpvPlayer.pause();
+                window.addClip(path);
+            }
+        }
+        window.show();
+        window.raise();
+    }
+    
+    // 첫 화면이 뜬 뒤 자주 쓰지 않는 창들을 미리 생성 (첫 열기 지연 방지)
+    Timer {
+        id: deferredWindowsTimer
+        interval: 3000
+        running: true
+        repeat: false
+        onTriggered: {
+            settingsWindowLoader.active = true;
+            scopeWindowLoader.active = true;
+        }
+    }
+    
+    // 성능 통계 패널 (Ctrl+Shift+P)
+    property bool showPerformanceStats: false
+    
+    PerformanceStats {
+        id: performanceStats
+        z: 10
+        visible: root.showPerformanceStats
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 12
+        governor: videoArea.mpvPlayer ? videoArea.mpvPlayer.governor : null
+    }
+    
+    // 리뷰 세션 패널 (Ctrl+Shift+R)
+    property bool showReviewSession: false
+    
+    ReviewSessionPanel {
+        z: 10
+        visible: root.showReviewSession
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 12
+        session: typeof reviewSession !== "undefined" ? reviewSession : null
+    }
+    
     // Main layout - separates video area and control area
     ColumnLayout {
         id: mainLayout
@@ -341,7 +476,7 @@ Item {
             // Connect the settingsToggleRequested signal - commented out until fixed
             // onSettingsToggleRequested: {
             //     // Forward to the settings toggle handler
-            //     settingsWindow.visible = !settingsWindow.visible
+            //     settingsWindowLoader.item.visible = !settingsWindowLoader.item.visible
             // }
             
             // 프레임/파일 변경 이벤트에서 상태 갱신
@@ -415,16 +550,8 @@ Item {
                 // 1. First, update internal state immediately
                 root.currentFrame = frame;
                 
-                // 2. Pass seek command to video area
+                // 2. Pass seek command to video area (재생 상태 머신이 시크/도착 확인)
                 videoArea.seekToFrame(frame);
-                
-                // 3. Pass seek command directly to MPV (double guarantee)
-                var mpv = getMpvObject();
-                if (mpv) {
-                    var pos = frame / fps;
-                    mpv.setProperty("time-pos", pos);
-                    console.log("MPV direct seek command:", pos);
-                }
             }
             
             onOpenFileRequested: videoArea.openFile()
@@ -437,17 +564,24 @@ Item {
             }
             onSettingsToggleRequested: {
                 // Open settings window instead
-                if (!settingsWindow.visible) {
-                    settingsWindow.show()
+                if (settingsWindowLoader.status !== Loader.Ready) {
+                    settingsWindowLoader.showWhenLoaded = true;
+                    settingsWindowLoader.active = true;
+                } else if (!settingsWindowLoader.item.visible) {
+                    settingsWindowLoader.item.show()
                 }
             }
             onToggleScopesRequested: {
                 // Open/close scopes window
-                if (!scopeWindow.visible) {
+                if (scopeWindowLoader.status !== Loader.Ready) {
+                    console.log("Showing scope window");
+                    scopeWindowLoader.showWhenLoaded = true;
+                    scopeWindowLoader.active = true;
+                } else if (!scopeWindowLoader.item.visible) {
                     console.log("Showing scope window");
-                    scopeWindow.show();
+                    scopeWindowLoader.item.show();
                 } else {
-                    scopeWindow.hide();
+                    scopeWindowLoader.item.hide();
                 }
             }
         }
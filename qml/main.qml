@@ -354,7 +354,7 @@ ApplicationWindow {
         sequence: "Home"
         onActivated: {
             if (videoArea.mpvPlayer) {
-                videoArea.mpvPlayer.setProperty("time-pos", 0);
+                videoArea.seekToFrame(0);
             }
         }
     }
@@ -362,8 +362,8 @@ ApplicationWindow {
     Shortcut {
         sequence: "End"
         onActivated: {
-            if (videoArea.mpvPlayer && videoArea.mpvPlayer.duration) {
-                videoArea.mpvPlayer.setProperty("time-pos", videoArea.mpvPlayer.duration - (1/fps));
+            if (videoArea.mpvPlayer && videoArea.frames > 0) {
+                videoArea.seekToFrame(videoArea.frames - 1);
             }
         }
     }
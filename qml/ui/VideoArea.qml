@@ -52,9 +52,6 @@ Item {
     // 메타데이터가 이미 로드되었는지 추적하는 플래그
     property bool metadataLoaded: false
     
-    // 시크/드래그 중 메타데이터 업데이트 방지 플래그
-    property bool metadataUpdateBlocked: false
-    
     // MPV 객체 초기화 시 이벤트 연결
     Component.onCompleted: {
         console.log("VideoArea initialized, waiting for MPV connection");
@@ -71,18 +68,9 @@ Item {
                     mpvPlayer.hasOwnProperty('fileLoaded')) {
                     mpvPlayer.fileLoaded.connect(function() {
                         console.log("VideoArea: File load completed event received");
+                        // 메타데이터는 mediaInfo.changed에서 반영
                         metadataLoaded = false;
-                        
-                        // 파일 로드 시에만 메타데이터 가져오기 - 일시정지 상태에서만
-                        metadataUpdateBlocked = false; // 로드 직후 차단 해제
-                        Qt.callLater(function() {
-                            if (!isPlaying) {
-                                console.log("VideoArea: Initial metadata fetch called in paused state");
-                                fetchVideoMetadata();
-                            } else {
-                                console.log("VideoArea: Skipping initial metadata fetch in playing state");
-                            }
-                        });
+                        fetchVideoMetadata();
                     });
                     console.log("VideoArea: fileLoaded signal connection successful");
                 }
@@ -97,14 +85,6 @@ Item {
                     console.log("VideoArea: Pause changed:", paused);
                     root.isPlaying = !paused;
                     root.onIsPlayingChangedEvent(!paused);
-                    
-                    // 일시정지 상태에서만 메타데이터 가져오기 허용
-                    if (paused && !metadataLoaded) {
-                        metadataUnblockTimer.restart(); // 일시정지 3초 후에 메타데이터 가져오기
-                    } else if (!paused) {
-                        // 재생 중에는 메타데이터 업데이트 차단
-                        metadataUpdateBlocked = true;
-                    }
                 });
                 
                 mpvPlayer.playingChanged.connect(function(playing) {
@@ -125,12 +105,6 @@ Item {
                         metadataLoaded = false;
                         console.log("VideoArea: New file detected, resetting metadata load state");
                         
-                        // EOF 복구 중인 경우 복구 완료 처리
-                        if (eofRecoveryTimer.running) {
-                            console.log("VideoArea: File reload detected during EOF recovery");
-                            // 파일 로드가 감지되면 복구 타이머는 계속 진행
-                        }
-                        
                         // 파일 변경 시에는 메타데이터 가져오기를 자동으로 하지 않음
                         // fileLoaded 이벤트에서 처리됨
                     }
@@ -141,42 +115,27 @@ Item {
         }
     }
     
-    // 영상 끝 감지 핸들러
+    // 시크 완료 - MPV가 새 위치의 첫 프레임을 준비한 뒤 (타이머로 기다리지 않음)
     Connections {
-        target: mpvPlayer
-        function onPositionChanged(position) {
-            // 영상 끝 근처 감지 로직
-            if (mpvPlayer && position > 0) {
-                var duration = mpvPlayer.getProperty("duration");
-                if (duration && duration > 0) {
-                    // 마지막 1초 이내에서 영상 끝 플래그 설정
-                    if (position > duration - 1.0 && !isNearEndOfFile) {
-                        console.log("VideoArea: Near end of file detected at position:", position);
-                        isNearEndOfFile = true;
-                    }
-                    // 마지막 0.1초 이내에서 완전 끝 플래그 설정
-                    else if (position > duration - 0.1 && !isAtEndOfFile) {
-                        console.log("VideoArea: At end of file detected at position:", position);
-                        isAtEndOfFile = true;
-                    }
-                    // 앞부분으로 돌아가면 플래그 리셋 (더 빠른 리셋)
-                    else if (position < duration - 1.5 && (isNearEndOfFile || isAtEndOfFile)) {
-                        console.log("VideoArea: Reset end flags, position:", position);
-                        isNearEndOfFile = false;
-                        isAtEndOfFile = false;
-                    }
-                    
-                    // 특별한 경우: 시작 부분(첫 2초)으로 이동하면 즉시 플래그 리셋
-                    if (position < 2.0 && (isNearEndOfFile || isAtEndOfFile)) {
-                        console.log("VideoArea: Position near start - force reset end flags");
-                        isNearEndOfFile = false;
-                        isAtEndOfFile = false;
-                    }
-                }
+        target: mpvPlayer ? mpvPlayer.playbackState : null
+        function onSeekFinished(frame) {
+            // 실제로 표시된 프레임으로 UI 맞춤 (빗나간 시크는 상태 머신이 이미 다시 시도함)
+            if (frame !== root.frame) {
+                root.frame = frame;
+                root.onFrameChangedEvent(frame);
             }
         }
     }
     
+    // 미디어 정보 - C++ MediaInfo가 한 번에 게시할 때만 반영 (재생/시크 중에도 값만 복사)
+    Connections {
+        target: mpvPlayer ? mpvPlayer.mediaInfo : null
+        function onChanged() {
+            metadataLoaded = false;
+            fetchVideoMetadata();
+        }
+    }
+    
     // Dark theme background
     Rectangle {
         anchors.fill: parent
@@ -374,16 +333,6 @@ Item {
                         // Connect events
                         connectMpvEvents();
                         
-                        // Setup file loaded callback handler
-                        if (mpvPlayer) {
-                            mpvPlayer.fileLoaded.connect(function() {
-                                console.log("File loaded event triggered");
-                                // Wait a moment to ensure all properties are available
-                                Qt.callLater(function() {
-                                    fetchVideoMetadata();
-                                });
-                            });
-                        }
                     }
                     
                     // Try to create TimelineSync dynamically
@@ -460,21 +409,7 @@ Item {
                     mpvPlayer.fileLoaded.connect(function() {
                         console.log("File fully loaded, fetching metadata");
                         metadataLoaded = false; // 확실히 초기화
-                        
-                        // 영상 끝 플래그 리셋 (파일 로드 시)
-                        isNearEndOfFile = false;
-                        isAtEndOfFile = false;
-                        
-                        // 즉시 메타데이터 가져오기 시도
                         fetchVideoMetadata();
-                        
-                        // 첫 번째 시도가 실패할 경우를 대비한 두 번째 시도 예약
-                        Qt.callLater(function() {
-                            if (!metadataLoaded) {
-                                console.log("First metadata load failed, trying again");
-                                fetchVideoMetadata();
-                            }
-                        });
                     });
                 }
                 
@@ -528,11 +463,13 @@ Item {
         
         try {
             if (mpvPlayer) {
-                mpvPlayer.command(["loadfile", path]);
+                // 재생 목록 모델을 거쳐 열어야 다음 항목 미리 분석이 동작함
+                if (typeof playlistModel !== "undefined" && playlistModel) {
+                    playlistModel.openFiles([path]);
+                } else {
+                    mpvPlayer.command(["loadfile", path]);
+                }
                 showMessage("Loading: " + path);
-                
-                // Set up a timer to fetch metadata after loading
-                metadataFetchTimer.start();
             } else {
                 showMessage("MPV player not initialized");
             }
@@ -542,47 +479,14 @@ Item {
         }
     }
     
-    // 재생/일시정지 토글
+    // 재생/일시정지 토글 (EOF면 상태 머신이 처음으로 시크한 뒤 재생)
     function playPause() {
         if (mpvPlayer) {
             try {
-                // 현재 위치가 끝에 가까운지 확인
-                var duration = mpvPlayer.getProperty("duration");
-                var position = mpvPlayer.getProperty("time-pos");
-                var isNearEnd = false;
-                
-                // 비디오 끝 근처인지 확인 (끝에서 0.5초 이내)
-                if (duration > 0 && position > 0) {
-                    isNearEnd = (duration - position) < 0.5;
-                }
-                
-                // EOF에 도달했거나 끝에 매우 가까우면 처음으로 돌아가기
-                if (isNearEnd || isAtEndOfFile || (mpvPlayer.hasOwnProperty('endReached') && mpvPlayer.endReached)) {
-                    console.log("End of video detected - restarting from beginning");
-                    
-                    // EOF 플래그 리셋
-                    isNearEndOfFile = false;
-                    isAtEndOfFile = false;
-                    
-                    // 비디오 시작 부분으로 시크
-                    mpvPlayer.setProperty("pause", true);
-                    mpvPlayer.setProperty("time-pos", 0.0);
-                    
-                    // 내부 상태 업데이트
-                    root.frame = 0;
-                    root.onFrameChangedEvent(0);
-                    
-                    // 약간의 지연 후 재생 시작 (시크 완료 보장)
-                    Qt.callLater(function() {
-                        mpvPlayer.setProperty("pause", false);
-                        isPlaying = true;
-                        onIsPlayingChangedEvent(true);
-                    });
+                if (mpvPlayer.playbackState) {
+                    mpvPlayer.playbackState.playPause();
                 } else {
-                    // 일반적인 재생/일시정지 전환
                     mpvPlayer.playPause();
-                    isPlaying = !mpvPlayer.pause;
-                    onIsPlayingChangedEvent(isPlaying);
                 }
             } catch (e) {
                 console.error("Error toggling play/pause:", e);
@@ -607,7 +511,7 @@ Item {
                 } catch (pauseError) {
                     console.warn("Cannot set pause property directly, trying command:", pauseError);
                     try {
-                        mpvPlayer.command(["set", "pause", "yes"]);
+                        mpvPlayer.setPause(true);
                     } catch (cmdError) {
                         console.error("Both pause methods failed:", cmdError);
                     }
@@ -640,7 +544,11 @@ Item {
                 
                 // 7. 시크 명령 실행
                 console.log("Seeking forward from frame " + currentFrame + " to " + targetFrame);
-                mpvPlayer.command(["seek", targetPos.toString(), "absolute", "exact"]);
+                if (frames === 1 && mpvPlayer.reversePlayback) {
+                    mpvPlayer.reversePlayback.stepForward();
+                } else {
+                    mpvPlayer.seekAbsolute(targetPos);
+                }
                 
                 // 8. 현재 프레임 업데이트
                 mpvPlayer.setProperty("pause", true); // 일시정지 상태 유지
@@ -669,7 +577,7 @@ Item {
                 } catch (pauseError) {
                     console.warn("Cannot set pause property directly, trying command:", pauseError);
                     try {
-                        mpvPlayer.command(["set", "pause", "yes"]);
+                        mpvPlayer.setPause(true);
                     } catch (cmdError) {
                         console.error("Both pause methods failed:", cmdError);
                     }
@@ -692,9 +600,13 @@ Item {
                 // 5. 목표 프레임을 시간으로 변환
                 var targetPos = targetFrame / fps;
                 
-                // 6. 시크 명령 실행
+                // 6. 한 프레임 뒤로는 역방향 디코딩 버퍼 사용 (이전 키프레임부터 매번 다시 디코딩하지 않음)
                 console.log("Seeking backward from frame " + currentFrame + " to " + targetFrame);
-                mpvPlayer.command(["seek", targetPos.toString(), "absolute", "exact"]);
+                if (frames === 1 && mpvPlayer.reversePlayback) {
+                    mpvPlayer.reversePlayback.stepBackward();
+                } else {
+                    mpvPlayer.seekAbsolute(targetPos);
+                }
                 
                 // 7. 현재 프레임 업데이트
                 mpvPlayer.setProperty("pause", true); // 일시정지 상태 유지
@@ -710,702 +622,31 @@ Item {
     }
     
     // 특정 프레임으로 이동
+    // 정확 시크 한 번만 보내고 도착 확인/재시도/EOF 탈출은 mpvPlayer.playbackState가 MPV 이벤트로 처리
     function seekToFrame(targetFrame) {
-        if (mpvPlayer) {
-            try {
-                console.log("VideoArea: Frame seek request -", targetFrame);
-                
-                // 메타데이터 업데이트 차단 설정
-                metadataUpdateBlocked = true;
-                
-                // 1. 영상 위치 검증
-                if (typeof mpvPlayer.duration !== 'undefined' && mpvPlayer.duration <= 0) {
-                    console.error("No valid video - cannot seek");
-                    metadataUpdateBlocked = false; // 차단 해제
-                    return;
-                }
-                
-                // 2. 프레임 범위 확인 및 엄격한 검증
-                if (targetFrame < 0) {
-                    console.warn("Invalid frame (negative):", targetFrame, "correcting to 0");
-                    targetFrame = 0;
-                }
-                
-                if (root.frames > 0 && targetFrame >= root.frames) {
-                    console.warn("Invalid frame (too large):", targetFrame, "max:", root.frames-1);
-                    targetFrame = root.frames - 1;
-                }
-                
-                // 3. EOF 상태 감지 및 특별 처리 (더 넓은 감지 범위)
-                var currentPos = mpvPlayer.getProperty("time-pos");
-                var duration = mpvPlayer.getProperty("duration");
-                var isAtEOF = false;
-                
-                // EOF 감지 조건을 더 넓게 설정 (마지막 2초 이내 또는 EOF 플래그)
-                if (currentPos && duration && 
-                    (currentPos > duration - 2.0 || 
-                     isNearEndOfFile || 
-                     isAtEndOfFile ||
-                     (root.frames > 0 && root.frame >= root.frames - 3))) {
-                    isAtEOF = true;
-                    eofRecoveryFailCount++; // 실패 카운터 증가
-                    
-                    console.log("VideoArea: Detected EOF state (attempt", eofRecoveryFailCount + "/" + maxEofRecoveryAttempts + ")");
-                    
-                    // 실패 횟수가 너무 많으면 강제 초기화
-                    if (eofRecoveryFailCount >= maxEofRecoveryAttempts) {
-                        console.log("VideoArea: Max EOF recovery attempts reached - FORCING COMPLETE RESET");
-                        forceCompleteReset(targetFrame);
-                        return true;
-                    }
-                    
-                    // EOF에서 벗어나기 위한 더 강력한 처리
-                    try {
-                        // 1. 먼저 일시정지 강제 설정
-                        mpvPlayer.setProperty("pause", true);
-                        
-                        // 2. 파일 재로드로 EOF 상태 완전 초기화
-                        var currentFile = mpvPlayer.getProperty("filename");
-                        if (currentFile) {
-                            console.log("VideoArea: Reloading file to escape EOF:", currentFile);
-                            mpvPlayer.command(["loadfile", currentFile]);
-                            
-                            // 3. 파일 로드 후 목표 프레임으로 시크 예약
-                            eofRecoveryTimer.targetFrame = targetFrame;
-                            eofRecoveryTimer.restart();
-                            
-                            return true;
-                        } else {
-                            // 파일명을 가져올 수 없으면 다른 방법 시도
-                            console.log("VideoArea: Cannot get filename, trying alternative EOF recovery");
-                            performAlternativeEOFRecovery(targetFrame);
-                            return true;
-                        }
-                    } catch (e) {
-                        console.error("VideoArea: EOF recovery failed:", e);
-                        // 최후의 수단으로 대체 방법 시도
-                        performAlternativeEOFRecovery(targetFrame);
-                        return true;
-                    }
-                } else {
-                    // EOF 상태가 아니면 카운터 리셋
-                    if (eofRecoveryFailCount > 0) {
-                        console.log("VideoArea: EOF recovery successful - resetting fail counter");
-                        eofRecoveryFailCount = 0;
-                    }
-                }
-                
-                // 4. 프레임 번호 조정 (항상 1-based 사용)
-                // 0번 프레임을 1번으로 조정, 그 외는 인덱스 +1
-                var adjustedFrame = Math.max(1, targetFrame + 1);
-                if (targetFrame === 0) {
-                    console.log("프레임 인덱스 조정: 0 -> 1 (1-based 인덱싱 적용)");
-                }
-                
-                // 5. 타임스탬프 계산 및 MPV 오류 방지를 위한 명확한 숫자 형식 지정
-                var timePos = (adjustedFrame - 1) / fps; // 0-based 시간 위치 계산
-                var numericPos = Number(timePos.toFixed(6)); // 명시적 숫자로 변환
-                
-                console.log("MPV direct seek command:", numericPos, "(프레임:", adjustedFrame, ")");
-                
-                // 6. 항상 일시정지 상태로 변경 - 정확한 프레임 포지셔닝 위해
-                mpvPlayer.setProperty("pause", true);
-                
-                // 7. MPV 안전한 시크 구현 - 속성 설정만 사용
-                mpvPlayer.setProperty("time-pos", numericPos);
-                
-                // 8. 내부 프레임 즉시 업데이트 (UI 응답성)
-                root.frame = targetFrame;
-                root.onFrameChangedEvent(targetFrame);
-                
-                // 9. 프레임 동기화 검증 - 지연 후 실행
-                Qt.callLater(function() {
-                    syncMpvAndUiFrames(targetFrame);
-                });
-                
-                // 10. 메타데이터 업데이트 차단 해제 예약
-                metadataBlockReleaseTimer.restart();
-                
-                return true;
-            } catch (e) {
-                console.error("Frame seek error:", e);
-                showMessage("Frame seek error: " + e);
-                metadataUpdateBlocked = false; // 차단 해제
-                return false;
-            }
-        } else {
+        if (!mpvPlayer || !mpvPlayer.playbackState) {
             console.error("Cannot seek: player not initialized");
             showMessage("Player not initialized");
-            metadataUpdateBlocked = false; // 차단 해제
             return false;
         }
-    }
-    
-    // EOF 복구 타이머 (파일 재로드 후 시크)
-    Timer {
-        id: eofRecoveryTimer
-        interval: 1000  // 파일 로드 후 1초 대기
-        repeat: false
-        property int targetFrame: 0
         
-        onTriggered: {
-            if (mpvPlayer) {
-                try {
-                    console.log("VideoArea: EOF recovery - seeking to target frame after reload:", targetFrame);
-                    
-                    // 파일이 로드된 후 목표 프레임으로 시크
-                    var adjustedFrame = Math.max(1, targetFrame + 1);
-                    var timePos = (adjustedFrame - 1) / fps;
-                    var numericPos = Number(timePos.toFixed(6));
-                    
-                    // 일시정지 상태에서 시크
-                    mpvPlayer.setProperty("pause", true);
-                    mpvPlayer.setProperty("time-pos", numericPos);
-                    
-                    // 내부 상태 업데이트
-                    root.frame = targetFrame;
-                    root.onFrameChangedEvent(targetFrame);
-                    
-                    // EOF 플래그 리셋
-                    isNearEndOfFile = false;
-                    isAtEndOfFile = false;
-                    
-                    console.log("VideoArea: EOF recovery completed - frame:", targetFrame);
-                    
-                } catch (e) {
-                    console.error("VideoArea: EOF recovery timer error:", e);
-                }
-            }
-            
-            // 메타데이터 업데이트 차단 해제
-            metadataUpdateBlocked = false;
+        if (mpvPlayer.duration <= 0) {
+            console.error("No valid video - cannot seek");
+            return false;
         }
-    }
-    
-    // 대체 EOF 복구 함수 (파일 재로드가 실패할 경우)
-    function performAlternativeEOFRecovery(targetFrame) {
-        try {
-            console.log("VideoArea: Attempting alternative EOF recovery for frame:", targetFrame);
-            
-            // 1. 강력한 EOF 탈출 시도
-            try {
-                // EOF 플래그 강제 해제
-                mpvPlayer.command(["set", "eof-reached", "no"]);
-            } catch (e) {
-                console.log("VideoArea: Cannot clear EOF flag:", e);
-            }
-            
-            // 2. 여러 MPV 속성을 순차적으로 리셋 시도
-            try {
-                mpvPlayer.setProperty("pause", true);
-            } catch (e) {
-                try {
-                    mpvPlayer.command(["set", "pause", "yes"]);
-                } catch (e2) {
-                    console.error("VideoArea: Cannot pause player:", e2);
-                }
-            }
-            
-            // 3. 강제로 처음 위치로 리셋 (여러 방법 시도)
-            var resetSuccess = false;
-            
-            // 방법 1: 직접 시간 위치 설정
-            try {
-                mpvPlayer.setProperty("time-pos", 0.0);
-                mpvPlayer.setProperty("time-start", 0.0);
-                resetSuccess = true;
-                console.log("VideoArea: Reset to start using time-pos");
-            } catch (e1) {
-                // 방법 2: 시크 명령 (exact)
-                try {
-                    mpvPlayer.command(["seek", "0", "absolute", "exact"]);
-                    resetSuccess = true;
-                    console.log("VideoArea: Reset to start using seek exact");
-                } catch (e2) {
-                    // 방법 3: 일반 시크 명령
-                    try {
-                        mpvPlayer.command(["seek", "0", "absolute"]);
-                        resetSuccess = true;
-                        console.log("VideoArea: Reset to start using seek normal");
-                    } catch (e3) {
-                        // 방법 4: 위치 백분율로 시크
-                        try {
-                            mpvPlayer.command(["seek", "0", "absolute-percent"]);
-                            resetSuccess = true;
-                            console.log("VideoArea: Reset to start using percent");
-                        } catch (e4) {
-                            console.error("VideoArea: All reset methods failed");
-                        }
-                    }
-                }
-            }
-            
-            // 4. 강제 프레임 번호 리셋
-            root.frame = 0;
-            root.onFrameChangedEvent(0);
-            
-            // 5. EOF 플래그 리셋
-            isNearEndOfFile = false;
-            isAtEndOfFile = false;
-            
-            // 6. 지연 후 목표 프레임으로 시크 시도
-            if (resetSuccess) {
-                alternativeRecoveryTimer.targetFrame = targetFrame;
-                alternativeRecoveryTimer.restart();
-            } else {
-                // 모든 방법이 실패하면 강제 UI 업데이트만
-                console.log("VideoArea: All methods failed, forcing UI update only");
-                forceUIUpdate(targetFrame);
-            }
-            
-        } catch (e) {
-            console.error("VideoArea: Alternative EOF recovery failed:", e);
-            // 최후의 수단: 강제 UI 업데이트
-            forceUIUpdate(targetFrame);
+        
+        // 프레임 범위 확인
+        targetFrame = Math.max(0, targetFrame);
+        if (root.frames > 0) {
+            targetFrame = Math.min(targetFrame, root.frames - 1);
         }
-    }
-    
-    // 강제 UI 업데이트 함수 (MPV가 완전히 응답하지 않을 때)
-    function forceUIUpdate(targetFrame) {
-        console.log("VideoArea: Forcing UI update to frame:", targetFrame);
         
-        // UI 상태만 강제로 업데이트
+        // 내부 프레임 즉시 업데이트 (UI 응답성)
         root.frame = targetFrame;
         root.onFrameChangedEvent(targetFrame);
         
-        // EOF 플래그 강제 리셋
-        isNearEndOfFile = false;
-        isAtEndOfFile = false;
-        
-        // 메타데이터 차단 해제
-        metadataUpdateBlocked = false;
-        
-        // 사용자에게 알림
-        showMessage("Frame position updated (MPV may be unresponsive)");
-    }
-    
-    // 강제 완전 리셋 함수 (모든 복구 방법이 실패했을 때의 최후 수단)
-    function forceCompleteReset(targetFrame) {
-        console.log("VideoArea: *** EMERGENCY RESET *** - All recovery methods failed, performing complete reset");
-        
-        try {
-            // 1단계: 모든 타이머 중지
-            eofRecoveryTimer.stop();
-            alternativeRecoveryTimer.stop();
-            secondSeekTimer.stop();
-            finalVerifyTimer.stop();
-            metadataBlockReleaseTimer.stop();
-            
-            // 2단계: 모든 상태 플래그 강제 리셋
-            isNearEndOfFile = false;
-            isAtEndOfFile = false;
-            metadataUpdateBlocked = false;
-            eofRecoveryFailCount = 0; // 카운터 리셋
-            
-            // 3단계: MPV 강제 정지 및 리셋 시도
-            try {
-                console.log("VideoArea: Emergency - stopping all MPV operations");
-                mpvPlayer.command(["stop"]);
-            } catch (e) {
-                console.log("VideoArea: MPV stop failed:", e);
-            }
-            
-            // 4단계: 현재 파일 재로드 시도
-            var currentFile = root.filename;
-            if (currentFile && currentFile !== "") {
-                console.log("VideoArea: Emergency - reloading file:", currentFile);
-                
-                // 파일 재로드
-                try {
-                    mpvPlayer.command(["loadfile", currentFile, "replace"]);
-                    
-                    // 재로드 후 목표 위치로 시크하는 타이머 예약
-                    emergencyRecoveryTimer.targetFrame = targetFrame;
-                    emergencyRecoveryTimer.restart();
-                    
-                    console.log("VideoArea: Emergency file reload initiated, target frame:", targetFrame);
-                    return;
-                } catch (e) {
-                    console.error("VideoArea: Emergency file reload failed:", e);
-                }
-            }
-            
-            // 5단계: 파일 재로드도 실패하면 처음 위치로 강제 이동
-            console.log("VideoArea: Emergency - forcing reset to frame 0");
-            try {
-                mpvPlayer.setProperty("pause", true);
-                mpvPlayer.setProperty("time-pos", 0.0);
-                
-                // UI 즉시 업데이트
-                root.frame = 0;
-                root.onFrameChangedEvent(0);
-                
-                showMessage("Video reset to beginning due to playback issues");
-                
-            } catch (e) {
-                console.error("VideoArea: Emergency reset to frame 0 failed:", e);
-                
-                // 6단계: 최후의 수단 - UI만 강제 업데이트
-                console.log("VideoArea: Last resort - UI-only reset");
-                root.frame = Math.max(0, Math.min(targetFrame, root.frames - 1));
-                root.onFrameChangedEvent(root.frame);
-                
-                showMessage("Emergency: UI reset only (video player unresponsive)");
-            }
-            
-        } catch (e) {
-            console.error("VideoArea: Complete emergency reset failed:", e);
-            
-            // 절대 최후의 수단: UI 상태만 리셋
-            root.frame = 0;
-            root.onFrameChangedEvent(0);
-            isNearEndOfFile = false;
-            isAtEndOfFile = false;
-            metadataUpdateBlocked = false;
-            eofRecoveryFailCount = 0;
-            
-            showMessage("Critical error: Video player requires restart");
-        }
-    }
-    
-    // 대체 복구 타이머
-    Timer {
-        id: alternativeRecoveryTimer
-        interval: 500
-        repeat: false
-        property int targetFrame: 0
-        
-        onTriggered: {
-            if (mpvPlayer) {
-                try {
-                    console.log("VideoArea: Alternative recovery - seeking to frame:", targetFrame);
-                    
-                    var adjustedFrame = Math.max(1, targetFrame + 1);
-                    var timePos = (adjustedFrame - 1) / fps;
-                    var numericPos = Number(timePos.toFixed(6));
-                    
-                    // 강제로 내부 상태 업데이트 (MPV가 응답하지 않아도)
-                    root.frame = targetFrame;
-                    root.onFrameChangedEvent(targetFrame);
-                    
-                    // EOF 플래그 강제 리셋
-                    isNearEndOfFile = false;
-                    isAtEndOfFile = false;
-                    
-                    console.log("VideoArea: Alternative recovery forced update to frame:", targetFrame);
-                    
-                } catch (e) {
-                    console.error("VideoArea: Alternative recovery timer error:", e);
-                }
-            }
-            
-            metadataUpdateBlocked = false;
-        }
-    }
-    
-    // 비상 복구 타이머 (강제 파일 재로드 후 시크)
-    Timer {
-        id: emergencyRecoveryTimer
-        interval: 2000  // 파일 재로드를 위해 2초 대기
-        repeat: false
-        property int targetFrame: 0
-        
-        onTriggered: {
-            if (mpvPlayer) {
-                try {
-                    console.log("VideoArea: Emergency recovery - seeking to target frame after complete reload:", targetFrame);
-                    
-                    // 일시정지 상태 확인
-                    mpvPlayer.setProperty("pause", true);
-                    
-                    // 안전한 프레임으로 시크 (처음이 아닌 경우)
-                    if (targetFrame > 0 && targetFrame < root.frames - 5) {
-                        var adjustedFrame = Math.max(1, targetFrame + 1);
-                        var timePos = (adjustedFrame - 1) / fps;
-                        var numericPos = Number(timePos.toFixed(6));
-                        
-                        mpvPlayer.setProperty("time-pos", numericPos);
-                        console.log("VideoArea: Emergency recovery - sought to frame:", targetFrame);
-                    } else {
-                        // 문제가 있는 프레임이면 처음으로
-                        mpvPlayer.setProperty("time-pos", 0.0);
-                        targetFrame = 0;
-                        console.log("VideoArea: Emergency recovery - reset to frame 0 for safety");
-                    }
-                    
-                    // UI 상태 업데이트
-                    root.frame = targetFrame;
-                    root.onFrameChangedEvent(targetFrame);
-                    
-                    // 모든 플래그 리셋
-                    isNearEndOfFile = false;
-                    isAtEndOfFile = false;
-                    metadataUpdateBlocked = false;
-                    eofRecoveryFailCount = 0; // 성공했으므로 카운터 리셋
-                    
-                    console.log("VideoArea: Emergency recovery completed successfully");
-                    showMessage("Video successfully recovered from playback error");
-                    
-                } catch (e) {
-                    console.error("VideoArea: Emergency recovery timer failed:", e);
-                    
-                    // 마지막 시도: UI만 업데이트
-                    root.frame = 0;
-                    root.onFrameChangedEvent(0);
-                    isNearEndOfFile = false;
-                    isAtEndOfFile = false;
-                    metadataUpdateBlocked = false;
-                    eofRecoveryFailCount = 0;
-                    
-                    showMessage("Recovery partially successful - UI reset only");
-                }
-            }
-        }
-    }
-    
-    // 영상 끝 감지 플래그
-    property bool isNearEndOfFile: false
-    property bool isAtEndOfFile: false
-    
-    // EOF 복구 실패 카운터 (무한 루프 방지)
-    property int eofRecoveryFailCount: 0
-    property int maxEofRecoveryAttempts: 3
-    
-    // 새로운 함수: MPV와 UI 프레임 동기화 (영상 끝에서 비활성화)
-    function syncMpvAndUiFrames(targetFrame) {
-        if (!mpvPlayer) return;
-        
-        // 영상 끝에서는 동기화 중단
-        if (isNearEndOfFile || isAtEndOfFile) {
-            console.log("Sync mediator: Near/at end of file - sync disabled");
-            return;
-        }
-        
-        try {
-            var actualPos = mpvPlayer.getProperty("time-pos");
-            if (actualPos !== undefined && actualPos !== null) {
-                // 영상 끝 근처 감지 (마지막 1초 이내)
-                var duration = mpvPlayer.getProperty("duration");
-                if (duration && actualPos > duration - 1.0) {
-                    console.log("Sync mediator: Near end detected - disabling sync");
-                    isNearEndOfFile = true;
-                    return;
-                }
-                
-                // MPV의 실제 프레임 계산 (시간 -> 프레임)
-                var rawMpvFrame = Math.round(actualPos * fps);
-                var actualFrame = rawMpvFrame;
-                
-                // 마지막 5프레임 이내에서는 동기화 중단
-                if (root.frames > 0 && actualFrame >= root.frames - 5) {
-                    console.log("Sync mediator: Near final frames - disabling sync");
-                    isNearEndOfFile = true;
-                    return;
-                }
-                
-                // 정상적인 범위인지 확인
-                if (actualFrame < 0 || (root.frames > 0 && actualFrame >= root.frames)) {
-                    console.warn("Sync mediator: Invalid MPV frame detected:", actualFrame);
-                    return;
-                }
-                
-                console.log("Sync mediator: MPV raw frame=", rawMpvFrame, ", adjusted frame=", actualFrame, ", UI frame=", targetFrame);
-                
-                // MPV와 UI 프레임 차이 로깅만 (강제 동기화 완전 비활성화)
-                if (Math.abs(actualFrame - targetFrame) > 10) {
-                    console.log("Sync mediator: Frame difference detected - MPV:", actualFrame, "UI:", targetFrame);
-                    console.log("Sync mediator: 사용자 시크 우선 - MPV 동기화 생략");
-                    
-                    // *** 중요: 강제 동기화 완전 제거 - 사용자 시크 우선 처리 ***
-                    // 더 이상 MPV 프레임으로 UI를 강제 업데이트하지 않음
-                    return;
-                }
-            }
-        } catch (e) {
-            console.error("Sync mediator error:", e);
-        }
-    }
-    
-    // 두 번째 시크 타이머 (setTimeout 대체)
-    Timer {
-        id: secondSeekTimer
-        interval: 100
-        repeat: false
-        property real timePos: 0
-        property int targetFrame: 0
-        
-        onTriggered: {
-            if (mpvPlayer) {
-                try {
-                    // 명확한 숫자 형식으로 변환 (MPV 오류 방지)
-                    var numericPos = Number(timePos.toFixed(6));
-                    
-                    // 안전하게 속성 직접 설정 - 명령 대신
-                    mpvPlayer.setProperty("pause", true);
-                    mpvPlayer.setProperty("time-pos", numericPos);
-                    
-                    // 현재 프레임 상태 재확인 및 시그널 발생
-                    var actualPos = mpvPlayer.getProperty("time-pos");
-                    if (actualPos !== undefined && actualPos !== null) {
-                        var actualFrame = Math.round(actualPos * fps);
-                        console.log("Second verification: requested=", targetFrame, "actual=", actualFrame);
-                        
-                        if (Math.abs(actualFrame - targetFrame) > 2) {
-                            console.log("Frame still mismatched, performing second correction");
-                            
-                            // MPV 상태에 맞추어 UI 업데이트 (실제 상태에 맞춤)
-                            root.frame = actualFrame;
-                            root.onFrameChangedEvent(actualFrame);
-                        }
-                    }
-                } catch (e) {
-                    console.error("Second seek timer error:", e);
-                }
-            }
-        }
-    }
-    
-    // 최종 검증 타이머 (완전한 동기화 보장)
-    Timer {
-        id: finalVerifyTimer
-        interval: 250
-        repeat: false
-        property real timePos: 0
-        property int targetFrame: 0
-        
-        onTriggered: {
-            if (mpvPlayer) {
-                try {
-                    // 최종 상태 검증
-                    mpvPlayer.setProperty("pause", true);
-                    var actualPos = mpvPlayer.getProperty("time-pos");
-                    if (actualPos !== undefined && actualPos !== null) {
-                        var actualFrame = Math.round(actualPos * fps);
-                        console.log("Verification: MPV frame=", actualFrame, "_internalFrame=", targetFrame);
-                        
-                        // 여전히 불일치가 있는지 확인 (2프레임 이상 차이 시)
-                        if (Math.abs(actualFrame - targetFrame) > 2) {
-                            console.log("Frame mismatch detected - synchronizing");
-                            
-                            // MPV의 실제 상태를 기준으로 UI 동기화
-                            root.frame = actualFrame;
-                            root.onFrameChangedEvent(actualFrame);
-                            
-                            // 최종 확인 메시지
-                            console.log("Frame seek final confirmation complete:", actualFrame);
-                            console.log("Stabilization period ended");
-                        } else {
-                            console.log("Frame seek final confirmation complete:", targetFrame);
-                            console.log("Stabilization period ended");
-                        }
-                    }
-                } catch (e) {
-                    console.error("Final verification timer error:", e);
-                }
-            }
-        }
-    }
-    
-    // 메타데이터 업데이트 차단 해제 타이머
-    Timer {
-        id: metadataBlockReleaseTimer
-        interval: 800  // 드래그/시크 후 0.8초 동안 메타데이터 업데이트 차단
-        repeat: false
-        onTriggered: {
-            console.log("Metadata update block released");
-            metadataUpdateBlocked = false;
-            
-            // 지연된 메타데이터 가져오기가 필요한 경우 실행
-            if (!metadataLoaded) {
-                delayedMetadataTimer.restart();
-            }
-        }
-    }
-    
-    // Timers for metadata handling
-    Timer {
-        id: delayedMetadataTimer
-        interval: 500
-        repeat: false
-        running: false
-        onTriggered: {
-            // 지연된 메타데이터 로드 - 파일 로드 직후 처음 한 번만 사용
-            if (!metadataLoaded) {
-                console.log("Delayed metadata fetch triggered");
-                fetchVideoMetadata();
-            }
-        }
-    }
-    
-    // 메타데이터 가져오기 타이머 - 백업용 (fileLoaded 이벤트 대체용)
-    Timer {
-        id: metadataFetchTimer
-        interval: 1000
-        repeat: false
-        running: false
-        onTriggered: {
-            if (!metadataLoaded) {
-                console.log("Backup metadata fetch timer triggered");
-                fetchVideoMetadata();
-            }
-        }
-    }
-    
-    // 메타데이터 차단 해제 타이머 (일시정지 후 3초로 증가)
-    Timer {
-        id: metadataUnblockTimer
-        interval: 3000
-        repeat: false
-        running: false
-        onTriggered: {
-            if (!isPlaying) {
-                console.log("Playback stopped for 3 seconds: Metadata update block released");
-                metadataUpdateBlocked = false;
-                
-                // 메타데이터가 아직 로드되지 않았으면 로드 (첫 파일 로드 시에만)
-                if (!metadataLoaded) {
-                    fetchVideoMetadata();
-                }
-            }
-        }
-    }
-    
-    Timer {
-        id: metadataBlockTimeoutTimer
-        interval: 10000  // 10초 후 강제 해제 (안전 장치)
-        repeat: false
-        running: metadataUpdateBlocked
-        onTriggered: {
-            // 메타데이터 업데이트 차단이 너무 오래 지속되면 강제로 해제
-            if (metadataUpdateBlocked) {
-                console.log("Metadata update block timeout - forced release");
-                metadataUpdateBlocked = false;
-                
-                // 새 파일이 로드된 경우에만 메타데이터 가져오기 (아직 로드되지 않은 경우)
-                if (!metadataLoaded) {
-                    console.log("Initial metadata load needed - fetching after block release");
-                    Qt.callLater(fetchVideoMetadata);
-                }
-            }
-        }
-    }
-    
-    // 메타데이터 업데이트 상태 관리 로직 추가 - 플레이어 상태에 따라 자동으로 차단/해제
-    onIsPlayingChanged: {
-        // 재생 중에는 메타데이터 업데이트 차단 (성능 향상)
-        if (isPlaying) {
-            console.log("Playback started: Metadata update block activated");
-            metadataUpdateBlocked = true;
-            
-            // 모든 메타데이터 관련 타이머 중지
-            if (metadataFetchTimer.running) metadataFetchTimer.stop();
-            if (delayedMetadataTimer.running) delayedMetadataTimer.stop();
-            if (metadataUnblockTimer.running) metadataUnblockTimer.stop();
-        } else {
-            // 정지 상태에서 일정 시간 후 메타데이터 업데이트 차단 해제
-            // (사용자가 일시정지 버튼을 누른 경우에만)
-            metadataUnblockTimer.restart();
-        }
+        mpvPlayer.playbackState.seekToFrame(targetFrame);
+        return true;
     }
     
     // Toggle scopes
@@ -1429,7 +670,10 @@ Item {
         if (mpvPlayer) {
             try {
                 console.log("Adding video filter:", filter);
-                mpvPlayer.command(["vf", "add", filter]);
+                // vf 체인은 videoFilters로만 변경 (vf set 한 번, 체인 상태 유지)
+                var filters = Array.from(mpvPlayer.videoFilters);
+                filters.push(filter);
+                mpvPlayer.videoFilters = filters;
                 return true;
             } catch (e) {
                 console.error("Failed to add filter:", e);
@@ -1452,7 +696,14 @@ Item {
         if (mpvPlayer) {
             try {
                 console.log("Removing video filter:", filter);
-                mpvPlayer.command(["vf", "remove", filter]);
+                var filters = Array.from(mpvPlayer.videoFilters);
+                var index = filters.indexOf(filter);
+                if (index < 0) {
+                    console.warn("Video filter not in chain:", filter);
+                    return false;
+                }
+                filters.splice(index, 1);
+                mpvPlayer.videoFilters = filters;
                 return true;
             } catch (e) {
                 console.error("Failed to remove filter:", e);
@@ -1471,271 +722,39 @@ Item {
     Keys.onLeftPressed: stepBackward(1)
     Keys.onRightPressed: stepForward(1)
     
-    // Function to fetch and update video metadata
+    // 비디오 메타데이터 반영 - mpvPlayer.mediaInfo 스냅샷 한 번만 읽음 (getProperty 반복 없음)
     function fetchVideoMetadata() {
-        // 이미 메타데이터가 로드되었으면 스킵
-        if (metadataLoaded) {
-            console.log("ControlBar: Metadata already loaded, preventing duplicate loading");
-            return;
-        }
-        
-        if (!mpvPlayer) {
-            console.log("Cannot fetch metadata: mpvPlayer is null");
+        if (metadataLoaded || !mpvPlayer || !mpvPlayer.mediaInfo) {
             return;
         }
         
-        // 메타데이터 업데이트가 차단된 상태면 스킵
-        if (metadataUpdateBlocked) {
-            console.log("Metadata update blocked - not fetching metadata");
+        var info = mpvPlayer.mediaInfo.snapshot();
+        if (!info.ready) {
             return;
         }
         
-        // 재생 중이면 메타데이터 가져오기 취소
-        if (isPlaying) {
-            console.log("Video is playing - skipping metadata fetch");
-            return;
-        }
+        videoCodec = info.videoCodec;
+        videoFormat = info.pixelFormat;
+        videoResolution = info.resolution;
+        videoBitrate = formatBitrate(info.bitrate);
+        videoAspectRatio = info.aspect > 0 ? info.aspect : 1.0;
+        videoColorSpace = info.colorMatrix;
+        audioCodec = info.audioCodec;
+        audioChannels = info.audioChannels > 0 ? info.audioChannels + " ch" : "";
+        audioSampleRate = info.audioSampleRate > 0 ? (info.audioSampleRate / 1000).toFixed(1) + " kHz" : "";
+        creationDate = info.creationDate;
         
-        try {
-            console.log("Attempting to fetch video metadata...");
-            
-            // Try to get all available properties for debugging first
-            console.log("Getting available property list...");
-            try {
-                var props = mpvPlayer.getPropertyString("property-list");
-                if (props) {
-                    console.log("Available properties:", props);
-                }
-                
-                // Also try to get tracks info which often has codec info
-                var trackList = mpvPlayer.getProperty("track-list");
-                if (trackList) {
-                    console.log("Track list information:", JSON.stringify(trackList));
-                }
-            } catch (e) {
-                console.log("Could not get property list:", e);
-            }
-            
-            // Get codec information - try multiple approaches
-            // 1. Try standard MPV property
-            videoCodec = getVideoProperty("video-codec") || "";
-            console.log("Video codec from video-codec:", videoCodec);
-            
-            // 2. If that fails, try video-params/codec
-            if (!videoCodec) {
-                videoCodec = getVideoProperty("video-params/codec") || "";
-                console.log("Video codec from video-params/codec:", videoCodec);
-            }
-            
-            // 3. If that fails, try getting from track-list
-            if (!videoCodec) {
-                try {
-                    var tracks = mpvPlayer.getProperty("track-list");
-                    if (tracks && Array.isArray(tracks)) {
-                        for (var i = 0; i < tracks.length; i++) {
-                            var track = tracks[i];
-                            if (track.type === "video" && track.selected) {
-                                if (track.codec) {
-                                    videoCodec = track.codec;
-                                    console.log("Video codec from track-list:", videoCodec);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                } catch (err) {
-                    console.log("Error getting codec from track-list:", err);
-                }
-            }
-            
-            // 4. If that fails, try direct command to get format info
-            if (!videoCodec) {
-                try {
-                    mpvPlayer.command(["script-message-to", "console", "format"]);
-                    console.log("Requested format info via script message");
-                } catch (err) {
-                    console.log("Error requesting format info:", err);
-                }
-            }
-            
-            // Get video format
-            videoFormat = getVideoProperty("video-format") || 
-                          getVideoProperty("video-params/pixelformat") || 
-                          getVideoProperty("video-params/hw-pixelformat") || "";
-            console.log("Video format:", videoFormat);
-            
-            // Get video resolution - with fallbacks
-            videoResolution = getVideoResolution();
-            console.log("Video resolution:", videoResolution);
-            
-            videoBitrate = getVideoBitrate();
-            console.log("Video bitrate:", videoBitrate);
-            
-            videoAspectRatio = getVideoProperty("video-aspect") || 
-                               getVideoProperty("video-params/aspect") || 1.0;
-            console.log("Video aspect ratio:", videoAspectRatio);
-            
-            videoColorSpace = getVideoProperty("video-params/colormatrix") || 
-                             getVideoProperty("video-params/colorspace") || "";
-            console.log("Video color space:", videoColorSpace);
-            
-            // Get audio information
-            audioCodec = getVideoProperty("audio-codec") || "";
-            console.log("Audio codec:", audioCodec);
-            
-            audioChannels = getVideoProperty("audio-channels") || 
-                           getVideoProperty("audio-params/channels") || "";
-            console.log("Audio channels:", audioChannels);
-            
-            audioSampleRate = getVideoProperty("audio-samplerate") ? 
-                              (getVideoProperty("audio-samplerate") / 1000).toFixed(1) + " kHz" : 
-                              (getVideoProperty("audio-params/samplerate") ? 
-                              (getVideoProperty("audio-params/samplerate") / 1000).toFixed(1) + " kHz" : "");
-            console.log("Audio sample rate:", audioSampleRate);
-            
-            // Get creation date (try multiple metadata sources)
-            creationDate = getCreationDate();
-            console.log("Creation date:", creationDate);
-            
-            // 메타데이터 로드 완료 표시
-            metadataLoaded = true;
-            console.log("Video metadata loading completed");
-            
-            // Emit signal that metadata changed
-            root.onMetadataChanged();
-            
-            // 메타데이터 로드 완료 후 더 이상 메타데이터 타이머 사용 안함
-            if (metadataFetchTimer.running) {
-                metadataFetchTimer.stop();
-            }
-            if (delayedMetadataTimer.running) {
-                delayedMetadataTimer.stop();
-            }
-        } catch (e) {
-            console.error("Error fetching metadata:", e);
-        }
+        metadataLoaded = true;
+        root.onMetadataChanged();
     }
     
-    // Helper function to safely get property from MPV
-    function getVideoProperty(propertyName) {
-        try {
-            console.log("Trying to get property:", propertyName);
-            
-            // First check if mpvPlayer is valid
-            if (!mpvPlayer) {
-                console.log("Cannot get property: mpvPlayer is null");
-                return null;
-            }
-            
-            // Try direct property access first if available
-            if (typeof mpvPlayer[propertyName] !== "undefined") {
-                console.log("Direct property access for:", propertyName, "=", mpvPlayer[propertyName]);
-                return mpvPlayer[propertyName];
-            }
-            
-            // Check if getProperty method exists
-            if (typeof mpvPlayer.getProperty === "function") {
-                try {
-                    var value = mpvPlayer.getProperty(propertyName);
-                    console.log("Property", propertyName, "value:", value);
-                    return value;
-                } catch (e) {
-                    console.log("Error getting property via getProperty:", e);
-                }
-            }
-            
-            // Fallback to getPropertyString if available
-            if (typeof mpvPlayer.getPropertyString === "function") {
-                try {
-                    console.log("Trying getPropertyString instead");
-                    return mpvPlayer.getPropertyString(propertyName);
-                } catch (e) {
-                    console.log("Error getting property via getPropertyString:", e);
-                }
-            }
-            
-            // Special case for common properties
-            if (propertyName === "video-codec" && typeof mpvPlayer.videoCodec !== "undefined") {
-                return mpvPlayer.videoCodec;
-            }
-            
-            if (propertyName === "fps" && typeof mpvPlayer.fps !== "undefined") {
-                return mpvPlayer.fps;
-            }
-            
-            console.log("No method available to get property:", propertyName);
-            return null;
-        } catch (e) {
-            console.log("Error getting property", propertyName + ":", e.toString());
-            return null;
-        }
-    }
-    
-    // Helper to get video resolution
-    function getVideoResolution() {
-        try {
-            const width = getVideoProperty("width") || getVideoProperty("video-params/w") || 0;
-            const height = getVideoProperty("height") || getVideoProperty("video-params/h") || 0;
-            if (width && height) {
-                return width + "×" + height;
-            }
-            return "";
-        } catch (e) {
-            return "";
-        }
-    }
-    
-    // Helper to get video bitrate in a nice format
-    function getVideoBitrate() {
-        try {
-            const bitrate = getVideoProperty("video-bitrate") || 0;
-            if (bitrate > 0) {
-                if (bitrate >= 1000000) {
-                    return (bitrate / 1000000).toFixed(2) + " Mbps";
-                } else {
-                    return (bitrate / 1000).toFixed(0) + " kbps";
-                }
-            }
-            return "";
-        } catch (e) {
-            return "";
-        }
-    }
-    
-    // Helper to get creation date from various metadata fields
-    function getCreationDate() {
-        try {
-            // Try different metadata fields where date might be stored
-            const dateFields = [
-                "creation_time",             // Common field
-                "metadata/creation_time",    // In metadata object
-                "file-creation-time",        // File system date
-                "metadata/date",             // Generic date field
-                "metadata/creation_date"     // Alternative name
-            ];
-            
-            for (let i = 0; i < dateFields.length; i++) {
-                const dateValue = getVideoProperty(dateFields[i]);
-                if (dateValue) {
-                    // Try to parse and format the date
-                    try {
-                        const date = new Date(dateValue);
-                        if (!isNaN(date.getTime())) {
-                            return date.toISOString().split('T')[0]; // YYYY-MM-DD format
-                        }
-                        return dateValue; // Return as is if can't parse
-                    } catch (e) {
-                        return dateValue; // Return as is if error
-                    }
-                }
-            }
-            
-            // Fallback to current date if no metadata date found
-            const currentDate = new Date();
-            return currentDate.toISOString().split('T')[0]; // YYYY-MM-DD format
-        } catch (e) {
-            console.error("Error getting creation date:", e);
-            return "";
+    // 비트레이트 표시 (bps -> Mbps/kbps)
+    function formatBitrate(bitrate) {
+        if (bitrate >= 1000000) {
+            return (bitrate / 1000000).toFixed(2) + " Mbps";
+        } else if (bitrate > 0) {
+            return (bitrate / 1000).toFixed(0) + " kbps";
         }
+        return "";
     }
 }
@@ -75,6 +75,8 @@ QtObject {
     readonly property color timelineMajorFrameColor: isDarkTheme ? "#303030" : "#888888" 
     readonly property color timelinePlayheadColor: "#FF453A" // Apple-inspired playhead
     readonly property color timelineActiveTrackColor: Qt.rgba(1.0, 1.0, 1.0, 0.15) // 투명한 흰색
+    readonly property color timelineHeatmapColor: isDarkTheme ? "#FF9F0A" : "#D97706" // 시크 비용 (GOP 위치)
+    readonly property color timelineKeyframeColor: isDarkTheme ? "#E0E0E0" : "#404040" // 키프레임 표시
     
     // Debug logging
     onCurrentThemeChanged: {
@@ -0,0 +1,258 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import QtQuick.Window
+import QtQuick.Dialogs
+import mpv 1.0
+import app.compare 1.0
+import "../utils"
+
+// A/B 비교 창 - 여러 클립을 하나의 마스터 시계로 프레임 단위 잠금 재생
+// 와이프(첫 두 클립), 나란히 보기(전체), 차이(첫 클립 - 둘째 클립) 모드 지원
+Window {
+    id: root
+    title: qsTr("Compare")
+    width: 1280
+    height: 720
+    color: ThemeManager.dialogColor
+    flags: Qt.Window | Qt.WindowTitleHint | Qt.WindowCloseButtonHint | Qt.WindowMinMaxButtonsHint
+    visible: false
+
+    readonly property int clipCount: clipModel.count
+
+    ListModel {
+        id: clipModel
+    }
+
+    CompareController {
+        id: controller
+    }
+
+    function addClip(path) {
+        clipModel.append({ "path": path })
+    }
+
+    function toLocalPath(url) {
+        var path = url.toString()
+        if (path.startsWith("file:///")) {
+            // Windows 드라이브 경로는 슬래시 하나를 남기지 않는다
+            path = Qt.platform.os === "windows" ? path.substring(8) : path.substring(7)
+        }
+        return decodeURIComponent(path)
+    }
+
+    FileDialog {
+        id: addClipDialog
+        title: "Add Clips"
+        fileMode: FileDialog.OpenFiles
+        nameFilters: ["Video files (*.mp4 *.mkv *.avi *.mov *.mxf *.wmv *.flv)", "All files (*)"]
+        onAccepted: {
+            for (var i = 0; i < selectedFiles.length; ++i) {
+                root.addClip(root.toLocalPath(selectedFiles[i]))
+            }
+        }
+    }
+
+    onClosing: {
+        controller.pause()
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 0
+
+        // 비교 화면
+        Item {
+            id: viewArea
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+
+            Repeater {
+                model: clipModel
+
+                // 모드별 배치: 와이프는 첫 클립을 와이프 위치까지만 잘라 둘째 클립 위에 겹치고,
+                // 나란히 보기는 균등 분할, 차이 모드는 첫 클립만 전체 화면
+                Item {
+                    id: slot
+                    readonly property int slotCount: clipModel.count
+                    readonly property bool shown: controller.mode === CompareController.SideBySide
+                                                  || (controller.mode === CompareController.Wipe && index < 2)
+                                                  || index === 0
+
+                    visible: shown
+                    clip: true
+                    z: slotCount - index
+                    x: controller.mode === CompareController.SideBySide ? index * viewArea.width / slotCount : 0
+                    y: 0
+                    height: viewArea.height
+                    width: {
+                        if (controller.mode === CompareController.SideBySide)
+                            return viewArea.width / slotCount
+                        if (controller.mode === CompareController.Wipe && index === 0 && slotCount > 1)
+                            return viewArea.width * controller.wipePosition
+                        return viewArea.width
+                    }
+
+                    MpvObject {
+                        id: player
+                        x: 0
+                        y: 0
+                        width: controller.mode === CompareController.SideBySide ? slot.width : viewArea.width
+                        height: viewArea.height
+
+                        Component.onCompleted: {
+                            setProperty("osd-level", 0)
+                            setProperty("keep-open", "always")
+                            command(["loadfile", model.path])
+                            controller.addPlayer(player)
+                        }
+                        Component.onDestruction: controller.removePlayer(player)
+                    }
+
+                    Text {
+                        anchors.left: parent.left
+                        anchors.top: parent.top
+                        anchors.margins: 8
+                        text: String.fromCharCode(65 + index) + "  " + model.path.split(/[\\/]/).pop()
+                        color: "#FFFFFF"
+                        style: Text.Outline
+                        styleColor: "#000000"
+                        font.pixelSize: 12
+                    }
+                }
+            }
+
+            // 와이프 경계선 드래그
+            Rectangle {
+                visible: controller.mode === CompareController.Wipe && clipModel.count > 1
+                z: 100
+                width: 2
+                height: parent.height
+                x: parent.width * controller.wipePosition - 1
+                color: ThemeManager.accentColor
+
+                MouseArea {
+                    anchors.fill: parent
+                    anchors.margins: -6
+                    cursorShape: Qt.SplitHCursor
+                    drag.threshold: 0
+                    onPositionChanged: function(mouse) {
+                        if (pressed) {
+                            var pos = mapToItem(viewArea, mouse.x, mouse.y)
+                            controller.wipePosition = pos.x / viewArea.width
+                        }
+                    }
+                }
+            }
+
+            Text {
+                anchors.centerIn: parent
+                visible: clipModel.count === 0
+                text: "Add two or more clips to compare"
+                color: ThemeManager.secondaryTextColor
+                font.pixelSize: 14
+            }
+        }
+
+        // 컨트롤 영역
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 76
+            color: ThemeManager.controlBgColor
+
+            ColumnLayout {
+                anchors.fill: parent
+                anchors.margins: 8
+                spacing: 4
+
+                Slider {
+                    Layout.fillWidth: true
+                    from: 0
+                    to: Math.max(1, controller.totalFrames - 1)
+                    stepSize: 1
+                    value: controller.currentFrame
+                    onMoved: controller.seekToFrame(Math.round(value))
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 8
+
+                    Button {
+                        text: "Add Clips"
+                        onClicked: addClipDialog.open()
+                    }
+
+                    Button {
+                        text: "Clear"
+                        enabled: clipModel.count > 0
+                        onClicked: {
+                            controller.clearPlayers()
+                            clipModel.clear()
+                        }
+                    }
+
+                    ComboBox {
+                        model: ["Wipe", "Side by Side", "Difference"]
+                        currentIndex: controller.mode
+                        onActivated: function(index) { controller.mode = index }
+                    }
+
+                    Button {
+                        text: "◀"
+                        onClicked: controller.stepFrames(-1)
+                    }
+
+                    Button {
+                        text: controller.playing ? "Pause" : "Play"
+                        enabled: clipModel.count > 0
+                        onClicked: controller.togglePlay()
+                    }
+
+                    Button {
+                        text: "▶"
+                        onClicked: controller.stepFrames(1)
+                    }
+
+                    Text {
+                        text: controller.currentFrame + " / " + Math.max(0, controller.totalFrames - 1)
+                        color: ThemeManager.textColor
+                        font.family: ThemeManager.monoFont
+                        font.pixelSize: 12
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    // 플레이어 간 최대 프레임 차이 (현재 / 재생 시작 이후 최대)
+                    Text {
+                        text: "offset " + controller.maxOffsetFrames.toFixed(2)
+                              + " fr  peak " + controller.peakOffsetFrames.toFixed(2) + " fr"
+                        color: controller.peakOffsetFrames >= 1 ? ThemeManager.timelinePlayheadColor
+                                                                 : ThemeManager.secondaryTextColor
+                        font.family: ThemeManager.monoFont
+                        font.pixelSize: 12
+                    }
+                }
+            }
+        }
+    }
+
+    // 창 안에서의 단축키 (Space 재생, ←/→ 프레임 이동)
+    Item {
+        anchors.fill: parent
+        focus: true
+        Keys.onPressed: function(event) {
+            if (event.key === Qt.Key_Space) {
+                controller.togglePlay()
+                event.accepted = true
+            } else if (event.key === Qt.Key_Left) {
+                controller.stepFrames(-1)
+                event.accepted = true
+            } else if (event.key === Qt.Key_Right) {
+                controller.stepFrames(1)
+                event.accepted = true
+            }
+        }
+    }
+}
@@ -526,6 +526,15 @@ Rectangle {
             // TimelineSync 객체 전달 (중앙 동기화 허브)
             timelineSync: root.timelineSync
             
+            // 디먹서 캐시 구간
+            cachedRanges: root.mpvObject && root.mpvObject.cacheManager ? root.mpvObject.cacheManager.cachedRanges : []
+            
+            // 오디오 파형
+            waveform: root.mpvObject ? root.mpvObject.waveform : null
+            
+            // 키프레임/비트레이트 지도
+            keyframeMap: root.mpvObject ? root.mpvObject.keyframeMap : null
+            
             // currentFrame 변경 감지 - 타임라인 내부 변경이 외부로 전달되도록
             onCurrentFrameChanged: {
                 // 내부-외부 값이 다를 때만 업데이트 (무한 루프 방지)
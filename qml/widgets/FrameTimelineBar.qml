@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import app.timeline 1.0
 
 import "../utils"
 
@@ -24,13 +25,18 @@ Item {
     property real fps: 24.0
     property bool isPlaying: false
     
+    // 디먹서 캐시에 들어 있는 구간 [{start, end}] (초) - 이 구간은 즉시 스크럽 가능
+    property var cachedRanges: []
+    
+    // 오디오 파형 분석기 (AudioWaveformAnalyzer) - 준비되면 프레임 눈금 뒤에 파형 표시
+    property var waveform: null
+    
+    // 키프레임 지도 (KeyframeMap) - 준비되면 눈금 위쪽에 시크 비용/비트레이트 띠와 키프레임 표시
+    property var keyframeMap: null
+    
     // Signal when user requests to seek to a specific frame
     signal seekRequested(int frame)
     
-    // Frame visualization settings
-    property int majorFrameInterval: 5  // Show bigger marker every N frames
-    property int timecodeInterval: Math.max(10, Math.floor(fps))  // Show timecode every N frames
-    
     // Colors and styling
     property color backgroundColor: ThemeManager.timelineBackgroundColor
     property color frameColor: ThemeManager.timelineFrameColor
@@ -186,53 +192,37 @@ Item {
         return Math.round(safeFrame * scaleFactor - 1);
     }
     
-    // MPV 시크 작업 최적화 - 중복 코드 제거 및 통합 (새로 추가)
+    // 프레임 시크 - 재생 상태 머신 한 곳에서 일시정지, 정확 시크, 도착 확인/재시도를 처리
+    // (여기서 time-pos를 직접 바꾸거나 따로 검증하지 않음)
     function performMpvSeek(frame) {
         if (!mpvObject) return false;
         
-        try {
-            console.log("Performing optimized MPV seek to frame:", frame);
-            
-            // MPV 명령 오류 방지를 위한 핵심 변경: 직접 속성 설정만 사용
-            
-            // 1. 먼저 안전하게 속성 설정 (MPV 명령보다 더 안정적)
-            mpvObject.setProperty("pause", true);
-            
-            // 2. 프레임 오프셋 조정 (1-based 고정)
-            // 항상 1-based로 처리 (중요: 0번 프레임이면 자동으로 1로 변환)
-            var adjustedFrame = Math.max(1, frame + 1);
-            if (frame === 0) {
-                console.log("프레임 인덱스 조정: 0 -> 1 (1-based 인덱싱 적용)");
-            }
-            
-            // 3. 정확한 위치 계산 (조정된 프레임 기준)
-            var adjustedPos = (adjustedFrame - 1) / fps; // 0-based 시간 위치 계산
-            
-            // 4. 명확한 소수점 형식으로 변환 (MPV 명령 오류 방지)
-            // toFixed(6)로 명시적 문자열 형식을 만든 후 다시 Number로 변환
-            var numericPos = Number(adjustedPos.toFixed(6));
-            
-            // 5. MPV 명령 대신 직접 속성 설정만 사용 (더 안정적)
-            console.log("Setting MPV position directly:", numericPos, "(프레임:", adjustedFrame, ")");
-            mpvObject.setProperty("time-pos", numericPos);
-            
-            // 6. 내부 프레임 업데이트
-            _internalFrame = frame;
-            currentFrame = frame; // UI와 내부 값 일치시킴
-            
-            // 7. 강제 업데이트 (UI 반응성)
-            mpvObject.update();
-            
-            // 8. 프레임 동기화 시그널 발생
+        // 내부 프레임 변경이 다시 시크를 보내지 않도록 먼저 안정화 표시
+        seekStabilizing = true;
+        _internalFrame = frame;
+        currentFrame = frame;
+        
+        if (mpvObject.playbackState) {
+            mpvObject.playbackState.seekToFrame(frame);
+        } else {
             seekRequested(frame);
-            
-            // 9. 동기화 안정화 시작
-            seekStabilizing = true;
-            
-            return true;
-        } catch (e) {
-            console.error("MPV seek error:", e);
-            return false;
+            seekInProgress = false;
+            stabilizationTimer.restart();
+        }
+        return true;
+    }
+    
+    // 상태 머신 시크 완료 - 실제 표시된 프레임으로 맞추고 안정화 종료
+    Connections {
+        target: mpvObject ? mpvObject.playbackState : null
+        ignoreUnknownSignals: true
+        function onSeekFinished(frame) {
+            if (!seekInProgress) return;
+            seekInProgress = false;
+            if (!isDragging) {
+                _internalFrame = frame;
+            }
+            stabilizationTimer.restart();
         }
     }
     
@@ -296,64 +286,6 @@ Item {
         }
     }
     
-    // 시크 후 검증 타이머 - 더 강력한 동기화 (간격 증가)
-    Timer {
-        id: verifySeekTimer
-        interval: 200  // 간격 더 증가 (200ms) - CPU 부하 추가 감소
-        repeat: false
-        
-        // 시크 실패 방지를 위한 재시도 제한
-        property int retryCount: 0
-        property int maxRetries: 2
-        
-        onTriggered: {
-            try {
-                // 1. 최종 시크 후 실제 위치 다시 확인
-                if (mpvObject) {
-                    var finalPos = mpvObject.getProperty("time-pos");
-                    if (finalPos !== undefined && finalPos !== null) {
-                        var finalFrame = Math.round(finalPos * fps);
-                        console.log("Verification: MPV frame=", finalFrame, "_internalFrame=", _internalFrame);
-                        
-                        // 계산된 프레임과 현재 프레임이 크게 다른 경우에만 재동기화
-                        // 차이 값 증가 - CPU 부하 감소
-                        if (Math.abs(finalFrame - _internalFrame) > 3) {
-                            console.log("Frame mismatch detected - synchronizing");
-                            
-                            // 내부 프레임 업데이트
-                            _internalFrame = finalFrame;
-                            updatePlayhead();
-                            
-                            // 차이가 매우 큰 경우에만 다시 시크 시도 (극단적인 경우만)
-                            if (Math.abs(finalFrame - currentFrame) > 10 && retryCount < maxRetries) {
-                                console.log("Large frame mismatch - retrying seek operation");
-                                retryCount++;
-                                // 차이가 크면 다시 시크 시도
-                                seekRequested(finalFrame);
-                                
-                                // 타이머 재시작하고 여기서 종료
-                                verifySeekTimer.restart();
-                                return;
-                            }
-                        }
-                    }
-                }
-            
-                // 2. 시크 완료 처리
-                seekInProgress = false;
-                retryCount = 0; // 재시도 카운트 리셋
-                
-                // 3. 안정화 기간 종료 (렉 방지 - 중요한 개선)
-                stabilizationTimer.restart();
-            } catch (e) {
-                console.error("Seek verification error:", e);
-                seekInProgress = false;
-                retryCount = 0; // 오류 시에도 카운트 리셋
-                stabilizationTimer.restart();
-            }
-        }
-    }
-    
     // 새로 추가: 안정화 타이머 - 드래그 후 렉 방지를 위한 핵심 개선
     Timer {
         id: stabilizationTimer
@@ -376,11 +308,12 @@ Item {
                 try {
                     console.log("Drag seek (debounced), frame:", dragFrame);
                     
-                    // 통합된 MPV 시크 함수 사용
-                    performMpvSeek(dragFrame);
-                    
-                    // 시그널 발생 (상위 알림)
-                    seekRequested(dragFrame);
+                    // TimelineSync가 키프레임 지도로 정확/키프레임 시크를 고름 (없으면 통합 MPV 시크)
+                    if (timelineSync) {
+                        timelineSync.seekToFrame(dragFrame, false);
+                    } else {
+                        performMpvSeek(dragFrame);
+                    }
                     
                 } catch (e) {
                     console.error("Debounce seek error:", e);
@@ -389,117 +322,47 @@ Item {
         }
     }
     
-    // 최종 검증 타이머 추가
-    Timer {
-        id: finalVerificationTimer
-        interval: 100
-        repeat: false
-        property int verifyDragFrame: 0
-        
-        onTriggered: {
-            try {
-                if (mpvObject) {
-                    // 실제 위치 확인
-                    var actualPos = mpvObject.getProperty("time-pos");
-                    var actualFrame = Math.round(actualPos * fps);
-                    
-                    console.log("Final verification - expected:", verifyDragFrame, "actual:", actualFrame);
-                    
-                    // 차이가 있으면 마지막으로 한 번 더 시크
-                    if (Math.abs(actualFrame - verifyDragFrame) > 0) {
-                        var finalPos = verifyDragFrame / fps;
-                        
-                        // 세 번째 시크 - 더 강제적인 방식
-                        mpvObject.command(["seek", finalPos.toFixed(6), "absolute", "exact"]);
-                        mpvObject.setProperty("pause", true);
-                        
-                        // 프레임 설정 강제 업데이트
-                        _internalFrame = verifyDragFrame;
-                        currentFrame = verifyDragFrame;
-                        
-                        // 강제 갱신
-                        mpvObject.update();
-                    }
-                }
-            } catch (e) {
-                console.error("Final verification error:", e);
-            } finally {
-                // 최종 안정화 타이머 시작
-                stabilizationTimer.restart();
-                seekInProgress = false;
-            }
-        }
-    }
-    
     // Main timeline background
     Rectangle {
         id: timelineBackground
         anchors.fill: parent
         color: backgroundColor
         
-        // Create the timeline markers
-        Item {
+        // 눈금, 캐시 구간 띠, 오디오 파형 (씬 그래프 정점)
+        // 프레임 수/fps/크기/구간/파형이 바뀔 때만 다시 만들고, 재생 중에는 재생 헤드만 움직인다
+        TimelineItem {
             id: timelineMarkers
             anchors.fill: parent
-            anchors.topMargin: 3
-            anchors.bottomMargin: 12
+            // 위 여백 = 3px 여백 + 키프레임 지도 띠 4px
+            tickTopMargin: 7
+            tickBottomMargin: 12
+            rangeHeight: 2
+            heatmapHeight: 4
             
-            // Draw frame markers using a canvas
-            Canvas {
-                id: frameMarkersCanvas
-                anchors.fill: parent
-                
-                // Redraw on window resize or totalFrames change
-                onWidthChanged: requestPaint()
-                onHeightChanged: requestPaint()
+            totalFrames: root.totalFrames
+            fps: root.fps
+            frameColor: root.frameColor
+            majorFrameColor: root.majorFrameColor
+            rangeColor: ThemeManager.accentColor
+            waveformColor: ThemeManager.accentColor
+            heatmapColor: ThemeManager.timelineHeatmapColor
+            keyframeColor: ThemeManager.timelineKeyframeColor
+            cachedRanges: root.cachedRanges
+            waveform: root.waveform
+            keyframeMap: root.keyframeMap
+            
+            // 프레임 번호 라벨 - 간격은 화면 폭에 맞춰 TimelineItem이 결정
+            Repeater {
+                model: timelineMarkers.labelFrames
                 
-                onPaint: {
-                    var ctx = getContext("2d");
-                    ctx.reset();
-                    
-                    // Skip if we don't have enough frames
-                    if (totalFrames <= 0) return;
-                    
-                    var h = height;
-                    
-                    // Draw frame markers
-                    ctx.strokeStyle = frameColor;
-                    ctx.lineWidth = 1;
-                    
-                    // Optimize by drawing fewer markers when zoomed out
-                    var skipFactor = Math.ceil(totalFrames / width / 0.5);
-                    
-                    for (var i = 0; i < totalFrames; i += skipFactor) {
-                        // Position for current frame
-                        var x = i * scaleFactor;
-                        
-                        // Skip if offscreen
-                        if (x > width) break;
-                        
-                        // Major frame markers (every N frames)
-                        if (i % majorFrameInterval === 0) {
-                            ctx.beginPath();
-                            ctx.moveTo(x, 0);
-                            ctx.lineTo(x, h * 0.75);
-                            ctx.strokeStyle = majorFrameColor;
-                            ctx.stroke();
-                            
-                            // Add timecode label for major intervals
-                            if (i % timecodeInterval === 0) {
-                                ctx.fillStyle = timecodeFontColor;
-                                ctx.font = timecodeFontSize + "px " + timecodeFontFamily;
-                                ctx.textAlign = "center";
-                                ctx.fillText(i.toString(), x, h - 2);
-                            }
-                        } else {
-                            // Minor frame markers
-                            ctx.beginPath();
-                            ctx.moveTo(x, 0);
-                            ctx.lineTo(x, h * 0.4);
-                            ctx.strokeStyle = frameColor;
-                            ctx.stroke();
-                        }
-                    }
+                Text {
+                    x: modelData * scaleFactor - width / 2
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 13
+                    text: modelData
+                    color: timecodeFontColor
+                    font.family: timecodeFontFamily
+                    font.pixelSize: timecodeFontSize
                 }
             }
         }
@@ -591,12 +454,8 @@ Item {
                 
                 isDragging = true;
                 recentlyDragged = true;
-                
-                // MPV 메타데이터 업데이트 차단 설정 (VideoArea에 알림)
-                if (mpvObject && mpvObject.parentItem && 
-                    typeof mpvObject.parentItem.metadataUpdateBlocked !== "undefined") {
-                    mpvObject.parentItem.metadataUpdateBlocked = true;
-                    console.log("Timeline: Blocked metadata updates during drag");
+                if (timelineSync) {
+                    timelineSync.beginDragging();
                 }
                 
                 // Calculate which frame was clicked
@@ -619,35 +478,11 @@ Item {
                 // Update activeTrack to follow playhead
                 activeTrack.width = playhead.x;
                 
-                // Immediately seek to the clicked position
+                // Immediately seek to the clicked position (상태 머신 한 경로)
                 if (mpvObject) {
                     seekInProgress = true;
-                    try {
-                        // 클릭 시크 개선 - 더 강력한 시크 방식 적용
-                        // 1. 내부 프레임 즉시 업데이트
-                        _internalFrame = dragFrame;
-                        currentFrame = dragFrame;
-                        
-                        // 2. 통합된 MPV 시크 함수 사용 (개선)
-                        performMpvSeek(dragFrame);
-                        
-                        // 3. 시그널 강화 - 여러 경로로 시그널 발생
-                        console.log("Click seek:", dragFrame);
-                        
-                        // 4. VideoArea 컴포넌트의 seekToFrame 함수 직접 호출 시도
-                        if (mpvObject && mpvObject.parentItem && 
-                            typeof mpvObject.parentItem.seekToFrame === "function") {
-                            mpvObject.parentItem.seekToFrame(dragFrame);
-                        }
-                        
-                        // 5. 중요: 클릭 시크를 위한 강화된 검증 즉시 시작
-                        Qt.callLater(function() {
-                            verifySeekTimer.restart();
-                        });
-                    } catch (e) {
-                        console.error("Click seek error:", e);
-                        seekInProgress = false;
-                    }
+                    console.log("Click seek:", dragFrame);
+                    performMpvSeek(dragFrame);
                 }
             }
             
@@ -665,45 +500,18 @@ Item {
                     // 메타데이터 업데이터는 드래그 후에도 계속 차단 유지
                     // 메타데이터는 처음 파일 로드시에만 필요하므로 해제하지 않음
                     
-                    // Ensure a final accurate seek occurs
-                    if (mpvObject) {
-                        try {
-                            // 드래그 후 프레임 멈춤 문제 해결을 위한 개선된 시크 처리
-                            
-                            // 1. 드래그 후 첫 번째 시크 - 속성 직접 설정 (빠른 응답)
-                            var pos = dragFrame / fps;
-                            mpvObject.setProperty("time-pos", pos);
-                            mpvObject.setProperty("pause", true);
-                            
-                            // 2. 지연 시간을 둔 후 두 번째 시크 실행 (더 정확한 프레임 설정)
-                            Qt.callLater(function() {
-                                try {
-                                    // 정확한 시크 명령 실행
-                                    mpvObject.command(["seek", pos.toFixed(6), "absolute", "exact"]);
-                                    
-                                    // 강제 업데이트 요청
-                                    mpvObject.update();
-                                    
-                                    // 상태 확인 타이머 재시작
-                                    verifySeekTimer.restart();
-                                } catch (e) {
-                                    console.error("Second seek error:", e);
-                                }
-                            });
-                            
-                            // 3. 더 긴 지연 후 최종 프레임 위치 확인 및 수정
-                            Qt.callLater(function() {
-                                // 새로 추가한 최종 검증 타이머 사용
-                                finalVerificationTimer.verifyDragFrame = dragFrame;
-                                finalVerificationTimer.restart();
-                            });
-                            
-                        } catch (e) {
-                            console.error("Final seek error:", e);
-                            // 오류 시에도 안정화 타이머 시작
-                            stabilizationTimer.restart();
-                            seekInProgress = false;
-                        }
+                    if (timelineSync) {
+                        // TimelineSync 드래그 종료 - 상태 머신으로 마지막 요청 프레임에 정확 시크 한 번
+                        // (키프레임에 머물러 있었어도 여기서 맞춰지고 도착 확인은 상태 머신이 함)
+                        seekDebounceTimer.stop();
+                        timelineSync.endDragging(dragFrame);
+                        seekInProgress = false;
+                        stabilizationTimer.restart();
+                    } else if (mpvObject) {
+                        // TimelineSync가 없으면 상태 머신으로 정확 시크 한 번
+                        seekDebounceTimer.stop();
+                        seekInProgress = true;
+                        performMpvSeek(dragFrame);
                     } else {
                         // MPV가 없어도 안정화 타이머 시작
                         stabilizationTimer.restart();
@@ -736,27 +544,4 @@ Item {
             font.pixelSize: 10
         }
     }
-    
-    // Update display when properties change
-    onTotalFramesChanged: {
-        frameMarkersCanvas.requestPaint();
-    }
-    
-    onWidthChanged: {
-        frameMarkersCanvas.requestPaint();
-    }
-    
-    onFpsChanged: {
-        timecodeInterval = Math.max(10, Math.floor(fps));
-        frameMarkersCanvas.requestPaint();
-    }
-    
-    // 프레임 번호 체계에 따라 업데이트
-    onDisplayOffsetChanged: {
-        frameMarkersCanvas.requestPaint();
-    }
-    
-    Component.onCompleted: {
-        frameMarkersCanvas.requestPaint();
-    }
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import "../utils"
+
+// 성능 통계 패널 - 적응형 성능 조절기의 현재 단계, 측정값, 최근 결정을 표시
+Rectangle {
+    id: root
+    width: 320
+    height: contentColumn.implicitHeight + 16
+    radius: 4
+    color: Qt.rgba(0, 0, 0, 0.75)
+    border.color: ThemeManager.borderColor
+
+    property var governor: null
+    readonly property var stats: governor ? governor.stats : ({})
+
+    function formatMs(value) {
+        return value !== undefined ? Number(value).toFixed(1) : "-"
+    }
+
+    ColumnLayout {
+        id: contentColumn
+        anchors.fill: parent
+        anchors.margins: 8
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+
+            Text {
+                text: "Performance"
+                color: ThemeManager.textColor
+                font.bold: true
+                font.pixelSize: 12
+                Layout.fillWidth: true
+            }
+
+            CheckBox {
+                text: "Auto"
+                checked: root.governor ? root.governor.enabled : false
+                onToggled: if (root.governor) root.governor.enabled = checked
+            }
+
+            Button {
+                text: "Full quality"
+                enabled: root.governor && root.governor.level > 0
+                onClicked: root.governor.restoreFullQuality()
+            }
+        }
+
+        Text {
+            text: root.governor
+                  ? "Level " + root.governor.level + "/" + root.governor.maxLevel + "  " + root.governor.levelName
+                  : "Governor not available"
+            color: root.governor && root.governor.level > 0 ? ThemeManager.accentColor : ThemeManager.textColor
+            font.family: ThemeManager.monoFont
+            font.pixelSize: 11
+        }
+
+        Text {
+            text: "render " + root.formatMs(root.stats.renderAvgMs) + " ms avg, "
+                  + root.formatMs(root.stats.renderMaxMs) + " ms max / "
+                  + root.formatMs(root.stats.budgetMs) + " ms budget"
+            color: ThemeManager.secondaryTextColor
+            font.family: ThemeManager.monoFont
+            font.pixelSize: 11
+        }
+
+        Text {
+            text: "frames " + (root.stats.frames !== undefined ? root.stats.frames : "-")
+                  + "  dropped " + (root.stats.dropped !== undefined ? root.stats.dropped : "-")
+                  + "  delayed " + (root.stats.delayed !== undefined ? root.stats.delayed : "-")
+                  + "  cache " + root.formatMs(root.stats.cacheSec) + " s"
+            color: ThemeManager.secondaryTextColor
+            font.family: ThemeManager.monoFont
+            font.pixelSize: 11
+        }
+
+        Text {
+            text: "state " + (root.stats.state !== undefined ? root.stats.state : "idle")
+            color: ThemeManager.secondaryTextColor
+            font.family: ThemeManager.monoFont
+            font.pixelSize: 11
+        }
+
+        // 최근 결정 (최신이 위)
+        Repeater {
+            model: root.governor ? root.governor.decisions.slice(0, 6) : []
+            delegate: Text {
+                text: modelData
+                color: ThemeManager.disabledTextColor
+                font.family: ThemeManager.monoFont
+                font.pixelSize: 10
+                elide: Text.ElideRight
+                Layout.fillWidth: true
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import "../utils"
+
+// 리뷰 세션 패널 - 진행/참가, 참가자별 왕복 시간과 동기 오차(프레임) 표시
+Rectangle {
+    id: root
+    width: 340
+    height: contentColumn.implicitHeight + 16
+    radius: 4
+    color: Qt.rgba(0, 0, 0, 0.75)
+    border.color: ThemeManager.borderColor
+
+    property var session: null
+    readonly property int role: session ? session.role : 0
+
+    function formatFrames(value) {
+        return (value >= 0 ? "+" : "") + Number(value).toFixed(2) + " fr"
+    }
+
+    ColumnLayout {
+        id: contentColumn
+        anchors.fill: parent
+        anchors.margins: 8
+        spacing: 4
+
+        Text {
+            text: "Review Session"
+            color: ThemeManager.textColor
+            font.bold: true
+            font.pixelSize: 12
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            visible: root.role === 0
+
+            TextField {
+                id: addressField
+                Layout.fillWidth: true
+                placeholderText: "host:47800"
+                font.pixelSize: 11
+            }
+
+            Button {
+                text: "Join"
+                enabled: root.session !== null
+                onClicked: root.session.join(addressField.text)
+            }
+
+            Button {
+                text: "Host"
+                enabled: root.session !== null
+                onClicked: root.session.host(47800)
+            }
+        }
+
+        Button {
+            visible: root.role !== 0
+            text: root.role === 1 ? "Stop Hosting" : "Leave"
+            onClicked: root.session.leave()
+        }
+
+        Text {
+            text: root.session ? root.session.status : "Not available"
+            color: ThemeManager.secondaryTextColor
+            font.pixelSize: 11
+            elide: Text.ElideRight
+            Layout.fillWidth: true
+        }
+
+        // 참가자: 진행자 시계와의 차이 및 현재 동기 오차
+        Text {
+            visible: root.role === 2
+            text: "rtt " + root.session.roundTripMs.toFixed(1) + " ms  offset "
+                  + root.session.clockOffsetMs.toFixed(1) + " ms  error "
+                  + root.formatFrames(root.session.syncErrorFrames)
+            color: Math.abs(root.session ? root.session.syncErrorFrames : 0) >= 1
+                   ? ThemeManager.timelinePlayheadColor : ThemeManager.textColor
+            font.family: ThemeManager.monoFont
+            font.pixelSize: 11
+        }
+
+        // 진행자: 참가자 목록
+        Repeater {
+            model: root.role === 1 ? root.session.peers : []
+            delegate: Text {
+                text: modelData.name + "  rtt " + Number(modelData.rttMs).toFixed(1) + " ms  "
+                      + (modelData.hasReport ? root.formatFrames(modelData.errorFrames) : "-")
+                color: Math.abs(modelData.errorFrames) >= 1 ? ThemeManager.timelinePlayheadColor
+                                                             : ThemeManager.secondaryTextColor
+                font.family: ThemeManager.monoFont
+                font.pixelSize: 11
+                elide: Text.ElideRight
+                Layout.fillWidth: true
+            }
+        }
+    }
+}
@@ -52,10 +52,12 @@ Rectangle {
     function updateFilters() {
         if (!mpvPlayer)
             return;
-        mpvPlayer.command(["vf", "clr"]);
+        // 체인 전체를 한 번에 적용 (vf set 한 번, 바뀌지 않았으면 아무 것도 하지 않음)
+        var filters = [];
         if (histogramCheck.checked)
-            mpvPlayer.command(["vf", "add", "lavfi=histogram"]);
+            filters.push("lavfi=histogram");
         if (vectorscopeCheck.checked)
-            mpvPlayer.command(["vf", "add", "lavfi=vectorscope"]);
+            filters.push("lavfi=vectorscope");
+        mpvPlayer.videoFilters = filters;
     }
 }
@@ -26,7 +26,7 @@ Window {
         onTriggered: {
             if (targetMpv) {
                 try {
-                    targetMpv.command(["vf", "set", "lavfi=histogram"]);
+                    targetMpv.videoFilters = ["lavfi=histogram"];
                     console.log("Histogram filter applied");
                 } catch (e) {
                     console.error("Failed to apply histogram filter:", e);
@@ -43,7 +43,7 @@ Window {
         onTriggered: {
             if (targetMpv) {
                 try {
-                    targetMpv.command(["vf", "set", "lavfi=vectorscope"]);
+                    targetMpv.videoFilters = ["lavfi=vectorscope"];
                     console.log("Vectorscope filter applied");
                 } catch (e) {
                     console.error("Failed to apply vectorscope filter:", e);
@@ -2,6 +2,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import QtQuick.Window
+import QtQuick.Dialogs
 
 import "../utils"
 import "../ui"
@@ -30,6 +31,9 @@ Window {
     // MPV 참조
     property var mpvObject: null
     
+    // GPU 색 보정 파이프라인 (MPV 빌드에서만 존재)
+    property var colorPipeline: mpvObject ? mpvObject.colorPipeline : null
+    
     // 테두리와 그림자 효과
     Rectangle {
         id: contentArea
@@ -865,6 +869,54 @@ Window {
                                                 }
                                             }
                                         }
+
+                                        // 디코더 자동 튜닝 (코덱별 스레드 수/hwdec 프로필)
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            visible: typeof decoderTuner !== "undefined"
+
+                                            Column {
+                                                Layout.fillWidth: true
+                                                spacing: 2
+
+                                                Text {
+                                                    text: "Decoder Auto-Tuning"
+                                                    color: ThemeManager.textColor
+                                                    font.pixelSize: 14
+                                                }
+
+                                                Text {
+                                                    text: {
+                                                        if (typeof decoderTuner === "undefined") return ""
+                                                        if (decoderTuner.running)
+                                                            return decoderTuner.status + " (" + Math.round(decoderTuner.progress * 100) + "%)"
+                                                        var count = Object.keys(decoderTuner.profiles).length
+                                                        if (count === 0)
+                                                            return "Not measured yet - run when idle"
+                                                        return decoderTuner.outdated ? count + " codec profiles (outdated - run again)" : count + " codec profiles"
+                                                    }
+                                                    color: ThemeManager.secondaryTextColor
+                                                    font.pixelSize: 11
+                                                }
+                                            }
+
+                                            Switch {
+                                                checked: typeof decoderTuner !== "undefined" && decoderTuner.autoApply
+                                                onToggled: decoderTuner.autoApply = checked
+                                            }
+
+                                            Button {
+                                                text: typeof decoderTuner !== "undefined" && decoderTuner.running ? "Cancel" : "Run Benchmark"
+                                                onClicked: {
+                                                    if (decoderTuner.running) {
+                                                        decoderTuner.cancel()
+                                                    } else {
+                                                        decoderTuner.runBenchmark()
+                                                    }
+                                                }
+                                            }
+                                        }
                                     }
                                 }
                                 
@@ -894,6 +946,167 @@ Window {
                                         }
                                     }
                                 }
+
+                                // GPU 색 보정 (렌더러 셰이더 - CPU 필터 없음)
+                                SettingsCard {
+                                    title: "Color Pipeline"
+                                    visible: !!colorPipeline
+                                    
+                                    Column {
+                                        width: parent.width
+                                        spacing: 20
+                                        
+                                        // 노출 (스톱)
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            
+                                            Text {
+                                                text: "Exposure"
+                                                color: ThemeManager.textColor
+                                                font.pixelSize: 14
+                                                Layout.fillWidth: true
+                                            }
+                                            
+                                            Slider {
+                                                from: -4
+                                                to: 4
+                                                stepSize: 0.1
+                                                value: colorPipeline ? colorPipeline.exposure : 0
+                                                onMoved: colorPipeline.exposure = value
+                                            }
+                                            
+                                            Text {
+                                                text: colorPipeline ? colorPipeline.exposure.toFixed(1) : "0.0"
+                                                color: ThemeManager.secondaryTextColor
+                                                font.pixelSize: 12
+                                                Layout.preferredWidth: 30
+                                            }
+                                        }
+                                        
+                                        // 채도 (CDL saturation)
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            
+                                            Text {
+                                                text: "Saturation"
+                                                color: ThemeManager.textColor
+                                                font.pixelSize: 14
+                                                Layout.fillWidth: true
+                                            }
+                                            
+                                            Slider {
+                                                from: 0
+                                                to: 2
+                                                stepSize: 0.05
+                                                value: colorPipeline ? colorPipeline.saturation : 1
+                                                onMoved: colorPipeline.saturation = value
+                                            }
+                                            
+                                            Text {
+                                                text: colorPipeline ? colorPipeline.saturation.toFixed(2) : "1.00"
+                                                color: ThemeManager.secondaryTextColor
+                                                font.pixelSize: 12
+                                                Layout.preferredWidth: 30
+                                            }
+                                        }
+                                        
+                                        // LUT (.cube / .3dl)
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            
+                                            Column {
+                                                Layout.fillWidth: true
+                                                spacing: 2
+                                                
+                                                Text {
+                                                    text: "LUT"
+                                                    color: ThemeManager.textColor
+                                                    font.pixelSize: 14
+                                                }
+                                                
+                                                Text {
+                                                    text: {
+                                                        if (!colorPipeline) return ""
+                                                        if (colorPipeline.errorString !== "") return colorPipeline.errorString
+                                                        if (colorPipeline.lutFile === "") return "None"
+                                                        return colorPipeline.lutFile.split(/[\\/]/).pop() + " (" + colorPipeline.lutSize + "\u00B3)"
+                                                    }
+                                                    color: ThemeManager.secondaryTextColor
+                                                    font.pixelSize: 11
+                                                    elide: Text.ElideMiddle
+                                                    width: parent.width
+                                                }
+                                            }
+                                            
+                                            Button {
+                                                text: "Load..."
+                                                onClicked: lutDialog.open()
+                                            }
+                                            
+                                            Button {
+                                                text: "Clear"
+                                                enabled: colorPipeline && colorPipeline.lutFile !== ""
+                                                onClicked: colorPipeline.clearLut()
+                                            }
+                                        }
+                                        
+                                        // 채널 분리
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            
+                                            Text {
+                                                text: "Channel"
+                                                color: ThemeManager.textColor
+                                                font.pixelSize: 14
+                                                Layout.fillWidth: true
+                                            }
+                                            
+                                            ComboBox {
+                                                model: ["RGB", "Red", "Green", "Blue", "Luma"]
+                                                currentIndex: colorPipeline ? colorPipeline.channel : 0
+                                                onActivated: colorPipeline.channel = currentIndex
+                                            }
+                                        }
+                                        
+                                        // 폴스 컬러 (노출 확인)
+                                        RowLayout {
+                                            width: parent.width
+                                            spacing: 10
+                                            
+                                            Text {
+                                                text: "False Color"
+                                                color: ThemeManager.textColor
+                                                font.pixelSize: 14
+                                                Layout.fillWidth: true
+                                            }
+                                            
+                                            Switch {
+                                                checked: colorPipeline ? colorPipeline.falseColor : false
+                                                onToggled: colorPipeline.falseColor = checked
+                                            }
+                                            
+                                            Button {
+                                                text: "Reset"
+                                                onClicked: colorPipeline.reset()
+                                            }
+                                        }
+                                    }
+                                    
+                                    FileDialog {
+                                        id: lutDialog
+                                        title: "Load LUT"
+                                        nameFilters: ["LUT files (*.cube *.3dl)", "All files (*)"]
+                                        onAccepted: {
+                                            if (colorPipeline) {
+                                                colorPipeline.loadLut(selectedFile.toString())
+                                            }
+                                        }
+                                    }
+                                }
                             }
                         }
                     }
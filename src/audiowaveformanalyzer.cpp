@@ -0,0 +1,611 @@
+#include "audiowaveformanalyzer.h"
+#include "mpvobject.h"
+#include "mpvheadless.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 0단계 묶음 크기 (48kHz에서 약 5.3ms - 프레임보다 촘촘)
+constexpr int kSamplesPerBucket = 256;
+constexpr quint32 kCacheMagic = 0x48505746; // "HPWF"
+constexpr quint32 kCacheVersion = 1;
+constexpr int kReadBufferBytes = 256 * 1024;
+constexpr int kProgressIntervalMs = 250;
+
+static_assert(sizeof(AudioWaveformAnalyzer::Peak) == 3, "Peak is stored raw in the cache file");
+
+// MPV ao=pcm 출력을 디스크를 거치지 않고 받는 파이프 (Unix는 FIFO, Windows는 명명 파이프)
+// 읽기는 항상 논블로킹 - 같은 스레드에서 MPV 이벤트도 처리해야 하므로
+class PcmPipe
+{
+public:
+    PcmPipe()
+    {
+        static std::atomic_int counter{0};
+        const QString name = QString("hyperplayer-wave-%1-%2")
+                                 .arg(QCoreApplication::applicationPid())
+                                 .arg(counter++);
+#ifdef Q_OS_WIN
+        m_path = QStringLiteral("\\\\.\\pipe\\") + name;
+        m_handle = CreateNamedPipeW(reinterpret_cast<LPCWSTR>(m_path.utf16()), PIPE_ACCESS_INBOUND,
+                                    PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
+                                    1, 0, 1024 * 1024, 0, nullptr);
+#else
+        m_path = QDir::temp().filePath(name + ".pcm");
+        const QByteArray nativePath = QFile::encodeName(m_path);
+        if (::mkfifo(nativePath.constData(), 0600) == 0) {
+            m_fd = ::open(nativePath.constData(), O_RDONLY | O_NONBLOCK);
+        }
+#endif
+    }
+
+    ~PcmPipe()
+    {
+#ifdef Q_OS_WIN
+        if (m_handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_handle);
+        }
+#else
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+        ::unlink(QFile::encodeName(m_path).constData());
+#endif
+    }
+
+    bool isValid() const
+    {
+#ifdef Q_OS_WIN
+        return m_handle != INVALID_HANDLE_VALUE;
+#else
+        return m_fd >= 0;
+#endif
+    }
+
+    QString path() const { return m_path; }
+
+    // 지금 읽을 수 있는 만큼 읽음 (없거나 쓰는 쪽이 닫혔으면 0)
+    qint64 read(char* data, qint64 maxSize)
+    {
+#ifdef Q_OS_WIN
+        DWORD available = 0;
+        if (!PeekNamedPipe(m_handle, nullptr, 0, nullptr, &available, nullptr) || available == 0) {
+            return 0;
+        }
+        DWORD bytesRead = 0;
+        if (!ReadFile(m_handle, data, DWORD(std::min<qint64>(available, maxSize)), &bytesRead, nullptr)) {
+            return 0;
+        }
+        return bytesRead;
+#else
+        const ssize_t bytesRead = ::read(m_fd, data, size_t(maxSize));
+        return bytesRead > 0 ? bytesRead : 0;
+#endif
+    }
+
+    void wait(int ms)
+    {
+#ifdef Q_OS_WIN
+        Q_UNUSED(ms);
+        Sleep(1);
+#else
+        pollfd descriptor{m_fd, POLLIN, 0};
+        // 쓰는 쪽이 닫히면 poll이 바로 돌아오므로 그때는 잠깐 쉼
+        if (::poll(&descriptor, 1, ms) > 0 && !(descriptor.revents & POLLIN)) {
+            QThread::msleep(ms);
+        }
+#endif
+    }
+
+private:
+    QString m_path;
+#ifdef Q_OS_WIN
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+#else
+    int m_fd = -1;
+#endif
+};
+
+quint16 readLe16(const char* data)
+{
+    return quint16(quint8(data[0]) | (quint8(data[1]) << 8));
+}
+
+quint32 readLe32(const char* data)
+{
+    return quint32(readLe16(data)) | (quint32(readLe16(data + 2)) << 16);
+}
+
+// WAV 헤더에서 형식을 읽고 데이터 시작 위치를 반환 (-1: 더 읽어야 함, -2: 지원하지 않는 형식)
+int parseWaveHeader(const QByteArray& header, int& channels, int& sampleRate)
+{
+    if (header.size() < 12) {
+        return -1;
+    }
+    if (!header.startsWith("RIFF") || header.mid(8, 4) != "WAVE") {
+        return -2;
+    }
+
+    int offset = 12;
+    int bits = 0;
+    while (header.size() >= offset + 8) {
+        const QByteArray id = header.mid(offset, 4);
+        const quint32 size = readLe32(header.constData() + offset + 4);
+        if (id == "data") {
+            return (channels > 0 && sampleRate > 0 && bits == 16) ? offset + 8 : -2;
+        }
+        if (header.size() < offset + 8 + int(size)) {
+            return -1;
+        }
+        if (id == "fmt " && size >= 16) {
+            const char* fmt = header.constData() + offset + 8;
+            channels = readLe16(fmt + 2);
+            sampleRate = int(readLe32(fmt + 4));
+            bits = readLe16(fmt + 14);
+        }
+        offset += 8 + int(size) + int(size & 1);
+    }
+    return -1;
+}
+
+AudioWaveformAnalyzer::Peak mergePeaks(const AudioWaveformAnalyzer::Peak& a, const AudioWaveformAnalyzer::Peak& b)
+{
+    AudioWaveformAnalyzer::Peak merged;
+    merged.min = std::min(a.min, b.min);
+    merged.max = std::max(a.max, b.max);
+    merged.rms = quint8(std::lround(std::sqrt((double(a.rms) * a.rms + double(b.rms) * b.rms) / 2.0)));
+    return merged;
+}
+
+} // namespace
+
+AudioWaveformAnalyzer::AudioWaveformAnalyzer(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+AudioWaveformAnalyzer::~AudioWaveformAnalyzer()
+{
+    cancelJob();
+    m_pool.waitForDone();
+}
+
+void AudioWaveformAnalyzer::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    emit enabledChanged(m_enabled);
+
+    if (m_enabled) {
+        analyzeCurrentFile();
+    } else {
+        cancelJob();
+        m_pyramid.reset();
+        emit peaksChanged();
+    }
+}
+
+double AudioWaveformAnalyzer::duration() const
+{
+    if (!m_pyramid || m_pyramid->sampleRate <= 0) {
+        return 0.0;
+    }
+    return double(m_pyramid->sampleCount) / m_pyramid->sampleRate;
+}
+
+void AudioWaveformAnalyzer::analyzeCurrentFile()
+{
+    cancelJob();
+    if (m_pyramid) {
+        m_pyramid.reset();
+        emit peaksChanged();
+    }
+    if (!m_enabled || !m_player || !m_player->handle()) {
+        return;
+    }
+
+    // 로컬 파일만 분석 (네트워크 스트림은 한 번 더 받아야 하므로 제외)
+    QString path;
+    if (char* raw = mpv_get_property_string(m_player->handle(), "path")) {
+        path = QString::fromUtf8(raw);
+        mpv_free(raw);
+    }
+    const QFileInfo info(path);
+    if (path.isEmpty() || !info.isFile()) {
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->path = info.absoluteFilePath();
+    job->cacheFile = cacheFilePath(job->path);
+    mpv_get_property(m_player->handle(), "duration", MPV_FORMAT_DOUBLE, &job->duration);
+    m_job = job;
+
+    setProgress(0.0);
+    setAnalyzing(true);
+    m_pool.start(QRunnable::create([this, job]() { run(job); }));
+}
+
+void AudioWaveformAnalyzer::cancelJob()
+{
+    if (m_job) {
+        m_job->cancel = true;
+        m_job.reset();
+    }
+    setAnalyzing(false);
+}
+
+void AudioWaveformAnalyzer::run(const std::shared_ptr<Job>& job)
+{
+    // 재생 디코더보다 낮은 우선순위
+    QThread::currentThread()->setPriority(QThread::LowPriority);
+
+    std::shared_ptr<Pyramid> pyramid = loadCache(job->cacheFile);
+    if (pyramid) {
+        qDebug() << "AudioWaveformAnalyzer: loaded cached peaks for" << job->path;
+    } else if (!job->cancel) {
+        QElapsedTimer timer;
+        timer.start();
+        pyramid = decode(job);
+        if (pyramid && !job->cancel) {
+            qDebug() << "AudioWaveformAnalyzer: analyzed" << job->path << "in" << timer.elapsed() << "ms,"
+                     << pyramid->sampleCount << "samples";
+            saveCache(job->cacheFile, *pyramid);
+        }
+    }
+    if (job->cancel) {
+        return;
+    }
+
+    std::shared_ptr<const Pyramid> result = pyramid;
+    QMetaObject::invokeMethod(this, [this, job, result]() { publish(job, result); }, Qt::QueuedConnection);
+}
+
+std::shared_ptr<AudioWaveformAnalyzer::Pyramid> AudioWaveformAnalyzer::decode(const std::shared_ptr<Job>& job)
+{
+    PcmPipe pipe;
+    if (!pipe.isValid()) {
+        qWarning() << "AudioWaveformAnalyzer: failed to create PCM pipe";
+        return nullptr;
+    }
+
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        qWarning() << "AudioWaveformAnalyzer: failed to create MPV instance";
+        return nullptr;
+    }
+
+    // 오디오만 모노 16비트로 파이프에 쓰고 시계와 관계없이 최대한 빨리 진행
+    const QByteArray pipePath = QDir::toNativeSeparators(pipe.path()).toUtf8();
+    mpv_set_option_string(mpv, "ao", "pcm");
+    mpv_set_option_string(mpv, "ao-pcm-file", pipePath.constData());
+    mpv_set_option_string(mpv, "ao-pcm-waveheader", "yes");
+    mpv_set_option_string(mpv, "audio-format", "s16");
+    mpv_set_option_string(mpv, "audio-channels", "mono");
+    mpv_set_option_string(mpv, "vid", "no");
+    mpv_set_option_string(mpv, "sid", "no");
+    mpv_set_option_string(mpv, "untimed", "yes");
+    mpv_set_option_string(mpv, "keep-open", "no");
+
+    const QByteArray path = job->path.toUtf8();
+    const char* loadCmd[] = {"loadfile", path.constData(), nullptr};
+    if (mpv_initialize(mpv) < 0 || mpv_command(mpv, loadCmd) < 0) {
+        qWarning() << "AudioWaveformAnalyzer: failed to start decoding" << job->path;
+        mpv_terminate_destroy(mpv);
+        return nullptr;
+    }
+
+    auto pyramid = std::make_shared<Pyramid>();
+    pyramid->samplesPerBucket = kSamplesPerBucket;
+    std::vector<Peak>& base = pyramid->levels.emplace_back();
+    if (job->duration > 0) {
+        base.reserve(size_t(job->duration * 48000.0 / kSamplesPerBucket) + 1);
+    }
+
+    QByteArray header;
+    QByteArray carry;
+    int dataOffset = -1;
+    int channels = 0;
+    bool unsupported = false;
+
+    float bucketMin = 0.0f;
+    float bucketMax = 0.0f;
+    double bucketSquares = 0.0;
+    int bucketCount = 0;
+
+    auto flushBucket = [&]() {
+        if (bucketCount == 0) {
+            return;
+        }
+        Peak peak;
+        peak.min = qint8(std::clamp(std::lround(bucketMin * 127.0f), -127L, 127L));
+        peak.max = qint8(std::clamp(std::lround(bucketMax * 127.0f), -127L, 127L));
+        peak.rms = quint8(std::clamp(std::lround(std::sqrt(bucketSquares / bucketCount) * 255.0), 0L, 255L));
+        base.push_back(peak);
+        bucketMin = bucketMax = 0.0f;
+        bucketSquares = 0.0;
+        bucketCount = 0;
+    };
+
+    auto feedSamples = [&](const char* data, qint64 size) {
+        const int frameBytes = 2 * channels;
+        qint64 offset = 0;
+        for (; offset + frameBytes <= size; offset += frameBytes) {
+            int sum = 0;
+            for (int c = 0; c < channels; ++c) {
+                sum += qint16(readLe16(data + offset + 2 * c));
+            }
+            const float value = float(sum) / (32768.0f * channels);
+            bucketMin = std::min(bucketMin, value);
+            bucketMax = std::max(bucketMax, value);
+            bucketSquares += double(value) * value;
+            ++pyramid->sampleCount;
+            if (++bucketCount == kSamplesPerBucket) {
+                flushBucket();
+            }
+        }
+        carry = QByteArray(data + offset, int(size - offset));
+    };
+
+    std::vector<char> buffer(kReadBufferBytes);
+    QElapsedTimer progressTimer;
+    progressTimer.start();
+    bool quitSent = false;
+    bool shutdown = false;
+
+    auto quit = [&]() {
+        if (!quitSent) {
+            const char* quitCmd[] = {"quit", nullptr};
+            mpv_command_async(mpv, 0, quitCmd);
+            quitSent = true;
+        }
+    };
+
+    while (true) {
+        while (true) {
+            mpv_event* event = mpv_wait_event(mpv, 0);
+            if (event->event_id == MPV_EVENT_NONE) {
+                break;
+            }
+            if (event->event_id == MPV_EVENT_END_FILE) {
+                quit();
+            } else if (event->event_id == MPV_EVENT_SHUTDOWN) {
+                shutdown = true;
+            }
+        }
+        if (job->cancel || unsupported) {
+            quit();
+        }
+
+        // 종료 신호 뒤에도 파이프에 남은 데이터를 모두 읽은 다음 끝낸다
+        const qint64 bytesRead = pipe.read(buffer.data(), buffer.size());
+        if (bytesRead <= 0) {
+            if (shutdown) {
+                break;
+            }
+            pipe.wait(20);
+            continue;
+        }
+        if (job->cancel || unsupported) {
+            continue;
+        }
+
+        if (dataOffset < 0) {
+            header.append(buffer.data(), int(bytesRead));
+            dataOffset = parseWaveHeader(header, channels, pyramid->sampleRate);
+            if (dataOffset == -2) {
+                qWarning() << "AudioWaveformAnalyzer: unexpected PCM format from MPV";
+                unsupported = true;
+            } else if (dataOffset >= 0) {
+                feedSamples(header.constData() + dataOffset, header.size() - dataOffset);
+                header.clear();
+            }
+            continue;
+        }
+
+        if (!carry.isEmpty()) {
+            carry.append(buffer.data(), int(bytesRead));
+            const QByteArray pending = carry;
+            feedSamples(pending.constData(), pending.size());
+        } else {
+            feedSamples(buffer.data(), bytesRead);
+        }
+
+        if (progressTimer.elapsed() >= kProgressIntervalMs && job->duration > 0 && pyramid->sampleRate > 0) {
+            progressTimer.restart();
+            const double progress = std::min(1.0, pyramid->sampleCount / (job->duration * pyramid->sampleRate));
+            QMetaObject::invokeMethod(this, [this, job, progress]() {
+                if (job == m_job) {
+                    setProgress(progress);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }
+    mpv_terminate_destroy(mpv);
+
+    flushBucket();
+    if (job->cancel || unsupported || base.empty()) {
+        return nullptr;
+    }
+    buildLevels(*pyramid);
+    return pyramid;
+}
+
+void AudioWaveformAnalyzer::buildLevels(Pyramid& pyramid)
+{
+    pyramid.levels.resize(1);
+    while (pyramid.levels.back().size() > 1) {
+        const std::vector<Peak>& below = pyramid.levels.back();
+        std::vector<Peak> level((below.size() + 1) / 2);
+        for (size_t i = 0; i < level.size(); ++i) {
+            const Peak& a = below[2 * i];
+            level[i] = 2 * i + 1 < below.size() ? mergePeaks(a, below[2 * i + 1]) : a;
+        }
+        pyramid.levels.push_back(std::move(level));
+    }
+}
+
+void AudioWaveformAnalyzer::publish(const std::shared_ptr<Job>& job, std::shared_ptr<const Pyramid> pyramid)
+{
+    if (job != m_job) {
+        return;
+    }
+    m_job.reset();
+    m_pyramid = std::move(pyramid);
+    setProgress(m_pyramid ? 1.0 : 0.0);
+    setAnalyzing(false);
+    emit peaksChanged();
+}
+
+QVariantList AudioWaveformAnalyzer::peaks(double start, double end, int count) const
+{
+    QVariantList result;
+    if (!m_pyramid || count <= 0 || end <= start || m_pyramid->levels.empty()) {
+        return result;
+    }
+
+    // 한 칸에 1~2개 묶음이 들어가는 단계를 골라 칸마다 최대 3개만 합친다
+    const Pyramid& pyramid = *m_pyramid;
+    const double bucketsPerSecond = double(pyramid.sampleRate) / pyramid.samplesPerBucket;
+    const double bucketsPerCell = (end - start) * bucketsPerSecond / count;
+    size_t level = 0;
+    double scale = 1.0;
+    while (level + 1 < pyramid.levels.size() && scale * 2.0 <= bucketsPerCell) {
+        ++level;
+        scale *= 2.0;
+    }
+
+    const std::vector<Peak>& data = pyramid.levels[level];
+    const qint64 size = qint64(data.size());
+    const double origin = start * bucketsPerSecond / scale;
+    const double step = bucketsPerCell / scale;
+
+    result.reserve(count * 3);
+    for (int i = 0; i < count; ++i) {
+        const double from = origin + i * step;
+        qint64 first = qint64(std::floor(from));
+        qint64 last = std::max(first, qint64(std::ceil(from + step)) - 1);
+        if (last < 0 || first >= size) {
+            result << 0.0 << 0.0 << 0.0;
+            continue;
+        }
+        first = std::max<qint64>(first, 0);
+        last = std::min(last, size - 1);
+
+        int minValue = 127;
+        int maxValue = -127;
+        double squares = 0.0;
+        for (qint64 j = first; j <= last; ++j) {
+            minValue = std::min<int>(minValue, data[j].min);
+            maxValue = std::max<int>(maxValue, data[j].max);
+            squares += double(data[j].rms) * data[j].rms;
+        }
+        result << minValue / 127.0 << maxValue / 127.0 << std::sqrt(squares / double(last - first + 1)) / 255.0;
+    }
+    return result;
+}
+
+void AudioWaveformAnalyzer::setAnalyzing(bool analyzing)
+{
+    if (m_analyzing != analyzing) {
+        m_analyzing = analyzing;
+        emit analyzingChanged(m_analyzing);
+    }
+}
+
+void AudioWaveformAnalyzer::setProgress(double progress)
+{
+    if (!qFuzzyCompare(m_progress, progress)) {
+        m_progress = progress;
+        emit progressChanged(m_progress);
+    }
+}
+
+QString AudioWaveformAnalyzer::cacheFilePath(const QString& path)
+{
+    // 경로 + 크기 + 수정 시각이 같으면 같은 오디오로 본다
+    const QFileInfo info(path);
+    const QByteArray key = path.toUtf8() + '|' + QByteArray::number(info.size()) + '|'
+                           + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/waveforms";
+    return dir + '/' + QString::fromLatin1(QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex()) + ".peaks";
+}
+
+std::shared_ptr<AudioWaveformAnalyzer::Pyramid> AudioWaveformAnalyzer::loadCache(const QString& file)
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    QDataStream stream(&input);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 sampleRate = 0;
+    qint32 samplesPerBucket = 0;
+    qint64 sampleCount = 0;
+    quint32 bucketCount = 0;
+    stream >> magic >> version >> sampleRate >> samplesPerBucket >> sampleCount >> bucketCount;
+    if (stream.status() != QDataStream::Ok || magic != kCacheMagic || version != kCacheVersion
+        || sampleRate <= 0 || samplesPerBucket <= 0 || bucketCount == 0) {
+        return nullptr;
+    }
+
+    // 0단계만 저장되어 있고 위 단계는 다시 만든다
+    auto pyramid = std::make_shared<Pyramid>();
+    pyramid->sampleRate = sampleRate;
+    pyramid->samplesPerBucket = samplesPerBucket;
+    pyramid->sampleCount = sampleCount;
+    std::vector<Peak>& base = pyramid->levels.emplace_back(bucketCount);
+    const int bytes = int(bucketCount * sizeof(Peak));
+    if (stream.readRawData(reinterpret_cast<char*>(base.data()), bytes) != bytes) {
+        return nullptr;
+    }
+    buildLevels(*pyramid);
+    return pyramid;
+}
+
+void AudioWaveformAnalyzer::saveCache(const QString& file, const Pyramid& pyramid)
+{
+    QDir().mkpath(QFileInfo(file).absolutePath());
+    QSaveFile output(file);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qWarning() << "AudioWaveformAnalyzer: cannot write cache" << file;
+        return;
+    }
+
+    const std::vector<Peak>& base = pyramid.levels.front();
+    QDataStream stream(&output);
+    stream << kCacheMagic << kCacheVersion << qint32(pyramid.sampleRate) << qint32(pyramid.samplesPerBucket)
+           << qint64(pyramid.sampleCount) << quint32(base.size());
+    stream.writeRawData(reinterpret_cast<const char*>(base.data()), int(base.size() * sizeof(Peak)));
+    if (!output.commit()) {
+        qWarning() << "AudioWaveformAnalyzer: failed to save cache" << file;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef AUDIOWAVEFORMANALYZER_H
+#define AUDIOWAVEFORMANALYZER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QVariantList>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class MpvObject;
+
+// 오디오 파형 분석기
+// 파일이 열리면 별도 MPV 인스턴스(ao=pcm)로 오디오 트랙을 한 번만 빠르게 디코딩하면서
+// 최소/최대/RMS 피크 피라미드(밉맵)를 만든다. 재생용 MPV와 GUI 스레드는 기다리지 않는다.
+// - 0단계: 256샘플 묶음, 위 단계는 아래 단계 두 개씩 합침
+// - 타임라인은 peaks()로 화면 픽셀 수만큼만 읽으므로 확대 정도와 관계없이 비용이 일정
+// - 결과는 캐시 폴더(waveforms/)에 저장해 같은 파일을 다시 열면 바로 표시
+class AudioWaveformAnalyzer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool ready READ isReady NOTIFY peaksChanged)
+    Q_PROPERTY(bool analyzing READ isAnalyzing NOTIFY analyzingChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(double duration READ duration NOTIFY peaksChanged)
+
+public:
+    // 묶음 하나의 최소/최대(-127..127)와 RMS(0..255)
+    struct Peak {
+        qint8 min = 0;
+        qint8 max = 0;
+        quint8 rms = 0;
+    };
+
+    // levels[0]이 가장 촘촘하고 한 단계 올라갈 때마다 묶음 수가 절반
+    struct Pyramid {
+        int sampleRate = 0;
+        int samplesPerBucket = 0;
+        qint64 sampleCount = 0;
+        std::vector<std::vector<Peak>> levels;
+    };
+
+    explicit AudioWaveformAnalyzer(MpvObject* player);
+    ~AudioWaveformAnalyzer();
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    bool isReady() const { return m_pyramid != nullptr; }
+    bool isAnalyzing() const { return m_analyzing; }
+    double progress() const { return m_progress; }
+    double duration() const;
+
+    // [start, end) 초 구간을 count 칸으로 나눈 피크 [min, max, rms, min, max, rms, ...] (-1..1)
+    Q_INVOKABLE QVariantList peaks(double start, double end, int count) const;
+
+    // 재생 중인 파일 분석 시작 (fileLoaded에서 호출)
+    void analyzeCurrentFile();
+
+signals:
+    void enabledChanged(bool enabled);
+    void analyzingChanged(bool analyzing);
+    void progressChanged(double progress);
+    void peaksChanged();
+
+private:
+    struct Job {
+        QString path;
+        QString cacheFile;
+        double duration = 0.0;
+        std::atomic_bool cancel{false};
+    };
+
+    void run(const std::shared_ptr<Job>& job);
+    std::shared_ptr<Pyramid> decode(const std::shared_ptr<Job>& job);
+    void publish(const std::shared_ptr<Job>& job, std::shared_ptr<const Pyramid> pyramid);
+    void cancelJob();
+    void setAnalyzing(bool analyzing);
+    void setProgress(double progress);
+
+    static QString cacheFilePath(const QString& path);
+    static std::shared_ptr<Pyramid> loadCache(const QString& file);
+    static void saveCache(const QString& file, const Pyramid& pyramid);
+    static void buildLevels(Pyramid& pyramid);
+
+    MpvObject* m_player;
+    QThreadPool m_pool;
+    bool m_enabled = true;
+    bool m_analyzing = false;
+    double m_progress = 0.0;
+    std::shared_ptr<Job> m_job;
+    std::shared_ptr<const Pyramid> m_pyramid;
+};
+
+#endif // AUDIOWAVEFORMANALYZER_H
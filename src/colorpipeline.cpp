@@ -0,0 +1,653 @@
+#include "colorpipeline.h"
+#include "mpvobject.h"
+#include "mpvnode.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFloat16>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// 슬라이더 조작 중 셰이더 교체를 한 번으로 묶는 간격
+constexpr int kApplyDelayMs = 30;
+
+// LUT 격자 크기 제한 (3D 텍스처 크기)
+constexpr int kMinLutSize = 2;
+constexpr int kMaxLutSize = 129;
+
+// 노출 조정에 쓰는 표시 감마 (선형 빛에서 곱한 뒤 다시 인코딩)
+constexpr double kExposureGamma = 2.4;
+
+// 셰이더 파일과 LUT 텍스처가 공유하는 이름
+const char kLutTextureName[] = "COLOR_PIPELINE_LUT";
+
+// 셰이더 캐시 상위 폴더 - 프로세스마다 <pid> 하위 폴더를 사용
+QString shaderRootDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/color-pipeline";
+}
+
+const char kShaderDirLockName[] = "/.lock";
+
+QString glslFloat(double value)
+{
+    QString text = QString::number(value, 'g', 9);
+    if (!text.contains('.') && !text.contains('e') && !text.contains("inf") && !text.contains("nan")) {
+        text += ".0";
+    }
+    return text;
+}
+
+QString glslVec3(const QVector3D& v)
+{
+    return QString("vec3(%1, %2, %3)").arg(glslFloat(v.x()), glslFloat(v.y()), glslFloat(v.z()));
+}
+
+bool isOne(const QVector3D& v)
+{
+    return qFuzzyCompare(v.x(), 1.0f) && qFuzzyCompare(v.y(), 1.0f) && qFuzzyCompare(v.z(), 1.0f);
+}
+
+bool isZero(const QVector3D& v)
+{
+    return qFuzzyIsNull(v.x()) && qFuzzyIsNull(v.y()) && qFuzzyIsNull(v.z());
+}
+
+QString localPath(const QString& file)
+{
+    // QML에서 넘어오는 file:// URL을 로컬 경로로 변환
+    if (file.startsWith("file:", Qt::CaseInsensitive)) {
+        return QUrl(file).toLocalFile();
+    }
+    return file;
+}
+
+// 공백으로 구분된 숫자를 최대 count개 읽음 (읽은 개수 반환)
+int parseFloats(const char* text, float* values, int count)
+{
+    int parsed = 0;
+    while (parsed < count) {
+        char* end = nullptr;
+        const float value = std::strtof(text, &end);
+        if (end == text) {
+            break;
+        }
+        values[parsed++] = value;
+        text = end;
+    }
+    return parsed;
+}
+
+// 주석과 빈 줄을 건너뛰고 앞뒤 공백을 제거한 줄 목록
+QList<QByteArray> contentLines(const QString& path, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = QString("Cannot open %1").arg(path);
+        }
+        return {};
+    }
+
+    QList<QByteArray> lines;
+    const QByteArray data = file.readAll();
+    for (const QByteArray& raw : data.split('\n')) {
+        const QByteArray line = raw.trimmed();
+        if (!line.isEmpty() && !line.startsWith('#')) {
+            lines.append(line);
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+ColorPipeline::ColorPipeline(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    m_applyTimer.setSingleShot(true);
+    m_applyTimer.setInterval(kApplyDelayMs);
+    connect(&m_applyTimer, &QTimer::timeout, this, &ColorPipeline::apply);
+
+    // 프로세스별 셰이더 폴더 - 같은 PID로 남은 이전 파일은 이 프로세스 것이므로 비움
+    const QString root = shaderRootDirectory();
+    m_shaderDir = root + '/' + QString::number(QCoreApplication::applicationPid());
+    QDir(m_shaderDir).removeRecursively();
+    QDir().mkpath(m_shaderDir);
+    m_shaderDirLock = std::make_unique<QLockFile>(m_shaderDir + kShaderDirLockName);
+    m_shaderDirLock->setStaleLockTime(0);
+    if (!m_shaderDirLock->tryLock(0)) {
+        qWarning() << "ColorPipeline: cannot lock shader directory" << m_shaderDir;
+    }
+
+    // 비정상 종료한 실행이 남긴 폴더만 정리 (잠금을 얻을 수 있으면 주인 프로세스가 없음)
+    QDir rootDir(root);
+    for (const QString& name : rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString path = rootDir.filePath(name);
+        if (path == m_shaderDir) {
+            continue;
+        }
+        QLockFile lock(path + kShaderDirLockName);
+        lock.setStaleLockTime(0);
+        if (lock.tryLock(0)) {
+            lock.unlock();
+            QDir(path).removeRecursively();
+        }
+    }
+}
+
+ColorPipeline::~ColorPipeline()
+{
+    // MpvObject가 MPV를 먼저 종료하므로 셰이더 파일을 지워도 됨
+    if (m_shaderDirLock) {
+        m_shaderDirLock->unlock();
+    }
+    QDir(m_shaderDir).removeRecursively();
+}
+
+void ColorPipeline::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    emit enabledChanged(m_enabled);
+    scheduleApply();
+}
+
+void ColorPipeline::setExposure(double stops)
+{
+    if (qFuzzyCompare(m_exposure + 1.0, stops + 1.0)) {
+        return;
+    }
+    m_exposure = stops;
+    emit gradeChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setSlope(const QVector3D& slope)
+{
+    if (m_slope == slope) {
+        return;
+    }
+    m_slope = slope;
+    emit gradeChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setOffset(const QVector3D& offset)
+{
+    if (m_offset == offset) {
+        return;
+    }
+    m_offset = offset;
+    emit gradeChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setPower(const QVector3D& power)
+{
+    if (m_power == power) {
+        return;
+    }
+    m_power = power;
+    emit gradeChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setSaturation(double saturation)
+{
+    if (qFuzzyCompare(m_saturation, saturation)) {
+        return;
+    }
+    m_saturation = saturation;
+    emit gradeChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setChannel(int channel)
+{
+    channel = std::clamp(channel, int(AllChannels), int(LumaChannel));
+    if (m_channel == channel) {
+        return;
+    }
+    m_channel = channel;
+    emit viewChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::setFalseColor(bool enabled)
+{
+    if (m_falseColor == enabled) {
+        return;
+    }
+    m_falseColor = enabled;
+    emit viewChanged();
+    scheduleApply();
+}
+
+bool ColorPipeline::loadLut(const QString& file)
+{
+    const QString path = localPath(file);
+    Lut lut;
+    QString error;
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    bool ok = false;
+    if (suffix == "cube") {
+        ok = parseCube(path, lut, &error);
+    } else if (suffix == "3dl") {
+        ok = parse3dl(path, lut, &error);
+    } else {
+        error = QString("Unsupported LUT format: %1").arg(path);
+    }
+
+    if (!ok) {
+        qWarning() << "ColorPipeline:" << error;
+        setErrorString(error);
+        return false;
+    }
+
+    // 텍스처 블록(16비트 부동소수점, 16진수)은 LUT가 바뀔 때만 만들어 별도 파일로 둔다
+    QByteArray texture;
+    texture += QString("//!TEXTURE %1\n").arg(kLutTextureName).toUtf8();
+    texture += QString("//!SIZE %1 %1 %1\n").arg(lut.size).toUtf8();
+    texture += "//!FORMAT rgba16f\n";
+    texture += "//!FILTER LINEAR\n";
+    texture += "//!BORDER CLAMP\n";
+
+    const size_t texels = size_t(lut.size) * lut.size * lut.size;
+    std::vector<qfloat16> pixels(texels * 4);
+    for (size_t i = 0; i < texels; ++i) {
+        pixels[i * 4] = qfloat16(lut.data[i * 3]);
+        pixels[i * 4 + 1] = qfloat16(lut.data[i * 3 + 1]);
+        pixels[i * 4 + 2] = qfloat16(lut.data[i * 3 + 2]);
+        pixels[i * 4 + 3] = qfloat16(1.0f);
+    }
+    texture += QByteArray::fromRawData(reinterpret_cast<const char*>(pixels.data()),
+                                       int(pixels.size() * sizeof(qfloat16))).toHex();
+    texture += '\n';
+
+    m_lut = std::move(lut);
+    m_lutFile = path;
+    m_lutTexture = texture;
+    m_lutTextureFile.clear();
+    setErrorString(QString());
+    qDebug() << "ColorPipeline: loaded LUT" << path << "size" << m_lut.size;
+    emit lutChanged();
+    scheduleApply();
+    return true;
+}
+
+void ColorPipeline::clearLut()
+{
+    if (m_lutFile.isEmpty()) {
+        return;
+    }
+    m_lut = Lut();
+    m_lutFile.clear();
+    m_lutTexture.clear();
+    m_lutTextureFile.clear();
+    emit lutChanged();
+    scheduleApply();
+}
+
+void ColorPipeline::reset()
+{
+    m_exposure = 0.0;
+    m_slope = QVector3D(1, 1, 1);
+    m_offset = QVector3D(0, 0, 0);
+    m_power = QVector3D(1, 1, 1);
+    m_saturation = 1.0;
+    m_channel = AllChannels;
+    m_falseColor = false;
+    emit gradeChanged();
+    emit viewChanged();
+    clearLut();
+    scheduleApply();
+}
+
+bool ColorPipeline::parseCube(const QString& path, Lut& lut, QString* error)
+{
+    const QList<QByteArray> lines = contentLines(path, error);
+    if (lines.isEmpty()) {
+        if (error && error->isEmpty()) {
+            *error = QString("Empty LUT: %1").arg(path);
+        }
+        return false;
+    }
+
+    lut = Lut();
+    size_t expected = 0;
+    for (const QByteArray& line : lines) {
+        const char first = line.at(0);
+        const bool numeric = (first >= '0' && first <= '9') || first == '-' || first == '+' || first == '.';
+        if (!numeric) {
+            float values[3];
+            if (line.startsWith("LUT_3D_SIZE")) {
+                lut.size = line.mid(11).trimmed().toInt();
+                if (lut.size < kMinLutSize || lut.size > kMaxLutSize) {
+                    if (error) {
+                        *error = QString("Unsupported LUT_3D_SIZE %1 in %2").arg(lut.size).arg(path);
+                    }
+                    return false;
+                }
+                expected = size_t(lut.size) * lut.size * lut.size;
+                lut.data.reserve(expected * 3);
+            } else if (line.startsWith("LUT_1D_SIZE")) {
+                if (error) {
+                    *error = QString("1D LUTs are not supported: %1").arg(path);
+                }
+                return false;
+            } else if (line.startsWith("DOMAIN_MIN") && parseFloats(line.constData() + 10, values, 3) == 3) {
+                lut.domainMin = QVector3D(values[0], values[1], values[2]);
+            } else if (line.startsWith("DOMAIN_MAX") && parseFloats(line.constData() + 10, values, 3) == 3) {
+                lut.domainMax = QVector3D(values[0], values[1], values[2]);
+            } else if (line.startsWith("LUT_3D_INPUT_RANGE") && parseFloats(line.constData() + 18, values, 2) == 2) {
+                lut.domainMin = QVector3D(values[0], values[0], values[0]);
+                lut.domainMax = QVector3D(values[1], values[1], values[1]);
+            }
+            // TITLE 등 나머지 키워드는 무시
+            continue;
+        }
+
+        if (expected == 0) {
+            if (error) {
+                *error = QString("LUT data before LUT_3D_SIZE in %1").arg(path);
+            }
+            return false;
+        }
+        float rgb[3];
+        if (parseFloats(line.constData(), rgb, 3) != 3) {
+            if (error) {
+                *error = QString("Malformed LUT entry \"%1\" in %2").arg(QString::fromUtf8(line), path);
+            }
+            return false;
+        }
+        lut.data.insert(lut.data.end(), rgb, rgb + 3);
+    }
+
+    // .cube는 red가 가장 빠르게 변하는 순서 - 3D 텍스처(x=r, y=g, z=b)와 같음
+    if (expected == 0 || lut.data.size() != expected * 3) {
+        if (error) {
+            *error = QString("Expected %1 LUT entries, found %2 in %3")
+                         .arg(expected).arg(lut.data.size() / 3).arg(path);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool ColorPipeline::parse3dl(const QString& path, Lut& lut, QString* error)
+{
+    const QList<QByteArray> lines = contentLines(path, error);
+    if (lines.isEmpty()) {
+        if (error && error->isEmpty()) {
+            *error = QString("Empty LUT: %1").arg(path);
+        }
+        return false;
+    }
+
+    lut = Lut();
+    int outputBits = 0;
+    std::vector<long> entries;
+    for (const QByteArray& line : lines) {
+        const char first = line.at(0);
+        if (!(first >= '0' && first <= '9')) {
+            // "Mesh <입력 비트> <출력 비트>" 헤더 (3DMESH 등 나머지는 무시)
+            const QList<QByteArray> words = line.simplified().split(' ');
+            if (words.size() == 3 && words[0].compare("Mesh", Qt::CaseInsensitive) == 0) {
+                outputBits = words[2].toInt();
+            }
+            continue;
+        }
+
+        const QList<QByteArray> words = line.simplified().split(' ');
+        if (lut.size == 0) {
+            // 첫 숫자 줄은 입력 셰이퍼 - 값 개수가 격자 크기
+            lut.size = int(words.size());
+            if (lut.size < kMinLutSize || lut.size > kMaxLutSize) {
+                if (error) {
+                    *error = QString("Unsupported 3DL mesh size %1 in %2").arg(lut.size).arg(path);
+                }
+                return false;
+            }
+            entries.reserve(size_t(lut.size) * lut.size * lut.size * 3);
+            continue;
+        }
+        if (words.size() != 3) {
+            if (error) {
+                *error = QString("Malformed LUT entry \"%1\" in %2").arg(QString::fromUtf8(line), path);
+            }
+            return false;
+        }
+        for (const QByteArray& word : words) {
+            entries.push_back(word.toLong());
+        }
+    }
+
+    const size_t count = size_t(lut.size) * lut.size * lut.size;
+    if (lut.size == 0 || entries.size() != count * 3) {
+        if (error) {
+            *error = QString("Expected %1 LUT entries, found %2 in %3")
+                         .arg(count).arg(entries.size() / 3).arg(path);
+        }
+        return false;
+    }
+
+    // 출력 비트 수가 없으면 가장 큰 값으로 10/12/16비트 추정
+    double scale = 0.0;
+    if (outputBits > 0 && outputBits <= 16) {
+        scale = double((1 << outputBits) - 1);
+    } else {
+        const long maximum = *std::max_element(entries.begin(), entries.end());
+        scale = maximum <= 1023 ? 1023.0 : (maximum <= 4095 ? 4095.0 : 65535.0);
+    }
+
+    // .3dl은 blue가 가장 빠르게 변하는 순서 - red가 가장 빠른 텍스처 순서로 재배열
+    const int n = lut.size;
+    lut.data.resize(count * 3);
+    for (int r = 0; r < n; ++r) {
+        for (int g = 0; g < n; ++g) {
+            for (int b = 0; b < n; ++b) {
+                const size_t source = (size_t(r) * n + g) * n + b;
+                const size_t target = (size_t(b) * n + g) * n + r;
+                for (int c = 0; c < 3; ++c) {
+                    lut.data[target * 3 + c] = float(entries[source * 3 + c] / scale);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool ColorPipeline::isNeutral() const
+{
+    return qFuzzyIsNull(m_exposure) && isOne(m_slope) && isZero(m_offset) && isOne(m_power)
+        && qFuzzyCompare(m_saturation, 1.0) && m_lut.size == 0
+        && m_channel == AllChannels && !m_falseColor;
+}
+
+QByteArray ColorPipeline::buildShader() const
+{
+    // MAIN 훅: 크로마 합성과 RGB 변환 뒤, 확대/축소와 색 관리 전 (원본 해상도, 원본 감마)
+    // LUT와 CDL은 원본 인코딩 값을 기준으로 만들어지므로 여기서 적용
+    QString body;
+    body += "//!HOOK MAIN\n";
+    body += "//!BIND HOOKED\n";
+    if (m_lut.size > 0) {
+        body += QString("//!BIND %1\n").arg(kLutTextureName);
+    }
+    body += "//!DESC color pipeline\n\n";
+
+    if (m_falseColor) {
+        // 휘도 구간별 색 (0-100% 신호 기준)
+        body +=
+            "vec3 falseColor(float y)\n"
+            "{\n"
+            "    if (y < 0.02) return vec3(0.5, 0.0, 0.6);\n"   // 블랙 클리핑
+            "    if (y < 0.10) return vec3(0.0, 0.3, 1.0);\n"   // 깊은 그림자
+            "    if (y >= 0.99) return vec3(1.0, 0.0, 0.0);\n"  // 화이트 클리핑
+            "    if (y >= 0.97) return vec3(1.0, 1.0, 0.0);\n"  // 클리핑 직전
+            "    if (y >= 0.38 && y < 0.44) return vec3(0.0, 0.8, 0.2);\n" // 18% 그레이
+            "    if (y >= 0.52 && y < 0.58) return vec3(1.0, 0.5, 0.7);\n" // 밝은 피부
+            "    return vec3(y * 0.6);\n"
+            "}\n\n";
+    }
+
+    body += "vec4 hook()\n{\n";
+    body += "    vec4 color = HOOKED_texOff(0);\n";
+    body += "    vec3 rgb = color.rgb;\n";
+
+    if (!qFuzzyIsNull(m_exposure)) {
+        body += QString("    rgb = pow(pow(max(rgb, 0.0), vec3(%1)) * %2, vec3(%3));\n")
+                    .arg(glslFloat(kExposureGamma), glslFloat(std::exp2(m_exposure)),
+                         glslFloat(1.0 / kExposureGamma));
+    }
+
+    // ASC CDL: out = (in * slope + offset) ^ power, 이후 Rec.709 휘도 기준 채도
+    if (!isOne(m_slope) || !isZero(m_offset)) {
+        body += QString("    rgb = rgb * %1 + %2;\n").arg(glslVec3(m_slope), glslVec3(m_offset));
+    }
+    if (!isOne(m_power)) {
+        body += QString("    rgb = pow(max(rgb, 0.0), %1);\n").arg(glslVec3(m_power));
+    }
+    if (!qFuzzyCompare(m_saturation, 1.0)) {
+        body += "    float luma = dot(rgb, vec3(0.2126, 0.7152, 0.0722));\n";
+        body += QString("    rgb = vec3(luma) + %1 * (rgb - vec3(luma));\n").arg(glslFloat(m_saturation));
+    }
+
+    if (m_lut.size > 0) {
+        // 격자 끝점이 텍셀 중심에 오도록 좌표 보정
+        const double n = m_lut.size;
+        body += QString("    vec3 lutCoord = clamp((rgb - %1) / (%2 - %1), 0.0, 1.0);\n")
+                    .arg(glslVec3(m_lut.domainMin), glslVec3(m_lut.domainMax));
+        body += QString("    rgb = texture(%1, lutCoord * %2 + %3).rgb;\n")
+                    .arg(kLutTextureName, glslFloat((n - 1.0) / n), glslFloat(0.5 / n));
+    }
+
+    switch (m_channel) {
+    case RedChannel:
+        body += "    rgb = vec3(rgb.r);\n";
+        break;
+    case GreenChannel:
+        body += "    rgb = vec3(rgb.g);\n";
+        break;
+    case BlueChannel:
+        body += "    rgb = vec3(rgb.b);\n";
+        break;
+    case LumaChannel:
+        body += "    rgb = vec3(dot(rgb, vec3(0.2126, 0.7152, 0.0722)));\n";
+        break;
+    default:
+        break;
+    }
+
+    if (m_falseColor) {
+        body += "    rgb = falseColor(clamp(dot(rgb, vec3(0.2126, 0.7152, 0.0722)), 0.0, 1.0));\n";
+    }
+
+    body += "    color.rgb = rgb;\n";
+    body += "    return color;\n";
+    body += "}\n";
+    return body.toUtf8();
+}
+
+void ColorPipeline::scheduleApply()
+{
+    m_applyTimer.start();
+}
+
+QString ColorPipeline::writeShader(const QByteArray& source) const
+{
+    // MPV는 셰이더 파일을 경로로 캐시하므로 내용이 바뀌면 이름도 바뀌어야 함
+    const QString& dir = m_shaderDir;
+    const QString file = dir + '/'
+        + QString::fromLatin1(QCryptographicHash::hash(source, QCryptographicHash::Sha1).toHex()) + ".glsl";
+    if (QFileInfo::exists(file)) {
+        return file;
+    }
+
+    QDir().mkpath(dir);
+    QSaveFile output(file);
+    if (!output.open(QIODevice::WriteOnly) || output.write(source) != source.size() || !output.commit()) {
+        qWarning() << "ColorPipeline: cannot write shader" << file;
+        return QString();
+    }
+    return file;
+}
+
+void ColorPipeline::apply()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return;
+    }
+
+    QStringList files;
+    if (m_enabled && !isNeutral()) {
+        // LUT 텍스처는 별도 파일 (슬라이더를 움직일 때 수 MB를 다시 쓰지 않도록) - 텍스처는 모든 셰이더에서 BIND 가능
+        if (m_lut.size > 0) {
+            if (m_lutTextureFile.isEmpty() || !QFileInfo::exists(m_lutTextureFile)) {
+                m_lutTextureFile = writeShader(m_lutTexture);
+            }
+            files.append(m_lutTextureFile);
+        }
+        files.append(writeShader(buildShader()));
+        if (files.contains(QString())) {
+            setErrorString("Cannot write color pipeline shader");
+            files.clear();
+        }
+    }
+
+    // 사용자/설정 파일의 glsl-shaders는 유지하고 이 파이프라인의 이전 파일만 바꿈
+    QVariantList paths;
+    mpv_node current;
+    if (mpv_get_property(mpv, "glsl-shaders", MPV_FORMAT_NODE, &current) >= 0) {
+        for (const QVariant& path : mpvNodeToVariant(current).toList()) {
+            if (!m_shaderFiles.contains(path.toString())) {
+                paths.append(path);
+            }
+        }
+        mpv_free_node_contents(&current);
+    }
+    for (const QString& file : files) {
+        paths.append(file);
+    }
+    MpvNodeBuilder value(paths);
+    const int result = mpv_set_property(mpv, "glsl-shaders", MPV_FORMAT_NODE, value.node());
+    if (result < 0) {
+        qWarning() << "ColorPipeline: failed to set glsl-shaders:" << mpv_error_string(result);
+        setErrorString(QString("Failed to apply shaders: %1").arg(mpv_error_string(result)));
+        return;
+    }
+
+    // 더 이상 쓰지 않는 셰이더 파일 삭제 (LUT 텍스처처럼 큰 파일이 쌓이지 않게)
+    for (const QString& old : m_shaderFiles) {
+        if (!files.contains(old)) {
+            QFile::remove(old);
+        }
+    }
+    const bool wasActive = isActive();
+    m_shaderFiles = files;
+    if (wasActive != isActive()) {
+        emit activeChanged(isActive());
+    }
+}
+
+void ColorPipeline::setErrorString(const QString& error)
+{
+    if (m_errorString != error) {
+        m_errorString = error;
+        emit errorStringChanged(m_errorString);
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef COLORPIPELINE_H
+#define COLORPIPELINE_H
+
+#include <QLockFile>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector3D>
+#include <memory>
+#include <vector>
+
+class MpvObject;
+
+// GPU 색 보정 파이프라인 (노출, ASC CDL, 3D LUT, 채널 분리, 폴스 컬러)
+// vf/lavfi 필터 대신 MPV 렌더러의 사용자 셰이더(glsl-shaders) 한 패스로 처리한다.
+// - 하드웨어 디코딩 프레임을 CPU로 되돌리지 않으므로 4K에서도 프레임당 비용이 거의 없음
+// - 설정이 바뀌면 셰이더 파일을 새로 만들어 교체 (내용 해시를 파일 이름으로 사용 - MPV가 경로로 캐시)
+// - 모두 기본값이면 셰이더를 빼서 보정 없는 경로와 같은 비용
+// - 사용자가 지정한 glsl-shaders는 그대로 두고 뒤에 덧붙임 (자기 파일만 교체)
+// - 셰이더 파일은 프로세스별 캐시 폴더에 씀 (여러 실행이 서로의 파일을 지우지 않도록)
+// - LUT(.cube/.3dl)는 셰이더 안의 3D 텍스처로 넣음 (lut 옵션은 gpu-next 전용이라 libmpv 렌더 API에서 쓸 수 없음)
+class ColorPipeline : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(double exposure READ exposure WRITE setExposure NOTIFY gradeChanged)
+    Q_PROPERTY(QVector3D slope READ slope WRITE setSlope NOTIFY gradeChanged)
+    Q_PROPERTY(QVector3D offset READ offset WRITE setOffset NOTIFY gradeChanged)
+    Q_PROPERTY(QVector3D power READ power WRITE setPower NOTIFY gradeChanged)
+    Q_PROPERTY(double saturation READ saturation WRITE setSaturation NOTIFY gradeChanged)
+    Q_PROPERTY(QString lutFile READ lutFile NOTIFY lutChanged)
+    Q_PROPERTY(int lutSize READ lutSize NOTIFY lutChanged)
+    Q_PROPERTY(int channel READ channel WRITE setChannel NOTIFY viewChanged)
+    Q_PROPERTY(bool falseColor READ falseColor WRITE setFalseColor NOTIFY viewChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
+
+public:
+    // 채널 분리 보기
+    enum Channel {
+        AllChannels = 0,
+        RedChannel,
+        GreenChannel,
+        BlueChannel,
+        LumaChannel
+    };
+    Q_ENUM(Channel)
+
+    // 3D LUT (red가 가장 빠르게 변하는 순서, size^3개 RGB)
+    struct Lut {
+        int size = 0;
+        QVector3D domainMin = QVector3D(0, 0, 0);
+        QVector3D domainMax = QVector3D(1, 1, 1);
+        std::vector<float> data;
+    };
+
+    explicit ColorPipeline(MpvObject* player);
+    ~ColorPipeline();
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    double exposure() const { return m_exposure; }
+    void setExposure(double stops);
+    QVector3D slope() const { return m_slope; }
+    void setSlope(const QVector3D& slope);
+    QVector3D offset() const { return m_offset; }
+    void setOffset(const QVector3D& offset);
+    QVector3D power() const { return m_power; }
+    void setPower(const QVector3D& power);
+    double saturation() const { return m_saturation; }
+    void setSaturation(double saturation);
+
+    QString lutFile() const { return m_lutFile; }
+    int lutSize() const { return m_lut.size; }
+
+    int channel() const { return m_channel; }
+    void setChannel(int channel);
+    bool falseColor() const { return m_falseColor; }
+    void setFalseColor(bool enabled);
+
+    // 현재 셰이더가 적용되어 있는지
+    bool isActive() const { return !m_shaderFiles.isEmpty(); }
+    QString errorString() const { return m_errorString; }
+
+    // .cube / .3dl 파일 로드 (경로 또는 file:// URL)
+    Q_INVOKABLE bool loadLut(const QString& file);
+    Q_INVOKABLE void clearLut();
+    // 노출/CDL/LUT/보기 모드를 모두 기본값으로
+    Q_INVOKABLE void reset();
+
+    static bool parseCube(const QString& path, Lut& lut, QString* error);
+    static bool parse3dl(const QString& path, Lut& lut, QString* error);
+
+signals:
+    void enabledChanged(bool enabled);
+    void gradeChanged();
+    void lutChanged();
+    void viewChanged();
+    void activeChanged(bool active);
+    void errorStringChanged(const QString& error);
+
+private:
+    bool isNeutral() const;
+    QByteArray buildShader() const;
+    QString writeShader(const QByteArray& source) const;
+    void scheduleApply();
+    void apply();
+    void setErrorString(const QString& error);
+
+    MpvObject* m_player = nullptr;
+    QTimer m_applyTimer;
+
+    bool m_enabled = true;
+    double m_exposure = 0.0;
+    QVector3D m_slope = QVector3D(1, 1, 1);
+    QVector3D m_offset = QVector3D(0, 0, 0);
+    QVector3D m_power = QVector3D(1, 1, 1);
+    double m_saturation = 1.0;
+    int m_channel = AllChannels;
+    bool m_falseColor = false;
+
+    QString m_lutFile;
+    Lut m_lut;
+    // LUT 텍스처 블록은 LUT가 바뀔 때만 다시 인코딩
+    QByteArray m_lutTexture;
+    QString m_lutTextureFile;
+
+    // 이 프로세스의 셰이더 폴더 (잠금 파일로 사용 중 표시 - 종료된 프로세스의 폴더만 정리)
+    QString m_shaderDir;
+    std::unique_ptr<QLockFile> m_shaderDirLock;
+
+    // 현재 glsl-shaders에 들어 있는 이 파이프라인의 파일
+    QStringList m_shaderFiles;
+    QString m_errorString;
+};
+
+#endif // COLORPIPELINE_H
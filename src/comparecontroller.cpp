@@ -0,0 +1,569 @@
+#include "comparecontroller.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 잠금 루프 주기 (재생 중에만 동작)
+constexpr int kLockIntervalMs = 20;
+// 이 범위 안이면 같은 프레임으로 본다
+constexpr double kLockedFrames = 0.5;
+// 이보다 크게 벗어나면 해당 플레이어만 다시 시크
+constexpr double kResyncFrames = 6.0;
+// 재시크 시 시크 지연만큼 앞선 위치로 보낸다
+constexpr double kResyncLeadSec = 0.1;
+// 속도 보정 - 약 1초에 걸쳐 차이를 없애고 최대 ±5%까지만 조정
+constexpr double kCorrectionSec = 1.0;
+constexpr double kMaxSpeedNudge = 0.05;
+// 오프셋 통계를 QML에 알리는 간격 (틱 단위)
+constexpr int kStatsEveryTicks = 10;
+
+const mpv_node* findNode(const mpv_node& map, const char* key)
+{
+    if (map.format != MPV_FORMAT_NODE_MAP || !map.u.list) {
+        return nullptr;
+    }
+    for (int i = 0; i < map.u.list->num; ++i) {
+        if (std::strcmp(map.u.list->keys[i], key) == 0) {
+            return &map.u.list->values[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+CompareController::CompareController(QObject *parent)
+    : QObject(parent)
+{
+    m_lockTimer.setInterval(kLockIntervalMs);
+    m_lockTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_lockTimer, &QTimer::timeout, this, &CompareController::lockTick);
+}
+
+CompareController::~CompareController()
+{
+    m_lockTimer.stop();
+    if (m_mode == Difference) {
+        applyDifference(false);
+    }
+}
+
+void CompareController::setMode(int mode)
+{
+    mode = std::clamp(mode, int(Wipe), int(Difference));
+    if (m_mode == mode) {
+        return;
+    }
+
+    const bool wasPlaying = m_playing;
+    if (wasPlaying) {
+        pause();
+    }
+    if (m_mode == Difference) {
+        applyDifference(false);
+    }
+    m_mode = mode;
+    if (m_mode == Difference) {
+        applyDifference(true);
+    }
+    emit modeChanged(m_mode);
+
+    // 모드가 바뀌면 활성 플레이어가 달라지므로 다시 같은 프레임으로 맞춘다
+    seekToFrame(m_currentFrame);
+    if (wasPlaying) {
+        play();
+    }
+}
+
+void CompareController::setWipePosition(double position)
+{
+    position = std::clamp(position, 0.0, 1.0);
+    if (qFuzzyCompare(m_wipePosition, position)) {
+        return;
+    }
+    m_wipePosition = position;
+    emit wipePositionChanged(m_wipePosition);
+}
+
+int CompareController::totalFrames() const
+{
+    // 가장 짧은 클립 기준
+    int total = 0;
+    for (const Player& player : m_players) {
+        if (player.mpv && player.mpv->frameCount() > 0) {
+            const int frames = player.mpv->frameCount() - player.frameOffset;
+            total = total == 0 ? frames : std::min(total, frames);
+        }
+    }
+    return std::max(0, total);
+}
+
+double CompareController::fps() const
+{
+    return m_players.isEmpty() ? 24.0 : playerFps(m_players.first());
+}
+
+QVariantList CompareController::playerStats() const
+{
+    QVariantList stats;
+    for (int i = 0; i < m_players.size(); ++i) {
+        const Player& player = m_players[i];
+        QVariantMap entry;
+        entry["index"] = i;
+        entry["drift"] = player.drift;
+        entry["speed"] = player.speed;
+        entry["seeking"] = player.seeking;
+        entry["resyncs"] = player.resyncs;
+        entry["frameOffset"] = player.frameOffset;
+        stats.append(entry);
+    }
+    return stats;
+}
+
+void CompareController::addPlayer(QObject* object, int frameOffset)
+{
+    MpvObject* mpv = qobject_cast<MpvObject*>(object);
+    if (!mpv) {
+        qWarning() << "CompareController: not an MpvObject" << object;
+        return;
+    }
+    for (const Player& player : m_players) {
+        if (player.mpv == mpv) {
+            return;
+        }
+    }
+
+    Player player;
+    player.mpv = mpv;
+    player.frameOffset = frameOffset;
+    m_players.append(player);
+
+    connect(mpv, &MpvObject::playbackRestarted, this, [this, mpv]() { onPlayerRestarted(mpv); });
+    connect(mpv, &MpvObject::fileLoaded, this, [this, mpv]() {
+        emit playersChanged();
+        // 새로 불러온 클립도 현재 프레임에 맞춘다 (재생 중이면 전체를 다시 맞춰 함께 시작)
+        if (m_playing) {
+            seekToFrame(int(std::floor(masterFrame())));
+            return;
+        }
+        for (Player& player : m_players) {
+            if (player.mpv == mpv) {
+                setPlayerPause(player, true);
+                seekPlayer(player, m_currentFrame);
+            }
+        }
+    });
+    connect(mpv, &MpvObject::frameCountChanged, this, &CompareController::playersChanged);
+    connect(mpv, &QObject::destroyed, this, [this]() {
+        m_players.erase(std::remove_if(m_players.begin(), m_players.end(),
+                                       [](const Player& player) { return player.mpv.isNull(); }),
+                        m_players.end());
+        emit playersChanged();
+    });
+
+    // 소리는 첫 플레이어만
+    mpv->setProperty("mute", m_players.size() > 1);
+    setPlayerPause(m_players.last(), true);
+    emit playersChanged();
+}
+
+void CompareController::removePlayer(QObject* object)
+{
+    for (int i = 0; i < m_players.size(); ++i) {
+        if (m_players[i].mpv == object) {
+            if (m_mode == Difference && i <= 1) {
+                applyDifference(false);
+            }
+            disconnect(m_players[i].mpv, nullptr, this, nullptr);
+            setPlayerSpeed(m_players[i], 1.0);
+            m_players.removeAt(i);
+            if (!m_players.isEmpty() && m_players.first().mpv) {
+                m_players.first().mpv->setProperty("mute", false);
+            }
+            if (m_mode == Difference) {
+                applyDifference(true);
+            }
+            emit playersChanged();
+            return;
+        }
+    }
+}
+
+void CompareController::clearPlayers()
+{
+    pause();
+    if (m_mode == Difference) {
+        applyDifference(false);
+    }
+    for (Player& player : m_players) {
+        if (player.mpv) {
+            disconnect(player.mpv, nullptr, this, nullptr);
+            setPlayerSpeed(player, 1.0);
+        }
+    }
+    m_players.clear();
+    emit playersChanged();
+}
+
+void CompareController::setFrameOffset(int index, int frameOffset)
+{
+    if (index < 0 || index >= m_players.size()) {
+        return;
+    }
+    m_players[index].frameOffset = frameOffset;
+    emit playersChanged();
+    seekToFrame(m_currentFrame);
+}
+
+void CompareController::play()
+{
+    if (m_players.isEmpty() || m_playing) {
+        return;
+    }
+    const int total = totalFrames();
+    if (total > 0 && m_currentFrame >= total - 1) {
+        m_currentFrame = 0;
+        emit currentFrameChanged(m_currentFrame);
+    }
+
+    m_playing = true;
+    emit playingChanged(true);
+
+    // 모두 같은 프레임에 정확히 시크한 뒤 준비되면 함께 재생 시작
+    m_startWhenReady = true;
+    for (Player& player : m_players) {
+        setPlayerPause(player, true);
+        seekPlayer(player, m_currentFrame);
+    }
+}
+
+void CompareController::pause()
+{
+    if (!m_playing) {
+        return;
+    }
+    // 마스터 프레임에서 정확히 멈춘다
+    const int frame = int(std::floor(masterFrame()));
+    m_lockTimer.stop();
+    m_startWhenReady = false;
+    m_playing = false;
+
+    for (Player& player : m_players) {
+        setPlayerPause(player, true);
+        setPlayerSpeed(player, 1.0);
+    }
+    emit playingChanged(false);
+    seekToFrame(frame);
+}
+
+void CompareController::togglePlay()
+{
+    if (m_playing) {
+        pause();
+    } else {
+        play();
+    }
+}
+
+void CompareController::seekToFrame(int frame)
+{
+    const int total = totalFrames();
+    frame = std::max(0, total > 0 ? std::min(frame, total - 1) : frame);
+
+    if (m_currentFrame != frame) {
+        m_currentFrame = frame;
+        emit currentFrameChanged(m_currentFrame);
+    }
+    m_peakOffsetFrames = 0.0;
+
+    if (m_playing) {
+        // 재생 중 시크는 전부 멈추고 맞춘 다음 다시 함께 시작
+        m_lockTimer.stop();
+        m_startWhenReady = true;
+        for (Player& player : m_players) {
+            setPlayerPause(player, true);
+        }
+    }
+    for (Player& player : m_players) {
+        seekPlayer(player, frame);
+    }
+}
+
+void CompareController::stepFrames(int delta)
+{
+    if (m_playing) {
+        pause();
+    }
+    seekToFrame(m_currentFrame + delta);
+}
+
+double CompareController::playerFps(const Player& player) const
+{
+    if (!player.mpv) {
+        return 24.0;
+    }
+    if (player.mpv->fps() > 0) {
+        return player.mpv->fps();
+    }
+    double fps = 0.0;
+    if (mpv_handle* handle = player.mpv->handle()) {
+        mpv_get_property(handle, "container-fps", MPV_FORMAT_DOUBLE, &fps);
+    }
+    return fps > 0 ? fps : 24.0;
+}
+
+double CompareController::playerFrame(const Player& player) const
+{
+    double position = 0.0;
+    if (player.mpv && player.mpv->handle()) {
+        mpv_get_property(player.mpv->handle(), "time-pos", MPV_FORMAT_DOUBLE, &position);
+    }
+    return position * playerFps(player) - player.frameOffset;
+}
+
+double CompareController::masterFrame() const
+{
+    if (!m_playing || m_startWhenReady || !m_clock.isValid()) {
+        return m_currentFrame;
+    }
+    return m_anchorFrame + m_clock.nsecsElapsed() / 1e9 * fps();
+}
+
+int CompareController::activePlayerCount() const
+{
+    // 차이 모드에서는 첫 플레이어가 두 클립을 함께 디코딩한다
+    return m_mode == Difference ? std::min<int>(1, m_players.size()) : m_players.size();
+}
+
+void CompareController::seekPlayer(Player& player, double frame)
+{
+    mpv_handle* handle = player.mpv ? player.mpv->handle() : nullptr;
+    if (!handle) {
+        return;
+    }
+    const double fps = playerFps(player);
+    const double position = std::max(0.0, (frame + player.frameOffset) / fps);
+    const QByteArray target = QByteArray::number(position, 'f', 6);
+    const char* cmd[] = {"seek", target.constData(), "absolute+exact", nullptr};
+    player.mpv->ensureForwardPlayback();
+    if (mpv_command_async(handle, 0, cmd) >= 0) {
+        player.seeking = true;
+    }
+}
+
+void CompareController::setPlayerPause(Player& player, bool pause)
+{
+    if (mpv_handle* handle = player.mpv ? player.mpv->handle() : nullptr) {
+        int flag = pause ? 1 : 0;
+        mpv_set_property(handle, "pause", MPV_FORMAT_FLAG, &flag);
+    }
+}
+
+void CompareController::setPlayerSpeed(Player& player, double speed)
+{
+    if (std::abs(player.speed - speed) < 0.001) {
+        return;
+    }
+    player.speed = speed;
+    if (mpv_handle* handle = player.mpv ? player.mpv->handle() : nullptr) {
+        mpv_set_property(handle, "speed", MPV_FORMAT_DOUBLE, &speed);
+    }
+}
+
+void CompareController::onPlayerRestarted(MpvObject* mpv)
+{
+    for (Player& player : m_players) {
+        if (player.mpv == mpv) {
+            player.seeking = false;
+        }
+    }
+    if (!m_startWhenReady) {
+        return;
+    }
+    for (int i = 0; i < activePlayerCount(); ++i) {
+        if (m_players[i].seeking) {
+            return;
+        }
+    }
+    startClock();
+}
+
+void CompareController::startClock()
+{
+    m_startWhenReady = false;
+    m_anchorFrame = m_currentFrame;
+    m_peakOffsetFrames = 0.0;
+
+    // 준비된 플레이어들을 한 번에 재생 (남은 차이는 잠금 루프가 보정)
+    for (int i = 0; i < activePlayerCount(); ++i) {
+        setPlayerSpeed(m_players[i], 1.0);
+        setPlayerPause(m_players[i], false);
+    }
+    m_clock.start();
+    m_lockTimer.start();
+}
+
+void CompareController::lockTick()
+{
+    if (!m_playing || m_startWhenReady) {
+        return;
+    }
+    const int active = activePlayerCount();
+    if (active == 0) {
+        return;
+    }
+
+    const double fps = this->fps();
+    double master = masterFrame();
+
+    double minDrift = 0.0;
+    double maxDrift = 0.0;
+    bool haveDrift = false;
+    for (int i = 0; i < active; ++i) {
+        Player& player = m_players[i];
+        if (player.seeking) {
+            continue;
+        }
+        player.drift = playerFrame(player) - master;
+        minDrift = haveDrift ? std::min(minDrift, player.drift) : player.drift;
+        maxDrift = haveDrift ? std::max(maxDrift, player.drift) : player.drift;
+        haveDrift = true;
+    }
+
+    if (haveDrift) {
+        // 모든 플레이어가 같은 방향으로 밀렸으면 (디스크 대기 등) 플레이어가 아니라 마스터 시계를 옮긴다
+        double shift = 0.0;
+        if (maxDrift < -kLockedFrames) {
+            shift = maxDrift;
+        } else if (minDrift > kLockedFrames) {
+            shift = minDrift;
+        }
+        if (shift != 0.0) {
+            m_anchorFrame += shift;
+            master += shift;
+            minDrift -= shift;
+            maxDrift -= shift;
+        }
+
+        for (int i = 0; i < active; ++i) {
+            Player& player = m_players[i];
+            if (player.seeking) {
+                continue;
+            }
+            player.drift -= shift;
+            const double drift = player.drift;
+            if (std::abs(drift) > kResyncFrames) {
+                // 이 플레이어만 다시 시크 - 나머지는 계속 재생
+                setPlayerSpeed(player, 1.0);
+                seekPlayer(player, master + kResyncLeadSec * fps);
+                ++player.resyncs;
+                qDebug() << "CompareController: resync player" << i << "drift" << drift << "frames";
+            } else if (std::abs(drift) > kLockedFrames) {
+                const double nudge = std::clamp(drift / (fps * kCorrectionSec), -kMaxSpeedNudge, kMaxSpeedNudge);
+                setPlayerSpeed(player, 1.0 - nudge);
+            } else {
+                setPlayerSpeed(player, 1.0);
+            }
+        }
+
+        m_maxOffsetFrames = maxDrift - minDrift;
+        m_peakOffsetFrames = std::max(m_peakOffsetFrames, m_maxOffsetFrames);
+    }
+
+    if (++m_tickCount % kStatsEveryTicks == 0) {
+        emit offsetChanged();
+    }
+
+    const int total = totalFrames();
+    const int frame = std::max(0, int(std::floor(master)));
+    if (total > 0 && frame >= total - 1) {
+        // 가장 짧은 클립 끝에서 함께 멈춤
+        m_currentFrame = total - 1;
+        emit currentFrameChanged(m_currentFrame);
+        m_clock.invalidate();
+        pause();
+        return;
+    }
+    if (frame != m_currentFrame) {
+        m_currentFrame = frame;
+        emit currentFrameChanged(m_currentFrame);
+    }
+}
+
+void CompareController::applyDifference(bool enable)
+{
+    if (m_players.size() < 2 || !m_players[0].mpv || !m_players[1].mpv) {
+        return;
+    }
+    mpv_handle* main = m_players[0].mpv->handle();
+    mpv_handle* other = m_players[1].mpv->handle();
+    if (!main || !other) {
+        return;
+    }
+
+    if (!enable) {
+        if (m_differenceTrack < 0) {
+            return;
+        }
+        mpv_set_property_string(main, "lavfi-complex", "");
+        const QByteArray track = QByteArray::number(m_differenceTrack);
+        const char* removeCmd[] = {"video-remove", track.constData(), nullptr};
+        mpv_command(main, removeCmd);
+        if (m_differenceMainTrack >= 0) {
+            mpv_set_property(main, "vid", MPV_FORMAT_INT64, &m_differenceMainTrack);
+        }
+        m_differenceTrack = -1;
+        m_differenceMainTrack = -1;
+        return;
+    }
+
+    char* rawPath = mpv_get_property_string(other, "path");
+    if (!rawPath) {
+        return;
+    }
+    const QByteArray path(rawPath);
+    mpv_free(rawPath);
+
+    // B 클립을 첫 플레이어의 외부 비디오 트랙으로 추가 - 같은 디먹서 시계로 움직이므로 프레임이 어긋나지 않는다
+    mpv_get_property(main, "vid", MPV_FORMAT_INT64, &m_differenceMainTrack);
+    const char* addCmd[] = {"video-add", path.constData(), "auto", nullptr};
+    if (mpv_command(main, addCmd) < 0) {
+        qWarning() << "CompareController: failed to add difference track" << path;
+        return;
+    }
+
+    mpv_node tracks;
+    if (mpv_get_property(main, "track-list", MPV_FORMAT_NODE, &tracks) >= 0) {
+        if (tracks.format == MPV_FORMAT_NODE_ARRAY) {
+            for (int i = 0; i < tracks.u.list->num; ++i) {
+                const mpv_node& entry = tracks.u.list->values[i];
+                const mpv_node* type = findNode(entry, "type");
+                const mpv_node* file = findNode(entry, "external-filename");
+                const mpv_node* id = findNode(entry, "id");
+                if (type && type->format == MPV_FORMAT_STRING && std::strcmp(type->u.string, "video") == 0
+                    && file && file->format == MPV_FORMAT_STRING && path == file->u.string
+                    && id && id->format == MPV_FORMAT_INT64) {
+                    m_differenceTrack = id->u.int64;
+                }
+            }
+        }
+        mpv_free_node_contents(&tracks);
+    }
+    if (m_differenceTrack < 0 || m_differenceMainTrack < 0) {
+        qWarning() << "CompareController: difference track not found";
+        return;
+    }
+
+    // B를 A 크기에 맞춘 뒤 절대 차이
+    const QByteArray graph = QString("[vid%1][vid%2]scale2ref[b][a];[a][b]blend=all_mode=difference[vo]")
+        .arg(m_differenceTrack).arg(m_differenceMainTrack).toUtf8();
+    if (mpv_set_property_string(main, "lavfi-complex", graph.constData()) < 0) {
+        qWarning() << "CompareController: failed to set difference graph";
+    }
+    for (int i = 1; i < m_players.size(); ++i) {
+        setPlayerPause(m_players[i], true);
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef COMPARECONTROLLER_H
+#define COMPARECONTROLLER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantList>
+#include "mpvobject.h"
+
+// 여러 클립 A/B 비교 컨트롤러
+// N개의 MpvObject를 하나의 마스터 시계로 구동한다. 시크/프레임 이동은 모든 플레이어에 같은 프레임으로
+// 정확(exact) 시크한 뒤 전부 준비되면 함께 재생을 시작한다.
+// 재생 중에는 각 플레이어의 위치를 마스터 프레임과 비교해 작은 차이는 재생 속도 미세 조정으로,
+// 큰 차이는 해당 플레이어만 다시 시크해 맞춘다 (다른 플레이어는 멈추지 않음).
+class CompareController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int playerCount READ playerCount NOTIFY playersChanged)
+    Q_PROPERTY(int mode READ mode WRITE setMode NOTIFY modeChanged)
+    Q_PROPERTY(double wipePosition READ wipePosition WRITE setWipePosition NOTIFY wipePositionChanged)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY playingChanged)
+    Q_PROPERTY(int currentFrame READ currentFrame NOTIFY currentFrameChanged)
+    Q_PROPERTY(int totalFrames READ totalFrames NOTIFY playersChanged)
+    Q_PROPERTY(double fps READ fps NOTIFY playersChanged)
+    Q_PROPERTY(double maxOffsetFrames READ maxOffsetFrames NOTIFY offsetChanged)
+    Q_PROPERTY(double peakOffsetFrames READ peakOffsetFrames NOTIFY offsetChanged)
+    Q_PROPERTY(QVariantList playerStats READ playerStats NOTIFY offsetChanged)
+
+public:
+    enum Mode {
+        Wipe = 0,
+        SideBySide = 1,
+        Difference = 2
+    };
+    Q_ENUM(Mode)
+
+    explicit CompareController(QObject *parent = nullptr);
+    ~CompareController();
+
+    int playerCount() const { return m_players.size(); }
+    int mode() const { return m_mode; }
+    void setMode(int mode);
+    double wipePosition() const { return m_wipePosition; }
+    void setWipePosition(double position);
+    bool isPlaying() const { return m_playing; }
+    int currentFrame() const { return m_currentFrame; }
+    int totalFrames() const;
+    double fps() const;
+
+    // 현재 플레이어 간 최대 프레임 차이, 재생/시크 이후 최대값
+    double maxOffsetFrames() const { return m_maxOffsetFrames; }
+    double peakOffsetFrames() const { return m_peakOffsetFrames; }
+    QVariantList playerStats() const;
+
+    // 플레이어 등록 - frameOffset만큼 앞선 프레임을 같은 위치로 맞춘다 (핸들 싱크용)
+    Q_INVOKABLE void addPlayer(QObject* player, int frameOffset = 0);
+    Q_INVOKABLE void removePlayer(QObject* player);
+    Q_INVOKABLE void clearPlayers();
+    Q_INVOKABLE void setFrameOffset(int index, int frameOffset);
+
+    Q_INVOKABLE void play();
+    Q_INVOKABLE void pause();
+    Q_INVOKABLE void togglePlay();
+    Q_INVOKABLE void seekToFrame(int frame);
+    Q_INVOKABLE void stepFrames(int delta);
+
+signals:
+    void playersChanged();
+    void modeChanged(int mode);
+    void wipePositionChanged(double position);
+    void playingChanged(bool playing);
+    void currentFrameChanged(int frame);
+    void offsetChanged();
+
+private slots:
+    void lockTick();
+
+private:
+    struct Player {
+        QPointer<MpvObject> mpv;
+        int frameOffset = 0;
+        bool seeking = false;
+        double speed = 1.0;
+        double drift = 0.0;   // 마스터 대비 프레임 차이 (+ = 앞섬)
+        qint64 resyncs = 0;
+    };
+
+    double playerFps(const Player& player) const;
+    double playerFrame(const Player& player) const;
+    double masterFrame() const;
+    void seekPlayer(Player& player, double frame);
+    void setPlayerPause(Player& player, bool pause);
+    void setPlayerSpeed(Player& player, double speed);
+    void onPlayerRestarted(MpvObject* mpv);
+    void startClock();
+    void applyDifference(bool enable);
+    int activePlayerCount() const;
+
+    QList<Player> m_players;
+    int m_mode = Wipe;
+    double m_wipePosition = 0.5;
+    bool m_playing = false;
+    bool m_startWhenReady = false;
+    int m_currentFrame = 0;
+
+    // 마스터 시계 - 재생 시작 프레임 + 경과 시간
+    QElapsedTimer m_clock;
+    double m_anchorFrame = 0.0;
+    QTimer m_lockTimer;
+    int m_tickCount = 0;
+
+    double m_maxOffsetFrames = 0.0;
+    double m_peakOffsetFrames = 0.0;
+
+    // 차이 모드에서 첫 플레이어에 추가한 외부 비디오 트랙
+    int64_t m_differenceTrack = -1;
+    int64_t m_differenceMainTrack = -1;
+};
+
+#endif // COMPARECONTROLLER_H
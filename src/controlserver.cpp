@@ -0,0 +1,549 @@
+#include "controlserver.h"
+#include "mpvobject.h"
+#include "mpvnode.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 다른 모듈의 비동기 명령(userdata 0)과 구분하기 위한 표시 비트
+constexpr quint64 kReplyTag = quint64(1) << 62;
+// 완료 대기 제한 - 시크/명령은 짧게, 파일 열기는 네트워크 경로를 고려해 길게
+constexpr int kAwaitTimeoutMs = 5000;
+constexpr int kLoadTimeoutMs = 15000;
+constexpr int kAwaitCheckIntervalMs = 100;
+// 다른 시크에 밀려 목표 프레임에 닿지 못했을 때 다시 보내는 횟수 (그 뒤로는 실제 프레임으로 응답)
+constexpr int kMaxSeekRetries = 1;
+// 한 줄 최대 크기 (잘못된 클라이언트가 메모리를 계속 쓰지 않도록)
+constexpr int kMaxLineBytes = 16 * 1024 * 1024;
+
+QJsonObject ok(const QJsonValue& data = QJsonValue())
+{
+    QJsonObject result;
+    result["ok"] = true;
+    if (!data.isUndefined() && !data.isNull()) {
+        result["data"] = data;
+    }
+    return result;
+}
+
+QJsonObject fail(const QString& error)
+{
+    QJsonObject result;
+    result["ok"] = false;
+    result["error"] = error;
+    return result;
+}
+
+} // namespace
+
+ControlServer::ControlServer(QObject *parent)
+    : QObject(parent)
+{
+    m_awaitTimer.setInterval(kAwaitCheckIntervalMs);
+    connect(&m_awaitTimer, &QTimer::timeout, this, &ControlServer::onAwaitTimeout);
+}
+
+ControlServer::~ControlServer()
+{
+    if (m_server) {
+        m_server->close();
+    }
+}
+
+QString ControlServer::defaultServerName()
+{
+    QString user = qEnvironmentVariable("USERNAME");
+    if (user.isEmpty()) {
+        user = qEnvironmentVariable("USER");
+    }
+    const QByteArray hash = QCryptographicHash::hash(user.toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+    return QStringLiteral("HyperPlayer-control-") + QString::fromLatin1(hash);
+}
+
+bool ControlServer::isListening() const
+{
+    return m_server && m_server->isListening();
+}
+
+QString ControlServer::serverName() const
+{
+    return m_server ? m_server->fullServerName() : QString();
+}
+
+bool ControlServer::listen(const QString& name)
+{
+    if (m_server) {
+        return m_server->isListening();
+    }
+
+    const QString serverName = name.isEmpty() ? defaultServerName() : name;
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+
+    if (!m_server->listen(serverName)) {
+        // 비정상 종료로 남은 소켓 파일이면 지우고 한 번 더 시도
+        if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+            QLocalSocket probe;
+            probe.connectToServer(serverName);
+            if (!probe.waitForConnected(100)) {
+                QLocalServer::removeServer(serverName);
+                m_server->listen(serverName);
+            }
+        }
+    }
+
+    if (!m_server->isListening()) {
+        qWarning() << "ControlServer: failed to listen on" << serverName << ":" << m_server->errorString();
+        delete m_server;
+        m_server = nullptr;
+        return false;
+    }
+
+    qDebug() << "ControlServer: listening on" << m_server->fullServerName();
+    emit listeningChanged();
+    return true;
+}
+
+void ControlServer::connectMpv(MpvObject* mpv)
+{
+    if (m_mpv == mpv) {
+        return;
+    }
+    if (m_mpv) {
+        disconnect(m_mpv, nullptr, this, nullptr);
+    }
+    m_mpv = mpv;
+    if (!m_mpv) {
+        return;
+    }
+
+    connect(m_mpv, &MpvObject::commandReply, this, &ControlServer::onCommandReply);
+    connect(m_mpv, &MpvObject::playbackRestarted, this, &ControlServer::onRestarted);
+    connect(m_mpv, &MpvObject::fileLoaded, this, &ControlServer::onFileLoaded);
+
+    // 구독 이벤트
+    connect(m_mpv, &MpvObject::positionChanged, this, [this](double position) {
+        emitEvent("position", position);
+        const int frame = int(std::floor(position * currentFps() + 0.5));
+        if (frame != m_lastEventFrame) {
+            m_lastEventFrame = frame;
+            emitEvent("frame", frame);
+        }
+    });
+    connect(m_mpv, &MpvObject::pauseChanged, this, [this](bool paused) {
+        emitEvent("pause", paused);
+    });
+    connect(m_mpv, &MpvObject::endReached, this, [this]() {
+        emitEvent("end", currentFrame());
+    });
+}
+
+void ControlServer::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        Client client;
+        client.socket = socket;
+        m_clients.insert(socket, client);
+
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        // 쓰기 도중 끊겨도 처리 중인 Client 참조가 무효화되지 않도록 이벤트 루프에서 정리
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() { onDisconnected(socket); },
+                Qt::QueuedConnection);
+        emit clientsChanged();
+    }
+}
+
+void ControlServer::onDisconnected(QLocalSocket* socket)
+{
+    if (m_clients.remove(socket) > 0) {
+        emit clientsChanged();
+    }
+    socket->deleteLater();
+}
+
+void ControlServer::onReadyRead(QLocalSocket* socket)
+{
+    auto it = m_clients.find(socket);
+    if (it == m_clients.end()) {
+        return;
+    }
+    Client& client = it.value();
+    client.buffer += socket->readAll();
+
+    int start = 0;
+    int end;
+    while ((end = client.buffer.indexOf('\n', start)) >= 0) {
+        const QByteArray line = client.buffer.mid(start, end - start).trimmed();
+        start = end + 1;
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (!document.isObject()) {
+            QJsonObject reply = fail(QString("invalid JSON: %1").arg(error.errorString()));
+            send(client, reply);
+            continue;
+        }
+
+        const QJsonObject request = document.object();
+        Job job;
+        job.id = request.value("id");
+        if (request.contains("batch")) {
+            job.batch = true;
+            job.items = request.value("batch").toArray();
+        } else {
+            job.items.append(request);
+        }
+        client.queue.append(job);
+    }
+    client.buffer.remove(0, start);
+
+    if (client.buffer.size() > kMaxLineBytes) {
+        qWarning() << "ControlServer: request line too long, closing client";
+        client.buffer.clear();
+        socket->disconnectFromServer();
+        return;
+    }
+
+    runQueue(client);
+}
+
+void ControlServer::runQueue(Client& client)
+{
+    while (client.waiting == Await::None && !client.queue.isEmpty()) {
+        Job& job = client.queue.first();
+        if (job.index >= job.items.size()) {
+            finishJob(client);
+            continue;
+        }
+
+        Await await = Await::None;
+        const QJsonObject result = execute(client, job.items.at(job.index).toObject(), await);
+        if (await != Await::None) {
+            // 완료 신호가 올 때까지 이 연결의 나머지 명령은 대기 (배치 안 순서 보장)
+            client.waiting = await;
+            client.deadline.setRemainingTime(await == Await::FileLoaded ? kLoadTimeoutMs : kAwaitTimeoutMs);
+            if (!m_awaitTimer.isActive()) {
+                m_awaitTimer.start();
+            }
+            return;
+        }
+
+        job.results.append(result);
+        ++job.index;
+    }
+}
+
+void ControlServer::completeAwait(Client& client, const QJsonObject& result)
+{
+    if (client.waiting == Await::None || client.queue.isEmpty()) {
+        return;
+    }
+    client.waiting = Await::None;
+    client.replyId = 0;
+    client.seekTarget = -1;
+    client.seekAccepted = false;
+    client.seekRetries = 0;
+
+    Job& job = client.queue.first();
+    job.results.append(result);
+    ++job.index;
+    runQueue(client);
+}
+
+void ControlServer::finishJob(Client& client)
+{
+    const Job job = client.queue.takeFirst();
+
+    QJsonObject reply;
+    if (job.batch) {
+        reply["results"] = job.results;
+    } else if (!job.results.isEmpty()) {
+        reply = job.results.first().toObject();
+    }
+    if (!job.id.isUndefined()) {
+        reply["id"] = job.id;
+    }
+    send(client, reply);
+}
+
+QJsonObject ControlServer::execute(Client& client, const QJsonObject& item, Await& await)
+{
+    const QString cmd = item.value("cmd").toString();
+
+    if (cmd == "ping") {
+        return ok("pong");
+    }
+
+    if (cmd == "subscribe" || cmd == "unsubscribe") {
+        for (const QJsonValue& value : item.value("events").toArray()) {
+            if (cmd == "subscribe") {
+                client.subscriptions.insert(value.toString());
+            } else {
+                client.subscriptions.remove(value.toString());
+            }
+        }
+        return ok(QJsonArray::fromStringList(QStringList(client.subscriptions.begin(), client.subscriptions.end())));
+    }
+
+    if (!m_mpv || !m_mpv->handle()) {
+        return fail("player not ready");
+    }
+    mpv_handle* handle = m_mpv->handle();
+
+    if (cmd == "get") {
+        const QByteArray name = item.value("name").toString().toUtf8();
+        mpv_node node;
+        const int error = mpv_get_property(handle, name.constData(), MPV_FORMAT_NODE, &node);
+        if (error < 0) {
+            return fail(QString::fromUtf8(mpv_error_string(error)));
+        }
+        const QVariant value = mpvNodeToVariant(node);
+        mpv_free_node_contents(&node);
+        return ok(QJsonValue::fromVariant(value));
+    }
+
+    if (cmd == "set") {
+        const QByteArray name = item.value("name").toString().toUtf8();
+        MpvNodeBuilder builder(item.value("value").toVariant());
+        const int error = mpv_set_property(handle, name.constData(), MPV_FORMAT_NODE, builder.node());
+        return error < 0 ? fail(QString::fromUtf8(mpv_error_string(error))) : ok();
+    }
+
+    if (cmd == "metadata") {
+        return ok(metadata());
+    }
+
+    if (cmd == "seek_frame" || cmd == "step") {
+        if (!item.contains("frame") && cmd == "seek_frame") {
+            return fail("missing frame");
+        }
+        // step도 정확 시크로 처리 - frame-step은 일시정지 상태에서 재생 재개 신호가 없어 완료 시점을 알 수 없음
+        int frame = cmd == "step" ? currentFrame() + item.value("count").toInt(1) : item.value("frame").toInt();
+        const int frameCount = m_mpv->frameCount();
+        if (frameCount > 0) {
+            frame = std::clamp(frame, 0, frameCount - 1);
+        }
+        if (!seekExact(client, std::max(0, frame))) {
+            return fail("seek failed");
+        }
+        await = Await::Restart;
+        return QJsonObject();
+    }
+
+    if (cmd == "command" || cmd == "screenshot" || cmd == "load") {
+        QVariantList args;
+        if (cmd == "command") {
+            args = item.value("args").toArray().toVariantList();
+            if (args.isEmpty()) {
+                return fail("missing args");
+            }
+        } else if (cmd == "screenshot") {
+            const QString path = item.value("path").toString();
+            if (path.isEmpty()) {
+                return fail("missing path");
+            }
+            args = {"screenshot-to-file", path, item.value("mode").toString("video")};
+        } else {
+            const QString path = item.value("path").toString();
+            if (path.isEmpty()) {
+                return fail("missing path");
+            }
+            args = {"loadfile", path, "replace"};
+        }
+
+        client.replyId = kReplyTag | m_nextReplyId++;
+        MpvNodeBuilder builder(args);
+        const int error = mpv_command_node_async(handle, client.replyId, builder.node());
+        if (error < 0) {
+            client.replyId = 0;
+            return fail(QString::fromUtf8(mpv_error_string(error)));
+        }
+        // 파일 열기는 명령 응답이 아니라 파일 로드 완료까지 기다림
+        await = cmd == "load" ? Await::FileLoaded : Await::CommandReply;
+        return QJsonObject();
+    }
+
+    return fail(QString("unknown command: %1").arg(cmd));
+}
+
+void ControlServer::onCommandReply(quint64 userdata, int error, const QVariant& result)
+{
+    if (!(userdata & kReplyTag)) {
+        return;
+    }
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client& client = it.value();
+        if (client.replyId != userdata) {
+            continue;
+        }
+        if (client.waiting == Await::Restart) {
+            // 시크 명령이 받아들여진 뒤의 playback-restart부터 이 연결의 시크로 봄
+            if (error < 0) {
+                completeAwait(client, fail(QString::fromUtf8(mpv_error_string(error))));
+            } else {
+                client.seekAccepted = true;
+            }
+        } else if (client.waiting == Await::CommandReply) {
+            completeAwait(client, error < 0 ? fail(QString::fromUtf8(mpv_error_string(error)))
+                                            : ok(QJsonValue::fromVariant(result)));
+        } else if (error < 0 && client.waiting == Await::FileLoaded) {
+            // loadfile 자체가 실패하면 파일 로드 신호가 오지 않음
+            completeAwait(client, fail(QString::fromUtf8(mpv_error_string(error))));
+        }
+        return;
+    }
+}
+
+void ControlServer::onRestarted()
+{
+    const int frame = currentFrame();
+    emitEvent("seek", frame);
+
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client& client = it.value();
+        if (client.waiting != Await::Restart || !client.seekAccepted) {
+            // 시크 명령 응답 전에 온 restart는 이전 시크(다른 연결이나 UI)의 것
+            continue;
+        }
+
+        // 목표 프레임에 닿았거나, 마지막 시크가 이 연결의 것이고 이미 다시 보내 봤으면 실제 프레임으로 완료
+        const bool latest = client.replyId == m_lastSeekReplyId;
+        if (frame == client.seekTarget || (latest && client.seekRetries >= kMaxSeekRetries)) {
+            QJsonObject data;
+            data["frame"] = frame;
+            completeAwait(client, ok(data));
+            continue;
+        }
+
+        // 다른 시크가 이 시크를 덮었으면 다시 보냄
+        if (latest) {
+            ++client.seekRetries;
+        }
+        if (!seekExact(client, client.seekTarget)) {
+            completeAwait(client, fail("seek failed"));
+        }
+    }
+}
+
+void ControlServer::onFileLoaded()
+{
+    const QJsonObject info = metadata();
+    emitEvent("file-loaded", info);
+
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        if (it->waiting == Await::FileLoaded) {
+            completeAwait(it.value(), ok(info));
+        }
+    }
+}
+
+void ControlServer::onAwaitTimeout()
+{
+    bool anyWaiting = false;
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client& client = it.value();
+        if (client.waiting == Await::None) {
+            continue;
+        }
+        if (client.deadline.hasExpired()) {
+            qWarning() << "ControlServer: request timed out";
+            completeAwait(client, fail("timeout"));
+        }
+        anyWaiting = anyWaiting || client.waiting != Await::None;
+    }
+    if (!anyWaiting) {
+        m_awaitTimer.stop();
+    }
+}
+
+void ControlServer::emitEvent(const QString& name, const QJsonValue& data)
+{
+    QJsonObject message;
+    message["event"] = name;
+    message["data"] = data;
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        if (it->subscriptions.contains(name)) {
+            send(it.value(), message);
+        }
+    }
+}
+
+void ControlServer::send(Client& client, const QJsonObject& message)
+{
+    if (client.socket && client.socket->state() == QLocalSocket::ConnectedState) {
+        client.socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+    }
+}
+
+QJsonObject ControlServer::metadata() const
+{
+    QJsonObject info;
+    if (!m_mpv) {
+        return info;
+    }
+
+    info["path"] = m_mpv->filename();
+    info["fps"] = currentFps();
+    info["frameCount"] = m_mpv->frameCount();
+    info["duration"] = m_mpv->duration();
+    info["codec"] = m_mpv->videoCodec();
+    info["frame"] = currentFrame();
+    info["paused"] = m_mpv->isPaused();
+
+    if (m_mpv->handle()) {
+        int64_t width = 0;
+        int64_t height = 0;
+        double position = 0.0;
+        mpv_get_property(m_mpv->handle(), "width", MPV_FORMAT_INT64, &width);
+        mpv_get_property(m_mpv->handle(), "height", MPV_FORMAT_INT64, &height);
+        mpv_get_property(m_mpv->handle(), "time-pos", MPV_FORMAT_DOUBLE, &position);
+        info["width"] = qint64(width);
+        info["height"] = qint64(height);
+        info["position"] = position;
+    }
+    return info;
+}
+
+double ControlServer::currentFps() const
+{
+    return m_mpv && m_mpv->fps() > 0 ? m_mpv->fps() : 24.0;
+}
+
+int ControlServer::currentFrame() const
+{
+    double position = 0.0;
+    if (m_mpv && m_mpv->handle()) {
+        mpv_get_property(m_mpv->handle(), "time-pos", MPV_FORMAT_DOUBLE, &position);
+    }
+    return int(std::floor(position * currentFps() + 0.5));
+}
+
+bool ControlServer::seekExact(Client& client, int frame)
+{
+    // 프레임 경계 바로 뒤로 시크해 부동소수점 오차로 앞 프레임이 표시되지 않게 함
+    const double position = (frame + 0.001) / currentFps();
+    const QByteArray target = QByteArray::number(position, 'f', 6);
+    const char* cmd[] = {"seek", target.constData(), "absolute+exact", nullptr};
+    m_mpv->ensureForwardPlayback();
+
+    // 연결마다 응답 id를 붙여 보내고, 응답이 온 뒤의 restart만 이 시크의 완료로 봄
+    client.replyId = kReplyTag | m_nextReplyId++;
+    client.seekTarget = frame;
+    client.seekAccepted = false;
+    if (mpv_command_async(m_mpv->handle(), client.replyId, cmd) < 0) {
+        client.replyId = 0;
+        return false;
+    }
+    m_lastSeekReplyId = client.replyId;
+    return true;
+}
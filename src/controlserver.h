@@ -0,0 +1,111 @@
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+class QLocalServer;
+class QLocalSocket;
+class MpvObject;
+
+// 로컬 제어 서버 (파이프라인 자동화용)
+// QLocalServer 위에서 한 줄에 JSON 요청 하나를 받는다. 프로토콜은 CONTROL_API.md 참고.
+// - 한 요청에 여러 명령을 묶어 보낼 수 있고(batch), 명령은 순서대로 실행된다
+// - 시크/파일 열기/스크린샷처럼 완료를 기다려야 하는 명령은 비동기로 처리하고 끝나면 응답한다
+// - 연결마다 요청을 파이프라인으로 쌓아 두고 차례로 처리하므로 응답을 기다리지 않고 계속 보낼 수 있다
+// - subscribe로 재생 이벤트를 구독하면 요청과 별도로 이벤트 메시지를 보낸다
+class ControlServer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool listening READ isListening NOTIFY listeningChanged)
+    Q_PROPERTY(QString serverName READ serverName NOTIFY listeningChanged)
+    Q_PROPERTY(int clientCount READ clientCount NOTIFY clientsChanged)
+
+public:
+    explicit ControlServer(QObject *parent = nullptr);
+    ~ControlServer();
+
+    bool isListening() const;
+    QString serverName() const;
+    int clientCount() const { return m_clients.size(); }
+
+    // 기본 이름 "HyperPlayer-control-<사용자 해시>"
+    static QString defaultServerName();
+
+    bool listen(const QString& name = QString());
+    Q_INVOKABLE void connectMpv(MpvObject* mpv);
+
+signals:
+    void listeningChanged();
+    void clientsChanged();
+
+private:
+    // 완료 조건 - 즉시 / MPV 비동기 명령 응답 / 시크 완료 / 파일 로드 완료
+    enum class Await {
+        None,
+        CommandReply,
+        Restart,
+        FileLoaded
+    };
+
+    struct Job {
+        QJsonValue id;
+        QJsonArray items;
+        QJsonArray results;
+        bool batch = false;
+        int index = 0;
+    };
+
+    struct Client {
+        QLocalSocket* socket = nullptr;
+        QByteArray buffer;
+        QList<Job> queue;
+        QSet<QString> subscriptions;
+        Await waiting = Await::None;
+        quint64 replyId = 0;
+        QDeadlineTimer deadline;
+        // 이 연결이 보낸 시크 - 명령 응답을 받은 뒤의 playback-restart만 완료로 봄
+        int seekTarget = -1;
+        bool seekAccepted = false;
+        int seekRetries = 0;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QLocalSocket* socket);
+    void onDisconnected(QLocalSocket* socket);
+
+    // 큐 앞의 작업을 가능한 만큼 실행 (비동기 명령을 만나면 멈춤)
+    void runQueue(Client& client);
+    QJsonObject execute(Client& client, const QJsonObject& item, Await& await);
+    void completeAwait(Client& client, const QJsonObject& result);
+    void finishJob(Client& client);
+
+    void onCommandReply(quint64 userdata, int error, const QVariant& result);
+    void onRestarted();
+    void onFileLoaded();
+    void onAwaitTimeout();
+
+    void emitEvent(const QString& name, const QJsonValue& data);
+    void send(Client& client, const QJsonObject& message);
+
+    QJsonObject metadata() const;
+    double currentFps() const;
+    int currentFrame() const;
+    bool seekExact(Client& client, int frame);
+
+    QLocalServer* m_server = nullptr;
+    QHash<QLocalSocket*, Client> m_clients;
+    QPointer<MpvObject> m_mpv;
+    quint64 m_nextReplyId = 1;
+    quint64 m_lastSeekReplyId = 0; // 가장 최근에 보낸 시크 (그 뒤로 다른 연결의 시크가 없었는지 확인)
+    int m_lastEventFrame = -1;
+    QTimer m_awaitTimer;
+};
+
+#endif // CONTROLSERVER_H
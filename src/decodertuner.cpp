@@ -0,0 +1,390 @@
+#include "decodertuner.h"
+#include "mpvheadless.h"
+#include "testclip.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+// 프로필 형식이 바뀌면 올려서 다시 측정하게 함
+constexpr int kProfileVersion = 1;
+
+// 측정용 클립 - 코덱마다 HD/UHD 두 가지 (인코더가 없는 코덱은 건너뜀)
+struct TuneCodec {
+    const char* decoder;   // MPV가 보고하는 코덱 이름 (프로필 키)
+    const char* encoder;   // 테스트 클립 생성에 쓰는 ovc 값
+    const char* container;
+    int gop;
+};
+
+constexpr TuneCodec kTuneCodecs[] = {
+    {"h264", "libx264", "mp4", 24},
+    {"hevc", "libx265", "mkv", 24},
+    {"mpeg2video", "mpeg2video", "mkv", 15},
+    {"mjpeg", "mjpeg", "mkv", 1},
+    {"prores", "prores_ks", "mov", 1},
+};
+
+struct TuneSize {
+    const char* name;
+    int width;
+    int height;
+};
+
+constexpr TuneSize kTuneSizes[] = {
+    {"hd", 1920, 1080},
+    {"uhd", 3840, 2160},
+};
+
+constexpr double kClipSeconds = 2.0;
+constexpr int kMeasureTimeoutMs = 30000;
+
+// hwdec가 소프트웨어보다 이 비율 이상 빠를 때만 선택 (복사 모드는 CPU 부하가 적어 동률이면 소프트웨어 유지)
+constexpr double kHwdecAdvantage = 1.05;
+
+const char* kSettingsGroup = "DecoderProfiles";
+
+// 적용 시 매번 QSettings를 읽지 않도록 캐시
+QMutex g_cacheMutex;
+QVariantMap g_profileCache;
+bool g_cacheLoaded = false;
+bool g_autoApply = true;
+
+void loadCacheLocked()
+{
+    if (g_cacheLoaded) {
+        return;
+    }
+    QSettings settings;
+    settings.beginGroup(kSettingsGroup);
+    g_autoApply = settings.value("autoApply", true).toBool();
+    g_profileCache = settings.value("profiles").toMap();
+    settings.endGroup();
+    g_cacheLoaded = true;
+}
+
+QString propertyString(mpv_handle* mpv, const char* name)
+{
+    QString value;
+    if (char* raw = mpv_get_property_string(mpv, name)) {
+        value = QString::fromUtf8(raw);
+        mpv_free(raw);
+    }
+    return value;
+}
+
+} // namespace
+
+DecoderTuner::DecoderTuner(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+DecoderTuner::~DecoderTuner()
+{
+    m_cancelRequested = true;
+    m_pool.waitForDone();
+}
+
+bool DecoderTuner::autoApply() const
+{
+    QMutexLocker lock(&g_cacheMutex);
+    loadCacheLocked();
+    return g_autoApply;
+}
+
+void DecoderTuner::setAutoApply(bool enabled)
+{
+    {
+        QMutexLocker lock(&g_cacheMutex);
+        loadCacheLocked();
+        if (g_autoApply == enabled) {
+            return;
+        }
+        g_autoApply = enabled;
+    }
+    QSettings settings;
+    settings.setValue(QString("%1/autoApply").arg(kSettingsGroup), enabled);
+    emit autoApplyChanged(enabled);
+}
+
+QVariantMap DecoderTuner::profiles() const
+{
+    QMutexLocker lock(&g_cacheMutex);
+    loadCacheLocked();
+    return g_profileCache;
+}
+
+QString DecoderTuner::profileKey(const QString& codec, int height)
+{
+    const char* sizeClass = height > 1080 ? "uhd" : (height > 720 ? "hd" : "sd");
+    return QString("%1/%2").arg(codec, sizeClass);
+}
+
+bool DecoderTuner::applyProfile(mpv_handle* mpv)
+{
+    if (!mpv) {
+        return false;
+    }
+
+    // 코덱 이름 ("h264") - 구버전 MPV는 video-codec 설명의 첫 단어 사용
+    QString codec = propertyString(mpv, "current-tracks/video/codec");
+    if (codec.isEmpty()) {
+        codec = propertyString(mpv, "video-codec").section(' ', 0, 0);
+    }
+    int64_t height = 0;
+    if (mpv_get_property(mpv, "current-tracks/video/demux-h", MPV_FORMAT_INT64, &height) < 0 || height <= 0) {
+        mpv_get_property(mpv, "height", MPV_FORMAT_INT64, &height);
+    }
+    if (codec.isEmpty() || height <= 0) {
+        return false;
+    }
+
+    QVariantMap profile;
+    {
+        QMutexLocker lock(&g_cacheMutex);
+        loadCacheLocked();
+        if (!g_autoApply) {
+            return false;
+        }
+        QString key = profileKey(codec, int(height));
+        // SD 프로필은 따로 측정하지 않으므로 HD 값 사용
+        if (!g_profileCache.contains(key) && key.endsWith("/sd")) {
+            key = profileKey(codec, 1080);
+        }
+        profile = g_profileCache.value(key).toMap();
+    }
+    if (profile.isEmpty()) {
+        return false;
+    }
+
+    // 값이 같으면 설정하지 않음 (디코더 재초기화 방지)
+    bool changed = false;
+    const QString threads = QString::number(profile.value("threads").toInt());
+    if (propertyString(mpv, "vd-lavc-threads") != threads) {
+        mpv_set_property_string(mpv, "vd-lavc-threads", threads.toUtf8().constData());
+        changed = true;
+    }
+    const QString hwdec = profile.value("hwdec").toString();
+    if (!hwdec.isEmpty() && propertyString(mpv, "hwdec") != hwdec) {
+        mpv_set_property_string(mpv, "hwdec", hwdec.toUtf8().constData());
+        changed = true;
+    }
+
+    if (changed) {
+        qDebug() << "DecoderTuner: applied profile" << profileKey(codec, int(height)) << profile;
+    }
+    return changed;
+}
+
+bool DecoderTuner::isOutdated() const
+{
+    QSettings settings;
+    settings.beginGroup(kSettingsGroup);
+    const bool upToDate = settings.value("version").toInt() == kProfileVersion
+                       && settings.value("cpuThreads").toInt() == QThread::idealThreadCount()
+                       && !settings.value("profiles").toMap().isEmpty();
+    settings.endGroup();
+    return !upToDate;
+}
+
+void DecoderTuner::runBenchmark()
+{
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    m_cancelRequested = false;
+    emit runningChanged(true);
+    setProgress(0.0);
+
+    m_pool.start(QRunnable::create([this]() { run(); }));
+}
+
+void DecoderTuner::cancel()
+{
+    m_cancelRequested = true;
+}
+
+void DecoderTuner::run()
+{
+    // 재생 중인 디코더보다 우선하지 않도록 낮은 우선순위로 실행
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+    const QString clipDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/decoder-tuning";
+    const int cores = std::max(1, QThread::idealThreadCount());
+
+    // 스레드 수 후보: 1, 2, 4, 8, ... 코어 수까지 + 코어 수 자체
+    QList<int> threadCounts;
+    for (int threads = 1; threads < cores; threads *= 2) {
+        threadCounts << threads;
+    }
+    threadCounts << cores;
+
+    const int codecCount = int(sizeof(kTuneCodecs) / sizeof(kTuneCodecs[0]));
+    const int sizeCount = int(sizeof(kTuneSizes) / sizeof(kTuneSizes[0]));
+    const int totalSteps = codecCount * sizeCount * (threadCounts.size() + 1);
+    int step = 0;
+
+    QVariantMap results;
+    for (const TuneCodec& codec : kTuneCodecs) {
+        for (const TuneSize& size : kTuneSizes) {
+            if (m_cancelRequested) {
+                break;
+            }
+
+            TestClip::Spec spec;
+            spec.name = QString("tune_%1_%2").arg(codec.decoder, size.name);
+            spec.codec = codec.encoder;
+            spec.container = codec.container;
+            spec.width = size.width;
+            spec.height = size.height;
+            spec.rateNum = 24;
+            spec.rateDen = 1;
+            spec.gop = codec.gop;
+            spec.seconds = kClipSeconds;
+
+            QMetaObject::invokeMethod(this, [this, spec]() {
+                setStatus(QString("Preparing %1").arg(spec.name));
+            }, Qt::QueuedConnection);
+
+            QString error;
+            const QString path = TestClip::ensure(spec, clipDir, &error);
+            if (path.isEmpty()) {
+                // 인코더가 포함되지 않은 MPV 빌드 - 해당 코덱은 건너뜀
+                qDebug() << "DecoderTuner: skipping" << spec.name << error;
+                step += threadCounts.size() + 1;
+                continue;
+            }
+
+            // 첫 실행은 파일 캐시 준비용으로 버림
+            measureDecodeFps(path, {cores, "no"}, spec.frameCount());
+
+            Candidate best{cores, "no"};
+            double bestFps = 0.0;
+            for (int threads : threadCounts) {
+                if (m_cancelRequested) {
+                    break;
+                }
+                const double fps = measureDecodeFps(path, {threads, "no"}, spec.frameCount());
+                // 측정 오차 범위 안이면 스레드가 적은 쪽 유지 (다른 작업과 코어를 나눠 쓰도록)
+                if (fps > bestFps * 1.03) {
+                    bestFps = fps;
+                    best = {threads, "no"};
+                }
+                setProgress(double(++step) / totalSteps);
+            }
+
+            const double hwFps = measureDecodeFps(path, {best.threads, "auto-copy"}, spec.frameCount());
+            if (hwFps > bestFps * kHwdecAdvantage) {
+                bestFps = hwFps;
+                best.hwdec = "auto-copy";
+            }
+            setProgress(double(++step) / totalSteps);
+
+            if (bestFps > 0) {
+                QVariantMap profile;
+                profile["threads"] = best.threads;
+                profile["hwdec"] = best.hwdec;
+                profile["fps"] = bestFps;
+                results.insert(profileKey(codec.decoder, size.height), profile);
+                qDebug() << "DecoderTuner:" << spec.name << "->" << profile;
+            }
+        }
+    }
+
+    const bool cancelled = m_cancelRequested;
+    QMetaObject::invokeMethod(this, [this, results, cancelled]() {
+        if (!cancelled && !results.isEmpty()) {
+            QSettings settings;
+            settings.beginGroup(kSettingsGroup);
+            settings.setValue("version", kProfileVersion);
+            settings.setValue("cpuThreads", QThread::idealThreadCount());
+            settings.setValue("profiles", results);
+            settings.endGroup();
+            {
+                QMutexLocker lock(&g_cacheMutex);
+                g_profileCache = results;
+                g_cacheLoaded = true;
+            }
+            emit profilesChanged();
+            setStatus(QString("Tuned %1 codec profiles").arg(results.size()));
+        } else {
+            setStatus(cancelled ? "Cancelled" : "No decoder could be measured");
+        }
+        setProgress(1.0);
+        m_running = false;
+        emit runningChanged(false);
+    }, Qt::QueuedConnection);
+}
+
+double DecoderTuner::measureDecodeFps(const QString& path, const Candidate& candidate, int frames)
+{
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        return 0.0;
+    }
+
+    // 화면 출력/오디오 없이 디코딩 속도만 측정
+    mpv_set_option_string(mpv, "untimed", "yes");
+    mpv_set_option_string(mpv, "aid", "no");
+    mpv_set_option_string(mpv, "hwdec", candidate.hwdec.toUtf8().constData());
+    mpv_set_option_string(mpv, "vd-lavc-threads", QByteArray::number(candidate.threads).constData());
+
+    if (mpv_initialize(mpv) < 0) {
+        mpv_terminate_destroy(mpv);
+        return 0.0;
+    }
+
+    const QByteArray pathBytes = path.toUtf8();
+    const char* cmd[] = {"loadfile", pathBytes.constData(), nullptr};
+    mpv_command(mpv, cmd);
+
+    QElapsedTimer timer;
+    QElapsedTimer timeout;
+    timeout.start();
+    bool ok = false;
+    while (!m_cancelRequested && timeout.elapsed() < kMeasureTimeoutMs) {
+        mpv_event* event = mpv_wait_event(mpv, 0.5);
+        if (event->event_id == MPV_EVENT_FILE_LOADED) {
+            timer.start();
+        } else if (event->event_id == MPV_EVENT_END_FILE) {
+            const auto* end = static_cast<mpv_event_end_file*>(event->data);
+            ok = timer.isValid() && end && end->reason == MPV_END_FILE_REASON_EOF;
+            break;
+        }
+    }
+
+    const qint64 elapsedNs = timer.isValid() ? timer.nsecsElapsed() : 0;
+    mpv_terminate_destroy(mpv);
+
+    if (!ok || elapsedNs <= 0) {
+        return 0.0;
+    }
+    return frames * 1e9 / elapsedNs;
+}
+
+void DecoderTuner::setStatus(const QString& status)
+{
+    if (m_status == status) {
+        return;
+    }
+    m_status = status;
+    emit statusChanged(m_status);
+}
+
+void DecoderTuner::setProgress(double progress)
+{
+    // 작업 스레드에서도 호출되므로 GUI 스레드로 넘김
+    QMetaObject::invokeMethod(this, [this, progress]() {
+        m_progress = progress;
+        emit progressChanged(m_progress);
+    }, Qt::QueuedConnection);
+}
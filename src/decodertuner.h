@@ -0,0 +1,76 @@
+#ifndef DECODERTUNER_H
+#define DECODERTUNER_H
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QVariantMap>
+#include <atomic>
+#include <client.h>
+
+// 디코더 자동 튜닝
+// 코덱/해상도별 테스트 클립을 생성해 여러 디코더 스레드 수와 hwdec 모드로 디코딩 속도를 측정하고,
+// 가장 빠른 조합을 QSettings(DecoderProfiles)에 저장한다. MpvObject는 파일 로드 시 해당 프로필을 적용한다.
+// 측정은 UHD 클립을 인코딩/디코딩하므로 재생과 CPU를 다툰다 - 자동으로 시작하지 않고
+// 설정 패널(Run Benchmark)이나 --tune-decoders로 요청할 때만 실행한다.
+class DecoderTuner : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(QString status READ status NOTIFY statusChanged)
+    Q_PROPERTY(bool autoApply READ autoApply WRITE setAutoApply NOTIFY autoApplyChanged)
+    Q_PROPERTY(QVariantMap profiles READ profiles NOTIFY profilesChanged)
+    Q_PROPERTY(bool outdated READ isOutdated NOTIFY profilesChanged)
+
+public:
+    explicit DecoderTuner(QObject *parent = nullptr);
+    ~DecoderTuner();
+
+    bool isRunning() const { return m_running; }
+    double progress() const { return m_progress; }
+    QString status() const { return m_status; }
+    bool autoApply() const;
+    void setAutoApply(bool enabled);
+    QVariantMap profiles() const;
+    // 저장된 프로필이 없거나 CPU 스레드 수/프로필 형식이 바뀜 (설정 패널에서 다시 측정 안내)
+    bool isOutdated() const;
+
+    // 백그라운드로 측정 (설정 패널, --tune-decoders)
+    Q_INVOKABLE void runBenchmark();
+    Q_INVOKABLE void cancel();
+
+    // 파일 로드 시 호출 - 코덱/세로 해상도에 맞는 프로필을 MPV에 적용 (변경이 없으면 아무것도 하지 않음)
+    // 해상도는 디먹서 값(current-tracks/video/demux-h)을 사용 - height는 VIDEO_RECONFIG 전에는 비어 있음
+    static bool applyProfile(mpv_handle* mpv);
+
+    // 코덱/해상도에 해당하는 프로필 키 ("h264/uhd")
+    static QString profileKey(const QString& codec, int height);
+
+signals:
+    void runningChanged(bool running);
+    void progressChanged(double progress);
+    void statusChanged(const QString &status);
+    void autoApplyChanged(bool enabled);
+    void profilesChanged();
+
+private:
+    struct Candidate {
+        int threads = 0;
+        QString hwdec;
+    };
+
+    void run();
+    double measureDecodeFps(const QString& path, const Candidate& candidate, int frames);
+    void setStatus(const QString& status);
+    void setProgress(double progress);
+
+    QThreadPool m_pool;
+    bool m_running = false;
+    double m_progress = 0.0;
+    QString m_status;
+    std::atomic<bool> m_cancelRequested{false};
+};
+
+#endif // DECODERTUNER_H
@@ -0,0 +1,243 @@
+#include "demuxcachemanager.h"
+#include "mpvobject.h"
+#include <QDebug>
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#elif defined(Q_OS_MACOS)
+#include <sys/sysctl.h>
+#endif
+
+namespace {
+
+constexpr qint64 kMiB = 1024 * 1024;
+
+// 전체 캐시 예산 = 사용 가능한 메모리의 1/4 (최소/최대 제한)
+constexpr double kMemoryFraction = 0.25;
+constexpr qint64 kMinBudget = 128 * kMiB;
+constexpr qint64 kMaxBudget = 8192 * kMiB;
+// 메모리 정보를 읽을 수 없을 때 (기존 고정값과 같은 총량)
+constexpr qint64 kFallbackBudget = 300 * kMiB;
+
+// 앞쪽은 선읽기 시간 + 여유, 뒤쪽은 스크럽용으로 이만큼 남긴다
+constexpr double kForwardMarginSec = 10.0;
+constexpr double kBackwardSec = 60.0;
+constexpr double kMaxForwardShare = 0.6;
+constexpr qint64 kMinForward = 32 * kMiB;
+constexpr qint64 kMinBackward = 16 * kMiB;
+
+// 구간 변화가 이보다 작으면 QML에 알리지 않음 (타임라인 다시 그리기 최소화)
+constexpr double kRangeEpsilonSec = 0.05;
+
+const mpv_node* findNode(const mpv_node& map, const char* key)
+{
+    if (map.format != MPV_FORMAT_NODE_MAP || !map.u.list) {
+        return nullptr;
+    }
+    for (int i = 0; i < map.u.list->num; ++i) {
+        if (std::strcmp(map.u.list->keys[i], key) == 0) {
+            return &map.u.list->values[i];
+        }
+    }
+    return nullptr;
+}
+
+double nodeDouble(const mpv_node* node, double fallback = 0.0)
+{
+    if (!node) {
+        return fallback;
+    }
+    if (node->format == MPV_FORMAT_DOUBLE) {
+        return node->u.double_;
+    }
+    if (node->format == MPV_FORMAT_INT64) {
+        return double(node->u.int64);
+    }
+    return fallback;
+}
+
+} // namespace
+
+DemuxCacheManager::DemuxCacheManager(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+}
+
+void DemuxCacheManager::setAutoSize(bool enabled)
+{
+    if (m_autoSize == enabled) {
+        return;
+    }
+    m_autoSize = enabled;
+    emit autoSizeChanged(m_autoSize);
+    if (m_autoSize) {
+        resize();
+    }
+}
+
+bool DemuxCacheManager::isCached(double seconds) const
+{
+    for (const QVariant& range : m_cachedRanges) {
+        const QVariantMap map = range.toMap();
+        if (seconds >= map.value("start").toDouble() && seconds <= map.value("end").toDouble()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DemuxCacheManager::updateCacheState(const mpv_node& state)
+{
+    m_cacheSeconds = nodeDouble(findNode(state, "cache-duration"));
+    m_forwardBytes = qint64(nodeDouble(findNode(state, "fw-bytes")));
+    m_totalBytes = qint64(nodeDouble(findNode(state, "total-bytes")));
+    emit cacheStateChanged();
+
+    QVariantList ranges;
+    const mpv_node* seekable = findNode(state, "seekable-ranges");
+    if (seekable && seekable->format == MPV_FORMAT_NODE_ARRAY && seekable->u.list) {
+        for (int i = 0; i < seekable->u.list->num; ++i) {
+            const mpv_node& entry = seekable->u.list->values[i];
+            const double start = nodeDouble(findNode(entry, "start"), -1.0);
+            const double end = nodeDouble(findNode(entry, "end"), -1.0);
+            if (start >= 0 && end > start) {
+                QVariantMap range;
+                range["start"] = start;
+                range["end"] = end;
+                ranges.append(range);
+            }
+        }
+    }
+
+    bool changed = ranges.size() != m_cachedRanges.size();
+    for (int i = 0; !changed && i < ranges.size(); ++i) {
+        const QVariantMap a = ranges[i].toMap();
+        const QVariantMap b = m_cachedRanges[i].toMap();
+        changed = std::abs(a.value("start").toDouble() - b.value("start").toDouble()) > kRangeEpsilonSec
+               || std::abs(a.value("end").toDouble() - b.value("end").toDouble()) > kRangeEpsilonSec;
+    }
+    if (changed) {
+        m_cachedRanges = ranges;
+        emit cachedRangesChanged();
+    }
+}
+
+void DemuxCacheManager::setMinimumBackwardSeconds(double seconds)
+{
+    seconds = std::max(0.0, seconds);
+    if (std::abs(m_minBackwardSeconds - seconds) < kRangeEpsilonSec) {
+        return;
+    }
+    m_minBackwardSeconds = seconds;
+    resize();
+}
+
+double DemuxCacheManager::estimateBitrate() const
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return 0.0;
+    }
+
+    // 파일 크기 / 길이 = 모든 스트림을 포함한 평균 비트레이트
+    int64_t fileSize = 0;
+    double duration = 0.0;
+    mpv_get_property(mpv, "file-size", MPV_FORMAT_INT64, &fileSize);
+    mpv_get_property(mpv, "duration", MPV_FORMAT_DOUBLE, &duration);
+    if (fileSize > 0 && duration > 0) {
+        return fileSize * 8.0 / duration;
+    }
+
+    // 스트림 등 파일 크기를 모르는 경우 디코더가 보고한 비트레이트 사용
+    double videoBitrate = 0.0;
+    double audioBitrate = 0.0;
+    mpv_get_property(mpv, "video-bitrate", MPV_FORMAT_DOUBLE, &videoBitrate);
+    mpv_get_property(mpv, "audio-bitrate", MPV_FORMAT_DOUBLE, &audioBitrate);
+    return videoBitrate + audioBitrate;
+}
+
+void DemuxCacheManager::resize()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!m_autoSize || !mpv) {
+        return;
+    }
+
+    const double bitrate = estimateBitrate();
+    if (bitrate <= 0) {
+        // 비트레이트를 모르면 기본값 유지
+        return;
+    }
+
+    const qint64 available = availableMemoryBytes();
+    const qint64 budget = available > 0
+        ? std::clamp(qint64(available * kMemoryFraction), kMinBudget, kMaxBudget)
+        : kFallbackBudget;
+
+    double readahead = 30.0;
+    mpv_get_property(mpv, "demuxer-readahead-secs", MPV_FORMAT_DOUBLE, &readahead);
+
+    const double bytesPerSec = bitrate / 8.0;
+    const qint64 forwardWanted = qint64(bytesPerSec * (readahead + kForwardMarginSec));
+    const qint64 backwardWanted = qint64(bytesPerSec * std::max(kBackwardSec, m_minBackwardSeconds + kForwardMarginSec));
+
+    const qint64 forward = std::clamp(forwardWanted, kMinForward,
+                                      std::max(kMinForward, qint64(budget * kMaxForwardShare)));
+    const qint64 backward = std::clamp(backwardWanted, kMinBackward,
+                                       std::max(kMinBackward, budget - forward));
+
+    // 변경된 값만 설정 (디먹서는 재생 중에도 새 한도를 반영)
+    if (forward != m_forwardLimit) {
+        mpv_set_property_string(mpv, "demuxer-max-bytes", QByteArray::number(forward).constData());
+    }
+    if (backward != m_backwardLimit) {
+        mpv_set_property_string(mpv, "demuxer-max-back-bytes", QByteArray::number(backward).constData());
+    }
+
+    m_forwardLimit = forward;
+    m_backwardLimit = backward;
+    m_bitrate = bitrate;
+    emit limitsChanged();
+
+    qDebug() << "DemuxCacheManager: bitrate" << qRound(bitrate / 1e6) << "Mbps, available"
+             << available / kMiB << "MiB -> forward" << forward / kMiB << "MiB, backward"
+             << backward / kMiB << "MiB";
+}
+
+qint64 DemuxCacheManager::availableMemoryBytes()
+{
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return qint64(status.ullAvailPhys);
+    }
+    return 0;
+#elif defined(Q_OS_MACOS)
+    // macOS는 사용 가능한 메모리를 간단히 얻을 수 없으므로 전체의 절반으로 본다
+    int64_t total = 0;
+    size_t size = sizeof(total);
+    if (sysctlbyname("hw.memsize", &total, &size, nullptr, 0) == 0) {
+        return total / 2;
+    }
+    return 0;
+#else
+    QFile meminfo("/proc/meminfo");
+    if (!meminfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+    while (!meminfo.atEnd()) {
+        const QByteArray line = meminfo.readLine();
+        if (line.startsWith("MemAvailable:")) {
+            // "MemAvailable:   12345678 kB"
+            return line.mid(13).trimmed().split(' ').first().toLongLong() * 1024;
+        }
+    }
+    return 0;
+#endif
+}
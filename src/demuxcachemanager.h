@@ -0,0 +1,78 @@
+#ifndef DEMUXCACHEMANAGER_H
+#define DEMUXCACHEMANAGER_H
+
+#include <QObject>
+#include <QVariantList>
+#include <client.h>
+
+class MpvObject;
+
+// 디먹서 캐시 관리자
+// 사용 가능한 메모리와 스트림 비트레이트로 앞/뒤 디먹서 캐시 크기(demuxer-max-bytes / demuxer-max-back-bytes)를 정하고,
+// 이벤트 루프로 들어오는 demuxer-cache-state에서 캐시된 구간을 읽어 타임라인에 표시할 수 있게 한다.
+class DemuxCacheManager : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool autoSize READ autoSize WRITE setAutoSize NOTIFY autoSizeChanged)
+    Q_PROPERTY(QVariantList cachedRanges READ cachedRanges NOTIFY cachedRangesChanged)
+    Q_PROPERTY(double cacheSeconds READ cacheSeconds NOTIFY cacheStateChanged)
+    Q_PROPERTY(qint64 forwardBytes READ forwardBytes NOTIFY cacheStateChanged)
+    Q_PROPERTY(qint64 totalBytes READ totalBytes NOTIFY cacheStateChanged)
+    Q_PROPERTY(qint64 forwardLimit READ forwardLimit NOTIFY limitsChanged)
+    Q_PROPERTY(qint64 backwardLimit READ backwardLimit NOTIFY limitsChanged)
+    Q_PROPERTY(double bitrate READ bitrate NOTIFY limitsChanged)
+
+public:
+    explicit DemuxCacheManager(MpvObject* player);
+
+    bool autoSize() const { return m_autoSize; }
+    void setAutoSize(bool enabled);
+
+    // 캐시된 구간 목록 [{start, end}] (초 단위)
+    QVariantList cachedRanges() const { return m_cachedRanges; }
+    double cacheSeconds() const { return m_cacheSeconds; }
+    qint64 forwardBytes() const { return m_forwardBytes; }
+    qint64 totalBytes() const { return m_totalBytes; }
+    qint64 forwardLimit() const { return m_forwardLimit; }
+    qint64 backwardLimit() const { return m_backwardLimit; }
+    double bitrate() const { return m_bitrate; }
+
+    // 주어진 시간이 캐시 안에 있는지 (즉시 스크럽 가능 여부)
+    Q_INVOKABLE bool isCached(double seconds) const;
+
+    // MPV 이벤트 루프에서 demuxer-cache-state 변경 시 호출 (GUI 스레드)
+    void updateCacheState(const mpv_node& state);
+
+    // 파일 로드 후 비트레이트/메모리에 맞춰 캐시 크기 재계산
+    void resize();
+
+    // 뒤쪽 캐시에 최소 이만큼(초)은 남기도록 (반복 구간 전체를 메모리에 유지, 0 = 기본값)
+    void setMinimumBackwardSeconds(double seconds);
+
+    // 시스템에서 사용 가능한 물리 메모리 (알 수 없으면 0)
+    static qint64 availableMemoryBytes();
+
+signals:
+    void autoSizeChanged(bool enabled);
+    void cachedRangesChanged();
+    void cacheStateChanged();
+    void limitsChanged();
+
+private:
+    double estimateBitrate() const;
+
+    MpvObject* m_player;
+    bool m_autoSize = true;
+
+    QVariantList m_cachedRanges;
+    double m_cacheSeconds = 0.0;
+    qint64 m_forwardBytes = 0;
+    qint64 m_totalBytes = 0;
+
+    qint64 m_forwardLimit = 0;
+    qint64 m_backwardLimit = 0;
+    double m_bitrate = 0.0;
+    double m_minBackwardSeconds = 0.0;
+};
+
+#endif // DEMUXCACHEMANAGER_H
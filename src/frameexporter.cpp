@@ -0,0 +1,439 @@
+#include "frameexporter.h"
+#include "mpvheadless.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 세그먼트가 이보다 짧으면 인스턴스 생성 비용이 이득보다 커진다
+const int kMinSegmentFrames = 24;
+
+// 이미지 포맷별 인코더와 확장자
+struct ImageCodec {
+    const char* format;
+    const char* encoder;
+    const char* extension;
+};
+
+const ImageCodec kImageCodecs[] = {
+    {"png", "png", "png"},
+    {"jpg", "mjpeg", "jpg"},
+    {"tiff", "tiff", "tif"},
+};
+
+const ImageCodec& codecForFormat(const QString& format)
+{
+    for (const ImageCodec& codec : kImageCodecs) {
+        if (format == QLatin1String(codec.format)) {
+            return codec;
+        }
+    }
+    return kImageCodecs[0];
+}
+
+// 프레임 번호를 시크 위치로 변환
+// 1/4 프레임 앞을 지정해 부동소수점 오차로 목표 프레임이 hr-seek에서 버려지는 것을 막는다
+double frameStartPosition(int frame, double fps)
+{
+    return std::max(0.0, (frame - 0.25) / fps);
+}
+}
+
+FrameExporter::FrameExporter(QObject *parent)
+    : QObject(parent)
+{
+    // 진행률은 워커 스레드의 원자 카운터를 GUI 스레드에서 주기적으로 읽어 갱신
+    m_progressTimer = new QTimer(this);
+    m_progressTimer->setInterval(100);
+    connect(m_progressTimer, &QTimer::timeout, this, &FrameExporter::updateProgress);
+}
+
+FrameExporter::~FrameExporter()
+{
+    m_cancelRequested = true;
+    m_pool.waitForDone();
+}
+
+void FrameExporter::setSegmentCount(int count)
+{
+    count = std::max(0, count);
+    if (m_segmentCount != count) {
+        m_segmentCount = count;
+        emit segmentCountChanged(count);
+    }
+}
+
+void FrameExporter::setImageFormat(const QString& format)
+{
+    QString normalized = format.toLower();
+    if (m_imageFormat != normalized) {
+        m_imageFormat = normalized;
+        emit imageFormatChanged(normalized);
+    }
+}
+
+QVector<FrameExporter::Segment> FrameExporter::splitRange(int firstFrame, int lastFrame, int segments)
+{
+    QVector<Segment> result;
+    int total = lastFrame - firstFrame + 1;
+    if (total <= 0) {
+        return result;
+    }
+
+    segments = qBound(1, segments, std::max(1, total / kMinSegmentFrames));
+
+    int base = total / segments;
+    int remainder = total % segments;
+    int frame = firstFrame;
+    for (int i = 0; i < segments; ++i) {
+        Segment segment;
+        segment.firstFrame = frame;
+        segment.frameCount = base + (i < remainder ? 1 : 0);
+        frame += segment.frameCount;
+        result.append(segment);
+    }
+    return result;
+}
+
+bool FrameExporter::exportRange(const QString& file, int firstFrame, int lastFrame, double fps,
+                                const QString& outputDir, int frameNumberOffset)
+{
+    Job job;
+    job.file = file;
+    job.outputDir = outputDir;
+    job.firstFrame = firstFrame;
+    job.lastFrame = lastFrame;
+    job.frameNumberOffset = frameNumberOffset;
+    job.fps = fps;
+    return startJob(job);
+}
+
+bool FrameExporter::benchmarkRange(const QString& file, int firstFrame, int lastFrame, double fps,
+                                   const QString& outputDir)
+{
+    Job job;
+    job.file = file;
+    job.outputDir = outputDir;
+    job.firstFrame = firstFrame;
+    job.lastFrame = lastFrame;
+    job.fps = fps;
+    job.benchmark = true;
+    return startJob(job);
+}
+
+void FrameExporter::cancel()
+{
+    if (m_running) {
+        qDebug() << "FrameExporter: cancel requested";
+        m_cancelRequested = true;
+    }
+}
+
+bool FrameExporter::startJob(const Job& requested)
+{
+    if (m_running) {
+        qWarning() << "FrameExporter: export already running";
+        return false;
+    }
+
+    if (requested.file.isEmpty() || requested.fps <= 0 || requested.lastFrame < requested.firstFrame) {
+        qWarning() << "FrameExporter: invalid export range" << requested.firstFrame << "-" << requested.lastFrame
+                   << "fps:" << requested.fps;
+        return false;
+    }
+
+    if (!QDir().mkpath(requested.outputDir)) {
+        qWarning() << "FrameExporter: cannot create output directory:" << requested.outputDir;
+        return false;
+    }
+
+    Job job = requested;
+    job.imageFormat = m_imageFormat;
+    job.segments = m_segmentCount > 0 ? m_segmentCount : std::max(1, QThread::idealThreadCount());
+
+    // 조정 작업 1개 + 세그먼트 인스턴스 N개가 동시에 돌 수 있어야 한다
+    m_pool.setMaxThreadCount(job.segments + 1);
+
+    int frames = job.lastFrame - job.firstFrame + 1;
+    m_totalFrames = job.benchmark ? frames * 2 : frames;
+    m_framesDone = 0;
+    m_cancelRequested = false;
+    m_progress = 0.0;
+    m_running = true;
+    emit runningChanged(true);
+    emit progressChanged(0.0);
+    m_progressTimer->start();
+
+    qDebug() << "FrameExporter: exporting frames" << job.firstFrame << "-" << job.lastFrame
+             << "with" << job.segments << "segments to" << job.outputDir;
+
+    m_pool.start(QRunnable::create([this, job]() { runJob(job); }));
+    return true;
+}
+
+void FrameExporter::runJob(const Job& job)
+{
+    int frames = job.lastFrame - job.firstFrame + 1;
+    QVector<Segment> segments = alignToKeyframes(job, splitRange(job.firstFrame, job.lastFrame, job.segments));
+
+    qint64 parallelMs = 0;
+    if (!exportSegments(job, segments, &parallelMs)) {
+        finishJob(false, frames, parallelMs, m_cancelRequested ? QString("Export cancelled")
+                                                              : QString("Export failed"));
+        return;
+    }
+
+    if (job.benchmark) {
+        // 같은 구간을 단일 인스턴스로 내보내 기준 처리량 측정
+        Job single = job;
+        single.outputDir = QDir(job.outputDir).filePath("single-instance");
+        QDir().mkpath(single.outputDir);
+
+        QVector<Segment> whole;
+        whole.append(Segment{job.firstFrame, frames});
+
+        qint64 singleMs = 0;
+        bool ok = exportSegments(single, whole, &singleMs);
+        QDir(single.outputDir).removeRecursively();
+
+        if (ok) {
+            QVariantMap result;
+            result["frames"] = frames;
+            result["segments"] = segments.size();
+            result["parallelMs"] = parallelMs;
+            result["singleMs"] = singleMs;
+            result["parallelFps"] = parallelMs > 0 ? frames * 1000.0 / parallelMs : 0.0;
+            result["singleFps"] = singleMs > 0 ? frames * 1000.0 / singleMs : 0.0;
+            result["speedup"] = parallelMs > 0 ? double(singleMs) / parallelMs : 0.0;
+
+            qDebug() << "FrameExporter: benchmark" << result;
+            QMetaObject::invokeMethod(this, [this, result]() {
+                emit benchmarkFinished(result);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    finishJob(true, frames, parallelMs, QString());
+}
+
+bool FrameExporter::exportSegments(const Job& job, const QVector<Segment>& segments, qint64* elapsedMs)
+{
+    // 인스턴스마다 전체 코어를 쓰면 과부하가 되므로 디코더 스레드를 나눠 준다
+    int decoderThreads = std::max(1, QThread::idealThreadCount() / std::max(1, int(segments.size())));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::atomic<int> failures{0};
+    QThreadPool segmentPool;
+    segmentPool.setMaxThreadCount(std::max(1, int(segments.size())));
+
+    for (const Segment& segment : segments) {
+        segmentPool.start(QRunnable::create([this, &job, segment, decoderThreads, &failures]() {
+            if (!exportSegment(job, segment, decoderThreads)) {
+                failures++;
+            }
+        }));
+    }
+    segmentPool.waitForDone();
+
+    *elapsedMs = timer.elapsed();
+    return failures == 0 && !m_cancelRequested;
+}
+
+bool FrameExporter::exportSegment(const Job& job, const Segment& segment, int decoderThreads)
+{
+    if (m_cancelRequested) {
+        return false;
+    }
+
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        qCritical() << "FrameExporter: failed to create MPV instance";
+        return false;
+    }
+
+    const ImageCodec& codec = codecForFormat(job.imageFormat);
+    QString pattern = QDir(job.outputDir).filePath(
+        QString("frame_%08d.%1").arg(QLatin1String(codec.extension)));
+    int firstNumber = segment.firstFrame + job.frameNumberOffset;
+    double startPos = frameStartPosition(segment.firstFrame, job.fps);
+
+    // 인코딩 모드: image2 먹서가 start_number부터 연속 번호로 파일을 쓴다
+    mpv_set_option_string(mpv, "o", QDir::toNativeSeparators(pattern).toUtf8().constData());
+    mpv_set_option_string(mpv, "of", "image2");
+    mpv_set_option_string(mpv, "ovc", codec.encoder);
+    mpv_set_option_string(mpv, "ofopts", QString("start_number=%1").arg(firstNumber).toUtf8().constData());
+    mpv_set_option_string(mpv, "start", QString::number(startPos, 'f', 6).toUtf8().constData());
+    mpv_set_option_string(mpv, "frames", QByteArray::number(segment.frameCount).constData());
+    mpv_set_option_string(mpv, "hr-seek", "yes");
+    mpv_set_option_string(mpv, "aid", "no");
+    mpv_set_option_string(mpv, "sid", "no");
+    mpv_set_option_string(mpv, "vd-lavc-threads", QByteArray::number(decoderThreads).constData());
+
+    if (mpv_initialize(mpv) < 0) {
+        qCritical() << "FrameExporter: failed to initialize MPV for segment" << segment.firstFrame;
+        mpv_terminate_destroy(mpv);
+        return false;
+    }
+
+    mpv_observe_property(mpv, 0, "time-pos", MPV_FORMAT_DOUBLE);
+
+    QByteArray path = job.file.toUtf8();
+    const char* cmd[] = {"loadfile", path.constData(), nullptr};
+    if (mpv_command(mpv, cmd) < 0) {
+        qCritical() << "FrameExporter: loadfile failed for" << job.file;
+        mpv_terminate_destroy(mpv);
+        return false;
+    }
+
+    bool success = false;
+    int reported = 0;
+    while (true) {
+        if (m_cancelRequested) {
+            break;
+        }
+
+        mpv_event* event = mpv_wait_event(mpv, 0.25);
+        if (event->event_id == MPV_EVENT_NONE) {
+            continue;
+        }
+
+        if (event->event_id == MPV_EVENT_PROPERTY_CHANGE) {
+            mpv_event_property* prop = static_cast<mpv_event_property*>(event->data);
+            if (prop->format == MPV_FORMAT_DOUBLE && prop->data) {
+                double pos = *static_cast<double*>(prop->data);
+                int encoded = qBound(0, int(std::lround((pos - startPos) * job.fps)) + 1, segment.frameCount);
+                if (encoded > reported) {
+                    m_framesDone += encoded - reported;
+                    reported = encoded;
+                }
+            }
+        } else if (event->event_id == MPV_EVENT_END_FILE) {
+            mpv_event_end_file* endFile = static_cast<mpv_event_end_file*>(event->data);
+            success = endFile->reason == MPV_END_FILE_REASON_EOF;
+            if (!success) {
+                qWarning() << "FrameExporter: segment" << segment.firstFrame << "ended with error:"
+                           << mpv_error_string(endFile->error);
+            }
+            break;
+        } else if (event->event_id == MPV_EVENT_SHUTDOWN) {
+            break;
+        }
+    }
+
+    // 종료 시 인코더가 마지막 프레임을 모두 기록한다
+    mpv_terminate_destroy(mpv);
+
+    if (success && reported < segment.frameCount) {
+        m_framesDone += segment.frameCount - reported;
+    }
+    return success;
+}
+
+QVector<FrameExporter::Segment> FrameExporter::alignToKeyframes(const Job& job, const QVector<Segment>& segments)
+{
+    if (segments.size() <= 1) {
+        return segments;
+    }
+
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        return segments;
+    }
+
+    mpv_set_option_string(mpv, "pause", "yes");
+    mpv_set_option_string(mpv, "aid", "no");
+    mpv_set_option_string(mpv, "sid", "no");
+    mpv_set_option_string(mpv, "hr-seek", "no");
+
+    QVector<int> boundaries;
+    for (const Segment& segment : segments) {
+        boundaries.append(segment.firstFrame);
+    }
+
+    QByteArray path = job.file.toUtf8();
+    const char* loadCmd[] = {"loadfile", path.constData(), nullptr};
+    if (mpv_initialize(mpv) >= 0 && mpv_command(mpv, loadCmd) >= 0 &&
+        waitForEvent(mpv, MPV_EVENT_PLAYBACK_RESTART, 10000)) {
+
+        // 각 경계를 바로 앞 키프레임으로 당겨 세그먼트 시작 시 버려지는 디코딩을 없앤다
+        for (int i = 1; i < boundaries.size() && !m_cancelRequested; ++i) {
+            QByteArray target = QByteArray::number(frameStartPosition(boundaries[i], job.fps), 'f', 6);
+            const char* seekCmd[] = {"seek", target.constData(), "absolute+keyframes", nullptr};
+            if (mpv_command(mpv, seekCmd) < 0 || !waitForEvent(mpv, MPV_EVENT_PLAYBACK_RESTART, 5000)) {
+                continue;
+            }
+
+            double keyframePos = 0;
+            if (mpv_get_property(mpv, "time-pos", MPV_FORMAT_DOUBLE, &keyframePos) < 0) {
+                continue;
+            }
+
+            int keyframe = int(std::lround(keyframePos * job.fps));
+            if (keyframe > boundaries[i - 1] + kMinSegmentFrames && keyframe <= boundaries[i]) {
+                boundaries[i] = keyframe;
+            }
+        }
+    }
+    mpv_terminate_destroy(mpv);
+
+    QVector<Segment> aligned;
+    for (int i = 0; i < boundaries.size(); ++i) {
+        int end = (i + 1 < boundaries.size()) ? boundaries[i + 1] : job.lastFrame + 1;
+        aligned.append(Segment{boundaries[i], end - boundaries[i]});
+    }
+
+    qDebug() << "FrameExporter: segment boundaries aligned to keyframes:" << boundaries;
+    return aligned;
+}
+
+bool FrameExporter::waitForEvent(mpv_handle* handle, mpv_event_id id, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!m_cancelRequested && timer.elapsed() < timeoutMs) {
+        mpv_event* event = mpv_wait_event(handle, 0.1);
+        if (event->event_id == id) {
+            return true;
+        }
+        if (event->event_id == MPV_EVENT_END_FILE || event->event_id == MPV_EVENT_SHUTDOWN) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void FrameExporter::finishJob(bool success, int frames, qint64 elapsedMs, const QString& error)
+{
+    QMetaObject::invokeMethod(this, [this, success, frames, elapsedMs, error]() {
+        m_progressTimer->stop();
+        updateProgress();
+
+        m_lastThroughput = (success && elapsedMs > 0) ? frames * 1000.0 / elapsedMs : 0.0;
+        m_running = false;
+
+        qDebug() << "FrameExporter: finished" << (success ? "successfully" : "with errors")
+                 << "-" << frames << "frames in" << elapsedMs << "ms," << m_lastThroughput << "fps";
+
+        if (!success) {
+            emit exportError(error);
+        }
+        emit exportFinished(success, frames, elapsedMs, m_lastThroughput);
+        emit runningChanged(false);
+    }, Qt::QueuedConnection);
+}
+
+void FrameExporter::updateProgress()
+{
+    double progress = m_totalFrames > 0 ? qBound(0.0, double(m_framesDone) / m_totalFrames, 1.0) : 0.0;
+    if (!qFuzzyCompare(progress + 1.0, m_progress + 1.0)) {
+        m_progress = progress;
+        emit progressChanged(progress);
+    }
+}
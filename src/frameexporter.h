@@ -0,0 +1,105 @@
+#ifndef FRAMEEXPORTER_H
+#define FRAMEEXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+#include <QThreadPool>
+#include <QTimer>
+#include <atomic>
+#include <client.h>
+
+// 프레임 구간을 이미지 시퀀스로 내보내는 클래스
+// 구간을 키프레임 경계에서 N개 세그먼트로 나누고, 세그먼트마다 별도의 헤드리스 MPV 인스턴스로
+// 병렬 디코딩/인코딩한다. 파일 이름에는 타임라인의 프레임 번호가 그대로 사용된다.
+class FrameExporter : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(int segmentCount READ segmentCount WRITE setSegmentCount NOTIFY segmentCountChanged)
+    Q_PROPERTY(QString imageFormat READ imageFormat WRITE setImageFormat NOTIFY imageFormatChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(double lastThroughput READ lastThroughput NOTIFY exportFinished)
+
+public:
+    // 하나의 디코더 인스턴스가 담당하는 연속 프레임 구간
+    struct Segment {
+        int firstFrame = 0;
+        int frameCount = 0;
+    };
+
+    explicit FrameExporter(QObject *parent = nullptr);
+    ~FrameExporter();
+
+    bool isRunning() const { return m_running; }
+    int segmentCount() const { return m_segmentCount; }
+    void setSegmentCount(int count);
+    QString imageFormat() const { return m_imageFormat; }
+    void setImageFormat(const QString& format);
+    double progress() const { return m_progress; }
+    double lastThroughput() const { return m_lastThroughput; }
+
+    // firstFrame~lastFrame(포함) 구간을 outputDir에 내보냄
+    // frameNumberOffset은 파일 이름에 더해지는 값 (1-기반 표시 번호를 쓰려면 1)
+    Q_INVOKABLE bool exportRange(const QString& file, int firstFrame, int lastFrame, double fps,
+                                 const QString& outputDir, int frameNumberOffset = 0);
+
+    // 병렬 내보내기 후 같은 구간을 단일 인스턴스로 다시 내보내 처리량을 비교
+    Q_INVOKABLE bool benchmarkRange(const QString& file, int firstFrame, int lastFrame, double fps,
+                                    const QString& outputDir);
+
+    Q_INVOKABLE void cancel();
+
+    // 구간을 균등하게 나눔 (키프레임 정렬 전 단계)
+    static QVector<Segment> splitRange(int firstFrame, int lastFrame, int segments);
+
+signals:
+    void runningChanged(bool running);
+    void segmentCountChanged(int count);
+    void imageFormatChanged(const QString &format);
+    void progressChanged(double progress);
+    void exportFinished(bool success, int frames, qint64 elapsedMs, double framesPerSecond);
+    void benchmarkFinished(const QVariantMap &result);
+    void exportError(const QString &message);
+
+private slots:
+    void updateProgress();
+
+private:
+    struct Job {
+        QString file;
+        QString outputDir;
+        QString imageFormat;
+        int firstFrame = 0;
+        int lastFrame = 0;
+        int frameNumberOffset = 0;
+        int segments = 1;
+        double fps = 0.0;
+        bool benchmark = false;
+    };
+
+    bool startJob(const Job& job);
+    void runJob(const Job& job);
+    bool exportSegments(const Job& job, const QVector<Segment>& segments, qint64* elapsedMs);
+    bool exportSegment(const Job& job, const Segment& segment, int decoderThreads);
+    QVector<Segment> alignToKeyframes(const Job& job, const QVector<Segment>& segments);
+    bool waitForEvent(mpv_handle* handle, mpv_event_id id, int timeoutMs);
+    void finishJob(bool success, int frames, qint64 elapsedMs, const QString& error);
+
+    QThreadPool m_pool;
+    QTimer* m_progressTimer = nullptr;
+
+    bool m_running = false;
+    int m_segmentCount = 0;            // 0 = CPU 코어 수에 맞춰 자동 결정
+    QString m_imageFormat = "png";
+    double m_progress = 0.0;
+    double m_lastThroughput = 0.0;
+    int m_totalFrames = 0;
+
+    std::atomic<bool> m_cancelRequested{false};
+    std::atomic<int> m_framesDone{0};
+};
+
+#endif // FRAMEEXPORTER_H
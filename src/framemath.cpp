@@ -0,0 +1,240 @@
+#include "framemath.h"
+#include <QChar>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QtGlobal>
+#include <cstdlib>
+
+namespace FrameMath {
+
+namespace {
+
+// 정규식은 한 번만 컴파일 (호출마다 생성하면 변환 비용의 대부분을 차지)
+const QRegularExpression& nonDropRegex()
+{
+    static const QRegularExpression regex("(\\d+):(\\d+):(\\d+):(\\d+)");
+    return regex;
+}
+
+const QRegularExpression& dropFrameRegex()
+{
+    static const QRegularExpression regex("(\\d+):(\\d+):(\\d+);(\\d+)");
+    return regex;
+}
+
+const QRegularExpression& millisecondsRegex()
+{
+    static const QRegularExpression regex("(\\d+):(\\d+):(\\d+)\\.(\\d+)");
+    return regex;
+}
+
+const QRegularExpression& simpleTimecodeRegex()
+{
+    static const QRegularExpression regex("(\\d{2}):(\\d{2}):(\\d{2}):(\\d{2})");
+    return regex;
+}
+
+QString twoDigits(int value)
+{
+    return QString("%1").arg(value, 2, 10, QChar('0'));
+}
+
+} // namespace
+
+int frameFromPosition(double position, double fps, int totalFrames)
+{
+    if (fps <= 0) return 0;
+
+    return qBound(0, qRound(position * fps), totalFrames - 1);
+}
+
+double positionFromFrame(int frame, double fps)
+{
+    if (fps <= 0) return 0.0;
+
+    return frame / fps;
+}
+
+QString frameToTimecode(int frame, double fps, int format, const QString& customPattern)
+{
+    if (fps <= 0)
+        return "00:00:00:00";
+
+    // 프레임 수가 음수인 경우 처리
+    bool isNegative = frame < 0;
+    frame = std::abs(frame);
+
+    // 총 초 계산
+    double totalSeconds = frame / fps;
+
+    // 시, 분, 초 계산
+    int hours = static_cast<int>(totalSeconds / 3600);
+    int minutes = static_cast<int>((totalSeconds - hours * 3600) / 60);
+    int seconds = static_cast<int>(totalSeconds - hours * 3600 - minutes * 60);
+
+    // 프레임 부분 계산
+    double fractionalSeconds = totalSeconds - static_cast<int>(totalSeconds);
+    int frameNumber = static_cast<int>(fractionalSeconds * fps);
+
+    // 밀리초 계산 (HH:MM:SS.MS 형식용)
+    int milliseconds = static_cast<int>(fractionalSeconds * 1000);
+
+    QString timecode;
+
+    switch (format) {
+        case SmpteDropFrame:
+            timecode = QString("%1:%2:%3;%4")
+                        .arg(hours, 2, 10, QChar('0'))
+                        .arg(minutes, 2, 10, QChar('0'))
+                        .arg(seconds, 2, 10, QChar('0'))
+                        .arg(frameNumber, 2, 10, QChar('0'));
+            break;
+
+        case Milliseconds:
+            timecode = QString("%1:%2:%3.%4")
+                        .arg(hours, 2, 10, QChar('0'))
+                        .arg(minutes, 2, 10, QChar('0'))
+                        .arg(seconds, 2, 10, QChar('0'))
+                        .arg(milliseconds, 3, 10, QChar('0'));
+            break;
+
+        case FramesOnly:
+            timecode = QString::number(frame);
+            break;
+
+        case Custom:
+            // 패턴 치환
+            timecode = customPattern;
+            timecode.replace("%H", twoDigits(hours));
+            timecode.replace("%M", twoDigits(minutes));
+            timecode.replace("%S", twoDigits(seconds));
+            timecode.replace("%f", twoDigits(frameNumber));
+            timecode.replace("%t", QString::number(frame));
+            timecode.replace("%ms", QString("%1").arg(milliseconds, 3, 10, QChar('0')));
+            break;
+
+        case SmpteNonDrop:
+        default:
+            timecode = QString("%1:%2:%3:%4")
+                        .arg(hours, 2, 10, QChar('0'))
+                        .arg(minutes, 2, 10, QChar('0'))
+                        .arg(seconds, 2, 10, QChar('0'))
+                        .arg(frameNumber, 2, 10, QChar('0'));
+    }
+
+    // 음수 프레임인 경우 음수 기호 추가
+    if (isNegative) {
+        timecode = "-" + timecode;
+    }
+
+    return timecode;
+}
+
+int timecodeToFrame(const QString& tc, double fps)
+{
+    if (fps <= 0)
+        return 0;
+
+    // 타임코드가 단순히 프레임 번호인 경우
+    bool ok;
+    int frame = tc.toInt(&ok);
+    if (ok) return frame;
+
+    // 음수 타임코드 처리
+    bool isNegative = tc.startsWith("-");
+    QString timecode = isNegative ? tc.mid(1) : tc;
+
+    QRegularExpressionMatch match;
+
+    // SMPTE Non-Drop 형식 (HH:MM:SS:FF) 처리
+    match = nonDropRegex().match(timecode);
+    if (match.hasMatch()) {
+        int hours = match.captured(1).toInt();
+        int minutes = match.captured(2).toInt();
+        int seconds = match.captured(3).toInt();
+        int frames = match.captured(4).toInt();
+
+        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * fps) + frames;
+        return isNegative ? -totalFrames : totalFrames;
+    }
+
+    // SMPTE Drop-Frame 형식 (HH:MM:SS;FF) 처리
+    match = dropFrameRegex().match(timecode);
+    if (match.hasMatch()) {
+        int hours = match.captured(1).toInt();
+        int minutes = match.captured(2).toInt();
+        int seconds = match.captured(3).toInt();
+        int frames = match.captured(4).toInt();
+
+        // 드롭 프레임 보정 (NTSC에 주로 사용)
+        int totalMinutes = hours * 60 + minutes;
+        int droppedFrames = 0;
+
+        if (qFuzzyCompare(fps, 29.97) || qFuzzyCompare(fps, 30.0)) {
+            // 각 10분마다 제외할 프레임 수 계산
+            droppedFrames = 2 * (totalMinutes - totalMinutes / 10);
+        }
+
+        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * fps) + frames - droppedFrames;
+        return isNegative ? -totalFrames : totalFrames;
+    }
+
+    // HH:MM:SS.MS 형식 처리
+    match = millisecondsRegex().match(timecode);
+    if (match.hasMatch()) {
+        int hours = match.captured(1).toInt();
+        int minutes = match.captured(2).toInt();
+        int seconds = match.captured(3).toInt();
+        int milliseconds = match.captured(4).toInt();
+
+        double fractionalSeconds = milliseconds / 1000.0;
+        int frames = static_cast<int>(fractionalSeconds * fps);
+
+        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * fps) + frames;
+        return isNegative ? -totalFrames : totalFrames;
+    }
+
+    // 지원하지 않는 형식
+    return 0;
+}
+
+QString frameToSimpleTimecode(int frame, double fps)
+{
+    if (fps <= 0) return "00:00:00:00";
+
+    // 프레임을 초로 변환
+    double seconds = frame / fps;
+
+    // 시, 분, 초, 프레임 계산
+    int hours = int(seconds / 3600);
+    int minutes = int((seconds - hours * 3600) / 60);
+    int secs = int(seconds) % 60;
+    int frames = int(frame % int(fps));
+
+    return QString("%1:%2:%3:%4")
+            .arg(hours, 2, 10, QChar('0'))
+            .arg(minutes, 2, 10, QChar('0'))
+            .arg(secs, 2, 10, QChar('0'))
+            .arg(frames, 2, 10, QChar('0'));
+}
+
+int simpleTimecodeToFrame(const QString& timecode, double fps, int totalFrames)
+{
+    if (fps <= 0) return 0;
+
+    QRegularExpressionMatch match = simpleTimecodeRegex().match(timecode);
+    if (!match.hasMatch())
+        return 0;
+
+    int hours = match.captured(1).toInt();
+    int minutes = match.captured(2).toInt();
+    int seconds = match.captured(3).toInt();
+    int frames = match.captured(4).toInt();
+
+    int totalSeconds = hours * 3600 + minutes * 60 + seconds;
+    int frame = totalSeconds * fps + frames;
+
+    return qBound(0, frame, totalFrames - 1);
+}
+
+} // namespace FrameMath
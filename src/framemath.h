@@ -0,0 +1,37 @@
+#ifndef FRAMEMATH_H
+#define FRAMEMATH_H
+
+#include <QString>
+
+// 프레임/시간/타임코드 변환 함수 모음
+// MPV나 Qt Quick에 의존하지 않는 순수 계산이라 MpvObject, TimelineSync와 벤치마크에서 함께 사용한다.
+namespace FrameMath {
+
+// 타임코드 표시 형식 (MpvObject::timecodeFormat 값과 동일)
+enum TimecodeFormat {
+    SmpteNonDrop = 0,   // HH:MM:SS:FF
+    SmpteDropFrame = 1, // HH:MM:SS;FF
+    Milliseconds = 2,   // HH:MM:SS.MS
+    FramesOnly = 3,
+    Custom = 4          // %H %M %S %f %t %ms 치환
+};
+
+// 시간 위치 -> 프레임 번호 (0 ~ totalFrames-1 범위로 제한)
+int frameFromPosition(double position, double fps, int totalFrames);
+
+// 프레임 번호 -> 시간 위치 (초)
+double positionFromFrame(int frame, double fps);
+
+// 프레임 번호 -> 타임코드 문자열 (MpvObject 표시 형식)
+QString frameToTimecode(int frame, double fps, int format, const QString& customPattern);
+
+// 타임코드 문자열 -> 프레임 번호 (프레임 번호, HH:MM:SS:FF, HH:MM:SS;FF, HH:MM:SS.MS 지원)
+int timecodeToFrame(const QString& timecode, double fps);
+
+// TimelineSync에서 쓰는 단순 HH:MM:SS:FF 변환
+QString frameToSimpleTimecode(int frame, double fps);
+int simpleTimecodeToFrame(const QString& timecode, double fps, int totalFrames);
+
+} // namespace FrameMath
+
+#endif // FRAMEMATH_H
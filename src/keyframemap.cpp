@@ -0,0 +1,463 @@
+#include "keyframemap.h"
+#include "mpvobject.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+
+namespace {
+
+// moov 상자 최대 크기 (이보다 크면 색인이 깨진 파일로 봄)
+constexpr qint64 kMaxMoovBytes = 512ll * 1024 * 1024;
+
+// 프레임 수 상한 (24fps로 약 3주 - 넘으면 깨진 색인)
+constexpr quint32 kMaxFrames = 50u * 1000 * 1000;
+
+// 히트맵 cost가 1이 되는 디코딩 거리 (초)
+constexpr double kHotDecodeSeconds = 1.0;
+
+// MOV/MP4 첫 상자로 올 수 있는 형식 (그 밖의 컨테이너는 바로 포기)
+const char* const kTopLevelTypes[] = {"ftyp", "moov", "wide", "free", "skip", "mdat", "pnot"};
+
+quint32 readBe32(const uchar* data)
+{
+    return (quint32(data[0]) << 24) | (quint32(data[1]) << 16) | (quint32(data[2]) << 8) | quint32(data[3]);
+}
+
+quint64 readBe64(const uchar* data)
+{
+    return (quint64(readBe32(data)) << 32) | readBe32(data + 4);
+}
+
+// 상자 내용 (헤더 제외)
+struct Span {
+    const uchar* data = nullptr;
+    qint64 size = 0;
+
+    bool isValid() const { return data != nullptr; }
+};
+
+// 상자 헤더 (크기 1 = 64비트 크기, 0 = 끝까지) - 잘못된 크기면 false
+bool parseBoxHeader(const uchar* header, qint64 available, qint64& size, qint64& headerSize)
+{
+    if (available < 8) {
+        return false;
+    }
+    size = readBe32(header);
+    headerSize = 8;
+    if (size == 1) {
+        if (available < 16) {
+            return false;
+        }
+        size = qint64(readBe64(header + 8));
+        headerSize = 16;
+    } else if (size == 0) {
+        size = available;
+    }
+    return size >= headerSize;
+}
+
+Span findChild(Span parent, const char* type)
+{
+    qint64 offset = 0;
+    while (parent.isValid() && offset + 8 <= parent.size) {
+        qint64 size = 0;
+        qint64 headerSize = 0;
+        if (!parseBoxHeader(parent.data + offset, parent.size - offset, size, headerSize)
+            || size > parent.size - offset) {
+            break;
+        }
+        if (std::memcmp(parent.data + offset + 4, type, 4) == 0) {
+            return Span{parent.data + offset + headerSize, size - headerSize};
+        }
+        offset += size;
+    }
+    return Span();
+}
+
+// 풀 박스 (버전/플래그 4바이트) 뒤의 항목 수와 항목 시작 - 항목이 다 들어 있지 않으면 0
+quint32 tableEntries(Span box, int entrySize, const uchar*& entries)
+{
+    if (!box.isValid() || box.size < 8) {
+        return 0;
+    }
+    const quint32 count = readBe32(box.data + 4);
+    if (qint64(count) * entrySize > box.size - 8) {
+        return 0;
+    }
+    entries = box.data + 8;
+    return count;
+}
+
+// 첫 비디오 트랙의 stbl (없으면 빈 Span)
+Span findVideoSampleTable(Span moov, quint32& timescale)
+{
+    qint64 offset = 0;
+    while (offset + 8 <= moov.size) {
+        qint64 size = 0;
+        qint64 headerSize = 0;
+        if (!parseBoxHeader(moov.data + offset, moov.size - offset, size, headerSize)
+            || size > moov.size - offset) {
+            break;
+        }
+        if (std::memcmp(moov.data + offset + 4, "trak", 4) == 0) {
+            const Span mdia = findChild(Span{moov.data + offset + headerSize, size - headerSize}, "mdia");
+            const Span hdlr = findChild(mdia, "hdlr");
+            const Span mdhd = findChild(mdia, "mdhd");
+            if (hdlr.size >= 12 && std::memcmp(hdlr.data + 8, "vide", 4) == 0 && mdhd.size >= 4) {
+                // mdhd 버전 1은 생성/수정 시각이 64비트
+                const qint64 timescaleOffset = mdhd.data[0] == 1 ? 20 : 12;
+                if (mdhd.size >= timescaleOffset + 4) {
+                    timescale = readBe32(mdhd.data + timescaleOffset);
+                    const Span stbl = findChild(findChild(mdia, "minf"), "stbl");
+                    if (stbl.isValid() && timescale > 0) {
+                        return stbl;
+                    }
+                }
+            }
+        }
+        offset += size;
+    }
+    return Span();
+}
+
+} // namespace
+
+KeyframeMap::KeyframeMap(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+KeyframeMap::~KeyframeMap()
+{
+    cancelJob();
+    m_pool.waitForDone();
+}
+
+int KeyframeMap::frameCount() const
+{
+    return m_index ? int(m_index->packetSizes.size()) : 0;
+}
+
+int KeyframeMap::keyframeCount() const
+{
+    return m_index ? int(m_index->keyframes.size()) : 0;
+}
+
+double KeyframeMap::averageGop() const
+{
+    if (!m_index || m_index->keyframes.empty()) {
+        return 0.0;
+    }
+    return double(m_index->packetSizes.size()) / m_index->keyframes.size();
+}
+
+void KeyframeMap::analyzeCurrentFile()
+{
+    cancelJob();
+    if (m_index) {
+        m_index.reset();
+        emit mapChanged();
+    }
+    if (!m_player || !m_player->handle()) {
+        return;
+    }
+
+    // 로컬 파일만 (색인이 파일 끝에 있으면 네트워크 스트림은 전체를 받아야 함)
+    QString path;
+    if (char* raw = mpv_get_property_string(m_player->handle(), "path")) {
+        path = QString::fromUtf8(raw);
+        mpv_free(raw);
+    }
+    const QFileInfo info(path);
+    if (path.isEmpty() || !info.isFile()) {
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->path = info.absoluteFilePath();
+    m_job = job;
+
+    setAnalyzing(true);
+    m_pool.start(QRunnable::create([this, job]() { run(job); }));
+}
+
+void KeyframeMap::cancelJob()
+{
+    if (m_job) {
+        m_job->cancel = true;
+        m_job.reset();
+    }
+    setAnalyzing(false);
+}
+
+void KeyframeMap::run(const std::shared_ptr<Job>& job)
+{
+    QThread::currentThread()->setPriority(QThread::LowPriority);
+
+    QElapsedTimer timer;
+    timer.start();
+    std::shared_ptr<Index> index = readSampleTables(job->path, job->cancel);
+    if (job->cancel) {
+        return;
+    }
+    if (index) {
+        qDebug() << "KeyframeMap: indexed" << job->path << "in" << timer.elapsed() << "ms,"
+                 << index->packetSizes.size() << "frames," << index->keyframes.size() << "keyframes, max GOP"
+                 << index->maxGop;
+    } else {
+        qDebug() << "KeyframeMap: no sample table in" << job->path;
+    }
+
+    std::shared_ptr<const Index> result = index;
+    QMetaObject::invokeMethod(this, [this, job, result]() { publish(job, result); }, Qt::QueuedConnection);
+}
+
+std::shared_ptr<KeyframeMap::Index> KeyframeMap::readSampleTables(const QString& path, const std::atomic_bool& cancel)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    // 최상위 상자를 건너뛰며 moov만 읽음 (mdat은 읽지 않음)
+    QByteArray moov;
+    qint64 position = 0;
+    bool first = true;
+    while (!cancel && position + 8 <= file.size()) {
+        uchar header[16];
+        if (!file.seek(position)) {
+            return nullptr;
+        }
+        const qint64 headerBytes = file.read(reinterpret_cast<char*>(header), sizeof(header));
+        const qint64 remaining = file.size() - position;
+        qint64 size = 0;
+        qint64 headerSize = 0;
+        if (!parseBoxHeader(header, headerBytes, size, headerSize)) {
+            return nullptr;
+        }
+        if (readBe32(header) == 0) {
+            size = remaining;
+        }
+        if (first) {
+            const bool known = std::any_of(std::begin(kTopLevelTypes), std::end(kTopLevelTypes), [&](const char* type) {
+                return std::memcmp(header + 4, type, 4) == 0;
+            });
+            if (!known) {
+                return nullptr;
+            }
+            first = false;
+        }
+        if (std::memcmp(header + 4, "moov", 4) == 0) {
+            if (size - headerSize > kMaxMoovBytes || !file.seek(position + headerSize)) {
+                return nullptr;
+            }
+            moov = file.read(size - headerSize);
+            break;
+        }
+        position += size;
+    }
+    if (cancel || moov.isEmpty()) {
+        return nullptr;
+    }
+
+    const Span moovSpan{reinterpret_cast<const uchar*>(moov.constData()), moov.size()};
+    quint32 timescale = 0;
+    const Span stbl = findVideoSampleTable(moovSpan, timescale);
+
+    // 패킷 크기 (stsz - 모두 같으면 sample_size 하나)
+    const Span stsz = findChild(stbl, "stsz");
+    if (stsz.size < 12) {
+        return nullptr;
+    }
+    const quint32 uniformSize = readBe32(stsz.data + 4);
+    const quint32 sampleCount = readBe32(stsz.data + 8);
+    if (sampleCount == 0 || sampleCount > kMaxFrames
+        || (uniformSize == 0 && qint64(sampleCount) * 4 > stsz.size - 12)) {
+        return nullptr;
+    }
+
+    // 디코딩 시각 (stts) - 모자라면 마지막 간격으로 채움
+    const uchar* entries = nullptr;
+    const quint32 timeEntries = tableEntries(findChild(stbl, "stts"), 8, entries);
+    if (timeEntries == 0) {
+        return nullptr;
+    }
+    std::vector<qint64> times(sampleCount);
+    qint64 dts = 0;
+    quint32 delta = 0;
+    size_t sample = 0;
+    for (quint32 i = 0; i < timeEntries && sample < sampleCount; ++i) {
+        const quint32 count = readBe32(entries + i * 8);
+        delta = readBe32(entries + i * 8 + 4);
+        for (quint32 j = 0; j < count && sample < sampleCount; ++j) {
+            times[sample++] = dts;
+            dts += delta;
+        }
+    }
+    for (; sample < sampleCount; ++sample) {
+        times[sample] = dts;
+        dts += delta;
+    }
+    if (cancel || dts <= 0) {
+        return nullptr;
+    }
+
+    // 표시 시각 = 디코딩 시각 + 구성 오프셋 (ctts, B 프레임이 있을 때만)
+    std::vector<int> order(sampleCount);
+    std::iota(order.begin(), order.end(), 0);
+    const quint32 offsetEntries = tableEntries(findChild(stbl, "ctts"), 8, entries);
+    if (offsetEntries > 0) {
+        sample = 0;
+        for (quint32 i = 0; i < offsetEntries && sample < sampleCount; ++i) {
+            const quint32 count = readBe32(entries + i * 8);
+            const qint32 offset = qint32(readBe32(entries + i * 8 + 4));
+            for (quint32 j = 0; j < count && sample < sampleCount; ++j) {
+                times[sample++] += offset;
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return times[a] < times[b]; });
+    }
+    if (cancel) {
+        return nullptr;
+    }
+
+    // 키프레임 (stss 1부터 시작, 없으면 모든 샘플이 키프레임 - 인트라 코덱)
+    const quint32 syncEntries = tableEntries(findChild(stbl, "stss"), 4, entries);
+    std::vector<bool> sync(sampleCount, syncEntries == 0);
+    for (quint32 i = 0; i < syncEntries; ++i) {
+        const quint32 number = readBe32(entries + i * 4);
+        if (number >= 1 && number <= sampleCount) {
+            sync[number - 1] = true;
+        }
+    }
+
+    // 표시 순서의 열 배열로 옮김
+    auto index = std::make_shared<Index>();
+    index->fps = double(sampleCount) * timescale / double(dts);
+    index->packetSizes.resize(sampleCount);
+    const uchar* sizes = stsz.data + 12;
+    double total = 0.0;
+    for (quint32 frame = 0; frame < sampleCount; ++frame) {
+        const int source = order[frame];
+        const quint32 packetSize = uniformSize ? uniformSize : readBe32(sizes + source * 4);
+        index->packetSizes[frame] = packetSize;
+        total += packetSize;
+        if (sync[source]) {
+            index->keyframes.push_back(int(frame));
+        }
+    }
+    index->meanPacketSize = total / sampleCount;
+
+    int previous = 0;
+    for (int keyframe : index->keyframes) {
+        index->maxGop = std::max(index->maxGop, keyframe - previous);
+        previous = keyframe;
+    }
+    index->maxGop = std::max(index->maxGop, int(sampleCount) - previous);
+    return index;
+}
+
+void KeyframeMap::publish(const std::shared_ptr<Job>& job, std::shared_ptr<const Index> index)
+{
+    if (job != m_job) {
+        return;
+    }
+    m_job.reset();
+    m_index = std::move(index);
+    setAnalyzing(false);
+    emit mapChanged();
+}
+
+void KeyframeMap::setAnalyzing(bool analyzing)
+{
+    if (m_analyzing != analyzing) {
+        m_analyzing = analyzing;
+        emit analyzingChanged(m_analyzing);
+    }
+}
+
+int KeyframeMap::previousKeyframe(int frame) const
+{
+    if (!m_index) {
+        return -1;
+    }
+    const std::vector<int>& keyframes = m_index->keyframes;
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), frame);
+    return it == keyframes.begin() ? -1 : *(it - 1);
+}
+
+int KeyframeMap::nextKeyframe(int frame) const
+{
+    if (!m_index) {
+        return -1;
+    }
+    const std::vector<int>& keyframes = m_index->keyframes;
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), frame);
+    return it == keyframes.end() ? -1 : *it;
+}
+
+int KeyframeMap::decodeDistance(int frame) const
+{
+    if (!m_index) {
+        return -1;
+    }
+    // 첫 키프레임 앞의 프레임(열린 GOP의 선행 B 프레임)은 처음부터 디코딩
+    const int keyframe = previousKeyframe(frame);
+    return keyframe >= 0 ? frame - keyframe : frame;
+}
+
+QVariantList KeyframeMap::heatmap(int startFrame, int endFrame, int count) const
+{
+    QVariantList result;
+    if (!m_index || count <= 0 || endFrame <= startFrame) {
+        return result;
+    }
+
+    const Index& index = *m_index;
+    const qint64 size = qint64(index.packetSizes.size());
+    const double step = double(endFrame - startFrame) / count;
+    const double hotDistance = index.fps > 0 ? index.fps * kHotDecodeSeconds : std::max(1, index.maxGop);
+    const double fullBitrate = std::max(1.0, index.meanPacketSize * 2.0);
+
+    result.reserve(count * 3);
+    for (int i = 0; i < count; ++i) {
+        const double from = startFrame + i * step;
+        qint64 first = qint64(std::floor(from));
+        qint64 last = std::max(first, qint64(std::ceil(from + step)) - 1);
+        if (last < 0 || first >= size) {
+            result << 0.0 << 0.0 << 0.0;
+            continue;
+        }
+        first = std::max<qint64>(first, 0);
+        last = std::min(last, size - 1);
+
+        // 칸 안에서 앞 키프레임을 따라가며 패킷 크기 합과 가장 먼 디코딩 거리를 구함
+        auto key = std::upper_bound(index.keyframes.begin(), index.keyframes.end(), int(first));
+        int previous = key == index.keyframes.begin() ? 0 : *(key - 1);
+        bool hasKeyframe = previous == first && key != index.keyframes.begin();
+        double bytes = 0.0;
+        qint64 distance = 0;
+        for (qint64 frame = first; frame <= last; ++frame) {
+            if (key != index.keyframes.end() && *key == frame) {
+                previous = *key++;
+                hasKeyframe = true;
+            }
+            bytes += index.packetSizes[frame];
+            distance = std::max(distance, frame - previous);
+        }
+
+        const double mean = bytes / double(last - first + 1);
+        result << std::min(1.0, mean / fullBitrate) << (hasKeyframe ? 1.0 : 0.0)
+               << std::min(1.0, distance / hotDistance);
+    }
+    return result;
+}
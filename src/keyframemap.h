@@ -0,0 +1,89 @@
+#ifndef KEYFRAMEMAP_H
+#define KEYFRAMEMAP_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QVariantList>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class MpvObject;
+
+// 키프레임/패킷 크기 지도 (GOP/비트레이트 히트맵, 드래그 시크 선택)
+// 파일이 열리면 컨테이너 색인(MOV/MP4 샘플 테이블: stss/stsz/stts/ctts)만 읽어
+// 프레임마다 패킷 크기와 키프레임 위치를 만든다. 디코딩하지 않고 미디어 데이터도 읽지 않는다.
+// - 값은 열 단위 배열 (프레임당 패킷 크기 4바이트 + 키프레임 번호 목록) - 표시 순서 기준
+// - 타임라인은 heatmap()으로 화면 폭만큼만 읽음
+// - TimelineSync는 previousKeyframe()/decodeDistance()로 드래그 중 키프레임 시크 여부를 고름
+// - 샘플 테이블이 없는 컨테이너(MKV, MXF, 조각난 MP4 등)는 지도 없음 (ready = false)
+class KeyframeMap : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool ready READ isReady NOTIFY mapChanged)
+    Q_PROPERTY(bool analyzing READ isAnalyzing NOTIFY analyzingChanged)
+    Q_PROPERTY(int frameCount READ frameCount NOTIFY mapChanged)
+    Q_PROPERTY(int keyframeCount READ keyframeCount NOTIFY mapChanged)
+    Q_PROPERTY(double averageGop READ averageGop NOTIFY mapChanged)
+    Q_PROPERTY(int maxGop READ maxGop NOTIFY mapChanged)
+
+public:
+    // 표시 순서로 정렬한 프레임 색인
+    struct Index {
+        double fps = 0.0;
+        std::vector<quint32> packetSizes;
+        // 키프레임 프레임 번호 (오름차순)
+        std::vector<int> keyframes;
+        double meanPacketSize = 0.0;
+        int maxGop = 0;
+    };
+
+    explicit KeyframeMap(MpvObject* player);
+    ~KeyframeMap();
+
+    bool isReady() const { return m_index != nullptr; }
+    bool isAnalyzing() const { return m_analyzing; }
+    int frameCount() const;
+    int keyframeCount() const;
+    double averageGop() const;
+    int maxGop() const { return m_index ? m_index->maxGop : 0; }
+
+    // [start, end) 프레임 구간을 count 칸으로 나눈 [bitrate, keyframe, cost, ...]
+    // bitrate: 칸 평균 패킷 크기 / (파일 평균 x 2) (0..1), keyframe: 칸에 키프레임이 있으면 1,
+    // cost: 칸에서 가장 먼 프레임까지 디코딩할 프레임 수 / 1초 분량 (0..1)
+    Q_INVOKABLE QVariantList heatmap(int startFrame, int endFrame, int count) const;
+
+    // frame 이하 / 초과의 가장 가까운 키프레임 (없으면 -1)
+    Q_INVOKABLE int previousKeyframe(int frame) const;
+    Q_INVOKABLE int nextKeyframe(int frame) const;
+    // frame을 표시하려면 앞 키프레임부터 디코딩해야 하는 프레임 수 (지도가 없으면 -1)
+    Q_INVOKABLE int decodeDistance(int frame) const;
+
+    // 재생 중인 파일 색인 (fileLoaded에서 호출)
+    void analyzeCurrentFile();
+
+signals:
+    void analyzingChanged(bool analyzing);
+    void mapChanged();
+
+private:
+    struct Job {
+        QString path;
+        std::atomic_bool cancel{false};
+    };
+
+    void run(const std::shared_ptr<Job>& job);
+    void publish(const std::shared_ptr<Job>& job, std::shared_ptr<const Index> index);
+    void cancelJob();
+    void setAnalyzing(bool analyzing);
+
+    static std::shared_ptr<Index> readSampleTables(const QString& path, const std::atomic_bool& cancel);
+
+    MpvObject* m_player;
+    QThreadPool m_pool;
+    bool m_analyzing = false;
+    std::shared_ptr<Job> m_job;
+    std::shared_ptr<const Index> m_index;
+};
+
+#endif // KEYFRAMEMAP_H
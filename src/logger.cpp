@@ -0,0 +1,297 @@
+#include "logger.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+
+Q_LOGGING_CATEGORY(lcMpv, "player.mpv")
+Q_LOGGING_CATEGORY(lcMpvCommand, "player.mpv.command")
+Q_LOGGING_CATEGORY(lcFrameCount, "player.mpv.framecount")
+Q_LOGGING_CATEGORY(lcSync, "player.sync")
+
+namespace {
+
+// QtMsgType을 심각도 순으로 변환 (QtInfoMsg 값이 QtFatalMsg보다 크기 때문에 직접 비교 불가)
+int severity(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return 0;
+    case QtInfoMsg: return 1;
+    case QtWarningMsg: return 2;
+    case QtCriticalMsg: return 3;
+    case QtFatalMsg: return 4;
+    }
+    return 0;
+}
+
+const char* typeLabel(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "Debug";
+    case QtInfoMsg: return "Info";
+    case QtWarningMsg: return "Warning";
+    case QtCriticalMsg: return "Critical";
+    case QtFatalMsg: return "Fatal";
+    }
+    return "Debug";
+}
+
+// 고정 크기 버퍼에 문자열 복사 (잘린 경우에도 NUL 종료 보장)
+int copyTruncated(char* dest, int capacity, const char* src, int length)
+{
+    if (!src || length <= 0) {
+        dest[0] = '\0';
+        return 0;
+    }
+    const int count = qMin(length, capacity - 1);
+    std::memcpy(dest, src, count);
+    dest[count] = '\0';
+    return count;
+}
+
+qint64 nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+AsyncLogger& AsyncLogger::instance()
+{
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger()
+    : m_slots(new Slot[kCapacity])
+{
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+    for (size_t i = 0; i < kCapacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stop();
+}
+
+void AsyncLogger::start(const QString& logPath)
+{
+    if (m_running.load()) {
+        return;
+    }
+
+    m_file = new QFile(logPath);
+    if (!m_file->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        fprintf(stderr, "Failed to open log file: %s\n", qPrintable(logPath));
+        delete m_file;
+        m_file = nullptr;
+    }
+
+    m_running.store(true);
+    m_writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+void AsyncLogger::stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.notify_one();
+    }
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+
+    delete m_file;
+    m_file = nullptr;
+}
+
+void AsyncLogger::setMinimumLevel(QtMsgType type)
+{
+    m_minimumLevel.store(severity(type), std::memory_order_relaxed);
+}
+
+void AsyncLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    AsyncLogger& logger = instance();
+
+    if (!logger.m_running.load(std::memory_order_relaxed)) {
+        // 기록 스레드가 없으면 콘솔로만 출력
+        fprintf(stderr, "%s: %s\n", typeLabel(type), qPrintable(msg));
+    } else {
+        logger.enqueue(type, context, msg);
+    }
+
+    if (type == QtFatalMsg) {
+        // 종료 전에 남은 메시지를 모두 기록
+        logger.stop();
+        std::abort();
+    }
+}
+
+void AsyncLogger::enqueue(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    if (severity(type) < m_minimumLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const QByteArray utf8 = msg.toUtf8();
+    const qint64 timestamp = nowMs();
+
+    // 반복 메시지 억제 - 경합 시 가끔 중복 기록될 수 있지만 정확성보다 속도 우선
+    const size_t hash = std::hash<std::string_view>()(std::string_view(utf8.constData(), utf8.size())) ^ size_t(type);
+    quint32 repeats = 0;
+    if (type != QtFatalMsg && hash == m_lastHash.load(std::memory_order_relaxed)
+        && timestamp - m_lastWrittenMs.load(std::memory_order_relaxed) < kRepeatWindowMs) {
+        m_repeatCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    repeats = m_repeatCount.exchange(0, std::memory_order_relaxed);
+    m_lastHash.store(hash, std::memory_order_relaxed);
+    m_lastWrittenMs.store(timestamp, std::memory_order_relaxed);
+
+    // 슬롯 확보 (Vyukov 방식 bounded queue)
+    Slot* slot = nullptr;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& candidate = m_slots[pos & (kCapacity - 1)];
+        const size_t sequence = candidate.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot = &candidate;
+                break;
+            }
+        } else if (diff < 0) {
+            // 버퍼가 가득 참 - 호출 스레드를 막지 않고 버림
+            m_dropped.fetch_add(1 + repeats, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    Entry& entry = slot->entry;
+    entry.timestampMs = timestamp;
+    entry.type = type;
+    entry.line = context.line;
+    entry.previousRepeats = repeats;
+    entry.messageLength = copyTruncated(entry.message, kMaxMessageBytes, utf8.constData(), utf8.size());
+    copyTruncated(entry.file, kMaxLocationBytes, context.file, context.file ? int(std::strlen(context.file)) : 0);
+    copyTruncated(entry.function, kMaxLocationBytes, context.function, context.function ? int(std::strlen(context.function)) : 0);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // 기록 스레드가 대기 중일 때만 깨움 (매 메시지마다 시스템 콜 방지)
+    if (m_writerSleeping.load(std::memory_order_acquire) || severity(type) >= severity(QtCriticalMsg)) {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.notify_one();
+    }
+}
+
+bool AsyncLogger::tryPop(Entry& out)
+{
+    Slot& slot = m_slots[m_dequeuePos & (kCapacity - 1)];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != m_dequeuePos + 1) {
+        return false;
+    }
+
+    out = slot.entry;
+    slot.sequence.store(m_dequeuePos + kCapacity, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+void AsyncLogger::appendEntry(QByteArray& batch, const Entry& entry)
+{
+    const QByteArray timestamp = QDateTime::fromMSecsSinceEpoch(entry.timestampMs)
+                                     .toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8();
+
+    if (entry.previousRepeats > 0) {
+        batch += timestamp;
+        batch += "Info: last message repeated ";
+        batch += QByteArray::number(entry.previousRepeats);
+        batch += " times\n";
+    }
+
+    batch += timestamp;
+    batch += typeLabel(entry.type);
+    batch += ": ";
+    batch.append(entry.message, entry.messageLength);
+    batch += " (";
+    batch += entry.file;
+    batch += ':';
+    batch += QByteArray::number(entry.line);
+    batch += ", ";
+    batch += entry.function;
+    batch += ")\n";
+}
+
+void AsyncLogger::drain(QByteArray& batch)
+{
+    Entry entry;
+    while (tryPop(entry)) {
+        appendEntry(batch, entry);
+    }
+
+    const quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDrops) {
+        batch += QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8();
+        batch += "Warning: log buffer full, dropped ";
+        batch += QByteArray::number(dropped - m_reportedDrops);
+        batch += " messages\n";
+        m_reportedDrops = dropped;
+    }
+}
+
+void AsyncLogger::writerLoop()
+{
+    QByteArray batch;
+    batch.reserve(64 * 1024);
+
+    for (;;) {
+        const bool running = m_running.load();
+
+        batch.clear();
+        drain(batch);
+
+        if (!batch.isEmpty()) {
+            // 모아둔 메시지를 한 번에 기록
+            if (m_file) {
+                m_file->write(batch);
+                m_file->flush();
+            }
+            fwrite(batch.constData(), 1, size_t(batch.size()), stderr);
+            fflush(stderr);
+            continue;
+        }
+
+        if (!running) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerSleeping.store(true, std::memory_order_release);
+        m_wakeCondition.wait_for(lock, std::chrono::milliseconds(100));
+        m_writerSleeping.store(false, std::memory_order_release);
+    }
+
+    // 억제 중이던 반복 횟수 기록
+    const quint32 repeats = m_repeatCount.exchange(0);
+    if (repeats > 0 && m_file) {
+        m_file->write(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8()
+                      + "Info: last message repeated " + QByteArray::number(repeats) + " times\n");
+        m_file->flush();
+    }
+}
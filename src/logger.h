@@ -0,0 +1,104 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QLoggingCategory>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 플레이어 로깅 카테고리 - 런타임에는 QT_LOGGING_RULES / PLAYER_LOG_RULES로 필터링
+Q_DECLARE_LOGGING_CATEGORY(lcMpv)
+Q_DECLARE_LOGGING_CATEGORY(lcMpvCommand)
+Q_DECLARE_LOGGING_CATEGORY(lcFrameCount)
+Q_DECLARE_LOGGING_CATEGORY(lcSync)
+
+// 고빈도 경로(시크, 프레임 카운트 등)용 로그 매크로
+// PLAYER_LOG_VERBOSE가 정의되지 않은 빌드에서는 호출 자체가 컴파일되지 않는다
+#ifdef PLAYER_LOG_VERBOSE
+#define hpVerbose(category) qCDebug(category)
+#else
+#define hpVerbose(category) while (false) qCDebug(category)
+#endif
+
+// 비동기 로그 백엔드
+// 메시지는 락프리 링 버퍼에 기록되고, 백그라운드 스레드가 모아서 파일과 stderr에 한 번에 쓴다.
+// 버퍼가 가득 차면 메시지를 버리고 개수만 기록하며, 같은 메시지가 반복되면 일정 간격으로만 남긴다.
+class AsyncLogger
+{
+public:
+    static AsyncLogger& instance();
+
+    // 로그 파일을 열고 기록 스레드 시작
+    void start(const QString& logPath);
+    // 남은 메시지를 모두 기록하고 스레드 종료
+    void stop();
+
+    // 최소 기록 레벨 (런타임 변경 가능)
+    void setMinimumLevel(QtMsgType type);
+
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // qInstallMessageHandler()에 등록하는 핸들러
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    static constexpr size_t kCapacity = 2048;        // 2의 거듭제곱이어야 함
+    static constexpr int kMaxMessageBytes = 448;
+    static constexpr int kMaxLocationBytes = 96;
+    static constexpr qint64 kRepeatWindowMs = 1000;  // 같은 메시지는 이 간격에 한 번만 기록
+
+    struct Entry {
+        qint64 timestampMs = 0;
+        QtMsgType type = QtDebugMsg;
+        int line = 0;
+        quint32 previousRepeats = 0;
+        int messageLength = 0;
+        char message[kMaxMessageBytes];
+        char file[kMaxLocationBytes];
+        char function[kMaxLocationBytes];
+    };
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Entry entry;
+    };
+
+    void enqueue(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+    bool tryPop(Entry& out);
+    void writerLoop();
+    void drain(QByteArray& batch);
+    static void appendEntry(QByteArray& batch, const Entry& entry);
+
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;
+
+    std::atomic<quint64> m_dropped{0};
+    quint64 m_reportedDrops = 0;
+    std::atomic<int> m_minimumLevel{QtDebugMsg};
+
+    // 반복 메시지 억제 상태
+    std::atomic<size_t> m_lastHash{0};
+    std::atomic<qint64> m_lastWrittenMs{0};
+    std::atomic<quint32> m_repeatCount{0};
+
+    // 기록 스레드
+    std::thread m_writer;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_writerSleeping{false};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    class QFile* m_file = nullptr;
+};
+
+#endif // LOGGER_H
@@ -0,0 +1,165 @@
+#include "looprange.h"
+#include "mpvobject.h"
+#include "demuxcachemanager.h"
+#include "logger.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// A/B를 프레임 경계 사이에 두는 비율 (타임스탬프 반올림 오차에 영향받지 않게)
+constexpr double kBoundaryOffset = 0.5;
+
+// 되감기 간격 평균에 쓰는 표본 수
+constexpr int kMaxWrapSamples = 120;
+
+} // namespace
+
+LoopRange::LoopRange(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    connect(player, &MpvObject::positionChanged, this, &LoopRange::onPositionChanged);
+    // 구간은 파일마다 따로 (새 파일에서는 해제), fps가 바뀌면 초 단위 A/B를 다시 계산
+    connect(player, &MpvObject::fileLoaded, this, &LoopRange::clear);
+    connect(player, &MpvObject::fpsChanged, this, &LoopRange::apply);
+}
+
+void LoopRange::setInFrame(int frame)
+{
+    frame = std::max(-1, frame);
+    if (m_inFrame == frame) {
+        return;
+    }
+    m_inFrame = frame;
+    emit rangeChanged();
+    apply();
+}
+
+void LoopRange::setOutFrame(int frame)
+{
+    frame = std::max(-1, frame);
+    if (m_outFrame == frame) {
+        return;
+    }
+    m_outFrame = frame;
+    emit rangeChanged();
+    apply();
+}
+
+void LoopRange::markIn()
+{
+    const int frame = currentFrame();
+    // 아웃보다 뒤에 인을 찍으면 아웃 해제
+    if (m_outFrame >= 0 && frame >= m_outFrame) {
+        m_outFrame = -1;
+    }
+    m_inFrame = frame;
+    emit rangeChanged();
+    apply();
+}
+
+void LoopRange::markOut()
+{
+    const int frame = currentFrame();
+    // 인보다 앞에 아웃을 찍으면 인 해제
+    if (m_inFrame >= 0 && frame <= m_inFrame) {
+        m_inFrame = -1;
+    }
+    m_outFrame = frame;
+    emit rangeChanged();
+    apply();
+}
+
+void LoopRange::clear()
+{
+    if (m_inFrame < 0 && m_outFrame < 0) {
+        return;
+    }
+    m_inFrame = -1;
+    m_outFrame = -1;
+    emit rangeChanged();
+    apply();
+}
+
+double LoopRange::averageWrapMs() const
+{
+    if (m_wrapSamples.isEmpty()) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (double sample : m_wrapSamples) {
+        total += sample;
+    }
+    return total / m_wrapSamples.size();
+}
+
+int LoopRange::currentFrame() const
+{
+    const double fps = m_player->fps();
+    return fps > 0 ? int(std::lround(m_player->position() * fps)) : 0;
+}
+
+void LoopRange::apply()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return;
+    }
+
+    const double fps = m_player->fps();
+    auto* cache = qobject_cast<DemuxCacheManager*>(m_player->cacheManager());
+
+    if (!isActive() || fps <= 0) {
+        mpv_set_property_string(mpv, "ab-loop-a", "no");
+        mpv_set_property_string(mpv, "ab-loop-b", "no");
+        if (cache) {
+            cache->setMinimumBackwardSeconds(0.0);
+        }
+        return;
+    }
+
+    // A는 인 프레임 반 프레임 앞 (정확한 시크가 인 프레임부터 표시), B는 아웃 프레임 반 프레임 뒤
+    double a = std::max(0.0, (m_inFrame - kBoundaryOffset) / fps);
+    double b = (m_outFrame + kBoundaryOffset) / fps;
+    mpv_set_property(mpv, "ab-loop-a", MPV_FORMAT_DOUBLE, &a);
+    mpv_set_property(mpv, "ab-loop-b", MPV_FORMAT_DOUBLE, &b);
+    mpv_set_property_string(mpv, "ab-loop-count", "inf");
+
+    // 구간 전체를 뒤쪽 캐시에 유지 - 되감을 때 인 프레임 앞 키프레임을 메모리에서 바로 읽음
+    if (cache) {
+        cache->setMinimumBackwardSeconds(b - a);
+    }
+
+    m_lastFrame = -1;
+    qDebug() << "LoopRange: frames" << m_inFrame << "-" << m_outFrame << "(ab-loop" << a << "-" << b << ")";
+}
+
+void LoopRange::onPositionChanged(double position)
+{
+    const double fps = m_player->fps();
+    if (!isActive() || fps <= 0 || m_player->isPaused()) {
+        m_lastFrame = -1;
+        return;
+    }
+
+    const int frame = int(std::lround(position * fps));
+    const double elapsedMs = m_frameClock.isValid() ? m_frameClock.nsecsElapsed() / 1e6 : 0.0;
+    m_frameClock.restart();
+
+    // 아웃 프레임 부근에서 인 프레임 쪽으로 뒤돌아가면 되감기 한 번
+    if (m_lastFrame >= m_outFrame - 1 && frame < m_lastFrame && frame <= m_inFrame + 1) {
+        m_wrapCount++;
+        m_lastWrapMs = elapsedMs;
+        m_lastWrapFrameError = frame - m_inFrame;
+        m_wrapSamples.append(elapsedMs);
+        if (m_wrapSamples.size() > kMaxWrapSamples) {
+            m_wrapSamples.removeFirst();
+        }
+        hpVerbose(lcMpvCommand) << "Loop wrap" << m_lastWrapMs << "ms (frame interval" << 1000.0 / fps
+                                << "ms), landed on frame" << frame << "error" << m_lastWrapFrameError;
+        emit wrapMeasured();
+    }
+    m_lastFrame = frame;
+}
@@ -0,0 +1,73 @@
+#ifndef LOOPRANGE_H
+#define LOOPRANGE_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVector>
+
+class MpvObject;
+
+// 인/아웃 프레임 구간 반복 (MPV A-B 루프)
+// EOF 이벤트와 타이머로 처음으로 되돌리지 않고 MPV가 재생 루프 안에서 직접 A로 시크한다.
+// - A/B는 프레임 경계 사이(반 프레임 앞/뒤)에 두어 인 프레임부터 아웃 프레임까지 정확히 한 번씩 표시
+// - B 이후 프레임은 MPV가 표시 전에 잘라내므로 아웃 프레임 뒤가 잠깐 보이지 않음
+// - 구간 전체가 디먹서 뒤쪽 캐시에 남도록 캐시 크기를 늘려 되감기 때 디스크를 읽지 않음
+// - 되감기 간격(마지막 프레임 ~ 인 프레임 표시)과 도착 프레임 오차를 측정
+class LoopRange : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int inFrame READ inFrame WRITE setInFrame NOTIFY rangeChanged)
+    Q_PROPERTY(int outFrame READ outFrame WRITE setOutFrame NOTIFY rangeChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY rangeChanged)
+    Q_PROPERTY(int wrapCount READ wrapCount NOTIFY wrapMeasured)
+    Q_PROPERTY(double lastWrapMs READ lastWrapMs NOTIFY wrapMeasured)
+    Q_PROPERTY(double averageWrapMs READ averageWrapMs NOTIFY wrapMeasured)
+    Q_PROPERTY(int lastWrapFrameError READ lastWrapFrameError NOTIFY wrapMeasured)
+
+public:
+    explicit LoopRange(MpvObject* player);
+
+    // 프레임 번호 (내부 0-기반, 설정 안 됨 = -1)
+    int inFrame() const { return m_inFrame; }
+    void setInFrame(int frame);
+    int outFrame() const { return m_outFrame; }
+    void setOutFrame(int frame);
+
+    // 인/아웃이 모두 있고 인 < 아웃일 때만 반복
+    bool isActive() const { return m_inFrame >= 0 && m_outFrame > m_inFrame; }
+
+    int wrapCount() const { return m_wrapCount; }
+    double lastWrapMs() const { return m_lastWrapMs; }
+    double averageWrapMs() const;
+    // 되감은 뒤 처음 표시된 프레임 - 인 프레임 (0이면 정확)
+    int lastWrapFrameError() const { return m_lastWrapFrameError; }
+
+public slots:
+    // 현재 위치를 인/아웃으로
+    void markIn();
+    void markOut();
+    void clear();
+
+signals:
+    void rangeChanged();
+    void wrapMeasured();
+
+private:
+    void apply();
+    void onPositionChanged(double position);
+    int currentFrame() const;
+
+    MpvObject* m_player = nullptr;
+    int m_inFrame = -1;
+    int m_outFrame = -1;
+
+    // 되감기 측정 (직전 위치 갱신 시각/프레임)
+    QElapsedTimer m_frameClock;
+    int m_lastFrame = -1;
+    int m_wrapCount = 0;
+    double m_lastWrapMs = 0.0;
+    int m_lastWrapFrameError = 0;
+    QVector<double> m_wrapSamples;
+};
+
+#endif // LOOPRANGE_H
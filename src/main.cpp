@@ -19,6 +19,7 @@
 #include <QIcon>
 #include <QFileInfo>
 #include <QCoreApplication>
+#include <cstdio>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -32,9 +33,21 @@
 #ifdef HAVE_MPV
 #include "mpvobject.h"
 #include "timelinesync.h"
+#include "frameexporter.h"
+#include "mpvwarmup.h"
+#include "playlistmodel.h"
+#include "decodertuner.h"
+#include "comparecontroller.h"
+#include "reviewsession.h"
+#include "controlserver.h"
 #endif
 
 #include "splash.h"
+#include "logger.h"
+#include "tracing.h"
+#include "startuptimeline.h"
+#include "singleinstance.h"
+#include "timelineitem.h"
 
 #ifdef _WIN32
 // 윈도우 파일 연결 등록 함수
@@ -235,45 +248,10 @@ void requestCloseSplash() {
     }
 }
 
-// 메시지 핸들러 함수
-void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
-{
-    // Open log file
-    QString logPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/hyper-player-log.txt";
-    QFile logFile(logPath);
-    if (logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
-        
-        // Format message
-        QString txt;
-        switch (type) {
-        case QtDebugMsg:
-            txt = QString("Debug: %1").arg(msg);
-            break;
-        case QtInfoMsg:
-            txt = QString("Info: %1").arg(msg);
-            break;
-        case QtWarningMsg:
-            txt = QString("Warning: %1").arg(msg);
-            break;
-        case QtCriticalMsg:
-            txt = QString("Critical: %1").arg(msg);
-            break;
-        case QtFatalMsg:
-            txt = QString("Fatal: %1").arg(msg);
-            break;
-        }
-        
-        // Add timestamp and write to file
-        QTextStream out(&logFile);
-        out << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz ") << txt << " (" << context.file << ":" << context.line << ", " << context.function << ")" << Qt::endl;
-        
-        // Also output to console
-        fprintf(stderr, "%s\n", qPrintable(txt));
-    }
-}
-
 int main(int argc, char *argv[])
 {
+    StartupTimeline::mark("main");
+    
 #ifdef _WIN32
     // Windows에서 콘솔 창 유지
     if (AllocConsole()) {
@@ -294,11 +272,50 @@ int main(int argc, char *argv[])
     // High-DPI scaling is automatically enabled in Qt 6
 
     QApplication app(argc, argv);
+
+    // 비동기 로그 백엔드 시작 (파일 기록은 별도 스레드에서 처리)
+    AsyncLogger::instance().start(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+                                  + "/hyper-player-log.txt");
+    qInstallMessageHandler(AsyncLogger::messageHandler);
     
     // 명령줄 인수 처리 - 비디오 파일 경로 확인
     QString videoFilePath;
     QStringList args = QCoreApplication::arguments(); // argc/argv 변경 문제 방지
     
+    // --startup-benchmark: 첫 화면(파일 지정 시 첫 비디오 프레임)까지의 시작 타임라인을 JSON으로 출력하고 종료
+    const bool startupBenchmark = args.removeAll("--startup-benchmark") > 0;
+    // --tune-decoders: 시작하면서 디코더 튜닝 측정 실행 (자동으로는 실행하지 않음)
+    const bool tuneDecoders = args.removeAll("--tune-decoders") > 0;
+    // --review-host[=포트] / --review-join=주소[:포트]: 동기 리뷰 세션 진행/참가
+    int reviewHostPort = 0;
+    QString reviewJoinAddress;
+    for (int i = args.size() - 1; i > 0; --i) {
+        const QString& arg = args[i];
+        if (arg == "--review-host" || arg.startsWith("--review-host=")) {
+            reviewHostPort = arg.contains('=') ? arg.section('=', 1).toInt() : 47800;
+            args.removeAt(i);
+        } else if (arg.startsWith("--review-join=")) {
+            reviewJoinAddress = arg.section('=', 1);
+            args.removeAt(i);
+        }
+    }
+    const bool reviewSessionRequested = reviewHostPort > 0 || !reviewJoinAddress.isEmpty();
+    
+    // --control-server[=이름]: 자동화용 로컬 제어 서버 (CONTROL_API.md)
+    bool controlServerRequested = false;
+    QString controlServerName;
+    for (int i = args.size() - 1; i > 0; --i) {
+        if (args[i] == "--control-server" || args[i].startsWith("--control-server=")) {
+            controlServerRequested = true;
+            controlServerName = args[i].section('=', 1);
+            args.removeAt(i);
+        }
+    }
+    
+    // --new-instance: 실행 중인 플레이어가 있어도 새 창으로 실행
+    // (리뷰 세션은 한 PC에서 여러 개 테스트할 수 있게, 제어 서버는 자동화가 다른 창을 조작하지 않게 항상 새 창)
+    const bool forceNewInstance = args.removeAll("--new-instance") > 0 || reviewSessionRequested || controlServerRequested;
+    
     qDebug() << "Application arguments count:" << args.size();
     qDebug() << "Command line arguments:" << args;
     
@@ -347,6 +364,35 @@ int main(int argc, char *argv[])
         qDebug() << "No command line arguments provided (normal startup)";
     }
     
+    // 단일 인스턴스 - 이미 실행 중인 플레이어가 있으면 파일을 넘기고 바로 종료
+    SingleInstance* singleInstance = nullptr;
+    if (!forceNewInstance && !startupBenchmark) {
+        const QStringList forwardFiles = videoFilePath.isEmpty() ? QStringList() : QStringList{videoFilePath};
+        if (SingleInstance::forwardToPrimary(forwardFiles)) {
+            AsyncLogger::instance().stop();
+            return 0;
+        }
+        
+        singleInstance = new SingleInstance(&app);
+        if (!singleInstance->listen()) {
+            // 동시에 실행된 다른 프로세스가 먼저 주 인스턴스가 된 경우 한 번 더 전달 시도
+            if (SingleInstance::forwardToPrimary(forwardFiles)) {
+                AsyncLogger::instance().stop();
+                return 0;
+            }
+            // 응답이 없으면 독립 실행
+            qWarning() << "Primary instance not responding, starting standalone";
+            delete singleInstance;
+            singleInstance = nullptr;
+        }
+    }
+    
+#ifdef HAVE_MPV
+    // QML을 불러오는 동안 MPV 생성/초기화와 시작 파일 열기를 백그라운드에서 진행
+    // MpvObject가 생성되면 이 핸들을 넘겨받고, QML이 같은 파일을 열면 재생 목록이 다시 열지 않는다
+    MpvWarmup::start(videoFilePath);
+#endif
+    
     // 애플리케이션 아이콘 설정 (실행파일 및 창 아이콘)
     QString iconPath;
     QDir currentDir(QDir::currentPath());
@@ -532,11 +578,18 @@ int main(int argc, char *argv[])
     splash.setVersionText(getApplicationVersion());
     
     qDebug() << "=== QT SPLASH SCREEN CREATED ===";
+    StartupTimeline::mark("splash shown");
     
     app.processEvents(); // 스플래시가 즉시 그려지도록
     
     // 디버그 모드 활성화
-    QLoggingCategory::setFilterRules("qt.qml.binding.removal.info=true");
+    // PLAYER_LOG_RULES 환경 변수로 카테고리별 필터 추가 (예: "player.mpv.command.debug=false")
+    QString logRules = "qt.qml.binding.removal.info=true";
+    const QByteArray extraLogRules = qgetenv("PLAYER_LOG_RULES");
+    if (!extraLogRules.isEmpty()) {
+        logRules += "\n" + QString::fromLocal8Bit(extraLogRules).replace(';', '\n');
+    }
+    QLoggingCategory::setFilterRules(logRules);
     
     // 앱 정보 설정
     app.setApplicationName("Player by HEIMLICH®");
@@ -554,6 +607,9 @@ int main(int argc, char *argv[])
     // QML 엔진 초기화
     QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
     
+    // 타임라인 눈금/구간/파형 (씬 그래프)
+    qmlRegisterType<TimelineItem>("app.timeline", 1, 0, "TimelineItem");
+    
 #ifdef HAVE_MPV
     // MPV 객체 등록 (QtQuick에서 사용 가능하도록)
     qmlRegisterType<MpvObject>("mpv", 1, 0, "MpvObject");
@@ -561,73 +617,108 @@ int main(int argc, char *argv[])
     // TimelineSync 객체 생성 및 등록
     TimelineSync* timelineSync = new TimelineSync();
     qmlRegisterType<TimelineSync>("app.sync", 1, 0, "TimelineSync");
+    
+    // 재생 목록 (다음 항목 메타데이터 미리 분석)
+    PlaylistModel* playlistModel = new PlaylistModel(&app);
+    
+    // 코덱별 디코더 스레드/hwdec 자동 튜닝
+    DecoderTuner* decoderTuner = new DecoderTuner(&app);
+    
+    // 여러 PC 동기 리뷰 세션
+    ReviewSession* reviewSession = new ReviewSession(&app);
+    
+    // 자동화용 로컬 제어 서버 (요청한 경우에만)
+    ControlServer* controlServer = controlServerRequested ? new ControlServer(&app) : nullptr;
+    
+    // 프레임 구간 병렬 내보내기
+    qmlRegisterType<FrameExporter>("app.export", 1, 0, "FrameExporter");
+    
+    // 여러 클립 프레임 잠금 비교
+    qmlRegisterType<CompareController>("app.compare", 1, 0, "CompareController");
 #endif
     
     // QML 모듈 등록 및 기본 속성 설정
     QQmlApplicationEngine engine;
     
-    // QML 파일 경로 설정 - 애플리케이션 실행 파일 기준으로 설정
+    // QML 로드 위치 결정
+    // 기본은 빌드 시 qmlcachegen으로 사전 컴파일된 QML 모듈(qrc:/qml)을 사용하므로 디스크 탐색이 필요 없다.
+    // PLAYER_QML_DIR=<qml 폴더>를 지정하면 디스크의 QML을 직접 불러온다 (재빌드 없이 QML 수정 확인용).
     QString qmlRootPath;
+    QUrl mainWindowUrl;
     QString appDir = QCoreApplication::applicationDirPath();
+    const QString qmlDirOverride = qEnvironmentVariable("PLAYER_QML_DIR");
+    
+    if (qmlDirOverride.isEmpty() && QFile::exists(":/qml/core/MainWindow.qml")) {
+        qmlRootPath = ":/qml";
+        mainWindowUrl = QUrl("qrc:/qml/core/MainWindow.qml");
+        engine.addImportPath("qrc:/");
+        qDebug() << "Using precompiled QML module:" << mainWindowUrl;
+    } else if (!qmlDirOverride.isEmpty()) {
+        qmlRootPath = QDir(qmlDirOverride).absolutePath();
+        mainWindowUrl = QUrl::fromLocalFile(qmlRootPath + "/core/MainWindow.qml");
+        engine.addImportPath(qmlRootPath);
+        qDebug() << "Using QML directory override:" << qmlRootPath;
+    } else {
+        qDebug() << "Application directory:" << appDir;
+        qDebug() << "Current working directory:" << QDir::currentPath();
     
-    qDebug() << "Application directory:" << appDir;
-    qDebug() << "Current working directory:" << QDir::currentPath();
-    
-    // 1. 설치된 환경: 애플리케이션 실행 파일과 같은 디렉토리의 qml 폴더
-    if (QDir(appDir + "/qml").exists() && QFile::exists(appDir + "/qml/core/MainWindow.qml")) {
-        qmlRootPath = appDir + "/qml";
-        qDebug() << "Using installed QML path (app dir):" << qmlRootPath;
-    }
-    // 2. 개발 환경: 프로젝트 디렉토리의 qml 폴더
-    else if (currentDir.exists("qml/core/MainWindow.qml")) {
-        qmlRootPath = currentDir.absoluteFilePath("qml");
-        qDebug() << "Using development QML path (current dir):" << qmlRootPath;
-    } 
-    // 3. 빌드 환경: build/qml 폴더
-    else if (currentDir.exists("build/qml/core/MainWindow.qml")) {
-        qmlRootPath = currentDir.absoluteFilePath("build/qml");
-        qDebug() << "Using build QML path:" << qmlRootPath;
-    }
-    // 4. 대체 경로: 애플리케이션 디렉토리 기준으로 한 번 더 시도
-    else if (QDir(appDir + "/../qml").exists()) {
-        qmlRootPath = QDir(appDir + "/../qml").absolutePath();
-        qDebug() << "Using alternative QML path:" << qmlRootPath;
-    }
-    // 5. 최후 수단: 현재 디렉토리의 qml 폴더 (없어도 설정)
-    else {
-        qmlRootPath = currentDir.absoluteFilePath("qml");
-        qDebug() << "Using fallback QML path:" << qmlRootPath;
-    }
+        // 1. 설치된 환경: 애플리케이션 실행 파일과 같은 디렉토리의 qml 폴더
+        if (QDir(appDir + "/qml").exists() && QFile::exists(appDir + "/qml/core/MainWindow.qml")) {
+            qmlRootPath = appDir + "/qml";
+            qDebug() << "Using installed QML path (app dir):" << qmlRootPath;
+        }
+        // 2. 개발 환경: 프로젝트 디렉토리의 qml 폴더
+        else if (currentDir.exists("qml/core/MainWindow.qml")) {
+            qmlRootPath = currentDir.absoluteFilePath("qml");
+            qDebug() << "Using development QML path (current dir):" << qmlRootPath;
+        } 
+        // 3. 빌드 환경: build/qml 폴더
+        else if (currentDir.exists("build/qml/core/MainWindow.qml")) {
+            qmlRootPath = currentDir.absoluteFilePath("build/qml");
+            qDebug() << "Using build QML path:" << qmlRootPath;
+        }
+        // 4. 대체 경로: 애플리케이션 디렉토리 기준으로 한 번 더 시도
+        else if (QDir(appDir + "/../qml").exists()) {
+            qmlRootPath = QDir(appDir + "/../qml").absolutePath();
+            qDebug() << "Using alternative QML path:" << qmlRootPath;
+        }
+        // 5. 최후 수단: 현재 디렉토리의 qml 폴더 (없어도 설정)
+        else {
+            qmlRootPath = currentDir.absoluteFilePath("qml");
+            qDebug() << "Using fallback QML path:" << qmlRootPath;
+        }
     
-    qDebug() << "Final QML root path:" << qmlRootPath;
+        qDebug() << "Final QML root path:" << qmlRootPath;
     
-    // QML 파일이 실제로 존재하는지 확인
-    QString mainWindowQml = qmlRootPath + "/core/MainWindow.qml";
-    if (!QFile::exists(mainWindowQml)) {
-        qDebug() << "ERROR: MainWindow.qml not found at:" << mainWindowQml;
-        qDebug() << "Trying to find QML files in other locations...";
+        // QML 파일이 실제로 존재하는지 확인
+        QString mainWindowQml = qmlRootPath + "/core/MainWindow.qml";
+        if (!QFile::exists(mainWindowQml)) {
+            qDebug() << "ERROR: MainWindow.qml not found at:" << mainWindowQml;
+            qDebug() << "Trying to find QML files in other locations...";
         
-        // 추가 검색 경로들
-        QStringList searchPaths = {
-            appDir + "/qml/core/MainWindow.qml",
-            appDir + "/../qml/core/MainWindow.qml", 
-            currentDir.absoluteFilePath("qml/core/MainWindow.qml"),
-            currentDir.absoluteFilePath("build/qml/core/MainWindow.qml")
-        };
+            // 추가 검색 경로들
+            QStringList searchPaths = {
+                appDir + "/qml/core/MainWindow.qml",
+                appDir + "/../qml/core/MainWindow.qml", 
+                currentDir.absoluteFilePath("qml/core/MainWindow.qml"),
+                currentDir.absoluteFilePath("build/qml/core/MainWindow.qml")
+            };
         
-        for (const QString& path : searchPaths) {
-            if (QFile::exists(path)) {
-                qmlRootPath = QFileInfo(path).absolutePath();
-                qmlRootPath.remove("/core"); // /core 부분 제거하여 루트 경로 얻기
-                qDebug() << "Found QML files at:" << qmlRootPath;
-                break;
+            for (const QString& path : searchPaths) {
+                if (QFile::exists(path)) {
+                    qmlRootPath = QFileInfo(path).absolutePath();
+                    qmlRootPath.remove("/core"); // /core 부분 제거하여 루트 경로 얻기
+                    qDebug() << "Found QML files at:" << qmlRootPath;
+                    break;
+                }
             }
         }
-    }
     
-    // Import 경로 추가 - 애플리케이션 디렉토리 기준
-    engine.addImportPath(qmlRootPath);
-    engine.addImportPath(appDir + "/qml");  // 추가 안전장치
+        // Import 경로 추가 - 애플리케이션 디렉토리 기준
+        engine.addImportPath(qmlRootPath);
+        engine.addImportPath(appDir + "/qml");  // 추가 안전장치
+        mainWindowUrl = QUrl::fromLocalFile(qmlRootPath + "/core/MainWindow.qml");
+    }
     
     // 작업 디렉토리를 QML 디렉토리로 변경하지 않음 (영상 파일 경로 문제 방지)
     // QDir::setCurrent(qmlRootPath); // 이 줄 제거!
@@ -636,10 +727,23 @@ int main(int argc, char *argv[])
 #ifdef HAVE_MPV
     engine.rootContext()->setContextProperty("hasMpvSupport", true);
     engine.rootContext()->setContextProperty("timelineSync", timelineSync);
+    engine.rootContext()->setContextProperty("playlistModel", playlistModel);
+    engine.rootContext()->setContextProperty("decoderTuner", decoderTuner);
+    engine.rootContext()->setContextProperty("reviewSession", reviewSession);
+    engine.rootContext()->setContextProperty("controlServer", controlServer);
 #else
     engine.rootContext()->setContextProperty("hasMpvSupport", false);
 #endif
     
+    // 트레이싱 제어 객체 - PLAYER_TRACE=<파일 경로>로 실행하면 시작부터 기록하고 종료 시 저장
+    TraceController* traceController = new TraceController(&app);
+    const QString startupTracePath = QString::fromLocal8Bit(qgetenv("PLAYER_TRACE"));
+    if (!startupTracePath.isEmpty()) {
+        traceController->setEnabled(true);
+        qDebug() << "Tracing enabled, output:" << startupTracePath;
+    }
+    engine.rootContext()->setContextProperty("tracing", traceController);
+    
     // 애플리케이션 정보를 QML에 전달
     engine.rootContext()->setContextProperty("appName", "Player by HEIMLICH®");
     engine.rootContext()->setContextProperty("appVersion", getApplicationVersion());
@@ -652,21 +756,98 @@ int main(int argc, char *argv[])
     qDebug() << "Initial video file passed to QML:" << videoFilePath;
     
     // 부트스트랩 QML 파일 로드 - 메인 윈도우를 직접 로드
-    QString mainQmlFile = qmlRootPath + "/core/MainWindow.qml";
-    qDebug() << "Loading Main Window from:" << mainQmlFile;
+    qDebug() << "Loading Main Window from:" << mainWindowUrl;
     
     // 메인 윈도우 로드
-    engine.load(QUrl::fromLocalFile(mainQmlFile));
+    engine.load(mainWindowUrl);
     
     if (engine.rootObjects().isEmpty()) {
-        qDebug() << "Failed to load Main Window:" << mainQmlFile;
+        qDebug() << "Failed to load Main Window:" << mainWindowUrl;
         if (g_splashManager) {
             g_splashManager->closeSplash();
             g_splashManager = nullptr;
         }
+#ifdef HAVE_MPV
+        MpvWarmup::shutdown();
+#endif
+        AsyncLogger::instance().stop();
         return -1;
     }
     
+    StartupTimeline::mark("engine loaded");
+    
+#ifdef HAVE_MPV
+    // 디코더 튜닝은 요청할 때만 (재생 중에 UHD 클립을 인코딩/디코딩하지 않도록)
+    if (tuneDecoders && !startupBenchmark) {
+        decoderTuner->runBenchmark();
+    }
+    
+    // 명령줄로 요청한 리뷰 세션 시작 (플레이어 연결은 QML에서)
+    if (reviewHostPort > 0) {
+        reviewSession->host(reviewHostPort);
+    } else if (!reviewJoinAddress.isEmpty()) {
+        reviewSession->join(reviewJoinAddress);
+    }
+    
+    // 제어 서버 시작 (플레이어 연결은 QML에서)
+    if (controlServer) {
+        controlServer->listen(controlServerName);
+    }
+#endif
+    
+    // 다른 프로세스에서 넘어온 파일 열기
+    if (singleInstance) {
+        QObject::connect(singleInstance, &SingleInstance::filesReceived, &app, [&](const QStringList& files) {
+            if (engine.rootObjects().isEmpty()) {
+                return;
+            }
+            QObject* rootObject = engine.rootObjects().first();
+            if (QWindow* window = qobject_cast<QWindow*>(rootObject)) {
+                if (window->windowState() & Qt::WindowMinimized) {
+                    window->showNormal();
+                }
+                window->raise();
+                window->requestActivate();
+            }
+            if (files.isEmpty()) {
+                return;
+            }
+#ifdef HAVE_MPV
+            // 여러 파일이 한꺼번에 넘어오면 재생 목록으로 열기
+            playlistModel->openFiles(files);
+#else
+            QMetaObject::invokeMethod(rootObject, "openFile",
+                                      Q_ARG(QVariant, QUrl::fromLocalFile(files.first()).toString()));
+#endif
+        });
+    }
+    
+    if (startupBenchmark) {
+        QQuickWindow* window = qobject_cast<QQuickWindow*>(engine.rootObjects().first());
+        const bool waitForVideo = !videoFilePath.isEmpty();
+        auto report = [](bool timedOut) {
+            std::fputs(StartupTimeline::toJson().constData(), stdout);
+            std::fflush(stdout);
+            QCoreApplication::exit(timedOut ? 1 : 0);
+        };
+        if (window) {
+            // 첫 프레임 표시 후 종료 - 비디오가 있으면 첫 비디오 프레임까지 대기
+            QObject::connect(window, &QQuickWindow::frameSwapped, &app, [waitForVideo, report]() {
+                static bool reported = false;
+                StartupTimeline::mark("first interactive frame");
+                if (reported || (waitForVideo && !StartupTimeline::hasStage("first frame"))) {
+                    return;
+                }
+                reported = true;
+                report(false);
+            }, Qt::QueuedConnection);
+        }
+        QTimer::singleShot(30000, &app, [report]() {
+            qWarning() << "Startup benchmark timed out";
+            report(true);
+        });
+    }
+    
     // 전역 스플래시 매니저 설정
     g_splashManager = new SplashManager(&splash);
     
@@ -679,7 +860,15 @@ int main(int argc, char *argv[])
     }
 #endif
     
-    return app.exec();
+    const int exitCode = app.exec();
+#ifdef HAVE_MPV
+    MpvWarmup::shutdown();
+#endif
+    if (!startupTracePath.isEmpty()) {
+        traceController->dump(startupTracePath);
+    }
+    AsyncLogger::instance().stop();
+    return exitCode;
 }
 
 #include "main.moc" 
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include "mediainfo.h"
+#include "mpvobject.h"
+#include "logger.h"
+#include <QDateTime>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+const mpv_node* findNode(const mpv_node& map, const char* key)
+{
+    if (map.format != MPV_FORMAT_NODE_MAP || !map.u.list) {
+        return nullptr;
+    }
+    for (int i = 0; i < map.u.list->num; ++i) {
+        if (std::strcmp(map.u.list->keys[i], key) == 0) {
+            return &map.u.list->values[i];
+        }
+    }
+    return nullptr;
+}
+
+// 메타데이터 태그는 컨테이너마다 대소문자가 다름 (timecode / TIMECODE)
+const mpv_node* findTag(const mpv_node& map, const char* key)
+{
+    if (map.format != MPV_FORMAT_NODE_MAP || !map.u.list) {
+        return nullptr;
+    }
+    for (int i = 0; i < map.u.list->num; ++i) {
+        if (qstricmp(map.u.list->keys[i], key) == 0) {
+            return &map.u.list->values[i];
+        }
+    }
+    return nullptr;
+}
+
+QString nodeString(const mpv_node* node)
+{
+    if (node && node->format == MPV_FORMAT_STRING && node->u.string) {
+        return QString::fromUtf8(node->u.string);
+    }
+    return QString();
+}
+
+double nodeDouble(const mpv_node* node, double fallback = 0.0)
+{
+    if (!node) {
+        return fallback;
+    }
+    if (node->format == MPV_FORMAT_DOUBLE) {
+        return node->u.double_;
+    }
+    if (node->format == MPV_FORMAT_INT64) {
+        return double(node->u.int64);
+    }
+    return fallback;
+}
+
+bool nodeFlag(const mpv_node* node)
+{
+    return node && node->format == MPV_FORMAT_FLAG && node->u.flag;
+}
+
+} // namespace
+
+MediaInfo::MediaInfo(MpvObject* player)
+    : QObject(player)
+{
+}
+
+template <typename T>
+void MediaInfo::assign(T& field, const T& value)
+{
+    if (field != value) {
+        field = value;
+        m_dirty = true;
+    }
+}
+
+QString MediaInfo::resolution() const
+{
+    if (m_width <= 0 || m_height <= 0) {
+        return QString();
+    }
+    return QString("%1×%2").arg(m_width).arg(m_height);
+}
+
+QVariantMap MediaInfo::snapshot() const
+{
+    QVariantMap info;
+    info["ready"] = m_ready;
+    info["videoCodec"] = m_videoCodec;
+    info["pixelFormat"] = m_pixelFormat;
+    info["width"] = m_width;
+    info["height"] = m_height;
+    info["resolution"] = resolution();
+    info["frameRate"] = m_frameRate;
+    info["aspect"] = m_aspect;
+    info["colorMatrix"] = m_colorMatrix;
+    info["colorPrimaries"] = m_colorPrimaries;
+    info["colorTransfer"] = m_colorTransfer;
+    info["bitrate"] = m_bitrate;
+    info["audioCodec"] = m_audioCodec;
+    info["audioChannels"] = m_audioChannels;
+    info["audioSampleRate"] = m_audioSampleRate;
+    info["tracks"] = m_tracks;
+    info["timecode"] = m_timecode;
+    info["creationDate"] = m_creationDate;
+    return info;
+}
+
+void MediaInfo::reset()
+{
+    assign(m_ready, false);
+    assign(m_videoCodec, QString());
+    assign(m_pixelFormat, QString());
+    assign(m_width, 0);
+    assign(m_height, 0);
+    assign(m_frameRate, 0.0);
+    assign(m_aspect, 0.0);
+    assign(m_colorMatrix, QString());
+    assign(m_colorPrimaries, QString());
+    assign(m_colorTransfer, QString());
+    assign(m_bitrate, 0.0);
+    assign(m_audioCodec, QString());
+    assign(m_audioChannels, 0);
+    assign(m_audioSampleRate, 0);
+    assign(m_tracks, QVariantList());
+    assign(m_timecode, QString());
+    assign(m_smpteTimecode, QString());
+    assign(m_creationDate, QString());
+}
+
+void MediaInfo::readTrackList(mpv_handle* mpv)
+{
+    if (!mpv) {
+        return;
+    }
+
+    mpv_node trackList{};
+    const int result = mpv_get_property(mpv, "track-list", MPV_FORMAT_NODE, &trackList);
+    if (result < 0) {
+        qWarning() << "MediaInfo: cannot read track-list:" << mpv_error_string(result);
+        return;
+    }
+
+    QVariantList tracks;
+    const mpv_node* video = nullptr;
+    const mpv_node* audio = nullptr;
+    bool videoSelected = false;
+    bool audioSelected = false;
+    if (trackList.format == MPV_FORMAT_NODE_ARRAY && trackList.u.list) {
+        for (int i = 0; i < trackList.u.list->num; ++i) {
+            const mpv_node& entry = trackList.u.list->values[i];
+            const QString type = nodeString(findNode(entry, "type"));
+            const bool selected = nodeFlag(findNode(entry, "selected"));
+
+            QVariantMap track;
+            track["id"] = qint64(nodeDouble(findNode(entry, "id")));
+            track["type"] = type;
+            track["codec"] = nodeString(findNode(entry, "codec"));
+            track["title"] = nodeString(findNode(entry, "title"));
+            track["lang"] = nodeString(findNode(entry, "lang"));
+            track["selected"] = selected;
+            track["default"] = nodeFlag(findNode(entry, "default"));
+            track["external"] = nodeFlag(findNode(entry, "external"));
+            tracks.append(track);
+
+            // 선택된 트랙 우선, 없으면 종류별 첫 트랙 (앨범 아트는 제외)
+            if (type == "video" && !nodeFlag(findNode(entry, "albumart"))) {
+                if (!video || (selected && !videoSelected)) {
+                    video = &entry;
+                    videoSelected = selected;
+                }
+            } else if (type == "audio") {
+                if (!audio || (selected && !audioSelected)) {
+                    audio = &entry;
+                    audioSelected = selected;
+                }
+            }
+        }
+    }
+    assign(m_tracks, tracks);
+
+    if (video) {
+        // 감시 중인 video-codec(설명 포함)이 먼저 오면 그대로 둠
+        if (m_videoCodec.isEmpty()) {
+            assign(m_videoCodec, nodeString(findNode(*video, "codec")));
+        }
+        if (m_width <= 0 || m_height <= 0) {
+            assign(m_width, int(nodeDouble(findNode(*video, "demux-w"))));
+            assign(m_height, int(nodeDouble(findNode(*video, "demux-h"))));
+        }
+        assign(m_frameRate, nodeDouble(findNode(*video, "demux-fps")));
+        assign(m_bitrate, nodeDouble(findNode(*video, "demux-bitrate")));
+    }
+    if (audio) {
+        assign(m_audioCodec, nodeString(findNode(*audio, "codec")));
+        assign(m_audioChannels, int(nodeDouble(findNode(*audio, "demux-channel-count"))));
+        assign(m_audioSampleRate, int(nodeDouble(findNode(*audio, "demux-samplerate"))));
+    }
+    mpv_free_node_contents(&trackList);
+
+    // 트랙 비트레이트가 없는 컨테이너는 평균 비트레이트 (파일 크기 / 길이)
+    // 길이는 이 파일의 값을 직접 읽음 (duration 속성 변경 이벤트는 아직 이전 파일 값일 수 있음)
+    if (m_bitrate <= 0) {
+        double duration = 0.0;
+        qint64 fileSize = 0;
+        if (mpv_get_property(mpv, "duration", MPV_FORMAT_DOUBLE, &duration) >= 0 && duration > 0
+            && mpv_get_property(mpv, "file-size", MPV_FORMAT_INT64, &fileSize) >= 0 && fileSize > 0) {
+            assign(m_bitrate, fileSize * 8.0 / duration);
+        }
+    }
+
+    // 챕터 메타데이터의 SMPTE 타임코드 - 파일마다 한 번만 읽어 둠 (타임코드 표시 타이머는 이 값을 읽음)
+    QString smpte;
+    if (char* tc = mpv_get_property_string(mpv, "chapter-metadata/SMPTE_TIMECODE")) {
+        smpte = QString::fromUtf8(tc);
+        mpv_free(tc);
+    }
+    assign(m_smpteTimecode, smpte);
+
+    assign(m_ready, true);
+    hpVerbose(lcMpvCommand) << "MediaInfo:" << tracks.size() << "tracks, video" << m_videoCodec
+                            << resolution() << m_frameRate << "fps, audio" << m_audioCodec;
+}
+
+void MediaInfo::setVideoCodec(const QString& codec)
+{
+    assign(m_videoCodec, codec);
+}
+
+void MediaInfo::setPixelFormat(const QString& format)
+{
+    // video-params의 pixelformat이 이미 있으면 그 값을 유지
+    if (m_pixelFormat.isEmpty()) {
+        assign(m_pixelFormat, format);
+    }
+}
+
+void MediaInfo::setWidth(int width)
+{
+    assign(m_width, width);
+}
+
+void MediaInfo::setHeight(int height)
+{
+    assign(m_height, height);
+}
+
+void MediaInfo::updateVideoParams(const mpv_node& params)
+{
+    // 하드웨어 디코딩이면 pixelformat은 hw 포맷(vaapi 등) - 실제 포맷은 hw-pixelformat
+    QString format = nodeString(findNode(params, "hw-pixelformat"));
+    if (format.isEmpty()) {
+        format = nodeString(findNode(params, "pixelformat"));
+    }
+    if (!format.isEmpty()) {
+        assign(m_pixelFormat, format);
+    }
+    const int w = int(nodeDouble(findNode(params, "w")));
+    const int h = int(nodeDouble(findNode(params, "h")));
+    if (w > 0 && h > 0) {
+        assign(m_width, w);
+        assign(m_height, h);
+    }
+    assign(m_aspect, nodeDouble(findNode(params, "aspect")));
+    assign(m_colorMatrix, nodeString(findNode(params, "colormatrix")));
+    assign(m_colorPrimaries, nodeString(findNode(params, "primaries")));
+    assign(m_colorTransfer, nodeString(findNode(params, "gamma")));
+}
+
+void MediaInfo::updateMetadata(const mpv_node& metadata)
+{
+    QString timecode = nodeString(findTag(metadata, "timecode"));
+    if (timecode.isEmpty()) {
+        timecode = nodeString(findTag(metadata, "reel_timecode"));
+    }
+    assign(m_timecode, timecode);
+
+    QString date;
+    for (const char* key : {"creation_time", "date", "creation_date"}) {
+        const QString value = nodeString(findTag(metadata, key));
+        if (value.isEmpty()) {
+            continue;
+        }
+        const QDateTime parsed = QDateTime::fromString(value, Qt::ISODateWithMs);
+        date = parsed.isValid() ? parsed.date().toString(Qt::ISODate) : value.left(10);
+        break;
+    }
+    assign(m_creationDate, date);
+}
+
+void MediaInfo::publish()
+{
+    if (!m_dirty) {
+        return;
+    }
+    m_dirty = false;
+    emit changed();
+}
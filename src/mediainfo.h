@@ -0,0 +1,115 @@
+#ifndef MEDIAINFO_H
+#define MEDIAINFO_H
+
+#include <QObject>
+#include <QVariantList>
+#include <QVariantMap>
+#include <client.h>
+
+class MpvObject;
+
+// 현재 파일의 미디어 정보 (코덱, 픽셀 포맷, 해상도, 프레임 레이트, 색 공간, 비트레이트, 트랙, 타임코드)
+// QML이 getProperty를 여러 번 부르는 대신 MPV 이벤트로 채운 값을 읽는다.
+// - 감시 속성(video-codec, video-format, width/height, video-params, metadata)은 이벤트 루프에서 갱신
+// - 파일 로드 시 track-list를 노드(MPV_FORMAT_NODE)로 한 번만 읽어 트랙/컨테이너 정보를 채움
+//   (챕터 SMPTE 타임코드, 평균 비트레이트용 duration/file-size도 이때 직접 읽음)
+// - 이벤트를 한 번 비울 때마다 바뀐 값을 모아 changed()를 한 번만 보냄 (중간 상태가 보이지 않음)
+class MediaInfo : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool ready READ isReady NOTIFY changed)
+    Q_PROPERTY(QString videoCodec READ videoCodec NOTIFY changed)
+    Q_PROPERTY(QString pixelFormat READ pixelFormat NOTIFY changed)
+    Q_PROPERTY(int width READ width NOTIFY changed)
+    Q_PROPERTY(int height READ height NOTIFY changed)
+    Q_PROPERTY(QString resolution READ resolution NOTIFY changed)
+    Q_PROPERTY(double frameRate READ frameRate NOTIFY changed)
+    Q_PROPERTY(double aspect READ aspect NOTIFY changed)
+    Q_PROPERTY(QString colorMatrix READ colorMatrix NOTIFY changed)
+    Q_PROPERTY(QString colorPrimaries READ colorPrimaries NOTIFY changed)
+    Q_PROPERTY(QString colorTransfer READ colorTransfer NOTIFY changed)
+    Q_PROPERTY(double bitrate READ bitrate NOTIFY changed)
+    Q_PROPERTY(QString audioCodec READ audioCodec NOTIFY changed)
+    Q_PROPERTY(int audioChannels READ audioChannels NOTIFY changed)
+    Q_PROPERTY(int audioSampleRate READ audioSampleRate NOTIFY changed)
+    Q_PROPERTY(QVariantList tracks READ tracks NOTIFY changed)
+    Q_PROPERTY(QString timecode READ timecode NOTIFY changed)
+    Q_PROPERTY(QString creationDate READ creationDate NOTIFY changed)
+
+public:
+    explicit MediaInfo(MpvObject* player);
+
+    // 파일 로드 후 track-list를 읽었는지
+    bool isReady() const { return m_ready; }
+
+    QString videoCodec() const { return m_videoCodec; }
+    QString pixelFormat() const { return m_pixelFormat; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    QString resolution() const;
+    // 컨테이너 프레임 레이트 (없으면 0)
+    double frameRate() const { return m_frameRate; }
+    double aspect() const { return m_aspect; }
+    QString colorMatrix() const { return m_colorMatrix; }
+    QString colorPrimaries() const { return m_colorPrimaries; }
+    QString colorTransfer() const { return m_colorTransfer; }
+    // 비디오 트랙 비트레이트 (bps, 없으면 파일 크기 / 길이)
+    double bitrate() const { return m_bitrate; }
+    QString audioCodec() const { return m_audioCodec; }
+    int audioChannels() const { return m_audioChannels; }
+    int audioSampleRate() const { return m_audioSampleRate; }
+    // [{id, type, codec, title, lang, selected, default, external}]
+    QVariantList tracks() const { return m_tracks; }
+    // 컨테이너 메타데이터의 시작 타임코드 (없으면 빈 문자열)
+    QString timecode() const { return m_timecode; }
+    // 내장 시작 타임코드 - 챕터 SMPTE_TIMECODE(파일 로드 시 한 번 읽음), 없으면 컨테이너 타임코드
+    QString embeddedTimecode() const { return m_smpteTimecode.isEmpty() ? m_timecode : m_smpteTimecode; }
+    // 촬영/생성 날짜 YYYY-MM-DD (없으면 빈 문자열)
+    QString creationDate() const { return m_creationDate; }
+
+    // 모든 값을 한 번에 (QML에서 여러 속성을 따로 읽지 않도록)
+    Q_INVOKABLE QVariantMap snapshot() const;
+
+    // MPV 이벤트 루프에서 호출 (GUI 스레드)
+    void reset();
+    void readTrackList(mpv_handle* mpv);
+    void setVideoCodec(const QString& codec);
+    void setPixelFormat(const QString& format);
+    void setWidth(int width);
+    void setHeight(int height);
+    void updateVideoParams(const mpv_node& params);
+    void updateMetadata(const mpv_node& metadata);
+
+    // 이벤트를 다 처리한 뒤 호출 - 바뀐 값이 있으면 changed()
+    void publish();
+
+signals:
+    void changed();
+
+private:
+    template <typename T>
+    void assign(T& field, const T& value);
+
+    bool m_dirty = false;
+    bool m_ready = false;
+
+    QString m_videoCodec;
+    QString m_pixelFormat;
+    int m_width = 0;
+    int m_height = 0;
+    double m_frameRate = 0.0;
+    double m_aspect = 0.0;
+    QString m_colorMatrix;
+    QString m_colorPrimaries;
+    QString m_colorTransfer;
+    double m_bitrate = 0.0;
+    QString m_audioCodec;
+    int m_audioChannels = 0;
+    int m_audioSampleRate = 0;
+    QVariantList m_tracks;
+    QString m_timecode;
+    QString m_smpteTimecode;
+    QString m_creationDate;
+};
+
+#endif // MEDIAINFO_H
@@ -0,0 +1,135 @@
+#ifndef MPVCOMMAND_H
+#define MPVCOMMAND_H
+
+#include <client.h>
+#include <cstdint>
+
+// 자주 쓰는 MPV 명령의 타입 지정 빠른 경로
+// 시크/일시정지/프레임 이동처럼 재생 중 계속 호출되는 명령은 QVariantList -> QByteArray 변환이나
+// "seek %1 absolute exact" 문자열 조립/재파싱 없이 스택의 mpv_node 배열로 바로 전달한다.
+// 이름은 모두 정적 문자열이므로 호출마다 힙 할당이 없다 (MPV 내부 복사는 제외).
+namespace MpvCommand {
+
+// 속성/명령 이름
+namespace Name {
+inline constexpr char Pause[] = "pause";
+inline constexpr char Speed[] = "speed";
+inline constexpr char TimePos[] = "time-pos";
+inline constexpr char Seek[] = "seek";
+inline constexpr char FrameStep[] = "frame-step";
+inline constexpr char FrameBackStep[] = "frame-back-step";
+}
+
+// 시크 플래그
+namespace Flag {
+inline constexpr char Absolute[] = "absolute";
+inline constexpr char Relative[] = "relative";
+inline constexpr char Exact[] = "exact";
+inline constexpr char Keyframes[] = "keyframes";
+}
+
+// 스택에 두는 명령 인자 배열 (최대 N개)
+template <int N>
+class Args
+{
+public:
+    Args()
+    {
+        m_list.num = 0;
+        m_list.values = m_values;
+        m_list.keys = nullptr;
+        m_root.format = MPV_FORMAT_NODE_ARRAY;
+        m_root.u.list = &m_list;
+    }
+
+    Args& add(const char* text)
+    {
+        mpv_node& node = next();
+        node.format = MPV_FORMAT_STRING;
+        node.u.string = const_cast<char*>(text);
+        return *this;
+    }
+
+    Args& add(double value)
+    {
+        mpv_node& node = next();
+        node.format = MPV_FORMAT_DOUBLE;
+        node.u.double_ = value;
+        return *this;
+    }
+
+    Args& add(int64_t value)
+    {
+        mpv_node& node = next();
+        node.format = MPV_FORMAT_INT64;
+        node.u.int64 = value;
+        return *this;
+    }
+
+    // 내부 포인터가 자기 멤버를 가리키므로 복사 불가
+    Args(const Args&) = delete;
+    Args& operator=(const Args&) = delete;
+
+    int size() const { return m_list.num; }
+    mpv_node* node() { return &m_root; }
+
+private:
+    mpv_node& next()
+    {
+        // 용량 초과는 프로그래밍 오류 - 마지막 칸을 덮어씀
+        return m_values[m_list.num < N ? m_list.num++ : N - 1];
+    }
+
+    mpv_node m_values[N];
+    mpv_node_list m_list;
+    mpv_node m_root;
+};
+
+// seek <seconds> absolute|relative exact|keyframes
+inline void fillSeek(Args<4>& args, double seconds, const char* mode, bool exact)
+{
+    args.add(Name::Seek).add(seconds).add(mode).add(exact ? Flag::Exact : Flag::Keyframes);
+}
+
+inline int seekAbsolute(mpv_handle* mpv, double seconds, bool exact)
+{
+    Args<4> args;
+    fillSeek(args, seconds, Flag::Absolute, exact);
+    return mpv_command_node(mpv, args.node(), nullptr);
+}
+
+inline int seekRelative(mpv_handle* mpv, double seconds, bool exact)
+{
+    Args<4> args;
+    fillSeek(args, seconds, Flag::Relative, exact);
+    return mpv_command_node(mpv, args.node(), nullptr);
+}
+
+inline int frameStep(mpv_handle* mpv)
+{
+    Args<1> args;
+    args.add(Name::FrameStep);
+    return mpv_command_node(mpv, args.node(), nullptr);
+}
+
+inline int frameBackStep(mpv_handle* mpv)
+{
+    Args<1> args;
+    args.add(Name::FrameBackStep);
+    return mpv_command_node(mpv, args.node(), nullptr);
+}
+
+inline int setPause(mpv_handle* mpv, bool paused)
+{
+    int flag = paused ? 1 : 0;
+    return mpv_set_property(mpv, Name::Pause, MPV_FORMAT_FLAG, &flag);
+}
+
+inline int setSpeed(mpv_handle* mpv, double speed)
+{
+    return mpv_set_property(mpv, Name::Speed, MPV_FORMAT_DOUBLE, &speed);
+}
+
+} // namespace MpvCommand
+
+#endif // MPVCOMMAND_H
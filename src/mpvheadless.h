@@ -0,0 +1,29 @@
+#ifndef MPVHEADLESS_H
+#define MPVHEADLESS_H
+
+#include <client.h>
+
+// 화면 출력 없이 백그라운드 작업(내보내기, 분석 등)에 사용하는 MPV 인스턴스 생성 함수
+// 사용자 설정/스크립트를 불러오지 않아 메인 플레이어와 독립적으로 동작한다.
+// mpv_initialize() 호출 전 상태로 반환하므로 호출자가 추가 옵션을 설정한 뒤 초기화해야 한다.
+inline mpv_handle* createHeadlessMpv()
+{
+    mpv_handle* handle = mpv_create();
+    if (!handle) {
+        return nullptr;
+    }
+
+    mpv_set_option_string(handle, "config", "no");
+    mpv_set_option_string(handle, "terminal", "no");
+    mpv_set_option_string(handle, "load-scripts", "no");
+    mpv_set_option_string(handle, "ytdl", "no");
+    mpv_set_option_string(handle, "osc", "no");
+    mpv_set_option_string(handle, "input-default-bindings", "no");
+    mpv_set_option_string(handle, "vo", "null");
+    mpv_set_option_string(handle, "ao", "null");
+    mpv_set_option_string(handle, "msg-level", "all=error");
+
+    return handle;
+}
+
+#endif // MPVHEADLESS_H
@@ -0,0 +1,140 @@
+#ifndef MPVNODE_H
+#define MPVNODE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+#include <client.h>
+#include <memory>
+#include <vector>
+
+// mpv_node <-> QVariant 변환
+// 노드 형식 속성(track-list, demuxer-cache-state 등)과 mpv_command_node 인자/결과를 Qt 쪽에서 다룰 때 사용한다.
+
+inline QVariant mpvNodeToVariant(const mpv_node& node)
+{
+    switch (node.format) {
+    case MPV_FORMAT_STRING:
+    case MPV_FORMAT_OSD_STRING:
+        return QString::fromUtf8(node.u.string);
+    case MPV_FORMAT_FLAG:
+        return bool(node.u.flag);
+    case MPV_FORMAT_INT64:
+        return qint64(node.u.int64);
+    case MPV_FORMAT_DOUBLE:
+        return node.u.double_;
+    case MPV_FORMAT_NODE_ARRAY: {
+        QVariantList list;
+        if (node.u.list) {
+            list.reserve(node.u.list->num);
+            for (int i = 0; i < node.u.list->num; ++i) {
+                list.append(mpvNodeToVariant(node.u.list->values[i]));
+            }
+        }
+        return list;
+    }
+    case MPV_FORMAT_NODE_MAP: {
+        QVariantMap map;
+        if (node.u.list) {
+            for (int i = 0; i < node.u.list->num; ++i) {
+                map.insert(QString::fromUtf8(node.u.list->keys[i]), mpvNodeToVariant(node.u.list->values[i]));
+            }
+        }
+        return map;
+    }
+    default:
+        return QVariant();
+    }
+}
+
+// QVariant로 mpv_node 트리를 만들고 수명 동안 메모리(문자열, 배열)를 보관
+class MpvNodeBuilder
+{
+public:
+    explicit MpvNodeBuilder(const QVariant& value) { fill(m_root, value); }
+
+    mpv_node* node() { return &m_root; }
+
+private:
+    void fill(mpv_node& node, const QVariant& value)
+    {
+        switch (value.typeId()) {
+        case QMetaType::Bool:
+            node.format = MPV_FORMAT_FLAG;
+            node.u.flag = value.toBool() ? 1 : 0;
+            break;
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+            node.format = MPV_FORMAT_INT64;
+            node.u.int64 = value.toLongLong();
+            break;
+        case QMetaType::Double:
+        case QMetaType::Float:
+            node.format = MPV_FORMAT_DOUBLE;
+            node.u.double_ = value.toDouble();
+            break;
+        case QMetaType::QVariantList:
+        case QMetaType::QStringList:
+            fillList(node, value.toList(), nullptr);
+            break;
+        case QMetaType::QVariantMap: {
+            const QVariantMap map = value.toMap();
+            fillList(node, map.values(), &map);
+            break;
+        }
+        default:
+            if (!value.isValid()) {
+                node.format = MPV_FORMAT_NONE;
+                break;
+            }
+            m_strings.append(value.toString().toUtf8());
+            node.format = MPV_FORMAT_STRING;
+            node.u.string = m_strings.last().data();
+            break;
+        }
+    }
+
+    void fillList(mpv_node& node, const QVariantList& values, const QVariantMap* map)
+    {
+        auto list = std::make_unique<mpv_node_list>();
+        auto items = std::make_unique<mpv_node[]>(values.size());
+        list->num = int(values.size());
+        list->values = items.get();
+        list->keys = nullptr;
+
+        std::unique_ptr<char*[]> keys;
+        if (map) {
+            keys = std::make_unique<char*[]>(values.size());
+            int i = 0;
+            for (auto it = map->constBegin(); it != map->constEnd(); ++it, ++i) {
+                m_strings.append(it.key().toUtf8());
+                keys[i] = m_strings.last().data();
+            }
+            list->keys = keys.get();
+        }
+        for (int i = 0; i < values.size(); ++i) {
+            fill(items[i], values[i]);
+        }
+
+        node.format = map ? MPV_FORMAT_NODE_MAP : MPV_FORMAT_NODE_ARRAY;
+        node.u.list = list.get();
+        m_lists.push_back(std::move(list));
+        m_items.push_back(std::move(items));
+        if (keys) {
+            m_keys.push_back(std::move(keys));
+        }
+    }
+
+    mpv_node m_root{};
+    // QList가 커져도 각 QByteArray의 내부 버퍼 주소는 바뀌지 않는다
+    QList<QByteArray> m_strings;
+    std::vector<std::unique_ptr<mpv_node_list>> m_lists;
+    std::vector<std::unique_ptr<mpv_node[]>> m_items;
+    std::vector<std::unique_ptr<char*[]>> m_keys;
+};
+
+#endif // MPVNODE_H
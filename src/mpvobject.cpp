@@ -1,5 +1,23 @@
 #include "mpvobject.h"
 #include "splash.h"
+#include "logger.h"
+#include "tracing.h"
+#include "framemath.h"
+#include "mpvproperties.h"
+#include "mpvwarmup.h"
+#include "startuptimeline.h"
+#include "performancegovernor.h"
+#include "decodertuner.h"
+#include "demuxcachemanager.h"
+#include "audiowaveformanalyzer.h"
+#include "colorpipeline.h"
+#include "reverseplayback.h"
+#include "looprange.h"
+#include "playbackstatemachine.h"
+#include "mediainfo.h"
+#include "keyframemap.h"
+#include "mpvnode.h"
+#include "mpvcommand.h"
 #include <stdexcept>
 #include <QtQuick/QQuickWindow>
 #include <QtGui/QOpenGLContext>
@@ -8,6 +26,7 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
+#include <QFileInfo>
 #include <QRegularExpression>
 #include <QRunnable>
 #include <QTimer>
@@ -71,6 +90,10 @@ public:
             qDebug() << "MPV render context created successfully";
             mpv_render_context_set_update_callback(obj->mpv_context, on_mpv_redraw, obj);
             
+            // 사전 준비로 열린 시작 파일은 비디오가 꺼진 상태이므로 GUI 스레드에서 켬
+            // (렌더 스레드에서 일반 libmpv API를 호출하면 교착될 수 있음)
+            QMetaObject::invokeMethod(obj, "activateWarmStartVideo", Qt::QueuedConnection);
+            
             // 스플래시 스크린 닫기 - MPV가 준비됨 (안전한 방식)
             requestCloseSplash();
         }
@@ -89,6 +112,7 @@ public:
 
     void render()
     {
+        HP_TRACE_SCOPE("MpvRenderer::render");
         if (!obj->mpv_context) {
             qWarning() << "Render called but no MPV context available";
             return;
@@ -124,11 +148,19 @@ public:
             {MPV_RENDER_PARAM_INVALID, nullptr}
         };
         
-        // 실제 MPV 렌더링 수행
+        // 실제 MPV 렌더링 수행 (렌더 시간은 성능 조절기에 매 프레임 기록)
+        QElapsedTimer renderTimer;
+        renderTimer.start();
         mpv_render_context_render(obj->mpv_context, params);
+        if (obj->m_governor) {
+            obj->m_governor->recordFrame(renderTimer.nsecsElapsed());
+        }
         
         // FBO 바인딩 해제
         fbo->release();
+        
+        // 시작 타임라인 - 첫 프레임 (최초 한 번만 기록)
+        StartupTimeline::markFirstFrame();
     }
 
     void swap() 
@@ -154,19 +186,10 @@ public:
     }
 };
 
-MpvObject::MpvObject(QQuickItem * parent)
-    : QQuickFramebufferObject(parent), mpv(nullptr), mpv_context(nullptr)
+// MPV 핸들 공통 옵션 설정 및 속성 감시 등록 (mpv_initialize() 전에 호출)
+// 시작 시 미리 준비하는 핸들(MpvWarmup)도 같은 설정을 사용한다.
+void MpvObject::configureHandle(mpv_handle* mpv)
 {
-    // qDebug() << "MpvObject constructor starting...";
-    mpv = mpv_create();
-    if (!mpv) {
-        qCritical() << "Failed to create MPV context";
-        throw std::runtime_error("Could not create mpv context");
-    }
-
-    // 기본값 설정 - 중요: 1-based 프레임 번호 사용
-    m_oneBasedFrameNumbers = true;
-    
     // 기본 MPV 옵션 설정 - 성능 및 안정성 개선
     mpv_set_option_string(mpv, "vo", "libmpv");
     
@@ -198,7 +221,8 @@ MpvObject::MpvObject(QQuickItem * parent)
     
     // 렌더링 성능 최적화
     mpv_set_option_string(mpv, "gpu-dumb-mode", "no");
-    mpv_set_option_string(mpv, "vd-lavc-threads", "4");
+    // 디코더 스레드는 MPV 자동 설정 (코덱별 튜닝 프로필이 있으면 파일 로드 시 덮어씀)
+    mpv_set_option_string(mpv, "vd-lavc-threads", "0");
     
     // 동기화 설정 조정
     mpv_set_option_string(mpv, "video-sync", "display-resample");
@@ -219,26 +243,44 @@ MpvObject::MpvObject(QQuickItem * parent)
     // idle 모드 활성화 - 파일이 없어도 mpv 유지
     mpv_set_option_string(mpv, "idle", "yes");
     
+    // 재생 목록의 다음 항목을 현재 항목 재생 중에 미리 열어 둠 (클립 전환 시 검은 화면 방지)
+    mpv_set_option_string(mpv, "prefetch-playlist", "yes");
+    
     // 프로퍼티 감시 설정
-    mpv_observe_property(mpv, 0, "pause", MPV_FORMAT_FLAG);
-    mpv_observe_property(mpv, 0, "time-pos", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(mpv, 0, "duration", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(mpv, 0, "media-title", MPV_FORMAT_STRING);
-    mpv_observe_property(mpv, 0, "filename", MPV_FORMAT_STRING);
-    mpv_observe_property(mpv, 0, "estimated-vf-fps", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(mpv, 0, "eof-reached", MPV_FORMAT_FLAG);
+    for (const MpvObservedProperty& property : kObservedMpvProperties) {
+        mpv_observe_property(mpv, static_cast<uint64_t>(property.id), property.name, property.format);
+    }
+}
+
+MpvObject::MpvObject(QQuickItem * parent)
+    : QQuickFramebufferObject(parent), mpv(nullptr), mpv_context(nullptr)
+{
+    // qDebug() << "MpvObject constructor starting...";
     
-    // 코덱 정보 감시 추가
-    mpv_observe_property(mpv, 0, "video-codec", MPV_FORMAT_STRING);
-    mpv_observe_property(mpv, 0, "video-format", MPV_FORMAT_STRING);
-    mpv_observe_property(mpv, 0, "width", MPV_FORMAT_INT64);
-    mpv_observe_property(mpv, 0, "height", MPV_FORMAT_INT64);
+    // 시작 시 백그라운드에서 미리 준비된 핸들이 있으면 넘겨받음 (시작 파일을 이미 열고 있을 수 있음)
+    const MpvWarmup::Handoff warm = MpvWarmup::take();
+    mpv = warm.handle;
+    const bool warmStarted = mpv != nullptr;
+    m_warmStartFile = warm.file;
+    m_warmStartPaused = warm.startPaused;
+    
+    if (!mpv) {
+        mpv = mpv_create();
+        if (!mpv) {
+            qCritical() << "Failed to create MPV context";
+            throw std::runtime_error("Could not create mpv context");
+        }
+        configureHandle(mpv);
+    }
+
+    // 기본값 설정 - 중요: 1-based 프레임 번호 사용
+    m_oneBasedFrameNumbers = true;
     
     // Log available properties
     qDebug() << "MPV initialized, setting up event handlers";
     mpv_set_wakeup_callback(mpv, on_mpv_events, this);
     
-    if (mpv_initialize(mpv) < 0) {
+    if (!warmStarted && mpv_initialize(mpv) < 0) {
         qCritical() << "Failed to initialize MPV";
         throw std::runtime_error("Failed to initialize mpv");
     }
@@ -249,17 +291,44 @@ MpvObject::MpvObject(QQuickItem * parent)
     m_stateChangeTimer->setInterval(50);
     connect(m_stateChangeTimer, &QTimer::timeout, this, &MpvObject::processStateChange);
     
-    m_performanceTimer = new QTimer(this);
-    m_performanceTimer->setInterval(5000); // 5초마다 성능 확인
-    connect(m_performanceTimer, &QTimer::timeout, this, &MpvObject::checkPerformance);
-    m_performanceTimer->start();
+    // 적응형 성능 조절 - 재생 중에만 1초 단위로 평가
+    m_governor = new PerformanceGovernor(this);
+    connect(this, &MpvObject::playingChanged, m_governor, &PerformanceGovernor::setPlaying);
+    connect(this, &MpvObject::fileLoaded, m_governor, &PerformanceGovernor::resetCounters);
+    
+    // 디먹서 캐시 - 파일마다 비트레이트와 사용 가능한 메모리로 크기 결정
+    m_cacheManager = new DemuxCacheManager(this);
+    connect(this, &MpvObject::fileLoaded, m_cacheManager, &DemuxCacheManager::resize);
+    
+    // 오디오 파형 - 별도 MPV 인스턴스로 백그라운드 분석
+    m_waveform = new AudioWaveformAnalyzer(this);
+    connect(this, &MpvObject::fileLoaded, m_waveform, &AudioWaveformAnalyzer::analyzeCurrentFile);
+    
+    // 색 보정 - vf 필터 대신 렌더러 셰이더로 처리 (파일이 바뀌어도 유지)
+    m_colorPipeline = new ColorPipeline(this);
+    
+    // 역방향 재생 - MPV 역순 디코딩 버퍼로 GOP를 한 번만 디코딩
+    m_reversePlayback = new ReversePlaybackController(this);
+    
+    // 인/아웃 구간 반복 - MPV A-B 루프 (EOF 타이머 없이 되감기)
+    m_loopRange = new LoopRange(this);
     
-    // 메타데이터 업데이트 타이머 추가 - 단일 샷으로 변경
-    m_metadataTimer = new QTimer(this);
-    m_metadataTimer->setSingleShot(true); // 반복 없이 한 번만 실행되도록 변경
-    m_metadataTimer->setInterval(500); // 0.5초 후 한 번만 메타데이터 업데이트
-    connect(m_metadataTimer, &QTimer::timeout, this, &MpvObject::updateVideoMetadata);
-    // 자동 시작 안함 - 파일 로드 시 한 번만 호출됨
+    // 재생 상태 머신 - QML 타이머 대신 MPV 이벤트로 시크/EOF 상태 전환
+    m_playbackState = new PlaybackStateMachine(this);
+    
+    // 미디어 정보 - 이벤트를 한 번 비울 때마다 바뀐 값을 한 번에 게시 (타이머/부모 탐색 없음)
+    m_mediaInfo = new MediaInfo(this);
+    connect(m_mediaInfo, &MediaInfo::changed, this, &MpvObject::updateVideoMetadata);
+    
+    // 키프레임/패킷 크기 지도 - 컨테이너 색인만 읽어 백그라운드로 (디코딩 없음)
+    m_keyframeMap = new KeyframeMap(this);
+    connect(this, &MpvObject::fileLoaded, m_keyframeMap, &KeyframeMap::analyzeCurrentFile);
+    
+    // 비디오 리컨피그 - 필터/hwdec 변경으로 연달아 와도 마지막 한 번만 처리
+    m_reconfigTimer = new QTimer(this);
+    m_reconfigTimer->setSingleShot(true);
+    m_reconfigTimer->setInterval(500);
+    connect(m_reconfigTimer, &QTimer::timeout, this, &MpvObject::handleVideoReconfig);
     
     // 타임코드 업데이트 타이머 설정
     m_timecodeTimer = new QTimer(this);
@@ -270,9 +339,39 @@ MpvObject::MpvObject(QQuickItem * parent)
     // UI를 항상 지연 없이 업데이트
     setFlag(ItemHasContents, true);
     
+    if (warmStarted) {
+        // 준비 중 쌓인 이벤트(파일 로드, 속성 초기값) 처리
+        qDebug() << "Adopted pre-warmed MPV instance, file:" << m_warmStartFile;
+        m_warmStartVideoPending = !m_warmStartFile.isEmpty();
+        QMetaObject::invokeMethod(this, "handleMpvEvents", Qt::QueuedConnection);
+    }
+    
     qDebug() << "MpvObject constructor completed successfully";
 }
 
+// 사전 준비된 핸들에서 렌더 컨텍스트가 생긴 뒤 비디오 출력을 켜고 원래 일시정지 상태로 복원
+void MpvObject::activateWarmStartVideo()
+{
+    if (!mpv || !m_warmStartVideoPending) {
+        return;
+    }
+    m_warmStartVideoPending = false;
+    
+    mpv_set_property_string(mpv, "vid", "auto");
+    setProperty("pause", m_warmStartPaused);
+}
+
+// 재생 목록이 시작 파일을 열려고 할 때 - 사전 준비에서 이미 열었으면 한 번만 true
+bool MpvObject::adoptWarmStartFile(const QString& path)
+{
+    if (m_warmStartFile.isEmpty()) {
+        return false;
+    }
+    const bool same = QFileInfo(path).absoluteFilePath() == QFileInfo(m_warmStartFile).absoluteFilePath();
+    m_warmStartFile.clear();
+    return same;
+}
+
 MpvObject::~MpvObject()
 {
     qDebug() << "MpvObject destructor called";
@@ -283,12 +382,8 @@ MpvObject::~MpvObject()
             m_stateChangeTimer->stop();
         }
         
-        if (m_performanceTimer) {
-            m_performanceTimer->stop();
-        }
-        
-        if (m_metadataTimer) {
-            m_metadataTimer->stop();
+        if (m_governor) {
+            m_governor->setPlaying(false);
         }
         
         if (m_timecodeTimer) {
@@ -315,10 +410,13 @@ QQuickFramebufferObject::Renderer *MpvObject::createRenderer() const
 
 void MpvObject::handleMpvEvents()
 {
+    HP_TRACE_SCOPE("MpvObject::handleMpvEvents");
     // mpv 이벤트 루프
     while (mpv) {
         mpv_event *event = mpv_wait_event(mpv, 0);
         if (event->event_id == MPV_EVENT_NONE) {
+            // 이번에 처리한 이벤트로 바뀐 미디어 정보를 한 번에 알림
+            m_mediaInfo->publish();
             break;
         }
         
@@ -326,125 +424,183 @@ void MpvObject::handleMpvEvents()
             case MPV_EVENT_PROPERTY_CHANGE: {
                 mpv_event_property *prop = (mpv_event_property *)event->data;
                 
-                // 모든 속성 변경 로그 출력 (디버깅용)
-                // qDebug() << "Property changed:" << prop->name;
+                // 값이 없는 경우(파일 미로드 등)는 무시
+                if (prop->format == MPV_FORMAT_NONE || !prop->data) {
+                    break;
+                }
                 
-                if (prop->format == MPV_FORMAT_FLAG) {
-                    if (strcmp(prop->name, "pause") == 0) {
-                        if (prop->data) {
-                            bool pause = *(int *)prop->data;
-                            if (m_pause != pause) {
-                                m_pause = pause;
-                                m_stateChangeTimer->start();
-                                emit pauseChanged(m_pause);
-                                emit playingChanged(!m_pause);
-                            }
+                // 감시 등록 시 넘긴 ID로 분기 (문자열 비교 없음)
+                switch (mpvPropertyFromUserdata(event->reply_userdata)) {
+                    case MpvProperty::Pause: {
+                        bool pause = *(int *)prop->data;
+                        if (m_pause != pause) {
+                            m_pause = pause;
+                            m_stateChangeTimer->start();
+                            emit pauseChanged(m_pause);
+                            emit playingChanged(!m_pause);
                         }
+                        break;
                     }
-                    else if (strcmp(prop->name, "eof-reached") == 0) {
-                        if (prop->data) {
-                            bool eofReached = *(int *)prop->data;
-                            if (m_endReached != eofReached) {
-                                m_endReached = eofReached;
-                                if (m_endReached) {
-                                    qDebug() << "End of file reached - handling EOF event";
-                                    
-                                    // handleEndOfVideo 함수 호출
-                                    // 즉시 실행하지 않고 조금 지연시켜 안정성 향상
-                                    QTimer::singleShot(50, this, &MpvObject::handleEndOfVideo);
-                                    
-                                    emit endReached();
-                                }
+                    
+                    case MpvProperty::EofReached: {
+                        bool eofReached = *(int *)prop->data;
+                        if (m_endReached != eofReached) {
+                            m_endReached = eofReached;
+                            emit endReachedChanged(m_endReached);
+                            if (m_endReached) {
+                                // keep-open이므로 마지막 프레임에 멈춘 채 파일이 열려 있음
+                                // 이후 처리(재생 시 처음부터, 반복)는 PlaybackStateMachine이 담당
+                                qDebug() << "End of file reached";
+                                emit endReached();
                             }
                         }
+                        break;
                     }
-                }
-                else if (prop->format == MPV_FORMAT_DOUBLE) {
-                    if (strcmp(prop->name, "time-pos") == 0) {
-                        if (prop->data) {
-                            double position = *(double *)prop->data;
-                            
-                            // 위치가 급격히 변화했는지 확인 (시크)
-                            bool isSeek = m_position >= 0 && 
-                                         std::abs(position - m_position) > 0.5;
-                            
-                            m_position = position;
-                            emit positionChanged(m_position);
+                    
+                    case MpvProperty::TimePos: {
+                        double position = *(double *)prop->data;
+                        
+                        m_position = position;
+                        emit positionChanged(m_position);
+                        
+                        // 끝에 가까운지 확인 (끝에서 0.1초 이내)
+                        if (m_duration > 0 && m_position > 0 && 
+                            (m_duration - m_position) < 0.1 && !m_endReached) {
+                            qDebug() << "Near end of file detected, preparing for EOF";
+                            // 미리 다음 프레임을 준비하거나 특별한 처리를 수행할 수 있음
+                        }
+                        break;
+                    }
+                    
+                    case MpvProperty::Duration: {
+                        double duration = *(double *)prop->data;
+                        
+                        if (qAbs(m_duration - duration) > 0.1) {
+                            m_duration = duration;
                             
-                            if (isSeek) {
-                                // 시크 감지
-                                m_lastSeekTime = QDateTime::currentMSecsSinceEpoch();
+                            // 프레임 수 계산
+                            if (m_fps > 0) {
+                                updateFrameCount();
                             }
                             
-                            // 끝에 가까운지 확인 (끝에서 0.1초 이내)
-                            if (m_duration > 0 && m_position > 0 && 
-                                (m_duration - m_position) < 0.1 && !m_endReached) {
-                                qDebug() << "Near end of file detected, preparing for EOF";
-                                // 미리 다음 프레임을 준비하거나 특별한 처리를 수행할 수 있음
-                            }
+                            emit durationChanged(duration);
                         }
+                        break;
                     }
-                    else if (strcmp(prop->name, "duration") == 0) {
-                        if (prop->data) {
-                            double duration = *(double *)prop->data;
+                    
+                    case MpvProperty::EstimatedVfFps: {
+                        double fps = *(double *)prop->data;
+                        // FPS 값이 유효하고 이전 값과 다른 경우에만 업데이트
+                        if (fps > 0 && qAbs(m_fps - fps) > 0.01) {
+                            m_fps = fps;
                             
-                            if (qAbs(m_duration - duration) > 0.1) {
-                                m_duration = duration;
-                                
-                                // 프레임 수 계산
-                                if (m_fps > 0) {
-                                    updateFrameCount();
-                                }
-                                
-                                emit durationChanged(duration);
-                            }
+                            // 프레임 수 업데이트
+                            updateFrameCount();
+                            
+                            emit fpsChanged(m_fps);
                         }
+                        break;
                     }
-                    else if (strcmp(prop->name, "estimated-vf-fps") == 0) {
-                        if (prop->data) {
-                            double fps = *(double *)prop->data;
-                            // FPS 값이 유효하고 이전 값과 다른 경우에만 업데이트
-                            if (fps > 0 && qAbs(m_fps - fps) > 0.01) {
-                                m_fps = fps;
-                                
-                                // 프레임 수 업데이트
-                                updateFrameCount();
-                                
-                                emit fpsChanged(m_fps);
-                            }
+                    
+                    case MpvProperty::MediaTitle: {
+                        QString mediaTitle = QString::fromUtf8(*(char **)prop->data);
+                        if (m_mediaTitle != mediaTitle) {
+                            m_mediaTitle = mediaTitle;
+                            emit mediaTitleChanged(m_mediaTitle);
                         }
+                        break;
                     }
-                }
-                else if (prop->format == MPV_FORMAT_STRING) {
-                    if (strcmp(prop->name, "media-title") == 0) {
-                        if (prop->data) {
-                            QString mediaTitle = QString::fromUtf8(*(char **)prop->data);
-                            if (m_mediaTitle != mediaTitle) {
-                                m_mediaTitle = mediaTitle;
-                                emit mediaTitleChanged(m_mediaTitle);
-                            }
+                    
+                    case MpvProperty::Filename: {
+                        QString filename = QString::fromUtf8(*(char **)prop->data);
+                        if (m_filename != filename) {
+                            m_filename = filename;
+                            emit filenameChanged(m_filename);
                         }
+                        break;
                     }
-                    else if (strcmp(prop->name, "filename") == 0) {
-                        if (prop->data) {
-                            QString filename = QString::fromUtf8(*(char **)prop->data);
-                            if (m_filename != filename) {
-                                m_filename = filename;
-                                emit filenameChanged(m_filename);
-                            }
+                    
+                    case MpvProperty::PlaylistPos: {
+                        emit playlistPosChanged(static_cast<int>(*(int64_t *)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::PlaylistCount: {
+                        emit playlistCountChanged(static_cast<int>(*(int64_t *)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::DemuxerCacheState: {
+                        if (m_cacheManager && prop->format == MPV_FORMAT_NODE) {
+                            m_cacheManager->updateCacheState(*(mpv_node *)prop->data);
+                        }
+                        break;
+                    }
+                    
+                    // 미디어 정보 - 값만 모아 두고 이벤트 루프 끝에서 한 번에 게시
+                    case MpvProperty::VideoCodec: {
+                        m_mediaInfo->setVideoCodec(QString::fromUtf8(*(char **)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::VideoFormat: {
+                        m_mediaInfo->setPixelFormat(QString::fromUtf8(*(char **)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::Width: {
+                        m_mediaInfo->setWidth(static_cast<int>(*(int64_t *)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::Height: {
+                        m_mediaInfo->setHeight(static_cast<int>(*(int64_t *)prop->data));
+                        break;
+                    }
+                    
+                    case MpvProperty::VideoParams: {
+                        if (prop->format == MPV_FORMAT_NODE) {
+                            m_mediaInfo->updateVideoParams(*(mpv_node *)prop->data);
                         }
+                        break;
                     }
+                    
+                    case MpvProperty::Metadata: {
+                        if (prop->format == MPV_FORMAT_NODE) {
+                            m_mediaInfo->updateMetadata(*(mpv_node *)prop->data);
+                        }
+                        break;
+                    }
+                    
+                    default:
+                        break;
                 }
                 
                 break;
             }
             
+            case MPV_EVENT_PLAYBACK_RESTART: {
+                // 시크 완료 (새 위치의 첫 프레임 준비됨) - CompareController가 잠금 시크 완료 판단에 사용
+                emit playbackRestarted();
+                break;
+            }
+            
+            case MPV_EVENT_COMMAND_REPLY: {
+                // mpv_command_node_async 결과 - reply_userdata가 있는 요청만 전달 (ControlServer)
+                if (event->reply_userdata != 0) {
+                    const auto* reply = static_cast<mpv_event_command*>(event->data);
+                    emit commandReply(event->reply_userdata, event->error,
+                                      reply ? mpvNodeToVariant(reply->result) : QVariant());
+                }
+                break;
+            }
+            
             case MPV_EVENT_VIDEO_RECONFIG: {
-                qDebug() << "Video reconfig event - updating frame count only in paused state";
+                hpVerbose(lcMpvCommand) << "Video reconfig event";
                 
-                // 비디오 리컨피그 발생 시 일시정지 상태일 때만 프레임 카운트 업데이트
+                // 일시정지 상태일 때만 프레임 카운트 확인 (타이머를 다시 시작해 연속 이벤트를 묶음)
                 if (m_pause) {
-                    QTimer::singleShot(500, this, &MpvObject::updateFrameCount);
+                    m_reconfigTimer->start();
                 }
                 
                 // 비디오 설정 변경 이벤트 발생
@@ -452,27 +608,32 @@ void MpvObject::handleMpvEvents()
                 break;
             }
             
+            case MPV_EVENT_START_FILE: {
+                m_mediaInfo->reset();
+                emit fileStarted();
+                break;
+            }
+            
             case MPV_EVENT_FILE_LOADED: {
                 qDebug() << "File load completed, updating metadata immediately";
                 
-                // 파일 로드 완료 시 한 번만 메타데이터 업데이트 (타이머 한 번만 실행)
-                if (!m_metadataTimer->isActive()) {
-                    m_metadataTimer->start();
-                }
+                // 코덱/해상도별 디코더 튜닝 프로필 적용 (스레드 수, hwdec)
+                DecoderTuner::applyProfile(mpv);
                 
-                // 타임코드 초기화 및 내장 타임코드 가져오기
+                // 트랙/컨테이너 정보는 track-list 노드를 한 번만 읽어 채움 (게시는 이벤트 루프 끝에서)
+                m_mediaInfo->readTrackList(mpv);
+                
+                // 타임코드 초기화 - 내장 타임코드는 MediaInfo가 파일마다 한 번 읽어 둔 값을 사용
+                // (chapter-metadata SMPTE_TIMECODE, 이후 metadata 이벤트는 MediaInfo를 거쳐 갱신)
                 m_timecode = "00:00:00:00";
-                m_embeddedTimecode = "";
-                if (m_useEmbeddedTimecode || m_timecodeSource > 0) {
-                    QTimer::singleShot(300, this, &MpvObject::fetchEmbeddedTimecode);
-                }
+                fetchEmbeddedTimecode();
                 
-                QTimer::singleShot(100, this, [this]() {
-                    qDebug() << "New file loaded - calculating initial frame count";
-                    updateFrameCount();
-                    updateTimecode();
-                    emit fileLoaded();
-                });
+                // 파일 이름/길이/fps는 속성 변경 이벤트보다 먼저 직접 읽음 (타이머로 기다리지 않음)
+                // - 상태 머신은 여기서 Ready, 첫 playback-restart에서 Playing/Paused로 옮김
+                readLoadedFileProperties();
+                updateFrameCount();
+                updateTimecode();
+                emit fileLoaded();
                 break;
             }
             
@@ -507,13 +668,24 @@ void MpvObject::command(const QVariant& params)
             }
             command.append(nullptr);
             
+            // vf를 직접 바꾸면 명령 뒤에 MPV에서 체인을 다시 읽을 때까지 모르는 상태로 표시
+            const bool changesVideoFilters = byteArrays[0] == "vf";
+            if (changesVideoFilters) {
+                m_videoFiltersKnown = false;
+            }
+            
+            // 시크/프레임 이동은 정방향 디코더로
+            if (byteArrays[0] == "seek" || byteArrays[0] == "frame-step" || byteArrays[0] == "frame-back-step") {
+                ensureForwardPlayback();
+            }
+            
                 // 명령 로깅 (디버깅용)
                 if (num > 0 && byteArrays[0] != "get_property") {
                     QString cmdStr = byteArrays[0];
                     if (cmdStr == "seek" && num > 1) {
-                        qDebug() << "MPV seek to:" << byteArrays[1];
+                        hpVerbose(lcMpvCommand) << "MPV seek to:" << byteArrays[1];
                     } else if (num > 1) {
-                        qDebug() << "MPV command:" << cmdStr << byteArrays[1];
+                        hpVerbose(lcMpvCommand) << "MPV command:" << cmdStr << byteArrays[1];
                     }
                 }
                 
@@ -523,6 +695,11 @@ void MpvObject::command(const QVariant& params)
                     QString error = QString("MPV command failed: %1 (code %2)").arg(mpv_error_string(result)).arg(result);
                     qWarning() << error;
         }
+                
+                // 직접 추가/제거한 필터도 videoFilters에 보이도록 실제 체인을 다시 읽음
+                if (changesVideoFilters) {
+                    refreshVideoFilters();
+                }
     }
 }
     } catch (const std::exception& e) {
@@ -549,12 +726,7 @@ void MpvObject::setProperty(const QString& name, const QVariant& value)
         int flag = value.toBool() ? 1 : 0;
             // 재생/일시 정지는 강제 실행
             if (name == "pause") {
-                mpv_command_string(mpv, QString("set pause %1").arg(flag).toUtf8().constData());
-                
-                // 직접 내부 상태 업데이트
-                m_pause = value.toBool();
-                emit pauseChanged(m_pause);
-                emit playingChanged(!m_pause);
+                setPause(flag != 0);
             } else {
                 mpv_set_property(mpv, nameStr, MPV_FORMAT_FLAG, &flag);
             }
@@ -566,8 +738,7 @@ void MpvObject::setProperty(const QString& name, const QVariant& value)
                 // 시크 함수 호출
                 seekToPosition(val);
             } else if (name == "speed") {
-                // 속도는 명령으로 설정 (더 안정적)
-                mpv_command_string(mpv, QString("set speed %1").arg(val).toUtf8().constData());
+                MpvCommand::setSpeed(mpv, val);
             } else {
                 mpv_set_property(mpv, nameStr, MPV_FORMAT_DOUBLE, &val);
             }
@@ -575,6 +746,9 @@ void MpvObject::setProperty(const QString& name, const QVariant& value)
         else if (value.canConvert<QString>()) {
         QByteArray bytes = value.toString().toUtf8();
             mpv_set_property_string(mpv, nameStr, bytes.constData());
+            if (name == "vf") {
+                refreshVideoFilters();
+            }
         }
     } catch (const std::exception& e) {
         qCritical() << "Exception in setProperty:" << e.what();
@@ -586,16 +760,15 @@ void MpvObject::setProperty(const QString& name, const QVariant& value)
 // 새로운 함수: 안전하고 정확한 시크 처리
 void MpvObject::seekToPosition(double pos)
 {
+    HP_TRACE_SCOPE("MpvObject::seekToPosition");
     try {
         if (!mpv || m_duration <= 0) {
             return;
         }
         
-        // 중요: 시크 전에 지연 중인 타이머 취소하고 마지막 시크 시간 업데이트
-        m_lastSeekTime = QDateTime::currentMSecsSinceEpoch();
-        
         // 시크하면 endReached 상태 초기화
         resetEndReached();
+        ensureForwardPlayback();
         
         // 안전한 시크 범위 계산
         double safePosition = qBound(0.0, pos, m_duration - 0.5);
@@ -612,19 +785,15 @@ void MpvObject::seekToPosition(double pos)
         qDebug() << "MPV seek to:" << finalSeekPos;
         
         // 1. 먼저 일시정지 설정
-        mpv_command_string(mpv, "set pause yes");
+        MpvCommand::setPause(mpv, true);
         if (!m_pause) {
             m_pause = true;
             emit pauseChanged(true);
             emit playingChanged(false);
         }
         
-        // 2. 정확한 시크 수행 (두 가지 방법으로 동시에) - 중요 부분
-        // 2.1 MPV 속성 직접 설정 (UI 즉시 반응)
-        mpv_set_property(mpv, "time-pos", MPV_FORMAT_DOUBLE, &finalSeekPos);
-        
-        // 2.2 명령어로 정확한 시크 실행 (더 정밀한 프레임 위치)
-        mpv_command_string(mpv, QString("seek %1 absolute exact").arg(finalSeekPos).toUtf8().constData());
+        // 2. 정확 시크 한 번 (time-pos 설정/지연 재확인 없음 - 도착 확인이 필요하면 playbackState 사용)
+        MpvCommand::seekAbsolute(mpv, finalSeekPos, true);
         
         // 3. 위치 정보 즉시 업데이트
         m_position = finalSeekPos;
@@ -639,58 +808,6 @@ void MpvObject::seekToPosition(double pos)
             int frame = qRound(finalSeekPos * m_fps);
             emit seekRequested(frame);
         }
-        
-        // 6. 시크 후 정확한 위치 확인을 위한 타이머 (50ms)
-        QTimer::singleShot(50, this, [this, finalSeekPos]() {
-            try {
-                // 시크된 위치 확인
-                double verifyPos = finalSeekPos;
-                mpv_set_property(mpv, "time-pos", MPV_FORMAT_DOUBLE, &verifyPos);
-                
-                // 위치 정보 다시 업데이트
-                m_position = verifyPos;
-                emit positionChanged(verifyPos);
-                
-                // 프레임 위치 다시 계산 및 시그널 발생
-                if (m_fps > 0) {
-                    int frame = qRound(verifyPos * m_fps);
-                    emit seekRequested(frame);
-                }
-                
-                // 강제 업데이트
-                update();
-            } catch (...) {
-                qWarning() << "Error in first seek verification";
-            }
-        });
-        
-        // 7. 두 번째 검증 타이머 (100ms - 더 확실한 검증)
-        QTimer::singleShot(150, this, [this, finalSeekPos]() {
-            try {
-                // 최종 위치 확인
-                QVariant posVal = getProperty("time-pos");
-                if (posVal.isValid()) {
-                    double actualPos = posVal.toDouble();
-                    if (std::abs(actualPos - finalSeekPos) > 0.08) {
-                        // 위치가 다르면 다시 정확하게 시크
-                        double fixPos = finalSeekPos;
-                        mpv_set_property(mpv, "time-pos", MPV_FORMAT_DOUBLE, &fixPos);
-                        
-                        // 위치 정보 다시 업데이트
-                        m_position = fixPos;
-                        emit positionChanged(fixPos);
-                        
-                        // 프레임 위치 시그널 재발생
-                        if (m_fps > 0) {
-                            int frame = qRound(fixPos * m_fps);
-                            emit seekRequested(frame);
-                        }
-                    }
-                }
-            } catch (...) {
-                qWarning() << "Error in second seek verification";
-            }
-        });
     } catch (const std::exception& e) {
         qCritical() << "Exception in seekToPosition:" << e.what();
     } catch (...) {
@@ -791,26 +908,76 @@ void MpvObject::pause()
 void MpvObject::playPause()
 {
     try {
-        bool paused = isPaused();
-        // setProperty 대신 mpv_command_string 직접 사용 (더 안정적)
-        if (paused) {
-            // 재생 시작
-            mpv_command_string(mpv, "set pause no");
-            m_pause = false;
-        } else {
-            // 일시 정지
-            mpv_command_string(mpv, "set pause yes");
-            m_pause = true;
-        }
-        // 상태 변경 알림
-        emit pauseChanged(m_pause);
-        emit playingChanged(!m_pause);
+        setPause(!isPaused());
         update();
     } catch (const std::exception& e) {
         qCritical() << "Exception in playPause:" << e.what();
     }
 }
 
+// 일시정지 설정 - 문자열 명령 대신 플래그 속성을 바로 설정하고 내부 상태도 즉시 갱신
+void MpvObject::setPause(bool paused)
+{
+    if (!mpv) {
+        return;
+    }
+    const int result = MpvCommand::setPause(mpv, paused);
+    if (result < 0) {
+        qWarning() << "Failed to set pause:" << mpv_error_string(result);
+        return;
+    }
+    m_pause = paused;
+    emit pauseChanged(m_pause);
+    emit playingChanged(!m_pause);
+}
+
+void MpvObject::seekAbsolute(double seconds, SeekMode mode)
+{
+    if (!mpv) {
+        return;
+    }
+    ensureForwardPlayback();
+    const int result = MpvCommand::seekAbsolute(mpv, seconds, mode == SeekExact);
+    if (result < 0) {
+        hpVerbose(lcMpvCommand) << "seek failed:" << mpv_error_string(result);
+    }
+}
+
+void MpvObject::seekRelative(double seconds, SeekMode mode)
+{
+    if (!mpv) {
+        return;
+    }
+    ensureForwardPlayback();
+    const int result = MpvCommand::seekRelative(mpv, seconds, mode == SeekExact);
+    if (result < 0) {
+        hpVerbose(lcMpvCommand) << "seek failed:" << mpv_error_string(result);
+    }
+}
+
+void MpvObject::frameStep()
+{
+    if (mpv) {
+        ensureForwardPlayback();
+        MpvCommand::frameStep(mpv);
+    }
+}
+
+void MpvObject::frameBackStep()
+{
+    if (mpv) {
+        ensureForwardPlayback();
+        MpvCommand::frameBackStep(mpv);
+    }
+}
+
+void MpvObject::ensureForwardPlayback()
+{
+    if (m_reversePlayback) {
+        m_reversePlayback->restoreForward();
+    }
+}
+
 // 포지션 업데이트 함수 - 제거 (불필요한 중복 호출 방지)
 void MpvObject::updatePositionProperty()
 {
@@ -838,52 +1005,6 @@ double MpvObject::fps() const
     return m_fps;
 }
 
-// 새로운 메서드: 성능 모니터링
-void MpvObject::checkPerformance()
-{
-    if (!mpv || m_filename.isEmpty()) return;
-    
-    try {
-        // 현재 시간과 마지막 체크 시간 간의 차이 계산
-        QDateTime now = QDateTime::currentDateTime();
-        
-        if (!m_lastPerformanceCheck.isValid()) {
-            m_lastPerformanceCheck = now;
-            return;
-        }
-        
-        qint64 elapsed = m_lastPerformanceCheck.msecsTo(now);
-        m_lastPerformanceCheck = now;
-        
-        if (elapsed <= 0) return;
-        
-        // 재생 중일 때만 체크
-        if (!m_pause && m_duration > 0) {
-            // FPS 체크
-            QVariant fps = getProperty("estimated-vf-fps");
-            if (fps.isValid() && fps.toDouble() > 0) {
-                double fpsValue = fps.toDouble();
-                // 필요한 경우 성능 최적화 적용
-                if (fpsValue < m_fps * 0.8) { // FPS가 20% 이상 떨어졌다면
-                    qDebug() << "Performance warning: FPS dropped to" << fpsValue << "(expected" << m_fps << ")";
-                    
-                    // 성능 최적화 단계 적용
-                    if (!m_performanceOptimizationApplied) {
-                        qDebug() << "Applying performance optimizations";
-                        command(QVariantList() << "set_property" << "scale" << "bilinear");
-                        command(QVariantList() << "set_property" << "hwdec" << "auto-copy");
-                        m_performanceOptimizationApplied = true;
-                    }
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        qWarning() << "Performance check error:" << e.what();
-    } catch (...) {
-        qWarning() << "Unknown error in performance check";
-    }
-}
-
 // 비디오 종료 처리를 일관되게 관리하는 함수
 void MpvObject::handleEndOfVideo()
 {
@@ -893,6 +1014,11 @@ void MpvObject::handleEndOfVideo()
             return;
         }
         
+        // 파일 반복은 MPV loop-file이 처리 (EOF에서 반복을 켠 경우는 PlaybackStateMachine)
+        if (m_loopEnabled) {
+            return;
+        }
+        
         qDebug() << "Handling end of video at position:" << m_position;
         m_endReached = true;
         emit endReachedChanged(true);
@@ -911,32 +1037,6 @@ void MpvObject::handleEndOfVideo()
             
             // 마지막 프레임으로 정확히 이동
             seekToLastFrame();
-            
-            // 루프 모드가 활성화된 경우 처리
-            if (m_loopEnabled) {
-                QTimer::singleShot(150, this, [this]() {
-                    try {
-                        qDebug() << "Loop activated, going back to start";
-                        seekToFirstFrame();
-                        
-                        // 다시 재생 시작
-                        QTimer::singleShot(200, this, [this]() {
-                            command(QVariantList() << "set_property" << "pause" << false);
-                            m_pause = false;
-                            emit pauseChanged(false);
-                            emit playingChanged(true);
-                            
-                            // endReached 상태 리셋
-                            m_endReached = false;
-                            emit endReachedChanged(false);
-                            
-                            update();
-                        });
-                    } catch (const std::exception& e) {
-                        qCritical() << "Exception in loop handling:" << e.what();
-                    }
-                });
-            }
         } else {
             // keep-open이 비활성화된 경우 기존 동작 유지
             // 항상 일시 정지 먼저 설정
@@ -969,30 +1069,6 @@ void MpvObject::handleEndOfVideo()
                 mpv_set_property_string(mpv, "pause", "yes");
                 mpv_set_property_string(mpv, "time-pos", posStr.toUtf8().constData());
                 emit positionChanged(lastFramePos);
-                
-                // 루프 모드 처리
-                if (m_loopEnabled) {
-                    QTimer::singleShot(150, this, [this]() {
-                        try {
-                            qDebug() << "Loop activated, going back to start";
-                            seekToFirstFrame();
-                            
-                            QTimer::singleShot(200, this, [this]() {
-                                command(QVariantList() << "set_property" << "pause" << false);
-                                m_pause = false;
-                                emit pauseChanged(false);
-                                emit playingChanged(true);
-                                
-                                m_endReached = false;
-                                emit endReachedChanged(false);
-                                
-                                update();
-                            });
-                        } catch (const std::exception& e) {
-                            qCritical() << "Exception in loop handling:" << e.what();
-                        }
-                    });
-                }
             }
         }
         
@@ -1034,8 +1110,10 @@ void MpvObject::setLoopEnabled(bool enabled)
     if (m_loopEnabled != enabled) {
         m_loopEnabled = enabled;
         
-        // MPV 속성 설정
-        command(QVariantList() << "set_property" << "loop" << (enabled ? "inf" : "no"));
+        // 파일 전체 반복 - MPV가 끝에서 바로 처음으로 시크 (EOF 처리/타이머 없음)
+        if (mpv) {
+            mpv_set_property_string(mpv, "loop-file", enabled ? "inf" : "no");
+        }
         
         emit loopChanged(enabled);
     }
@@ -1081,6 +1159,51 @@ double MpvObject::duration() const
     return m_duration;
 }
 
+QObject* MpvObject::governor() const
+{
+    return m_governor;
+}
+
+QObject* MpvObject::cacheManager() const
+{
+    return m_cacheManager;
+}
+
+QObject* MpvObject::waveform() const
+{
+    return m_waveform;
+}
+
+QObject* MpvObject::colorPipeline() const
+{
+    return m_colorPipeline;
+}
+
+QObject* MpvObject::reversePlayback() const
+{
+    return m_reversePlayback;
+}
+
+QObject* MpvObject::loopRange() const
+{
+    return m_loopRange;
+}
+
+QObject* MpvObject::playbackState() const
+{
+    return m_playbackState;
+}
+
+QObject* MpvObject::mediaInfo() const
+{
+    return m_mediaInfo;
+}
+
+QObject* MpvObject::keyframeMap() const
+{
+    return m_keyframeMap;
+}
+
 QString MpvObject::mediaTitle() const
 {
     return m_mediaTitle;
@@ -1089,43 +1212,16 @@ QString MpvObject::mediaTitle() const
 // 총 프레임 수 계산 메서드 추가 - MPV 네이티브 속성 우선 사용
 void MpvObject::updateFrameCount()
 {
+    HP_TRACE_SCOPE("MpvObject::updateFrameCount");
     // 기본 검증
     if (!mpv || m_filename.isEmpty()) {
-        qDebug() << "Failed to calculate frame count: missing required data";
-        return;
-    }
-    
-    // 드래그/시크 중에는 업데이트 방지
-    QVariant blocked = false;
-    try {
-        QObject* parent = this->parent();
-        while (parent) {
-            if (parent->metaObject()->className() == QStringLiteral("QQuickItem") || 
-                QString(parent->metaObject()->className()).contains("VideoArea")) {
-                
-                blocked = parent->property("metadataUpdateBlocked");
-                if (blocked.isValid() && blocked.toBool()) {
-                    qDebug() << "Metadata blocked - skipping frame count update";
-                    return;
-                }
-                break;
-            }
-            parent = parent->parent();
-        }
-    } catch (...) {
-        // 무시하고 계속 진행
-    }
-    
-    // 시크 직후에는 업데이트 방지
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (m_lastSeekTime > 0 && (now - m_lastSeekTime) < 2000) {
-        qDebug() << "Within 2 seconds after seek - skipping frame count update";
+        hpVerbose(lcFrameCount) << "Failed to calculate frame count: missing required data";
         return;
     }
     
     // 실제 프레임 카운트 계산 수행
     try {
-        qDebug() << "Updating frame count for file:" << m_filename;
+        hpVerbose(lcFrameCount) << "Updating frame count for file:" << m_filename;
         
         int finalFrameCount = 0;
         QString method = "unknown";
@@ -1137,32 +1233,20 @@ void MpvObject::updateFrameCount()
             if (result >= 0 && estimatedFrames > 0) {
                 finalFrameCount = static_cast<int>(std::round(estimatedFrames));
                 method = "estimated-frame-count";
-                qDebug() << "Method 1 - estimated-frame-count:" << estimatedFrames << "rounded to:" << finalFrameCount;
+                hpVerbose(lcFrameCount) << "Method 1 - estimated-frame-count:" << estimatedFrames << "rounded to:" << finalFrameCount;
             }
         } catch (...) {
-            qDebug() << "Method 1 failed - estimated-frame-count not available";
+            hpVerbose(lcFrameCount) << "Method 1 failed - estimated-frame-count not available";
         }
         
-        // 방법 2: track-list의 demux-frame-count 시도
+        // 방법 2: 첫 번째 트랙의 demux-frame-count 시도 (track-list 전체는 읽지 않음)
         if (finalFrameCount <= 0) {
-            try {
-                char* trackListStr = nullptr;
-                int result = mpv_get_property(mpv, "track-list", MPV_FORMAT_STRING, &trackListStr);
-                if (result >= 0 && trackListStr) {
-                    QString trackList(trackListStr);
-                    mpv_free(trackListStr);
-                    
-                    // 첫 번째 비디오 트랙의 demux-frame-count 찾기
-                    double demuxFrames = 0;
-                    result = mpv_get_property(mpv, "track-list/0/demux-frame-count", MPV_FORMAT_DOUBLE, &demuxFrames);
-                    if (result >= 0 && demuxFrames > 0) {
-                        finalFrameCount = static_cast<int>(std::round(demuxFrames));
-                        method = "demux-frame-count";
-                        qDebug() << "Method 2 - demux-frame-count:" << demuxFrames << "rounded to:" << finalFrameCount;
-                    }
-                }
-            } catch (...) {
-                qDebug() << "Method 2 failed - demux-frame-count not available";
+            double demuxFrames = 0;
+            int result = mpv_get_property(mpv, "track-list/0/demux-frame-count", MPV_FORMAT_DOUBLE, &demuxFrames);
+            if (result >= 0 && demuxFrames > 0) {
+                finalFrameCount = static_cast<int>(std::round(demuxFrames));
+                method = "demux-frame-count";
+                hpVerbose(lcFrameCount) << "Method 2 - demux-frame-count:" << demuxFrames << "rounded to:" << finalFrameCount;
             }
         }
         
@@ -1174,10 +1258,10 @@ void MpvObject::updateFrameCount()
                 if (result >= 0 && frameCount > 0) {
                     finalFrameCount = static_cast<int>(std::round(frameCount));
                     method = "frame-count";
-                    qDebug() << "Method 3 - frame-count:" << frameCount << "rounded to:" << finalFrameCount;
+                    hpVerbose(lcFrameCount) << "Method 3 - frame-count:" << frameCount << "rounded to:" << finalFrameCount;
                 }
             } catch (...) {
-                qDebug() << "Method 3 failed - frame-count not available";
+                hpVerbose(lcFrameCount) << "Method 3 failed - frame-count not available";
             }
         }
         
@@ -1185,24 +1269,26 @@ void MpvObject::updateFrameCount()
         if (finalFrameCount <= 0 && m_duration > 0 && m_fps > 0) {
             finalFrameCount = static_cast<int>(std::ceil(m_duration * m_fps));
             method = "duration * fps calculation";
-            qDebug() << "Method 4 (fallback) - duration * fps:" << m_duration << "*" << m_fps << "=" << finalFrameCount;
+            hpVerbose(lcFrameCount) << "Method 4 (fallback) - duration * fps:" << m_duration << "*" << m_fps << "=" << finalFrameCount;
         }
         
         // 최소 1 프레임 보장
         m_frameCount = std::max(1, finalFrameCount);
         
-        qDebug() << "Frame count determined using" << method << ": total frames =" << m_frameCount;
+        qCDebug(lcFrameCount) << "Frame count determined using" << method << ": total frames =" << m_frameCount;
         
         // MPV의 실제 프레임 수를 그대로 사용 (강제 조정 제거)
         // 이전에 172->171 강제 조정이 "171 프레임 트랩" 원인이었음
         
         // 프레임 번호 체계에 따른 표시 정보 출력
         if (m_oneBasedFrameNumbers) {
-            qDebug() << "Final frame count:" << m_frameCount << "(Display: 1-" << m_frameCount << ")";
+            hpVerbose(lcFrameCount) << "Final frame count:" << m_frameCount << "(Display: 1-" << m_frameCount << ")";
         } else {
-            qDebug() << "Final frame count:" << m_frameCount << "(Display: 0-" << (m_frameCount - 1) << ")";
+            hpVerbose(lcFrameCount) << "Final frame count:" << m_frameCount << "(Display: 0-" << (m_frameCount - 1) << ")";
         }
         
+        m_frameCountFilename = m_filename;
+        
         // 프레임 카운트 변경 신호 발생
         emit frameCountChanged(m_frameCount);
         
@@ -1251,14 +1337,132 @@ int MpvObject::frameCount() const
     return m_frameCount;
 }
 
+// 비디오 리컨피그가 잦아든 뒤 처리 - 필터 체인 변경 같은 리컨피그는 길이/fps가 그대로이므로 프레임 수를 다시 계산하지 않음
+void MpvObject::handleVideoReconfig()
+{
+    if (m_frameCount > 0 && m_frameCountFilename == m_filename) {
+        hpVerbose(lcFrameCount) << "Reconfig for the same file - frame count unchanged";
+        return;
+    }
+    updateFrameCount();
+}
+
+// FILE_LOADED 시점의 파일 이름/길이/fps (이전 파일 값이 남지 않도록 MPV에서 직접 읽음)
+void MpvObject::readLoadedFileProperties()
+{
+    if (!mpv)
+        return;
+
+    if (char* name = mpv_get_property_string(mpv, "filename")) {
+        const QString filename = QString::fromUtf8(name);
+        mpv_free(name);
+        if (m_filename != filename) {
+            m_filename = filename;
+            emit filenameChanged(m_filename);
+        }
+    }
+
+    double duration = 0;
+    if (mpv_get_property(mpv, "duration", MPV_FORMAT_DOUBLE, &duration) >= 0 && qAbs(m_duration - duration) > 0.1) {
+        m_duration = duration;
+        emit durationChanged(m_duration);
+    }
+
+    // estimated-vf-fps는 프레임이 디코딩된 뒤에 생기므로 컨테이너 fps로 시작
+    double fps = 0;
+    if (mpv_get_property(mpv, "container-fps", MPV_FORMAT_DOUBLE, &fps) >= 0 && fps > 0 && qAbs(m_fps - fps) > 0.01) {
+        m_fps = fps;
+        emit fpsChanged(m_fps);
+    }
+}
+
+QStringList MpvObject::videoFilters() const
+{
+    return m_videoFilters;
+}
+
+// CPU 필터(vf) 체인 적용 - 하드웨어 디코딩 프레임을 CPU로 복사하므로 색 보정은 colorPipeline(GPU 셰이더)을 사용
+// 원하는 체인 전체를 vf set 한 번으로 적용 (clr + add 반복은 단계마다 비디오 체인을 다시 구성함)
+// MPV는 이전 체인과 같은 필터 인스턴스를 재사용하므로 바뀐 필터만 다시 초기화된다
 void MpvObject::applyVideoFilters(const QStringList& filters)
 {
     if (!mpv)
         return;
 
-    command(QVariantList() << "vf" << "clr");
-    for (const QString &f : filters) {
-        command(QVariantList() << "vf" << "add" << f);
+    // 체인을 모르면 (다시 읽기 실패) 비교하지 않고 그대로 적용
+    if (m_videoFiltersKnown && filters == m_videoFilters) {
+        return;
+    }
+
+    const QByteArray chain = filters.join(',').toUtf8();
+    const char* args[] = {"vf", "set", chain.constData(), nullptr};
+    const int result = mpv_command(mpv, args);
+    if (result < 0) {
+        qWarning() << "Failed to set video filters" << filters << ":" << mpv_error_string(result);
+        return;
+    }
+
+    m_videoFiltersKnown = true;
+    if (m_videoFilters != filters) {
+        m_videoFilters = filters;
+        emit videoFiltersChanged(m_videoFilters);
+    }
+}
+
+// MPV의 실제 vf 체인을 읽어 m_videoFilters 갱신 (command()/setProperty()로 vf를 직접 바꾼 뒤)
+// 직접 넣은 필터도 목록에 남아 QML이 videoFilters로 체인을 다시 만들 때 빠지지 않는다.
+// MPV가 정규화한 형태(name=key=value:...)로 읽으므로 vf set에 그대로 다시 쓸 수 있다.
+void MpvObject::refreshVideoFilters()
+{
+    if (!mpv)
+        return;
+
+    mpv_node node;
+    const int result = mpv_get_property(mpv, "vf", MPV_FORMAT_NODE, &node);
+    if (result < 0) {
+        qWarning() << "Failed to read video filters:" << mpv_error_string(result);
+        return;
+    }
+    const QVariantList entries = mpvNodeToVariant(node).toList();
+    mpv_free_node_contents(&node);
+
+    // 값에 구분 문자가 있으면 MPV의 %길이% 인용 사용
+    auto quote = [](const QString& value) -> QString {
+        static const QRegularExpression special(QStringLiteral(R"([,:=\[\]%\s"'])"));
+        if (!value.contains(special)) {
+            return value;
+        }
+        return "%" + QString::number(value.toUtf8().size()) + "%" + value;
+    };
+
+    QStringList filters;
+    for (const QVariant& entry : entries) {
+        const QVariantMap filter = entry.toMap();
+        QString text;
+        const QString label = filter.value("label").toString();
+        if (!label.isEmpty()) {
+            text += "@" + label + ":";
+        }
+        if (filter.contains("enabled") && !filter.value("enabled").toBool()) {
+            text += "!";
+        }
+        text += filter.value("name").toString();
+
+        const QVariantMap params = filter.value("params").toMap();
+        QStringList pairs;
+        for (auto it = params.constBegin(); it != params.constEnd(); ++it) {
+            pairs.append(it.key() + "=" + quote(it.value().toString()));
+        }
+        if (!pairs.isEmpty()) {
+            text += "=" + pairs.join(':');
+        }
+        filters.append(text);
+    }
+
+    m_videoFiltersKnown = true;
+    if (m_videoFilters != filters) {
+        m_videoFilters = filters;
+        emit videoFiltersChanged(m_videoFilters);
     }
 }
 
@@ -1278,115 +1482,83 @@ QString MpvObject::videoResolution() const
     return m_videoResolution;
 }
 
-// 메타데이터 업데이트 함수 구현
-void MpvObject::updateVideoMetadata()
+// 재생 목록에서 미리 분석한 메타데이터 적용 - 파일 전환 직후 타이머를 기다리지 않고 UI에 반영
+void MpvObject::applyPreprobedMetadata(const QVariantMap& info)
 {
-    if (!mpv) return;
+    if (info.isEmpty()) {
+        return;
+    }
     
-    // 메타데이터 업데이트가 차단된 상태인지 확인 - 강화된 검사
-    QVariant blocked = false;
-    try {
-        // 1. 직접 부모 객체에서 플래그 확인
-        QObject* parent = this->parent();
-        while (parent) {
-            if (parent->metaObject()->className() == QStringLiteral("QQuickItem") || 
-                QString(parent->metaObject()->className()).contains("VideoArea")) {
-                
-                blocked = parent->property("metadataUpdateBlocked");
-                if (blocked.isValid() && blocked.toBool()) {
-                    qDebug() << "Metadata update blocked - skipping update";
-                    return;
-                }
-                break;
-            }
-            parent = parent->parent();
-        }
-    } catch (...) {
-        // 무시하고 계속 진행
+    const QString codec = info.value("codec").toString();
+    if (!codec.isEmpty() && m_videoCodec != codec) {
+        m_videoCodec = codec;
+        emit videoCodecChanged(m_videoCodec);
     }
     
-    // 2. 재생 중인지 확인 - 재생 중이면 메타데이터 업데이트 차단
-    if (!m_pause) {
-        qDebug() << "Video is playing - skipping metadata update";
-        return;
+    const QString format = info.value("format").toString();
+    if (!format.isEmpty() && m_videoFormat != format) {
+        m_videoFormat = format;
+        emit videoFormatChanged(m_videoFormat);
     }
     
-    // 3. 시크 직후에는 업데이트 방지 (5초 이내로 확장)
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (m_lastSeekTime > 0 && (now - m_lastSeekTime) < 5000) {
-        qDebug() << "Within 5 seconds after seek - skipping metadata update";
-        return;
+    const QString resolution = info.value("resolution").toString();
+    if (!resolution.isEmpty() && m_videoResolution != resolution) {
+        m_videoResolution = resolution;
+        emit videoResolutionChanged(m_videoResolution);
     }
     
-    // 4. 초기 로드 후 메타데이터가 이미 업데이트된 경우 불필요한 업데이트 방지
-    static bool metadataAlreadyUpdated = false;
-    if (metadataAlreadyUpdated && !m_filename.isEmpty()) {
-        static QString lastProcessedFile = "";
-        if (lastProcessedFile == m_filename) {
-            qDebug() << "Metadata already processed for this file - skipping redundant update";
-            return;
-        }
+    const double fps = info.value("fps").toDouble();
+    if (fps > 0 && qAbs(m_fps - fps) > 0.01) {
+        m_fps = fps;
+        emit fpsChanged(m_fps);
     }
     
-    qDebug() << "Starting metadata update - file:" << m_filename;
+    const double duration = info.value("duration").toDouble();
+    if (duration > 0 && qAbs(m_duration - duration) > 0.1) {
+        m_duration = duration;
+        emit durationChanged(m_duration);
+    }
     
-    try {
-        // 비디오 코덱 정보 가져오기
-        QVariant codecVar = getProperty("video-codec");
-        if (codecVar.isValid() && !codecVar.toString().isEmpty()) {
-            QString newCodec = codecVar.toString();
-            if (m_videoCodec != newCodec) {
-                m_videoCodec = newCodec;
-                emit videoCodecChanged(m_videoCodec);
-                qDebug() << "Video codec updated:" << m_videoCodec;
-            }
-        }
-        
-        // 비디오 포맷 정보 가져오기
-        QVariant formatVar = getProperty("video-format");
-        if (formatVar.isValid() && !formatVar.toString().isEmpty()) {
-            QString newFormat = formatVar.toString();
-            if (m_videoFormat != newFormat) {
-                m_videoFormat = newFormat;
-                emit videoFormatChanged(m_videoFormat);
-                qDebug() << "Video format updated:" << m_videoFormat;
-            }
-        }
-        
-        // 비디오 해상도 정보 계산
-        QVariant widthVar = getProperty("width");
-        QVariant heightVar = getProperty("height");
-        if (widthVar.isValid() && heightVar.isValid()) {
-            int width = widthVar.toInt();
-            int height = heightVar.toInt();
-            if (width > 0 && height > 0) {
-                QString newResolution = QString("%1×%2").arg(width).arg(height);
-                if (m_videoResolution != newResolution) {
-                    m_videoResolution = newResolution;
-                    emit videoResolutionChanged(m_videoResolution);
-                    qDebug() << "Video resolution updated:" << m_videoResolution;
-                }
-            }
-        }
-        
-        // 메타데이터 변경 시그널 발생
-        emit videoMetadataChanged();
-        qDebug() << "Metadata update completed - one-time update successful";
-        
-        // 한 번 업데이트 완료 후 타이머 중지 (반복 방지)
-        if (m_metadataTimer->isActive() && !m_metadataTimer->isSingleShot()) {
-            m_metadataTimer->stop();
-        }
-        
-        // 현재 파일에 대한 메타데이터 업데이트 완료 표시
-        metadataAlreadyUpdated = true;
-        static QString lastProcessedFile = m_filename;
-        
-    } catch (const std::exception& e) {
-        qWarning() << "Error updating video metadata:" << e.what();
-    } catch (...) {
-        qWarning() << "Unknown error updating video metadata";
+    const int frameCount = info.value("frameCount").toInt();
+    if (frameCount > 0 && m_frameCount != frameCount) {
+        m_frameCount = frameCount;
+        emit frameCountChanged(m_frameCount);
+    }
+    
+    emit videoMetadataChanged();
+    qDebug() << "Applied pre-probed metadata:" << info;
+}
+
+// MediaInfo 게시 시 호출 - 기존 videoCodec/videoFormat/videoResolution 속성에 반영
+// (재생 중이나 시크 직후에도 값만 옮기므로 건너뛰지 않음)
+void MpvObject::updateVideoMetadata()
+{
+    HP_TRACE_SCOPE("MpvObject::updateVideoMetadata");
+    
+    const QString codec = m_mediaInfo->videoCodec();
+    if (!codec.isEmpty() && m_videoCodec != codec) {
+        m_videoCodec = codec;
+        emit videoCodecChanged(m_videoCodec);
+    }
+    
+    const QString format = m_mediaInfo->pixelFormat();
+    if (!format.isEmpty() && m_videoFormat != format) {
+        m_videoFormat = format;
+        emit videoFormatChanged(m_videoFormat);
     }
+    
+    const QString resolution = m_mediaInfo->resolution();
+    if (!resolution.isEmpty() && m_videoResolution != resolution) {
+        m_videoResolution = resolution;
+        emit videoResolutionChanged(m_videoResolution);
+    }
+    
+    // 컨테이너 타임코드가 바뀌면 내장 타임코드 다시 결정
+    if ((m_useEmbeddedTimecode || m_timecodeSource > 0) && m_mediaInfo->embeddedTimecode() != m_embeddedTimecode) {
+        fetchEmbeddedTimecode();
+    }
+    
+    emit videoMetadataChanged();
 }
 
 // 타임코드 관련 접근자/설정자 구현
@@ -1495,9 +1667,12 @@ void MpvObject::updateTimecode()
     // 타임코드 소스에 따라 분기
     if (m_timecodeSource > 0) {
         // 1=Embedded SMPTE, 2=File Metadata, 3=Reel Name
-        fetchEmbeddedTimecode();
+        // 파일 로드/메타데이터 이벤트에서 캐시한 값만 읽음 (타이머 틱마다 MPV를 조회하지 않음)
         if (!m_embeddedTimecode.isEmpty()) {
-            emit timecodeChanged(m_embeddedTimecode);
+            if (m_timecode != m_embeddedTimecode) {
+                m_timecode = m_embeddedTimecode;
+                emit timecodeChanged(m_timecode);
+            }
             return;
         }
     }
@@ -1512,212 +1687,33 @@ void MpvObject::updateTimecode()
 }
 
 // 내장 타임코드 추출 함수
+// MediaInfo가 FILE_LOADED(챕터 SMPTE_TIMECODE)와 metadata 이벤트(timecode/reel_timecode)로
+// 캐시한 값을 읽기만 함 - MPV 호출 없음
 void MpvObject::fetchEmbeddedTimecode()
 {
-    if (!mpv)
-        return;
-    
-    // MPV에서 타임코드 관련 속성 추출 시도
-    // 1. SMPTE 타임코드 확인
-    char* tc_smpte = mpv_get_property_string(mpv, "chapter-metadata/SMPTE_TIMECODE");
-    if (tc_smpte && strlen(tc_smpte) > 0) {
-        m_embeddedTimecode = QString(tc_smpte);
-        mpv_free(tc_smpte);
+    const QString embedded = m_mediaInfo->embeddedTimecode();
+    if (embedded != m_embeddedTimecode) {
+        m_embeddedTimecode = embedded;
         emit embeddedTimecodeChanged(m_embeddedTimecode);
-        return;
     }
-    if (tc_smpte) mpv_free(tc_smpte);
-    
-    // 2. 파일 메타데이터에서 타임코드 확인
-    char* tc_meta = mpv_get_property_string(mpv, "metadata/timecode");
-    if (tc_meta && strlen(tc_meta) > 0) {
-        m_embeddedTimecode = QString(tc_meta);
-        mpv_free(tc_meta);
-        emit embeddedTimecodeChanged(m_embeddedTimecode);
-        return;
-    }
-    if (tc_meta) mpv_free(tc_meta);
-    
-    // 3. 릴 이름에서 타임코드 확인 (일부 프로페셔널 비디오 파일에서 사용)
-    char* reel_tc = mpv_get_property_string(mpv, "metadata/reel_timecode");
-    if (reel_tc && strlen(reel_tc) > 0) {
-        m_embeddedTimecode = QString(reel_tc);
-        mpv_free(reel_tc);
-        emit embeddedTimecodeChanged(m_embeddedTimecode);
-        return;
-    }
-    if (reel_tc) mpv_free(reel_tc);
-    
-    // 내장 타임코드가 없는 경우
-    m_embeddedTimecode = "";
-    emit embeddedTimecodeChanged(m_embeddedTimecode);
 }
 
 // 프레임을 타임코드 문자열로 변환하는 유틸리티 메서드
 QString MpvObject::frameToTimecode(int frame, int format, const QString& customPattern) const
 {
-    if (m_fps <= 0) 
-        return "00:00:00:00";
-    
     // 기본 형식 사용 (호출자가 지정하지 않았을 경우)
     if (format < 0) {
         format = m_timecodeFormat;
     }
     
-    // 프레임 수가 음수인 경우 처리
-    bool isNegative = frame < 0;
-    frame = abs(frame);
-    
-    // 총 초 계산
-    double totalSeconds = frame / m_fps;
-    
-    // 시, 분, 초 계산
-    int hours = static_cast<int>(totalSeconds / 3600);
-    int minutes = static_cast<int>((totalSeconds - hours * 3600) / 60);
-    int seconds = static_cast<int>(totalSeconds - hours * 3600 - minutes * 60);
-    
-    // 프레임 부분 계산
-    double fractionalSeconds = totalSeconds - static_cast<int>(totalSeconds);
-    int frameNumber = static_cast<int>(fractionalSeconds * m_fps);
-    
-    // 밀리초 계산 (HH:MM:SS.MS 형식용)
-    int milliseconds = static_cast<int>(fractionalSeconds * 1000);
-    
-    // 타임코드 포맷에 따라 문자열 생성
-    QString timecode;
-    
-    switch (format) {
-        case 0: // SMPTE Non-Drop (HH:MM:SS:FF)
-            timecode = QString("%1:%2:%3:%4")
-                        .arg(hours, 2, 10, QChar('0'))
-                        .arg(minutes, 2, 10, QChar('0'))
-                        .arg(seconds, 2, 10, QChar('0'))
-                        .arg(frameNumber, 2, 10, QChar('0'));
-            break;
-        
-        case 1: // SMPTE Drop-Frame (HH:MM:SS;FF)
-            timecode = QString("%1:%2:%3;%4")
-                        .arg(hours, 2, 10, QChar('0'))
-                        .arg(minutes, 2, 10, QChar('0'))
-                        .arg(seconds, 2, 10, QChar('0'))
-                        .arg(frameNumber, 2, 10, QChar('0'));
-            break;
-        
-        case 2: // HH:MM:SS.MS (밀리초)
-            timecode = QString("%1:%2:%3.%4")
-                        .arg(hours, 2, 10, QChar('0'))
-                        .arg(minutes, 2, 10, QChar('0'))
-                        .arg(seconds, 2, 10, QChar('0'))
-                        .arg(milliseconds, 3, 10, QChar('0'));
-            break;
-        
-        case 3: // Frames Only
-            timecode = QString::number(frame);
-            break;
-        
-        case 4: // Custom Format
-            {
-                QString pattern = customPattern.isEmpty() ? m_customTimecodePattern : customPattern;
-                
-                // 패턴 치환
-                timecode = pattern;
-                timecode.replace("%H", QString("%1").arg(hours, 2, 10, QChar('0')));
-                timecode.replace("%M", QString("%1").arg(minutes, 2, 10, QChar('0')));
-                timecode.replace("%S", QString("%1").arg(seconds, 2, 10, QChar('0')));
-                timecode.replace("%f", QString("%1").arg(frameNumber, 2, 10, QChar('0')));
-                timecode.replace("%t", QString::number(frame));
-                timecode.replace("%ms", QString("%1").arg(milliseconds, 3, 10, QChar('0')));
-            }
-            break;
-        
-        default:
-            timecode = QString("%1:%2:%3:%4")
-                        .arg(hours, 2, 10, QChar('0'))
-                        .arg(minutes, 2, 10, QChar('0'))
-                        .arg(seconds, 2, 10, QChar('0'))
-                        .arg(frameNumber, 2, 10, QChar('0'));
-    }
-    
-    // 음수 프레임인 경우 음수 기호 추가
-    if (isNegative) {
-        timecode = "-" + timecode;
-    }
-    
-    return timecode;
+    return FrameMath::frameToTimecode(frame, m_fps, format,
+                                      customPattern.isEmpty() ? m_customTimecodePattern : customPattern);
 }
 
 // 타임코드 문자열을 프레임 번호로 변환하는 유틸리티 메서드
 int MpvObject::timecodeToFrame(const QString& tc) const
 {
-    if (m_fps <= 0) 
-        return 0;
-    
-    // 타임코드가 단순히 프레임 번호인 경우
-    bool ok;
-    int frame = tc.toInt(&ok);
-    if (ok) return frame;
-    
-    // 음수 타임코드 처리
-    bool isNegative = tc.startsWith("-");
-    QString timecode = isNegative ? tc.mid(1) : tc;
-    
-    // 여러 타임코드 형식 처리
-    QRegularExpression reNonDrop("(\\d+):(\\d+):(\\d+):(\\d+)");
-    QRegularExpression reDropFrame("(\\d+):(\\d+):(\\d+);(\\d+)");
-    QRegularExpression reMilliseconds("(\\d+):(\\d+):(\\d+)\\.(\\d+)");
-    
-    QRegularExpressionMatch match;
-    
-    // SMPTE Non-Drop 형식 (HH:MM:SS:FF) 처리
-    match = reNonDrop.match(timecode);
-    if (match.hasMatch()) {
-        int hours = match.captured(1).toInt();
-        int minutes = match.captured(2).toInt();
-        int seconds = match.captured(3).toInt();
-        int frames = match.captured(4).toInt();
-        
-        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * m_fps) + frames;
-        return isNegative ? -totalFrames : totalFrames;
-    }
-    
-    // SMPTE Drop-Frame 형식 (HH:MM:SS;FF) 처리
-    match = reDropFrame.match(timecode);
-    if (match.hasMatch()) {
-        int hours = match.captured(1).toInt();
-        int minutes = match.captured(2).toInt();
-        int seconds = match.captured(3).toInt();
-        int frames = match.captured(4).toInt();
-        
-        // 드롭 프레임 보정 (NTSC에 주로 사용)
-        int totalMinutes = hours * 60 + minutes;
-        int droppedFrames = 0;
-        
-        if (qFuzzyCompare(m_fps, 29.97) || qFuzzyCompare(m_fps, 30.0)) {
-            // 각 10분마다 제외할 프레임 수 계산
-            droppedFrames = 2 * (totalMinutes - totalMinutes / 10);
-        }
-        
-        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * m_fps) + frames - droppedFrames;
-        return isNegative ? -totalFrames : totalFrames;
-    }
-    
-    // HH:MM:SS.MS 형식 처리
-    match = reMilliseconds.match(timecode);
-    if (match.hasMatch()) {
-        int hours = match.captured(1).toInt();
-        int minutes = match.captured(2).toInt();
-        int seconds = match.captured(3).toInt();
-        int milliseconds = match.captured(4).toInt();
-        
-        double fractionalSeconds = milliseconds / 1000.0;
-        int frames = static_cast<int>(fractionalSeconds * m_fps);
-        
-        int totalFrames = static_cast<int>((hours * 3600 + minutes * 60 + seconds) * m_fps) + frames;
-        return isNegative ? -totalFrames : totalFrames;
-    }
-    
-    // 지원하지 않는 형식
-    return 0;
+    return FrameMath::timecodeToFrame(tc, m_fps);
 }
 
 // 마지막 프레임으로 정확히 이동하는 메서드
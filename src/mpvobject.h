@@ -6,9 +6,19 @@
 #include <render_gl.h>
 #include <QTimer>
 #include <QVariant>
+#include <QStringList>
 #include <QDateTime>
 
 class MpvRenderer;
+class PerformanceGovernor;
+class DemuxCacheManager;
+class AudioWaveformAnalyzer;
+class ColorPipeline;
+class ReversePlaybackController;
+class LoopRange;
+class PlaybackStateMachine;
+class MediaInfo;
+class KeyframeMap;
 
 class MpvObject : public QQuickFramebufferObject
 {
@@ -24,6 +34,16 @@ class MpvObject : public QQuickFramebufferObject
     Q_PROPERTY(int frameCount READ frameCount NOTIFY frameCountChanged)
     Q_PROPERTY(bool oneBasedFrameNumbers READ isOneBasedFrameNumbers WRITE setOneBasedFrameNumbers NOTIFY oneBasedFrameNumbersChanged)
     Q_PROPERTY(bool keepOpen READ isKeepOpenEnabled WRITE setKeepOpenEnabled NOTIFY keepOpenChanged)
+    Q_PROPERTY(QObject* governor READ governor CONSTANT)
+    Q_PROPERTY(QObject* cacheManager READ cacheManager CONSTANT)
+    Q_PROPERTY(QObject* waveform READ waveform CONSTANT)
+    Q_PROPERTY(QObject* colorPipeline READ colorPipeline CONSTANT)
+    Q_PROPERTY(QObject* reversePlayback READ reversePlayback CONSTANT)
+    Q_PROPERTY(QObject* loopRange READ loopRange CONSTANT)
+    Q_PROPERTY(QObject* playbackState READ playbackState CONSTANT)
+    Q_PROPERTY(QObject* mediaInfo READ mediaInfo CONSTANT)
+    Q_PROPERTY(QObject* keyframeMap READ keyframeMap CONSTANT)
+    Q_PROPERTY(QStringList videoFilters READ videoFilters WRITE applyVideoFilters NOTIFY videoFiltersChanged)
     
     // 비디오 코덱 정보를 위한 새 프로퍼티
     Q_PROPERTY(QString videoCodec READ videoCodec NOTIFY videoCodecChanged)
@@ -71,24 +91,98 @@ class MpvObject : public QQuickFramebufferObject
     QString m_customTimecodePattern = "%H:%M:%S.%f";
     int m_timecodeSource = 0; // 0=Calculate, 1=Embedded SMPTE, 2=File Metadata, 3=Reel Name
     
-    // 성능 모니터링 관련 변수
-    QDateTime m_lastPerformanceCheck;
-    bool m_performanceOptimizationApplied = false;
+    // 적응형 성능 조절기 (렌더 스레드에서 프레임 시간 기록)
+    PerformanceGovernor *m_governor = nullptr;
     
-    // 시크 관련 변수
-    qint64 m_lastSeekTime = 0;
+    // 디먹서 캐시 크기 조정 및 캐시 구간
+    DemuxCacheManager *m_cacheManager = nullptr;
+    
+    // 타임라인 오디오 파형
+    AudioWaveformAnalyzer *m_waveform = nullptr;
+    
+    // GPU 색 보정 (노출/CDL/LUT/채널/폴스 컬러 셰이더)
+    ColorPipeline *m_colorPipeline = nullptr;
+    
+    // 역방향 재생 / 빠른 프레임 뒤로 이동 (J/K/L)
+    ReversePlaybackController *m_reversePlayback = nullptr;
+    
+    // 인/아웃 구간 반복
+    LoopRange *m_loopRange = nullptr;
+    
+    // 재생 상태 머신 (시크/EOF 처리)
+    PlaybackStateMachine *m_playbackState = nullptr;
+    
+    // 미디어 정보 (이벤트로 채우고 한 번에 게시)
+    MediaInfo *m_mediaInfo = nullptr;
+    
+    // 키프레임/패킷 크기 지도 (타임라인 히트맵, 드래그 시크)
+    KeyframeMap *m_keyframeMap = nullptr;
+    
+    // 현재 적용된 vf 체인 (command()로 직접 vf를 바꾸면 MPV에서 다시 읽음, 읽지 못하면 m_videoFiltersKnown = false)
+    QStringList m_videoFilters;
+    bool m_videoFiltersKnown = true;
+    
+    // 사전 준비(MpvWarmup)에서 이미 연 시작 파일과 비디오를 켤 때 복원할 일시정지 상태
+    QString m_warmStartFile;
+    bool m_warmStartPaused = false;
+    bool m_warmStartVideoPending = false;
+    
+    // 프레임 수를 계산한 파일 (같은 파일의 비디오 리컨피그에서는 다시 계산하지 않음)
+    QString m_frameCountFilename;
     
     // 타이머
     QTimer *m_stateChangeTimer = nullptr;
-    QTimer *m_performanceTimer = nullptr;
-    QTimer *m_metadataTimer = nullptr;  // 메타데이터 업데이트 타이머
     QTimer *m_timecodeTimer = nullptr;  // 타임코드 업데이트 타이머
+    QTimer *m_reconfigTimer = nullptr;  // 연속된 비디오 리컨피그를 한 번으로 묶는 타이머
 
 public:
+    // 시크 방식 (exact: 정확한 프레임, keyframes: 가장 가까운 키프레임 - 스크럽용)
+    enum SeekMode {
+        SeekExact = 0,
+        SeekKeyframes
+    };
+    Q_ENUM(SeekMode)
+
     explicit MpvObject(QQuickItem * parent = 0);
     virtual ~MpvObject();
     virtual Renderer *createRenderer() const;
 
+    // 공통 MPV 옵션 설정 (MpvWarmup과 공유)
+    static void configureHandle(mpv_handle* handle);
+    
+    // 내부 MPV 핸들 (PlaylistModel 등 직접 속성을 읽어야 하는 곳에서 사용)
+    mpv_handle* handle() const { return mpv; }
+    
+    // 사전 준비에서 이미 연 시작 파일이면 true (한 번만, PlaylistModel이 다시 열지 않도록)
+    bool adoptWarmStartFile(const QString& path);
+    
+    // 적응형 성능 조절기 (QML 통계 패널에서 사용)
+    QObject* governor() const;
+    
+    // 디먹서 캐시 관리자 (타임라인 캐시 구간 표시에 사용)
+    QObject* cacheManager() const;
+    
+    // 오디오 파형 분석기 (타임라인 파형 표시에 사용)
+    QObject* waveform() const;
+    
+    // GPU 색 보정 파이프라인 (설정 패널에서 사용)
+    QObject* colorPipeline() const;
+    
+    // 역방향 재생 컨트롤러 (J/K/L 셔틀, 한 프레임 뒤로)
+    QObject* reversePlayback() const;
+    
+    // 인/아웃 구간 반복 (I/O 키, 타임라인)
+    QObject* loopRange() const;
+    
+    // 재생 상태 머신 (프레임 시크, EOF에서 재생)
+    QObject* playbackState() const;
+    
+    // 미디어 정보 (코덱/포맷/색 공간/트랙/타임코드 - 정보 패널에서 사용)
+    QObject* mediaInfo() const;
+    
+    // 키프레임/패킷 크기 지도 (GOP/비트레이트 히트맵, 키프레임 위치)
+    QObject* keyframeMap() const;
+
     QString filename() const;
     bool isPaused() const;
     double position() const;
@@ -127,6 +221,16 @@ public:
     Q_INVOKABLE QString frameToTimecode(int frame, int format = -1, const QString& customPattern = "") const;
     Q_INVOKABLE int timecodeToFrame(const QString& tc) const;
 
+    // 현재 vf 체인
+    QStringList videoFilters() const;
+
+    // 타입 지정 명령 (QVariantList 변환 없이 바로 MPV에 전달 - mpvcommand.h)
+    Q_INVOKABLE void seekAbsolute(double seconds, SeekMode mode = SeekExact);
+    Q_INVOKABLE void seekRelative(double seconds, SeekMode mode = SeekExact);
+
+    // 시크/프레임 이동 전에 호출 - 뒤로 한 프레임 이동 뒤 남은 역방향(play-dir=backward)을 되돌림
+    void ensureForwardPlayback();
+
     // 프레임 번호 변환 함수 추가
     int displayFrameNumber(int internalFrame) const;
     int internalFrameNumber(int displayFrame) const;
@@ -135,23 +239,30 @@ public slots:
     void play();
     void pause();
     void playPause();
+    void setPause(bool paused);
+    void frameStep();
+    void frameBackStep();
     void command(const QVariant& params);
     void setProperty(const QString& name, const QVariant& value);
     QVariant getProperty(const QString& name);
     void handleMpvEvents();
     void updatePositionProperty();
     void processStateChange();
-    void checkPerformance();
     void resetEndReached();
     void handleEndOfVideo();
     void seekToPosition(double pos);
     void updateFrameCount();
-    void updateVideoMetadata();  // 메타데이터 업데이트 함수 추가
+    void updateVideoMetadata();  // MediaInfo 게시 시 기존 코덱/포맷/해상도 속성 갱신
+    void handleVideoReconfig();  // 리컨피그가 잦아든 뒤 한 번만 처리
+    void readLoadedFileProperties(); // FILE_LOADED에서 파일 이름/길이/fps 직접 읽기
+    void activateWarmStartVideo();   // 렌더 컨텍스트 생성 후 사전 준비된 시작 파일의 비디오 켜기
     void applyVideoFilters(const QStringList& filters);
+    void refreshVideoFilters();  // 직접 바꾼 vf 체인을 MPV에서 다시 읽기
     void updateTimecode();      // 타임코드 업데이트 함수
     void fetchEmbeddedTimecode(); // 내장 타임코드 추출 함수
     void seekToLastFrame();     // 마지막 프레임으로 정확히 이동
     void seekToFirstFrame();    // 첫 번째 프레임으로 정확히 이동
+    void applyPreprobedMetadata(const QVariantMap& info); // 미리 분석한 메타데이터 적용
 
 signals:
     void positionChanged(double position);
@@ -163,6 +274,7 @@ signals:
     void playingChanged(bool playing);
     void frameCountChanged(int count);
     void videoReconfig();
+    void fileStarted();  // 파일 로드 시작 (loadfile 직후)
     void fileLoaded();
     void seekRequested(int frame);
     void videoCodecChanged(const QString &codec);
@@ -176,11 +288,16 @@ signals:
     void timecodeOffsetChanged(int offset);
     void customTimecodePatternChanged(const QString &pattern);
     void timecodeSourceChanged(int source);
+    void videoFiltersChanged(const QStringList& filters);
     void loopChanged(bool enabled);
     void oneBasedFrameNumbersChanged(bool oneBased);
     void keepOpenChanged(bool enabled);
     void endReached();  // 영상 종료 시 발생하는 시그널
     void endReachedChanged(bool reached);  // endReached 속성 변경 시그널
+    void playlistPosChanged(int pos);
+    void playlistCountChanged(int count);
+    void playbackRestarted();  // 시크 후 재생 재개 준비 완료
+    void commandReply(quint64 userdata, int error, const QVariant& result);  // 비동기 명령 완료
 };
 
 #endif // MPVOBJECT_H 
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef MPVPROPERTIES_H
+#define MPVPROPERTIES_H
+
+#include <client.h>
+#include <cstdint>
+#include <cstring>
+
+// MpvObject가 감시하는 MPV 속성 목록
+// mpv_observe_property()의 reply_userdata로 ID를 넘겨 이벤트 처리 시 문자열 비교 없이 분기한다.
+enum class MpvProperty : uint64_t {
+    Unknown = 0,
+    Pause,
+    TimePos,
+    Duration,
+    MediaTitle,
+    Filename,
+    EstimatedVfFps,
+    EofReached,
+    VideoCodec,
+    VideoFormat,
+    Width,
+    Height,
+    PlaylistPos,
+    PlaylistCount,
+    DemuxerCacheState,
+    VideoParams,
+    Metadata
+};
+
+struct MpvObservedProperty {
+    MpvProperty id;
+    const char* name;
+    mpv_format format;
+};
+
+inline constexpr MpvObservedProperty kObservedMpvProperties[] = {
+    {MpvProperty::Pause, "pause", MPV_FORMAT_FLAG},
+    {MpvProperty::TimePos, "time-pos", MPV_FORMAT_DOUBLE},
+    {MpvProperty::Duration, "duration", MPV_FORMAT_DOUBLE},
+    {MpvProperty::MediaTitle, "media-title", MPV_FORMAT_STRING},
+    {MpvProperty::Filename, "filename", MPV_FORMAT_STRING},
+    {MpvProperty::EstimatedVfFps, "estimated-vf-fps", MPV_FORMAT_DOUBLE},
+    {MpvProperty::EofReached, "eof-reached", MPV_FORMAT_FLAG},
+    // 코덱 정보
+    {MpvProperty::VideoCodec, "video-codec", MPV_FORMAT_STRING},
+    {MpvProperty::VideoFormat, "video-format", MPV_FORMAT_STRING},
+    {MpvProperty::Width, "width", MPV_FORMAT_INT64},
+    {MpvProperty::Height, "height", MPV_FORMAT_INT64},
+    // 재생 목록 (PlaylistModel 동기화)
+    {MpvProperty::PlaylistPos, "playlist-pos", MPV_FORMAT_INT64},
+    {MpvProperty::PlaylistCount, "playlist-count", MPV_FORMAT_INT64},
+    // 캐시된 구간 (DemuxCacheManager)
+    {MpvProperty::DemuxerCacheState, "demuxer-cache-state", MPV_FORMAT_NODE},
+    // 미디어 정보 (MediaInfo - 픽셀 포맷/색 공간, 컨테이너 태그)
+    {MpvProperty::VideoParams, "video-params", MPV_FORMAT_NODE},
+    {MpvProperty::Metadata, "metadata", MPV_FORMAT_NODE},
+};
+
+// 이벤트의 reply_userdata를 속성 ID로 변환
+inline MpvProperty mpvPropertyFromUserdata(uint64_t userdata)
+{
+    return userdata <= uint64_t(MpvProperty::Metadata) ? MpvProperty(userdata) : MpvProperty::Unknown;
+}
+
+// 이름으로 속성 ID 찾기 (reply_userdata 없이 감시한 속성용)
+inline MpvProperty mpvPropertyFromName(const char* name)
+{
+    for (const MpvObservedProperty& property : kObservedMpvProperties) {
+        if (std::strcmp(property.name, name) == 0) {
+            return property.id;
+        }
+    }
+    return MpvProperty::Unknown;
+}
+
+#endif // MPVPROPERTIES_H
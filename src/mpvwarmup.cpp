@@ -0,0 +1,110 @@
+#include "mpvwarmup.h"
+#include "mpvobject.h"
+#include "startuptimeline.h"
+#include <QDebug>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace MpvWarmup {
+
+namespace {
+
+std::mutex g_mutex;
+std::thread g_thread;
+Handoff g_handoff;
+bool g_taken = false;
+
+void warmUp(QString file)
+{
+    mpv_handle* handle = mpv_create();
+    if (!handle) {
+        qWarning() << "MpvWarmup: failed to create MPV context";
+        return;
+    }
+
+    MpvObject::configureHandle(handle);
+
+    // 원래 일시정지 설정을 기억해 두었다가 비디오를 켤 때 복원
+    bool startPaused = false;
+    if (char* pause = mpv_get_property_string(handle, "pause")) {
+        startPaused = std::strcmp(pause, "yes") == 0;
+        mpv_free(pause);
+    }
+
+    // 렌더 컨텍스트가 생길 때까지 비디오 출력은 만들지 않음
+    if (!file.isEmpty()) {
+        mpv_set_option_string(handle, "vid", "no");
+        mpv_set_option_string(handle, "pause", "yes");
+    }
+
+    if (mpv_initialize(handle) < 0) {
+        qWarning() << "MpvWarmup: failed to initialize MPV";
+        mpv_terminate_destroy(handle);
+        return;
+    }
+    StartupTimeline::mark("mpv initialized");
+
+    if (!file.isEmpty()) {
+        const QByteArray path = file.toUtf8();
+        const char* cmd[] = {"loadfile", path.constData(), nullptr};
+        if (mpv_command(handle, cmd) < 0) {
+            // 열지 못하면 원래 상태로 되돌리고 QML이 일반 경로로 열게 함
+            qWarning() << "MpvWarmup: loadfile failed for" << file;
+            mpv_set_property_string(handle, "vid", "auto");
+            mpv_set_property_string(handle, "pause", startPaused ? "yes" : "no");
+            file.clear();
+        } else {
+            StartupTimeline::mark("file open requested");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_handoff.handle = handle;
+    g_handoff.file = file;
+    g_handoff.startPaused = startPaused;
+}
+
+} // namespace
+
+void start(const QString& file)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_thread.joinable() || g_taken) {
+        return;
+    }
+    g_thread = std::thread(warmUp, file);
+}
+
+Handoff take()
+{
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_taken) {
+            return Handoff();
+        }
+        g_taken = true;
+        thread = std::move(g_thread);
+    }
+
+    // 아직 준비 중이면 완료까지 대기 (대부분 QML 로딩이 더 오래 걸림)
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Handoff handoff = g_handoff;
+    g_handoff = Handoff();
+    return handoff;
+}
+
+void shutdown()
+{
+    const Handoff handoff = take();
+    if (handoff.handle) {
+        mpv_terminate_destroy(handoff.handle);
+    }
+}
+
+} // namespace MpvWarmup
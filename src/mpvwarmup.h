@@ -0,0 +1,34 @@
+#ifndef MPVWARMUP_H
+#define MPVWARMUP_H
+
+#include <QString>
+#include <client.h>
+
+// MPV 사전 준비 (시작 시간 단축)
+// QML 엔진이 UI를 불러오는 동안 백그라운드 스레드에서 MPV를 생성/초기화하고 시작 파일을 연다.
+// 렌더 컨텍스트가 생기기 전에는 비디오 출력을 만들 수 없으므로 vid=no, 일시정지 상태로 열고
+// MpvObject가 렌더 컨텍스트를 만든 뒤 비디오를 켜고 원래 일시정지 상태로 되돌린다.
+// 파일 열기/프로브/디먹스가 QML 로딩과 겹치며, 재생 목록은 MPV의 playlist 속성에서 그대로 동기화된다.
+namespace MpvWarmup {
+
+// 넘겨받은 핸들 정보
+struct Handoff {
+    mpv_handle* handle = nullptr;
+    QString file;              // 이미 열고 있는 시작 파일 (없으면 빈 문자열)
+    bool startPaused = false;  // 사전 준비 전 pause 옵션 값 (비디오를 켤 때 복원)
+};
+
+// 백그라운드 준비 시작 (file이 비어 있으면 초기화만 함)
+void start(const QString& file = QString());
+
+// 준비된 핸들을 넘겨받음 (준비 중이면 완료될 때까지 대기)
+// 준비에 실패한 경우 handle이 nullptr이므로 호출자가 직접 만들어야 한다.
+// 한 번만 넘겨주며 이후 호출은 빈 Handoff를 반환한다.
+Handoff take();
+
+// 종료 시 호출 - 넘겨주지 못한 핸들 정리
+void shutdown();
+
+} // namespace MpvWarmup
+
+#endif // MPVWARMUP_H
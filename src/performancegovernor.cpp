@@ -0,0 +1,307 @@
+#include "performancegovernor.h"
+#include "mpvobject.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QTime>
+#include <algorithm>
+
+namespace {
+
+struct OptionValue {
+    const char* name;
+    const char* value;
+};
+
+struct LadderStep {
+    const char* label;
+    OptionValue options[3];
+};
+
+// 품질 단계 - 아래로 갈수록 가볍다 (각 단계는 이전 단계 설정을 포함)
+// 디코더 스레드 수는 DecoderTuner 프로필이 정하므로 여기서 건드리지 않는다.
+// vd-lavc-lowres는 디코더를 다시 만들 때(다음 파일/트랙 전환) 적용되고 소프트웨어 디코딩에만 효과가 있어
+// 즉시 효과가 있는 단계를 모두 쓴 뒤 마지막에 둔다.
+constexpr LadderStep kLadder[] = {
+    {"Full quality", {}},
+    {"Fast scaler", {{"scale", "bilinear"}, {"dscale", "bilinear"}, {"cscale", "bilinear"}}},
+    {"No deband", {{"deband", "no"}}},
+    {"Drop late frames", {{"framedrop", "vo"}}},
+    {"Decoder frame drop", {{"framedrop", "decoder+vo"}}},
+    {"Low-res decode (next file)", {{"vd-lavc-lowres", "1"}}},
+};
+
+constexpr int kLadderSize = int(sizeof(kLadder) / sizeof(kLadder[0]));
+
+// 평가 주기와 판단 기준
+constexpr int kSampleIntervalMs = 1000;
+constexpr int kDegradeAfterWindows = 2;
+constexpr int kRestoreAfterWindows = 8;
+constexpr int kMaxRestoreWindows = 64;
+constexpr int kCooldownWindows = 2;
+constexpr qint64 kOscillationMs = 15000;
+constexpr qint64 kStableResetMs = 60000;
+constexpr double kOverloadBudgetRatio = 0.85;
+constexpr double kHeadroomBudgetRatio = 0.5;
+// 디먹서 캐시가 이 값보다 적으면 I/O 대기로 보고 품질을 건드리지 않는다
+constexpr double kStarvedCacheSec = 0.5;
+
+int64_t readInt(mpv_handle* mpv, const char* name)
+{
+    int64_t value = 0;
+    mpv_get_property(mpv, name, MPV_FORMAT_INT64, &value);
+    return value;
+}
+
+} // namespace
+
+PerformanceGovernor::PerformanceGovernor(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    m_sampleTimer.setInterval(kSampleIntervalMs);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &PerformanceGovernor::evaluate);
+}
+
+void PerformanceGovernor::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    if (!m_enabled && m_level > 0) {
+        applyLevel(0, "governor disabled");
+    }
+    setPlaying(m_playing);
+    emit enabledChanged(m_enabled);
+}
+
+int PerformanceGovernor::maxLevel() const
+{
+    return kLadderSize - 1;
+}
+
+QString PerformanceGovernor::levelName() const
+{
+    return QString::fromLatin1(kLadder[m_level].label);
+}
+
+void PerformanceGovernor::recordFrame(qint64 renderNs)
+{
+    m_frameCount.fetch_add(1, std::memory_order_relaxed);
+    m_renderNsTotal.fetch_add(renderNs, std::memory_order_relaxed);
+    qint64 previous = m_renderNsMax.load(std::memory_order_relaxed);
+    while (renderNs > previous &&
+           !m_renderNsMax.compare_exchange_weak(previous, renderNs, std::memory_order_relaxed)) {
+    }
+}
+
+void PerformanceGovernor::setPlaying(bool playing)
+{
+    m_playing = playing;
+    if (m_playing && m_enabled) {
+        if (!m_sampleTimer.isActive()) {
+            resetCounters();
+            m_sampleTimer.start();
+        }
+    } else {
+        m_sampleTimer.stop();
+    }
+}
+
+void PerformanceGovernor::resetCounters()
+{
+    // 파일이 바뀌면 MPV 카운터도 0부터 다시 시작하므로 기준값을 버린다
+    m_haveLastCounters = false;
+    // 원래 품질 단계면 파일별로 적용된 디코더 프로필을 기준값으로 다시 읽는다
+    if (m_level == 0) {
+        m_baselineCaptured = false;
+        m_baseline.clear();
+    }
+    m_overloadedWindows = 0;
+    m_headroomWindows = 0;
+    m_frameCount.store(0, std::memory_order_relaxed);
+    m_renderNsTotal.store(0, std::memory_order_relaxed);
+    m_renderNsMax.store(0, std::memory_order_relaxed);
+}
+
+void PerformanceGovernor::restoreFullQuality()
+{
+    m_restoreWindowsRequired = kRestoreAfterWindows;
+    applyLevel(0, "restored by user");
+}
+
+PerformanceGovernor::Counters PerformanceGovernor::readCounters() const
+{
+    Counters counters;
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return counters;
+    }
+    counters.dropped = readInt(mpv, "frame-drop-count");
+    counters.decoderDropped = readInt(mpv, "decoder-frame-drop-count");
+    counters.delayed = readInt(mpv, "vo-delayed-frame-count");
+    return counters;
+}
+
+void PerformanceGovernor::captureBaseline()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (m_baselineCaptured || !mpv) {
+        return;
+    }
+    for (const LadderStep& step : kLadder) {
+        for (const OptionValue& option : step.options) {
+            if (!option.name || m_baseline.contains(option.name)) {
+                continue;
+            }
+            if (char* value = mpv_get_property_string(mpv, option.name)) {
+                m_baseline.insert(option.name, QString::fromUtf8(value));
+                mpv_free(value);
+            }
+        }
+    }
+    m_baselineCaptured = true;
+}
+
+void PerformanceGovernor::evaluate()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!m_enabled || !m_playing || !mpv) {
+        return;
+    }
+    captureBaseline();
+
+    const qint64 frames = m_frameCount.exchange(0, std::memory_order_relaxed);
+    const qint64 renderNs = m_renderNsTotal.exchange(0, std::memory_order_relaxed);
+    const qint64 renderMaxNs = m_renderNsMax.exchange(0, std::memory_order_relaxed);
+
+    const Counters counters = readCounters();
+    if (!m_haveLastCounters) {
+        m_lastCounters = counters;
+        m_haveLastCounters = true;
+        return;
+    }
+
+    const int64_t dropped = std::max<int64_t>(0, counters.dropped - m_lastCounters.dropped)
+                          + std::max<int64_t>(0, counters.decoderDropped - m_lastCounters.decoderDropped);
+    const int64_t delayed = std::max<int64_t>(0, counters.delayed - m_lastCounters.delayed);
+    m_lastCounters = counters;
+
+    const double fps = m_player->fps();
+    const double budgetMs = fps > 0 ? 1000.0 / fps : 0.0;
+    const double renderAvgMs = frames > 0 ? renderNs / 1e6 / frames : 0.0;
+    const double renderMaxMs = renderMaxNs / 1e6;
+
+    double cacheSec = -1.0;
+    mpv_get_property(mpv, "demuxer-cache-duration", MPV_FORMAT_DOUBLE, &cacheSec);
+    const bool starved = cacheSec >= 0 && cacheSec < kStarvedCacheSec;
+
+    const bool overloaded = (dropped + delayed) > std::max<int64_t>(1, frames / 50)
+                         || (budgetMs > 0 && renderAvgMs > budgetMs * kOverloadBudgetRatio);
+    const bool headroom = dropped == 0 && delayed == 0
+                       && (budgetMs <= 0 || renderAvgMs < budgetMs * kHeadroomBudgetRatio);
+
+    m_stats["frames"] = frames;
+    m_stats["dropped"] = qint64(dropped);
+    m_stats["delayed"] = qint64(delayed);
+    m_stats["renderAvgMs"] = renderAvgMs;
+    m_stats["renderMaxMs"] = renderMaxMs;
+    m_stats["budgetMs"] = budgetMs;
+    m_stats["cacheSec"] = cacheSec;
+    m_stats["starved"] = starved;
+    m_stats["state"] = starved ? "starved" : overloaded ? "overloaded" : headroom ? "headroom" : "steady";
+    emit statsChanged();
+
+    const QString window = QString("drops %1, delayed %2, render %3/%4 ms")
+        .arg(dropped).arg(delayed)
+        .arg(renderAvgMs, 0, 'f', 1).arg(budgetMs, 0, 'f', 1);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    // 한동안 진동이 없으면 복구 대기 시간을 원래대로
+    if (m_restoreWindowsRequired > kRestoreAfterWindows && now - m_lastDegradeMs > kStableResetMs) {
+        m_restoreWindowsRequired = kRestoreAfterWindows;
+    }
+
+    if (m_cooldownWindows > 0) {
+        --m_cooldownWindows;
+        return;
+    }
+
+    if (starved) {
+        m_overloadedWindows = 0;
+        m_headroomWindows = 0;
+        return;
+    }
+
+    if (overloaded) {
+        m_headroomWindows = 0;
+        if (++m_overloadedWindows >= kDegradeAfterWindows && m_level < maxLevel()) {
+            // 복구 직후 다시 과부하면 다음 복구까지 더 오래 기다림
+            if (now - m_lastRestoreMs < kOscillationMs) {
+                m_restoreWindowsRequired = std::min(kMaxRestoreWindows, m_restoreWindowsRequired * 2);
+            }
+            applyLevel(m_level + 1, window);
+            m_lastDegradeMs = now;
+            m_overloadedWindows = 0;
+            m_cooldownWindows = kCooldownWindows;
+        }
+    } else if (headroom) {
+        m_overloadedWindows = 0;
+        if (++m_headroomWindows >= m_restoreWindowsRequired && m_level > 0) {
+            applyLevel(m_level - 1, window);
+            m_lastRestoreMs = now;
+            m_headroomWindows = 0;
+            m_cooldownWindows = kCooldownWindows;
+        }
+    } else {
+        m_overloadedWindows = 0;
+        m_headroomWindows = 0;
+    }
+}
+
+void PerformanceGovernor::applyLevel(int level, const QString& reason)
+{
+    mpv_handle* mpv = m_player->handle();
+    level = std::clamp(level, 0, maxLevel());
+    if (level == m_level || !mpv) {
+        return;
+    }
+    captureBaseline();
+
+    // 목표 단계까지의 누적 설정 계산 (설정하지 않은 옵션은 원래 값)
+    QVariantMap target = m_baseline;
+    for (int i = 1; i <= level; ++i) {
+        for (const OptionValue& option : kLadder[i].options) {
+            if (option.name) {
+                target.insert(option.name, QString::fromLatin1(option.value));
+            }
+        }
+    }
+
+    for (auto it = target.constBegin(); it != target.constEnd(); ++it) {
+        const QByteArray name = it.key().toUtf8();
+        const QByteArray value = it.value().toString().toUtf8();
+        if (mpv_set_property_string(mpv, name.constData(), value.constData()) < 0) {
+            qWarning() << "PerformanceGovernor: failed to set" << it.key() << "=" << it.value();
+        }
+    }
+
+    const bool degrade = level > m_level;
+    m_level = level;
+    logDecision(QString("%1 %2 %3 (%4)")
+                .arg(degrade ? "down" : "up")
+                .arg(m_level)
+                .arg(levelName(), reason));
+    emit levelChanged(m_level);
+}
+
+void PerformanceGovernor::logDecision(const QString& text)
+{
+    const QString entry = QTime::currentTime().toString("HH:mm:ss") + "  " + text;
+    qInfo().noquote() << "PerformanceGovernor:" << text;
+    m_decisions.prepend(entry);
+    while (m_decisions.size() > 20) {
+        m_decisions.removeLast();
+    }
+    emit decisionsChanged();
+}
@@ -0,0 +1,100 @@
+#ifndef PERFORMANCEGOVERNOR_H
+#define PERFORMANCEGOVERNOR_H
+
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantMap>
+#include <atomic>
+#include <client.h>
+
+class MpvObject;
+
+// 적응형 성능 조절기
+// 렌더 스레드에서 매 프레임 렌더 시간을 기록하고, 1초 단위로 MPV 드롭/지연 카운터와 함께 평가해
+// 품질 단계(스케일러 → 디밴딩 → 프레임 드롭 → 디코더 프레임 드롭 → 저해상도 디코딩)를 한 칸씩 조정한다.
+// 저해상도 디코딩은 다음 디코더 초기화(파일/트랙 전환)부터 적용된다.
+// 단계를 낮출 때는 연속 2회, 올릴 때는 더 긴 여유 구간을 요구하고 진동하면 복구 대기 시간을 늘린다.
+class PerformanceGovernor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(int level READ level NOTIFY levelChanged)
+    Q_PROPERTY(int maxLevel READ maxLevel CONSTANT)
+    Q_PROPERTY(QString levelName READ levelName NOTIFY levelChanged)
+    Q_PROPERTY(QVariantMap stats READ stats NOTIFY statsChanged)
+    Q_PROPERTY(QStringList decisions READ decisions NOTIFY decisionsChanged)
+
+public:
+    explicit PerformanceGovernor(MpvObject* player);
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    int level() const { return m_level; }
+    int maxLevel() const;
+    QString levelName() const;
+    QVariantMap stats() const { return m_stats; }
+    QStringList decisions() const { return m_decisions; }
+
+    // 렌더 스레드에서 매 프레임 호출 (원자 변수만 사용)
+    void recordFrame(qint64 renderNs);
+
+    // 재생 상태/파일 변경 알림 (GUI 스레드)
+    void setPlaying(bool playing);
+    void resetCounters();
+
+    // 사용자가 원래 품질로 되돌림
+    Q_INVOKABLE void restoreFullQuality();
+
+signals:
+    void enabledChanged(bool enabled);
+    void levelChanged(int level);
+    void statsChanged();
+    void decisionsChanged();
+
+private slots:
+    void evaluate();
+
+private:
+    struct Counters {
+        int64_t dropped = 0;
+        int64_t decoderDropped = 0;
+        int64_t delayed = 0;
+    };
+
+    Counters readCounters() const;
+    void captureBaseline();
+    void applyLevel(int level, const QString& reason);
+    void logDecision(const QString& text);
+
+    MpvObject* m_player;
+    QTimer m_sampleTimer;
+    bool m_enabled = true;
+    bool m_playing = false;
+    int m_level = 0;
+
+    // 매 프레임 기록 (렌더 스레드)
+    std::atomic<qint64> m_frameCount{0};
+    std::atomic<qint64> m_renderNsTotal{0};
+    std::atomic<qint64> m_renderNsMax{0};
+
+    // 평가 상태
+    Counters m_lastCounters;
+    bool m_haveLastCounters = false;
+    int m_overloadedWindows = 0;
+    int m_headroomWindows = 0;
+    int m_cooldownWindows = 0;
+    int m_restoreWindowsRequired = 8;
+    qint64 m_lastDegradeMs = 0;
+    qint64 m_lastRestoreMs = 0;
+
+    // 단계 0(원래 설정)으로 되돌릴 때 사용할 옵션 값
+    QVariantMap m_baseline;
+    bool m_baselineCaptured = false;
+
+    QVariantMap m_stats;
+    QStringList m_decisions;
+};
+
+#endif // PERFORMANCEGOVERNOR_H
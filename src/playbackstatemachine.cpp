@@ -0,0 +1,323 @@
+#include "playbackstatemachine.h"
+#include "mpvobject.h"
+#include "mpvcommand.h"
+#include "logger.h"
+#include <QDebug>
+#include <QMetaEnum>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// 도착 프레임 허용 오차 (타임스탬프 반올림)
+constexpr int kFrameTolerance = 1;
+
+// 같은 목표로 보내는 시크 최대 횟수 (첫 시크 포함)
+constexpr int kMaxSeekAttempts = 3;
+
+// playback-restart를 기다리는 최대 시간 (느린 네트워크/원격 파일의 시크도 보통 이 안에 끝남)
+constexpr int kRestartTimeoutMs = 3000;
+
+} // namespace
+
+PlaybackStateMachine::PlaybackStateMachine(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    connect(player, &MpvObject::fileStarted, this, &PlaybackStateMachine::onFileStarted);
+    connect(player, &MpvObject::fileLoaded, this, &PlaybackStateMachine::onFileLoaded);
+    connect(player, &MpvObject::playbackRestarted, this, &PlaybackStateMachine::onPlaybackRestarted);
+    connect(player, &MpvObject::playingChanged, this, &PlaybackStateMachine::onPlayingChanged);
+    connect(player, &MpvObject::endReached, this, &PlaybackStateMachine::onEndReached);
+    connect(player, &MpvObject::endReachedChanged, this, &PlaybackStateMachine::onEndReachedChanged);
+    connect(player, &MpvObject::loopChanged, this, &PlaybackStateMachine::onLoopChanged);
+
+    m_watchdog.setSingleShot(true);
+    m_watchdog.setInterval(kRestartTimeoutMs);
+    connect(&m_watchdog, &QTimer::timeout, this, &PlaybackStateMachine::onWatchdogTimeout);
+}
+
+QString PlaybackStateMachine::stateName() const
+{
+    return QString::fromLatin1(QMetaEnum::fromType<State>().valueToKey(m_state));
+}
+
+void PlaybackStateMachine::seekToFrame(int frame, bool exact)
+{
+    if (!m_player->handle() || m_state == Idle) {
+        return;
+    }
+    frame = clampFrame(frame);
+    m_resumeAfterSeek = false;
+
+    // 로드 중이면 첫 프레임이 나온 뒤에, 시크 중이면 현재 시크가 끝난 뒤에 마지막 요청만 보냄
+    if (m_state == Loading || m_state == Ready || m_state == Seeking || m_state == Recovering) {
+        // 쌓인 요청 없이 진행 중인 시크와 같은 요청 (클릭 후 놓기 등)은 다시 보내지 않음
+        if (m_pendingFrame < 0 && frame == m_targetFrame && exact == m_exact) {
+            return;
+        }
+        m_pendingFrame = frame;
+        m_pendingExact = exact;
+        if (m_state == Seeking || m_state == Recovering) {
+            m_targetFrame = frame;
+            emit stateChanged(m_state);
+        }
+        return;
+    }
+
+    if (!m_player->isPaused()) {
+        m_player->setPause(true);
+    }
+    m_attempts = 0;
+    m_exact = exact;
+    startSeek(frame);
+}
+
+void PlaybackStateMachine::playPause()
+{
+    if (!m_player->handle()) {
+        return;
+    }
+
+    // 시크가 끝나기 전이면 끝난 뒤의 재생 여부만 바꿈
+    if (m_state == Seeking || m_state == Recovering) {
+        m_resumeAfterSeek = !m_resumeAfterSeek;
+        return;
+    }
+
+    // EOF - 처음으로 정확 시크한 뒤 playback-restart에서 재생 (파일 재로드 없음)
+    if (m_state == Ended || m_player->isEndReached()) {
+        m_attempts = 0;
+        m_pendingFrame = -1;
+        m_resumeAfterSeek = true;
+        m_exact = true;
+        startSeek(0);
+        return;
+    }
+
+    m_player->playPause();
+}
+
+void PlaybackStateMachine::setState(State state)
+{
+    if (m_state == state) {
+        return;
+    }
+    hpVerbose(lcMpvCommand) << "Playback state" << stateName() << "->"
+                            << QMetaEnum::fromType<State>().valueToKey(state);
+    m_state = state;
+    emit stateChanged(m_state);
+}
+
+void PlaybackStateMachine::startSeek(int frame)
+{
+    mpv_handle* mpv = m_player->handle();
+    const double fps = m_player->fps();
+    if (!mpv || fps <= 0) {
+        return;
+    }
+
+    // MPV가 시크하면서 eof-reached를 내리지만, 상태는 도착을 확인할 때까지 시크로 둠
+    m_player->resetEndReached();
+    m_player->ensureForwardPlayback();
+
+    m_targetFrame = frame;
+    m_attempts++;
+    const int result = MpvCommand::seekAbsolute(mpv, frame / fps, m_exact);
+    if (result < 0) {
+        qWarning() << "PlaybackState: seek to frame" << frame << "failed:" << mpv_error_string(result);
+        m_resumeAfterSeek = false;
+        finishSeek(currentFrame());
+        return;
+    }
+    m_watchdog.start();
+    setState(m_attempts > 1 ? Recovering : Seeking);
+}
+
+// 시크 종료 - 목표 정리 후 재생 요청이 있었으면 재생, 아니면 쉬는 상태로
+void PlaybackStateMachine::finishSeek(int frame)
+{
+    m_watchdog.stop();
+    m_targetFrame = -1;
+    m_attempts = 0;
+    if (m_resumeAfterSeek) {
+        m_resumeAfterSeek = false;
+        setState(Playing);
+        m_player->setPause(false);
+    } else {
+        setState(restingState());
+    }
+    emit seekFinished(frame);
+}
+
+// 로드/시크 중에 쌓인 마지막 시크를 보냄 (없으면 false)
+bool PlaybackStateMachine::startPendingSeek()
+{
+    if (m_pendingFrame < 0) {
+        return false;
+    }
+    const int frame = m_pendingFrame;
+    m_pendingFrame = -1;
+    if (!m_player->isPaused()) {
+        m_player->setPause(true);
+    }
+    m_attempts = 0;
+    m_exact = m_pendingExact;
+    startSeek(frame);
+    return true;
+}
+
+int PlaybackStateMachine::clampFrame(int frame) const
+{
+    frame = std::max(0, frame);
+    if (m_player->frameCount() > 0) {
+        frame = std::min(frame, m_player->frameCount() - 1);
+    }
+    return frame;
+}
+
+int PlaybackStateMachine::currentFrame() const
+{
+    // playback-restart 직후에는 time-pos 변경 알림이 아직 안 왔을 수 있어 직접 읽음
+    double position = m_player->position();
+    if (mpv_handle* mpv = m_player->handle()) {
+        mpv_get_property(mpv, "time-pos", MPV_FORMAT_DOUBLE, &position);
+    }
+    const double fps = m_player->fps();
+    return fps > 0 ? int(std::lround(position * fps)) : 0;
+}
+
+PlaybackStateMachine::State PlaybackStateMachine::restingState() const
+{
+    if (m_player->isEndReached()) {
+        return Ended;
+    }
+    return m_player->isPaused() ? Paused : Playing;
+}
+
+void PlaybackStateMachine::onFileStarted()
+{
+    m_targetFrame = -1;
+    m_pendingFrame = -1;
+    m_attempts = 0;
+    m_resumeAfterSeek = false;
+    m_watchdog.stop();
+    setState(Loading);
+}
+
+void PlaybackStateMachine::onFileLoaded()
+{
+    // 파일은 열렸지만 첫 프레임 전 - 첫 playback-restart에서 Playing/Paused로
+    m_targetFrame = -1;
+    m_attempts = 0;
+    m_watchdog.start();
+    setState(Ready);
+}
+
+void PlaybackStateMachine::onPlaybackRestarted()
+{
+    // 파일을 연 뒤 첫 프레임 - 로드 중에 들어온 시크를 이제 보냄
+    if (m_state == Ready) {
+        m_watchdog.stop();
+        setState(restingState());
+        startPendingSeek();
+        return;
+    }
+
+    if (m_state != Seeking && m_state != Recovering) {
+        return;
+    }
+
+    // 시크 중에 들어온 새 목표가 있으면 도착 확인 없이 바로 다음 시크
+    if (startPendingSeek()) {
+        return;
+    }
+
+    const int frame = currentFrame();
+    // 키프레임 시크는 앞 키프레임에 도착하는 것이 정상
+    const bool missed = m_exact && std::abs(frame - m_targetFrame) > kFrameTolerance;
+    if (missed && m_attempts < kMaxSeekAttempts) {
+        m_recoveryCount++;
+        emit recoveryCountChanged();
+        qDebug() << "PlaybackState: seek landed on frame" << frame << "instead of" << m_targetFrame
+                 << "- retrying (" << m_attempts << "/" << kMaxSeekAttempts << ")";
+        startSeek(m_targetFrame);
+        return;
+    }
+    if (missed) {
+        qWarning() << "PlaybackState: frame" << m_targetFrame << "not reached after" << m_attempts
+                   << "seeks, staying on frame" << frame;
+    }
+
+    finishSeek(frame);
+}
+
+void PlaybackStateMachine::onWatchdogTimeout()
+{
+    if (m_state == Ready) {
+        qWarning() << "PlaybackState: no playback-restart after file load";
+        setState(restingState());
+        startPendingSeek();
+        return;
+    }
+    if (m_state != Seeking && m_state != Recovering) {
+        return;
+    }
+
+    // 시크가 끝나지 않음 - 멈추지 않도록 현재 위치에서 끝내고 쌓인 시크가 있으면 보냄
+    qWarning() << "PlaybackState: no playback-restart for seek to frame" << m_targetFrame
+               << "within" << kRestartTimeoutMs << "ms";
+    if (startPendingSeek()) {
+        return;
+    }
+    finishSeek(currentFrame());
+}
+
+void PlaybackStateMachine::onPlayingChanged(bool playing)
+{
+    // 로드/시크 중 일시정지 변경은 첫 프레임/시크가 끝날 때 정리
+    if (m_state == Idle || m_state == Loading || m_state == Ready || m_state == Seeking || m_state == Recovering) {
+        return;
+    }
+    if (playing) {
+        setState(Playing);
+    } else if (m_state == Playing) {
+        setState(Paused);
+    }
+}
+
+void PlaybackStateMachine::onEndReached()
+{
+    // 끝 근처로 시크하다 닿은 EOF는 playback-restart에서 정리
+    if (m_state == Seeking || m_state == Recovering || m_state == Loading || m_state == Ready) {
+        return;
+    }
+    // 반복은 보통 loop-file이 MPV 안에서 처리 - EOF까지 온 경우만 처음부터 다시 재생
+    if (m_player->isLoopEnabled()) {
+        m_attempts = 0;
+        m_resumeAfterSeek = true;
+        m_exact = true;
+        startSeek(0);
+        return;
+    }
+    setState(Ended);
+}
+
+void PlaybackStateMachine::onEndReachedChanged(bool reached)
+{
+    if (!reached && m_state == Ended) {
+        setState(restingState());
+    }
+}
+
+void PlaybackStateMachine::onLoopChanged(bool enabled)
+{
+    // 이미 끝에 멈춘 상태에서 반복을 켜면 바로 처음부터 재생
+    if (enabled && m_state == Ended) {
+        m_attempts = 0;
+        m_resumeAfterSeek = true;
+        m_exact = true;
+        startSeek(0);
+    }
+}
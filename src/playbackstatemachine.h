@@ -0,0 +1,99 @@
+#ifndef PLAYBACKSTATEMACHINE_H
+#define PLAYBACKSTATEMACHINE_H
+
+#include <QObject>
+#include <QTimer>
+
+class MpvObject;
+
+// 재생 상태 머신 (로드/준비/재생/일시정지/시크/EOF/복구)
+// QML 타이머(EOF 복구, 재시크, 최종 검증) 대신 MPV 이벤트로만 상태를 옮긴다.
+// - start-file -> Loading, file-loaded -> Ready, Ready에서 첫 playback-restart -> Playing/Paused
+// - 모든 프레임 시크(타임라인, 키 입력, TimelineSync)는 seekToFrame 하나로 들어옴
+// - 정확 시크는 한 번 보내고 playback-restart에서 도착 프레임 확인
+//   (빗나가면 같은 시크를 몇 번만 다시 보냄 - 파일을 다시 로드하지 않음)
+// - 키프레임 시크(스크럽 미리보기)는 도착 확인 없이 playback-restart에서 끝남
+// - 로드/시크 중에 들어온 시크는 마지막 것만 남겼다가 첫 프레임/현재 시크가 끝나면 보냄
+// - playback-restart가 오지 않으면(디코더 오류 등) 감시 시간 뒤 현재 위치로 시크를 끝냄
+// - keep-open이므로 EOF에서도 파일이 열려 있어 시크만으로 빠져나옴
+class PlaybackStateMachine : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(State state READ state NOTIFY stateChanged)
+    Q_PROPERTY(QString stateName READ stateName NOTIFY stateChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY stateChanged)
+    Q_PROPERTY(int targetFrame READ targetFrame NOTIFY stateChanged)
+    Q_PROPERTY(int recoveryCount READ recoveryCount NOTIFY recoveryCountChanged)
+
+public:
+    enum State {
+        Idle,
+        Loading,
+        Ready,
+        Playing,
+        Paused,
+        Seeking,
+        Ended,
+        Recovering
+    };
+    Q_ENUM(State)
+
+    explicit PlaybackStateMachine(MpvObject* player);
+
+    State state() const { return m_state; }
+    QString stateName() const;
+    // 로드/시크/복구 중 (메타데이터 갱신 보류용)
+    bool isBusy() const { return m_state == Loading || m_state == Seeking || m_state == Recovering; }
+    // 진행 중인 시크의 목표 프레임 (없으면 -1)
+    int targetFrame() const { return m_targetFrame; }
+    // 도착 프레임이 빗나가 다시 시크한 누적 횟수
+    int recoveryCount() const { return m_recoveryCount; }
+
+public slots:
+    // 프레임 단위 시크 (일시정지 상태로) - exact = false면 앞 키프레임 시크 (스크럽)
+    void seekToFrame(int frame, bool exact = true);
+    // 재생/일시정지 - EOF면 처음부터 다시 재생
+    void playPause();
+
+signals:
+    void stateChanged(State state);
+    // 시크 완료 - 실제로 표시된 프레임
+    void seekFinished(int frame);
+    void recoveryCountChanged();
+
+private:
+    void setState(State state);
+    void startSeek(int frame);
+    void finishSeek(int frame);
+    bool startPendingSeek();
+    int clampFrame(int frame) const;
+    int currentFrame() const;
+    State restingState() const;
+
+    void onFileStarted();
+    void onFileLoaded();
+    void onPlaybackRestarted();
+    void onPlayingChanged(bool playing);
+    void onEndReached();
+    void onEndReachedChanged(bool reached);
+    void onLoopChanged(bool enabled);
+    void onWatchdogTimeout();
+
+    MpvObject* m_player = nullptr;
+    State m_state = Idle;
+
+    // 시크 진행 상태
+    int m_targetFrame = -1;
+    int m_pendingFrame = -1;
+    bool m_exact = true;
+    bool m_pendingExact = true;
+    int m_attempts = 0;
+    // 시크가 끝나면 재생 (EOF에서 재생 요청)
+    bool m_resumeAfterSeek = false;
+    int m_recoveryCount = 0;
+
+    // Ready/Seeking/Recovering에서 playback-restart를 기다리는 최대 시간
+    QTimer m_watchdog;
+};
+
+#endif // PLAYBACKSTATEMACHINE_H
@@ -0,0 +1,401 @@
+#include "playlistmodel.h"
+#include "mpvobject.h"
+#include "mpvheadless.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QUrl>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 분석 한 건에 허용하는 최대 시간 (네트워크 경로 등에서 무한 대기 방지)
+constexpr double kProbeTimeoutSec = 3.0;
+
+QString nodeString(const mpv_node& node)
+{
+    return node.format == MPV_FORMAT_STRING ? QString::fromUtf8(node.u.string) : QString();
+}
+
+} // namespace
+
+PlaylistModel::PlaylistModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    // 재생 중인 디코더와 경쟁하지 않도록 분석은 두 개까지만 동시에 실행
+    m_probePool.setMaxThreadCount(2);
+}
+
+PlaylistModel::~PlaylistModel()
+{
+    m_probePool.clear();
+    m_probePool.waitForDone();
+}
+
+int PlaylistModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_paths.size();
+}
+
+QVariant PlaylistModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_paths.size()) {
+        return QVariant();
+    }
+
+    const QString& path = m_paths.at(index.row());
+    const QVariantMap info = m_probeCache.value(path);
+
+    switch (role) {
+        case Qt::DisplayRole:
+        case FileNameRole:
+            return QFileInfo(path).fileName();
+        case PathRole:
+            return path;
+        case CurrentRole:
+            return index.row() == m_currentIndex;
+        case ProbedRole:
+            return !info.isEmpty();
+        case FpsRole:
+            return info.value("fps");
+        case FrameCountRole:
+            return info.value("frameCount");
+        case DurationRole:
+            return info.value("duration");
+        case CodecRole:
+            return info.value("codec");
+        case ResolutionRole:
+            return info.value("resolution");
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PlaylistModel::roleNames() const
+{
+    return {
+        {PathRole, "path"},
+        {FileNameRole, "fileName"},
+        {CurrentRole, "current"},
+        {ProbedRole, "probed"},
+        {FpsRole, "fps"},
+        {FrameCountRole, "frameCount"},
+        {DurationRole, "duration"},
+        {CodecRole, "codec"},
+        {ResolutionRole, "resolution"}
+    };
+}
+
+void PlaylistModel::setPrefetchCount(int count)
+{
+    count = qBound(0, count, 16);
+    if (m_prefetchCount == count) {
+        return;
+    }
+    m_prefetchCount = count;
+    emit prefetchCountChanged(m_prefetchCount);
+    scheduleProbes();
+}
+
+void PlaylistModel::connectMpv(MpvObject* mpv)
+{
+    if (m_mpv == mpv) {
+        return;
+    }
+    if (m_mpv) {
+        disconnect(m_mpv, nullptr, this, nullptr);
+    }
+
+    m_mpv = mpv;
+    if (!m_mpv) {
+        return;
+    }
+
+    connect(m_mpv, &MpvObject::playlistPosChanged, this, &PlaylistModel::syncFromMpv);
+    connect(m_mpv, &MpvObject::playlistCountChanged, this, &PlaylistModel::syncFromMpv);
+    syncFromMpv();
+
+    if (!m_pendingOpen.isEmpty()) {
+        const QStringList files = m_pendingOpen;
+        m_pendingOpen.clear();
+        openFiles(files);
+    }
+}
+
+void PlaylistModel::openFiles(const QStringList& files)
+{
+    if (files.isEmpty()) {
+        return;
+    }
+    if (!m_mpv) {
+        m_pendingOpen = files;
+        return;
+    }
+
+    // 목록을 먼저 알려주면 첫 파일이 열리는 동안 나머지 분석을 바로 시작할 수 있다
+    // 첫 파일을 시작 시 사전 준비(MpvWarmup)에서 이미 열었으면 다시 열지 않고 나머지만 추가
+    int first = 0;
+    if (m_mpv->adoptWarmStartFile(normalizePath(files.first()))) {
+        first = 1;
+    }
+    for (int i = first; i < files.size(); ++i) {
+        command({"loadfile", normalizePath(files.at(i)), i == 0 ? "replace" : "append"});
+    }
+}
+
+void PlaylistModel::append(const QStringList& files)
+{
+    if (!m_mpv) {
+        m_pendingOpen.append(files);
+        return;
+    }
+    for (const QString& file : files) {
+        // 재생 중인 항목이 없으면 바로 재생
+        command({"loadfile", normalizePath(file), "append-play"});
+    }
+}
+
+void PlaylistModel::playIndex(int index)
+{
+    if (index >= 0 && index < m_paths.size()) {
+        command({"playlist-play-index", index});
+    }
+}
+
+void PlaylistModel::next()
+{
+    if (m_currentIndex + 1 < m_paths.size()) {
+        command({"playlist-next"});
+    }
+}
+
+void PlaylistModel::previous()
+{
+    if (m_currentIndex > 0) {
+        command({"playlist-prev"});
+    }
+}
+
+void PlaylistModel::remove(int index)
+{
+    if (index >= 0 && index < m_paths.size()) {
+        command({"playlist-remove", index});
+    }
+}
+
+void PlaylistModel::clear()
+{
+    // 현재 재생 중인 항목은 유지하고 나머지만 제거
+    command({"playlist-clear"});
+}
+
+QVariantMap PlaylistModel::metadata(int index) const
+{
+    if (index < 0 || index >= m_paths.size()) {
+        return QVariantMap();
+    }
+    return m_probeCache.value(m_paths.at(index));
+}
+
+void PlaylistModel::command(const QVariantList& args)
+{
+    if (m_mpv) {
+        m_mpv->command(args);
+    }
+}
+
+void PlaylistModel::syncFromMpv()
+{
+    if (!m_mpv || !m_mpv->handle()) {
+        return;
+    }
+    mpv_handle* handle = m_mpv->handle();
+
+    QStringList paths;
+    mpv_node node;
+    if (mpv_get_property(handle, "playlist", MPV_FORMAT_NODE, &node) >= 0) {
+        if (node.format == MPV_FORMAT_NODE_ARRAY) {
+            for (int i = 0; i < node.u.list->num; ++i) {
+                const mpv_node& entry = node.u.list->values[i];
+                if (entry.format != MPV_FORMAT_NODE_MAP) {
+                    continue;
+                }
+                for (int k = 0; k < entry.u.list->num; ++k) {
+                    if (std::strcmp(entry.u.list->keys[k], "filename") == 0) {
+                        paths.append(nodeString(entry.u.list->values[k]));
+                    }
+                }
+            }
+        }
+        mpv_free_node_contents(&node);
+    }
+
+    int64_t pos = -1;
+    mpv_get_property(handle, "playlist-pos", MPV_FORMAT_INT64, &pos);
+    const int newIndex = static_cast<int>(pos);
+
+    const bool indexChanged = newIndex != m_currentIndex;
+    if (paths != m_paths) {
+        beginResetModel();
+        m_paths = paths;
+        m_currentIndex = newIndex;
+        endResetModel();
+        emit countChanged(m_paths.size());
+        emit currentIndexChanged(m_currentIndex);
+    } else if (indexChanged) {
+        const int oldIndex = m_currentIndex;
+        m_currentIndex = newIndex;
+        if (oldIndex >= 0 && oldIndex < m_paths.size()) {
+            emit dataChanged(index(oldIndex), index(oldIndex), {CurrentRole});
+        }
+        if (newIndex >= 0 && newIndex < m_paths.size()) {
+            emit dataChanged(index(newIndex), index(newIndex), {CurrentRole});
+        }
+        emit currentIndexChanged(m_currentIndex);
+    } else {
+        return;
+    }
+
+    // 전환된 항목의 메타데이터가 준비되어 있으면 바로 적용 (파일 로드 완료를 기다리지 않음)
+    if (indexChanged && m_currentIndex >= 0 && m_currentIndex < m_paths.size()) {
+        const QVariantMap info = m_probeCache.value(m_paths.at(m_currentIndex));
+        if (!info.isEmpty()) {
+            m_mpv->applyPreprobedMetadata(info);
+        }
+    }
+
+    scheduleProbes();
+}
+
+void PlaylistModel::scheduleProbes()
+{
+    if (m_prefetchCount <= 0 || m_paths.isEmpty()) {
+        return;
+    }
+
+    const int first = qMax(0, m_currentIndex + 1);
+    const int last = qMin(int(m_paths.size()) - 1, m_currentIndex + m_prefetchCount);
+    for (int i = first; i <= last; ++i) {
+        const QString path = m_paths.at(i);
+        if (m_probeCache.contains(path) || m_probing.contains(path)) {
+            continue;
+        }
+        m_probing.insert(path);
+        m_probePool.start(QRunnable::create([this, path]() {
+            const QVariantMap info = probeFile(path);
+            QMetaObject::invokeMethod(this, [this, path, info]() {
+                onProbeFinished(path, info);
+            }, Qt::QueuedConnection);
+        }));
+    }
+}
+
+void PlaylistModel::onProbeFinished(const QString& path, const QVariantMap& info)
+{
+    m_probing.remove(path);
+    if (info.isEmpty()) {
+        return;
+    }
+    m_probeCache.insert(path, info);
+
+    for (int i = 0; i < m_paths.size(); ++i) {
+        if (m_paths.at(i) == path) {
+            emit dataChanged(index(i), index(i));
+            emit itemProbed(i);
+        }
+    }
+}
+
+QString PlaylistModel::normalizePath(const QString& file)
+{
+    // QML에서 넘어오는 file:// URL을 로컬 경로로 변환
+    if (file.startsWith("file:", Qt::CaseInsensitive)) {
+        return QUrl(file).toLocalFile();
+    }
+    return file;
+}
+
+QVariantMap PlaylistModel::probeFile(const QString& path)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        return QVariantMap();
+    }
+
+    // 첫 프레임까지만 디코딩해 코덱/포맷 정보를 얻는다
+    mpv_set_option_string(mpv, "pause", "yes");
+    mpv_set_option_string(mpv, "hwdec", "no");
+    mpv_set_option_string(mpv, "aid", "no");
+    mpv_set_option_string(mpv, "sid", "no");
+
+    if (mpv_initialize(mpv) < 0) {
+        mpv_terminate_destroy(mpv);
+        return QVariantMap();
+    }
+
+    const QByteArray pathBytes = path.toUtf8();
+    const char* cmd[] = {"loadfile", pathBytes.constData(), nullptr};
+    if (mpv_command(mpv, cmd) < 0) {
+        mpv_terminate_destroy(mpv);
+        return QVariantMap();
+    }
+
+    bool loaded = false;
+    bool failed = false;
+    while (!failed) {
+        const double remaining = kProbeTimeoutSec - timer.elapsed() / 1000.0;
+        if (remaining <= 0) {
+            break;
+        }
+        mpv_event* event = mpv_wait_event(mpv, remaining);
+        if (event->event_id == MPV_EVENT_FILE_LOADED) {
+            loaded = true;
+        } else if (event->event_id == MPV_EVENT_VIDEO_RECONFIG && loaded) {
+            break;
+        } else if (event->event_id == MPV_EVENT_END_FILE) {
+            failed = true;
+        }
+    }
+
+    QVariantMap info;
+    if (loaded) {
+        double duration = 0;
+        double fps = 0;
+        int64_t frames = 0;
+        int64_t width = 0;
+        int64_t height = 0;
+        mpv_get_property(mpv, "duration", MPV_FORMAT_DOUBLE, &duration);
+        if (mpv_get_property(mpv, "container-fps", MPV_FORMAT_DOUBLE, &fps) < 0 || fps <= 0) {
+            mpv_get_property(mpv, "estimated-vf-fps", MPV_FORMAT_DOUBLE, &fps);
+        }
+        if (mpv_get_property(mpv, "estimated-frame-count", MPV_FORMAT_INT64, &frames) < 0 || frames <= 0) {
+            frames = (duration > 0 && fps > 0) ? static_cast<int64_t>(std::round(duration * fps)) : 0;
+        }
+        mpv_get_property(mpv, "width", MPV_FORMAT_INT64, &width);
+        mpv_get_property(mpv, "height", MPV_FORMAT_INT64, &height);
+
+        info["duration"] = duration;
+        info["fps"] = fps;
+        info["frameCount"] = static_cast<int>(frames);
+        if (width > 0 && height > 0) {
+            info["resolution"] = QString("%1×%2").arg(width).arg(height);
+        }
+        if (char* codec = mpv_get_property_string(mpv, "video-codec")) {
+            info["codec"] = QString::fromUtf8(codec);
+            mpv_free(codec);
+        }
+        if (char* format = mpv_get_property_string(mpv, "video-format")) {
+            info["format"] = QString::fromUtf8(format);
+            mpv_free(format);
+        }
+    }
+
+    mpv_terminate_destroy(mpv);
+    qDebug() << "PlaylistModel: probed" << path << "in" << timer.elapsed() << "ms" << (loaded ? "" : "(failed)");
+    return info;
+}
@@ -0,0 +1,94 @@
+#ifndef PLAYLISTMODEL_H
+#define PLAYLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariantMap>
+
+class MpvObject;
+
+// 재생 목록 모델
+// MPV 내부 재생 목록을 그대로 반영하고(명령은 MPV로 보내고 playlist-pos/count 변경 시 다시 읽음),
+// 현재 항목 재생 중에 다음 N개 항목의 메타데이터를 별도 MPV 인스턴스로 미리 분석해 둔다.
+// 다음 항목의 데이터 미리 읽기는 MPV prefetch-playlist 옵션이 담당한다.
+class PlaylistModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int currentIndex READ currentIndex NOTIFY currentIndexChanged)
+    Q_PROPERTY(int prefetchCount READ prefetchCount WRITE setPrefetchCount NOTIFY prefetchCountChanged)
+
+public:
+    enum Roles {
+        PathRole = Qt::UserRole + 1,
+        FileNameRole,
+        CurrentRole,
+        ProbedRole,
+        FpsRole,
+        FrameCountRole,
+        DurationRole,
+        CodecRole,
+        ResolutionRole
+    };
+
+    explicit PlaylistModel(QObject *parent = nullptr);
+    ~PlaylistModel();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_paths.size(); }
+    int currentIndex() const { return m_currentIndex; }
+    int prefetchCount() const { return m_prefetchCount; }
+    void setPrefetchCount(int count);
+
+    // MPV 객체 연결 (연결 전에 요청된 파일은 연결 시 열림)
+    Q_INVOKABLE void connectMpv(MpvObject* mpv);
+
+    // 재생 목록을 교체하고 첫 항목 재생
+    Q_INVOKABLE void openFiles(const QStringList& files);
+    // 재생 목록 끝에 추가
+    Q_INVOKABLE void append(const QStringList& files);
+
+    Q_INVOKABLE void playIndex(int index);
+    Q_INVOKABLE void next();
+    Q_INVOKABLE void previous();
+    Q_INVOKABLE void remove(int index);
+    Q_INVOKABLE void clear();
+
+    // 미리 분석한 메타데이터 (분석 전이면 빈 맵)
+    Q_INVOKABLE QVariantMap metadata(int index) const;
+
+signals:
+    void countChanged(int count);
+    void currentIndexChanged(int index);
+    void prefetchCountChanged(int count);
+    void itemProbed(int index);
+
+private slots:
+    void syncFromMpv();
+
+private:
+    void command(const QVariantList& args);
+    void scheduleProbes();
+    void onProbeFinished(const QString& path, const QVariantMap& info);
+    static QString normalizePath(const QString& file);
+    static QVariantMap probeFile(const QString& path);
+
+    QPointer<MpvObject> m_mpv;
+    QStringList m_paths;
+    int m_currentIndex = -1;
+    int m_prefetchCount = 2;
+
+    QStringList m_pendingOpen;              // MPV 연결 전에 요청된 파일
+    QHash<QString, QVariantMap> m_probeCache;
+    QSet<QString> m_probing;
+    QThreadPool m_probePool;
+};
+
+#endif // PLAYLISTMODEL_H
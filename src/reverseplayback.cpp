@@ -0,0 +1,306 @@
+#include "reverseplayback.h"
+#include "mpvobject.h"
+#include "mpvcommand.h"
+#include "logger.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr qint64 kMiB = 1024 * 1024;
+
+// 역순 프레임 버퍼 - 긴 GOP 한 구간(+다음 구간)이 들어갈 만큼, 메모리는 제한
+constexpr int kBufferedFrames = 300;
+constexpr qint64 kMinReversalBuffer = 256 * kMiB;
+constexpr qint64 kMaxReversalBuffer = 1024 * kMiB;
+// 한 번에 디코딩할 키프레임 구간 수 (2 = 표시 중인 구간 + 다음 구간 미리 디코딩)
+constexpr int kBackwardBatch = 2;
+// 이전 구간을 다시 읽지 않도록 뒤쪽 캐시를 이만큼은 확보
+constexpr qint64 kMinBackBytes = 256 * kMiB;
+
+// 셔틀 단계 한계 (최대 8배속)
+constexpr int kMaxShuttle = 4;
+
+// 지연 통계 표본 수
+constexpr int kMaxStepSamples = 240;
+
+double percentile(QVector<double> samples, double fraction)
+{
+    if (samples.isEmpty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const int index = std::clamp(int(std::ceil(fraction * samples.size())) - 1, 0, int(samples.size()) - 1);
+    return samples[index];
+}
+
+} // namespace
+
+ReversePlaybackController::ReversePlaybackController(MpvObject* player)
+    : QObject(player)
+    , m_player(player)
+{
+    connect(player, &MpvObject::playingChanged, this, &ReversePlaybackController::onPlayingChanged);
+    connect(player, &MpvObject::playbackRestarted, this, &ReversePlaybackController::onPlaybackRestarted);
+    connect(player, &MpvObject::positionChanged, this, &ReversePlaybackController::onPositionChanged);
+    connect(player, &MpvObject::fileLoaded, this, &ReversePlaybackController::reset);
+}
+
+double ReversePlaybackController::averageStepMs() const
+{
+    if (m_stepSamples.isEmpty()) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (double sample : m_stepSamples) {
+        total += sample;
+    }
+    return total / m_stepSamples.size();
+}
+
+double ReversePlaybackController::p95StepMs() const
+{
+    return percentile(m_stepSamples, 0.95);
+}
+
+QVariantMap ReversePlaybackController::stepLatency() const
+{
+    QVariantMap stats;
+    stats["count"] = m_stepSamples.size();
+    stats["lastMs"] = m_lastStepMs;
+    stats["averageMs"] = averageStepMs();
+    stats["p50Ms"] = percentile(m_stepSamples, 0.5);
+    stats["p95Ms"] = p95StepMs();
+    stats["maxMs"] = m_stepSamples.isEmpty() ? 0.0 : *std::max_element(m_stepSamples.begin(), m_stepSamples.end());
+    return stats;
+}
+
+void ReversePlaybackController::resetStepLatency()
+{
+    m_stepSamples.clear();
+    m_lastStepMs = 0.0;
+    emit stepLatencyChanged();
+}
+
+void ReversePlaybackController::stepBackward()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return;
+    }
+
+    setShuttle(0);
+    m_player->setPause(true);
+
+    // 방향 전환은 MPV 내부 시크 - 그 시크가 끝난 뒤에 frame-step을 보내야 지연 측정이 단계 자체만 잼
+    if (m_directionSeekPending) {
+        m_queuedSteps++;
+        return;
+    }
+    if (!m_backward) {
+        setBackward(true);
+        if (m_backward) {
+            m_directionSeekPending = true;
+            m_queuedSteps = 1;
+        }
+        return;
+    }
+    issueBackStep();
+}
+
+void ReversePlaybackController::issueBackStep()
+{
+    // 역방향 모드에서 frame-step은 재생 방향(뒤)으로 한 프레임 - 역순 버퍼에서 바로 꺼냄
+    m_stepTimer.start();
+    m_stepPending = true;
+    const int result = MpvCommand::frameStep(m_player->handle());
+    if (result < 0) {
+        m_stepPending = false;
+        qWarning() << "ReversePlayback: frame-step failed:" << mpv_error_string(result);
+    }
+}
+
+void ReversePlaybackController::stepForward()
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv) {
+        return;
+    }
+
+    setShuttle(0);
+    m_player->setPause(true);
+    restoreForward();
+    MpvCommand::frameStep(mpv);
+}
+
+void ReversePlaybackController::shuttleReverse()
+{
+    // 정방향 재생 중이면 먼저 정지, 이미 역방향이면 두 배씩 빠르게
+    setShuttle(m_shuttle > 0 ? 0 : std::max(-kMaxShuttle, m_shuttle - 1));
+}
+
+void ReversePlaybackController::shuttleForward()
+{
+    setShuttle(m_shuttle < 0 ? 0 : std::min(kMaxShuttle, m_shuttle + 1));
+}
+
+void ReversePlaybackController::stop()
+{
+    setShuttle(0);
+}
+
+void ReversePlaybackController::reset()
+{
+    m_stepPending = false;
+    m_directionSeekPending = false;
+    m_queuedSteps = 0;
+    if (m_shuttle != 0) {
+        m_shuttle = 0;
+        emit shuttleChanged(m_shuttle);
+    }
+    if (m_player->handle()) {
+        MpvCommand::setSpeed(m_player->handle(), 1.0);
+    }
+    setBackward(false);
+}
+
+void ReversePlaybackController::restoreForward()
+{
+    // 역방향 셔틀 재생 중의 시크는 그 방향 그대로 (J 누른 채 타임라인 클릭 등)
+    if (!m_backward || m_shuttle < 0) {
+        return;
+    }
+    m_stepPending = false;
+    m_directionSeekPending = false;
+    m_queuedSteps = 0;
+    setBackward(false);
+}
+
+void ReversePlaybackController::setShuttle(int shuttle)
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv || m_shuttle == shuttle) {
+        return;
+    }
+    m_shuttle = shuttle;
+    emit shuttleChanged(m_shuttle);
+
+    if (m_shuttle == 0) {
+        m_player->setPause(true);
+        MpvCommand::setSpeed(mpv, 1.0);
+        return;
+    }
+
+    // 방향을 먼저 정한 뒤 재생 (onPlayingChanged가 방향을 되돌리지 않도록)
+    setBackward(m_shuttle < 0);
+    MpvCommand::setSpeed(mpv, std::pow(2.0, std::abs(m_shuttle) - 1));
+    m_player->setPause(false);
+}
+
+void ReversePlaybackController::setBackward(bool backward)
+{
+    mpv_handle* mpv = m_player->handle();
+    if (!mpv || m_backward == backward) {
+        return;
+    }
+
+    if (backward) {
+        configureBackwardDecoding();
+    }
+    // 방향 전환은 MPV 내부에서 현재 위치로 시크 (한 번만 발생)
+    const int result = mpv_set_property_string(mpv, "play-dir", backward ? "backward" : "forward");
+    if (result < 0) {
+        qWarning() << "ReversePlayback: cannot set play-dir:" << mpv_error_string(result);
+        return;
+    }
+    m_backward = backward;
+
+    // 역방향용으로 늘린 뒤쪽 캐시 복원 - 그 사이 DemuxCacheManager가 다시 정했으면 그 값을 둠
+    if (!backward && m_savedBackBytes >= 0) {
+        qint64 backBytes = 0;
+        if (mpv_get_property(mpv, "demuxer-max-back-bytes", MPV_FORMAT_INT64, &backBytes) >= 0
+            && backBytes == kMinBackBytes) {
+            mpv_set_property_string(mpv, "demuxer-max-back-bytes", QByteArray::number(m_savedBackBytes).constData());
+        }
+        m_savedBackBytes = -1;
+    }
+    qDebug() << "ReversePlayback: play direction" << (backward ? "backward" : "forward");
+    emit backwardChanged(m_backward);
+}
+
+void ReversePlaybackController::configureBackwardDecoding()
+{
+    mpv_handle* mpv = m_player->handle();
+
+    // 역순 버퍼 크기 = 프레임 크기(YUV 4:2:0 기준) x 버퍼링할 프레임 수
+    qint64 width = 0;
+    qint64 height = 0;
+    mpv_get_property(mpv, "width", MPV_FORMAT_INT64, &width);
+    mpv_get_property(mpv, "height", MPV_FORMAT_INT64, &height);
+    const qint64 frameBytes = width > 0 && height > 0 ? width * height * 3 / 2 : 1920 * 1080 * 3 / 2;
+    const qint64 reversalBuffer = std::clamp(frameBytes * kBufferedFrames, kMinReversalBuffer, kMaxReversalBuffer);
+    mpv_set_property_string(mpv, "video-reversal-buffer", QByteArray::number(reversalBuffer).constData());
+    mpv_set_property_string(mpv, "video-backward-batch", QByteArray::number(kBackwardBatch).constData());
+
+    // DemuxCacheManager가 정한 뒤쪽 캐시가 너무 작으면 이전 구간을 디스크에서 다시 읽음
+    qint64 backBytes = 0;
+    if (mpv_get_property(mpv, "demuxer-max-back-bytes", MPV_FORMAT_INT64, &backBytes) >= 0 && backBytes < kMinBackBytes) {
+        m_savedBackBytes = backBytes;
+        mpv_set_property_string(mpv, "demuxer-max-back-bytes", QByteArray::number(kMinBackBytes).constData());
+    }
+
+    hpVerbose(lcMpvCommand) << "Backward decoding: reversal buffer" << reversalBuffer / kMiB << "MiB, batch" << kBackwardBatch;
+}
+
+void ReversePlaybackController::onPlayingChanged(bool playing)
+{
+    // 셔틀이 아닌 일반 재생(Space 등)은 항상 정방향
+    if (playing && m_shuttle == 0) {
+        restoreForward();
+    }
+}
+
+void ReversePlaybackController::onPlaybackRestarted()
+{
+    // 방향 전환 시크 완료 - 기다리던 뒤로 이동을 이제 보냄 (이 restart는 측정하지 않음)
+    if (m_directionSeekPending) {
+        m_directionSeekPending = false;
+        if (m_queuedSteps > 0 && m_backward) {
+            m_queuedSteps--;
+            issueBackStep();
+        }
+        return;
+    }
+    finishBackStep();
+}
+
+void ReversePlaybackController::onPositionChanged()
+{
+    // 방향 전환 시크의 위치 갱신은 건너뜀
+    if (m_directionSeekPending) {
+        return;
+    }
+    finishBackStep();
+}
+
+void ReversePlaybackController::finishBackStep()
+{
+    if (!m_stepPending) {
+        return;
+    }
+    m_stepPending = false;
+    m_lastStepMs = m_stepTimer.nsecsElapsed() / 1e6;
+    m_stepSamples.append(m_lastStepMs);
+    if (m_stepSamples.size() > kMaxStepSamples) {
+        m_stepSamples.removeFirst();
+    }
+    qCDebug(lcMpvCommand) << "Back-step latency" << m_lastStepMs << "ms (p95" << p95StepMs() << "ms)";
+    emit stepLatencyChanged();
+
+    // 방향 전환 중에 더 눌린 뒤로 이동
+    if (m_queuedSteps > 0 && m_backward) {
+        m_queuedSteps--;
+        issueBackStep();
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef REVERSEPLAYBACK_H
+#define REVERSEPLAYBACK_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+
+class MpvObject;
+
+// 역방향 재생과 빠른 프레임 뒤로 이동 (J/K/L 셔틀)
+// MPV의 역방향 재생(play-dir=backward)을 사용한다.
+// - 키프레임 구간(GOP)을 한 번 디코딩해 역순 버퍼(video-reversal-buffer)에 담고 뒤에서부터 표시
+// - 다음 구간은 디코더 스레드가 미리 디코딩 (video-backward-batch)
+// - 뒤로 한 프레임씩 이동할 때 매번 이전 키프레임부터 다시 디코딩하지 않음
+// - 디먹서는 뒤쪽 캐시(demuxer-max-back-bytes)에서 이전 구간을 읽음
+// 정방향 재생이 시작되거나 다른 시크/프레임 이동이 오면 play-dir=forward로 돌아간다.
+// (뒤로 한 프레임 이동 뒤에 남은 역방향 디코더로 스크럽/시크하지 않도록)
+class ReversePlaybackController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool backward READ isBackward NOTIFY backwardChanged)
+    Q_PROPERTY(int shuttle READ shuttle NOTIFY shuttleChanged)
+    Q_PROPERTY(double lastStepMs READ lastStepMs NOTIFY stepLatencyChanged)
+    Q_PROPERTY(double averageStepMs READ averageStepMs NOTIFY stepLatencyChanged)
+    Q_PROPERTY(double p95StepMs READ p95StepMs NOTIFY stepLatencyChanged)
+
+public:
+    explicit ReversePlaybackController(MpvObject* player);
+
+    bool isBackward() const { return m_backward; }
+    // 셔틀 단계 (음수: 역방향, 0: 정지, 양수: 정방향) - 속도는 2^(|단계|-1)배
+    int shuttle() const { return m_shuttle; }
+
+    double lastStepMs() const { return m_lastStepMs; }
+    double averageStepMs() const;
+    double p95StepMs() const;
+
+    // 뒤로 이동 지연 통계 {count, lastMs, averageMs, p50Ms, p95Ms, maxMs}
+    Q_INVOKABLE QVariantMap stepLatency() const;
+    Q_INVOKABLE void resetStepLatency();
+
+public slots:
+    // 한 프레임 뒤로/앞으로 (일시정지 상태 유지)
+    void stepBackward();
+    void stepForward();
+
+    // J: 역방향 재생 (누를 때마다 빨라짐), L: 정방향 재생, K: 정지
+    void shuttleReverse();
+    void shuttleForward();
+    void stop();
+
+    // 새 파일 - 정방향, 정지 상태로
+    void reset();
+
+    // 뒤로 이동이 아닌 시크/프레임 이동 전에 호출 - 역방향 셔틀 재생 중이 아니면 정방향으로
+    void restoreForward();
+
+signals:
+    void backwardChanged(bool backward);
+    void shuttleChanged(int shuttle);
+    void stepLatencyChanged();
+
+private:
+    void setBackward(bool backward);
+    void setShuttle(int shuttle);
+    void configureBackwardDecoding();
+    void issueBackStep();
+    void finishBackStep();
+    void onPlayingChanged(bool playing);
+    void onPlaybackRestarted();
+    void onPositionChanged();
+
+    MpvObject* m_player = nullptr;
+    bool m_backward = false;
+    int m_shuttle = 0;
+
+    // 방향 전환 시크가 끝나기를 기다리는 뒤로 이동 수
+    bool m_directionSeekPending = false;
+    int m_queuedSteps = 0;
+
+    // 자리를 비켜 둔 뒤쪽 캐시 크기 (정방향으로 돌아가면 복원, 없으면 -1)
+    qint64 m_savedBackBytes = -1;
+
+    // frame-step 명령 ~ 그 단계의 playback-restart(또는 위치 갱신)까지의 시간
+    QElapsedTimer m_stepTimer;
+    bool m_stepPending = false;
+    double m_lastStepMs = 0.0;
+    QVector<double> m_stepSamples;
+};
+
+#endif // REVERSEPLAYBACK_H
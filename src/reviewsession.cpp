@@ -0,0 +1,638 @@
+#include "reviewsession.h"
+#include "mpvobject.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 참가자 재생 시작 여유 - 이만큼 앞 프레임에 미리 시크하고 진행자가 도달할 때 시작
+constexpr double kPrerollSec = 0.25;
+constexpr int kMaxStartAttempts = 3;
+// 시계 동기화 - 연결 직후 짧은 간격으로 여러 번, 이후 주기적으로
+constexpr int kInitialPings = 5;
+constexpr int kPingIntervalMs = 2000;
+constexpr int kClockSamples = 16;
+// 보고/보정 주기
+constexpr int kReportIntervalMs = 1000;
+constexpr int kDriftIntervalMs = 100;
+// 드리프트 보정 - 반 프레임 이내는 그대로, 6프레임 넘으면 다시 시크, 그 사이는 속도 ±5% 조정
+constexpr double kLockedFrames = 0.5;
+constexpr double kResyncFrames = 6.0;
+constexpr double kCorrectionSec = 1.0;
+constexpr double kMaxSpeedNudge = 0.05;
+
+QByteArray encode(const QJsonObject& message)
+{
+    return QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n';
+}
+
+} // namespace
+
+ReviewSession::ReviewSession(QObject *parent)
+    : QObject(parent)
+{
+    m_startTimer.setSingleShot(true);
+    m_startTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_startTimer, &QTimer::timeout, this, [this]() {
+        m_pendingStartFrame = -1.0;
+        setPause(false);
+    });
+
+    m_pingTimer.setInterval(kPingIntervalMs);
+    connect(&m_pingTimer, &QTimer::timeout, this, &ReviewSession::sendPing);
+
+    m_reportTimer.setInterval(kReportIntervalMs);
+    connect(&m_reportTimer, &QTimer::timeout, this, [this]() {
+        if (m_role == Host) {
+            // 실제 재생 위치로 기준을 다시 보내 진행자 자신의 재생 지연도 반영
+            if (m_reference.playing) {
+                broadcastState("sync");
+            }
+        } else if (m_role == Peer) {
+            sendReport();
+        }
+    });
+
+    m_driftTimer.setInterval(kDriftIntervalMs);
+    m_driftTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_driftTimer, &QTimer::timeout, this, &ReviewSession::correctDrift);
+}
+
+ReviewSession::~ReviewSession()
+{
+    leave();
+}
+
+qint64 ReviewSession::nowNs()
+{
+    static QElapsedTimer clock;
+    if (!clock.isValid()) {
+        clock.start();
+    }
+    return clock.nsecsElapsed();
+}
+
+QVariantList ReviewSession::peers() const
+{
+    QVariantList list;
+    for (const PeerState& peer : m_peers) {
+        QVariantMap entry;
+        entry["name"] = peer.name;
+        entry["rttMs"] = peer.rttMs;
+        entry["offsetMs"] = peer.offsetMs;
+        entry["errorFrames"] = peer.errorFrames;
+        entry["hasReport"] = peer.hasReport;
+        list.append(entry);
+    }
+    return list;
+}
+
+void ReviewSession::connectMpv(MpvObject* mpv)
+{
+    if (m_mpv == mpv) {
+        return;
+    }
+    if (m_mpv) {
+        disconnect(m_mpv, nullptr, this, nullptr);
+    }
+    m_mpv = mpv;
+    if (!m_mpv) {
+        return;
+    }
+    connect(m_mpv, &MpvObject::pauseChanged, this, &ReviewSession::onHostPaused);
+    connect(m_mpv, &MpvObject::playbackRestarted, this, &ReviewSession::onPlaybackRestarted);
+}
+
+bool ReviewSession::host(int port)
+{
+    leave();
+
+    m_server = new QTcpServer(this);
+    if (!m_server->listen(QHostAddress::Any, quint16(port))) {
+        setStatus(QString("Cannot listen on port %1: %2").arg(port).arg(m_server->errorString()));
+        delete m_server;
+        m_server = nullptr;
+        return false;
+    }
+    connect(m_server, &QTcpServer::newConnection, this, &ReviewSession::onNewConnection);
+
+    m_reference = Reference();
+    m_reference.fps = currentFps();
+    m_reference.frame = currentFrame();
+    m_reference.at = nowNs();
+    m_reference.playing = m_mpv && !m_mpv->isPaused();
+
+    setRole(Host);
+    setStatus(QString("Hosting on port %1").arg(m_server->serverPort()));
+    m_reportTimer.start();
+    return true;
+}
+
+void ReviewSession::join(const QString& address)
+{
+    leave();
+
+    QString hostName = address.trimmed();
+    quint16 port = kDefaultPort;
+    const int colon = hostName.lastIndexOf(':');
+    if (colon > 0) {
+        port = quint16(hostName.mid(colon + 1).toUInt());
+        hostName = hostName.left(colon);
+    }
+    if (hostName.isEmpty()) {
+        hostName = "127.0.0.1";
+    }
+
+    m_socket = new QTcpSocket(this);
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    connect(m_socket, &QTcpSocket::connected, this, &ReviewSession::onPeerConnected);
+    connect(m_socket, &QTcpSocket::readyRead, this, [this]() {
+        readLines(m_socket, m_buffer, [this](const QJsonObject& message) { handlePeerMessage(message); });
+    });
+    connect(m_socket, &QTcpSocket::disconnected, this, [this]() {
+        setStatus("Disconnected from host");
+        leave();
+    });
+    connect(m_socket, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+        if (m_socket) {
+            setStatus("Connection failed: " + m_socket->errorString());
+        }
+    });
+
+    setRole(Peer);
+    setStatus(QString("Connecting to %1:%2").arg(hostName).arg(port));
+    m_socket->connectToHost(hostName, port);
+}
+
+void ReviewSession::leave()
+{
+    m_pingTimer.stop();
+    m_reportTimer.stop();
+    m_driftTimer.stop();
+    m_startTimer.stop();
+    m_pendingStartFrame = -1.0;
+    setSpeed(1.0);
+
+    for (PeerState& peer : m_peers) {
+        if (peer.socket) {
+            peer.socket->disconnect(this);
+            peer.socket->close();
+            peer.socket->deleteLater();
+        }
+    }
+    m_peers.clear();
+    if (m_server) {
+        m_server->close();
+        m_server->deleteLater();
+        m_server = nullptr;
+    }
+    if (m_socket) {
+        m_socket->disconnect(this);
+        m_socket->close();
+        m_socket->deleteLater();
+        m_socket = nullptr;
+    }
+    m_buffer.clear();
+    m_clockSamples.clear();
+    m_clockOffsetNs = 0;
+    m_bestRttNs = 0;
+    m_syncErrorFrames = 0.0;
+
+    if (m_role != Idle) {
+        setRole(Idle);
+        emit peersChanged();
+        emit syncChanged();
+    }
+}
+
+// ---- 진행자 ----
+
+void ReviewSession::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        socket->setParent(this);
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        PeerState peer;
+        peer.socket = socket;
+        peer.name = socket->peerAddress().toString();
+        m_peers.append(peer);
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            for (PeerState& state : m_peers) {
+                if (state.socket == socket) {
+                    readLines(socket, state.buffer, [this, socket](const QJsonObject& message) {
+                        handleHostMessage(socket, message);
+                    });
+                    break;
+                }
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_peers.erase(std::remove_if(m_peers.begin(), m_peers.end(),
+                                         [socket](const PeerState& state) { return state.socket == socket; }),
+                          m_peers.end());
+            socket->deleteLater();
+            setStatus(QString("Hosting, %1 peer(s)").arg(m_peers.size()));
+            emit peersChanged();
+        });
+
+        sendState(socket);
+        setStatus(QString("Hosting, %1 peer(s)").arg(m_peers.size()));
+        emit peersChanged();
+    }
+}
+
+void ReviewSession::handleHostMessage(QTcpSocket* socket, const QJsonObject& message)
+{
+    const QString type = message.value("t").toString();
+    if (type == "ping") {
+        // 시계 차이 추정용 - 받은 값과 진행자 시각을 그대로 돌려준다
+        QJsonObject pong;
+        pong["t"] = "pong";
+        pong["c0"] = message.value("c0");
+        pong["h"] = double(nowNs());
+        send(socket, pong);
+        return;
+    }
+
+    for (PeerState& peer : m_peers) {
+        if (peer.socket != socket) {
+            continue;
+        }
+        if (type == "hello") {
+            peer.name = message.value("name").toString(peer.name);
+        } else if (type == "report") {
+            peer.rttMs = message.value("rttMs").toDouble();
+            peer.offsetMs = message.value("offsetMs").toDouble();
+            peer.errorFrames = message.value("error").toDouble();
+            peer.hasReport = true;
+        }
+        emit peersChanged();
+        break;
+    }
+
+    if (type == "report") {
+        // 가장 크게 벗어난 참가자 기준으로 표시
+        double worst = 0.0;
+        for (const PeerState& peer : m_peers) {
+            if (peer.hasReport && std::abs(peer.errorFrames) > std::abs(worst)) {
+                worst = peer.errorFrames;
+            }
+        }
+        m_syncErrorFrames = worst;
+        emit syncChanged();
+    }
+}
+
+void ReviewSession::onHostPaused(bool paused)
+{
+    if (m_role != Host) {
+        return;
+    }
+    broadcastState(paused ? "pause" : "play");
+}
+
+void ReviewSession::onPlaybackRestarted()
+{
+    if (m_role == Host) {
+        // 시크/스크럽이 끝날 때마다 (시크 지연만큼 자연스럽게 간격이 생김)
+        broadcastState("seek");
+        return;
+    }
+    if (m_role != Peer || m_pendingStartFrame < 0) {
+        return;
+    }
+
+    // 미리 시크한 프레임에 진행자가 도달하는 시각에 맞춰 재생 시작
+    const double fps = m_reference.fps > 0 ? m_reference.fps : 24.0;
+    const qint64 hostStart = m_reference.at + qint64((m_pendingStartFrame - m_reference.frame) / fps * 1e9);
+    const qint64 delayNs = hostStart - m_clockOffsetNs - nowNs();
+    if (delayNs < 0) {
+        if (++m_startAttempts < kMaxStartAttempts) {
+            schedulePlayStart();
+        } else {
+            // 계속 늦으면 바로 시작하고 드리프트 보정에 맡김
+            m_pendingStartFrame = -1.0;
+            setPause(false);
+        }
+        return;
+    }
+    m_startTimer.start(int(delayNs / 1000000));
+}
+
+void ReviewSession::broadcastState(const char* kind)
+{
+    if (m_role != Host || !m_mpv) {
+        return;
+    }
+    m_reference.fps = currentFps();
+    m_reference.frame = currentFrame();
+    m_reference.at = nowNs();
+    m_reference.playing = !m_mpv->isPaused();
+
+    QJsonObject message;
+    message["t"] = "state";
+    message["kind"] = kind;
+    message["frame"] = m_reference.frame;
+    message["at"] = double(m_reference.at);
+    message["fps"] = m_reference.fps;
+    message["playing"] = m_reference.playing;
+    message["seq"] = double(++m_referenceSeq);
+    broadcast(message);
+}
+
+void ReviewSession::broadcast(const QJsonObject& message)
+{
+    const QByteArray line = encode(message);
+    for (const PeerState& peer : m_peers) {
+        if (peer.socket) {
+            peer.socket->write(line);
+        }
+    }
+}
+
+void ReviewSession::sendState(QTcpSocket* socket)
+{
+    QJsonObject hello;
+    hello["t"] = "hello";
+    hello["file"] = m_mpv ? m_mpv->filename() : QString();
+    send(socket, hello);
+
+    if (m_mpv) {
+        m_reference.fps = currentFps();
+        m_reference.frame = currentFrame();
+        m_reference.at = nowNs();
+        m_reference.playing = !m_mpv->isPaused();
+    }
+    QJsonObject state;
+    state["t"] = "state";
+    state["kind"] = m_reference.playing ? "play" : "seek";
+    state["frame"] = m_reference.frame;
+    state["at"] = double(m_reference.at);
+    state["fps"] = m_reference.fps;
+    state["playing"] = m_reference.playing;
+    state["seq"] = double(++m_referenceSeq);
+    send(socket, state);
+}
+
+// ---- 참가자 ----
+
+void ReviewSession::onPeerConnected()
+{
+    setStatus("Connected to host");
+
+    QJsonObject hello;
+    hello["t"] = "hello";
+    hello["name"] = QString("%1 (%2)").arg(QSysInfo::machineHostName()).arg(QCoreApplication::applicationPid());
+    send(m_socket, hello);
+
+    // 연결 직후 여러 번 왕복해서 시계 차이를 빠르게 추정
+    for (int i = 0; i < kInitialPings; ++i) {
+        QTimer::singleShot(i * 50, this, &ReviewSession::sendPing);
+    }
+    m_pingTimer.start();
+    m_reportTimer.start();
+    m_driftTimer.start();
+}
+
+void ReviewSession::sendPing()
+{
+    if (!m_socket || m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+    QJsonObject ping;
+    ping["t"] = "ping";
+    ping["c0"] = double(nowNs());
+    send(m_socket, ping);
+}
+
+void ReviewSession::sendReport()
+{
+    if (!m_socket || m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+    QJsonObject report;
+    report["t"] = "report";
+    report["error"] = m_syncErrorFrames;
+    report["rttMs"] = roundTripMs();
+    report["offsetMs"] = clockOffsetMs();
+    send(m_socket, report);
+}
+
+void ReviewSession::handlePeerMessage(const QJsonObject& message)
+{
+    const QString type = message.value("t").toString();
+
+    if (type == "pong") {
+        const qint64 c0 = qint64(message.value("c0").toDouble());
+        const qint64 hostNs = qint64(message.value("h").toDouble());
+        const qint64 c1 = nowNs();
+        const qint64 rtt = c1 - c0;
+        // 진행자 시각은 왕복 중간에 찍혔다고 가정
+        const qint64 offset = hostNs - (c0 + c1) / 2;
+
+        m_clockSamples.append(qMakePair(rtt, offset));
+        while (m_clockSamples.size() > kClockSamples) {
+            m_clockSamples.removeFirst();
+        }
+        // 왕복 시간이 가장 짧은 표본이 가장 정확
+        const auto best = std::min_element(m_clockSamples.begin(), m_clockSamples.end());
+        m_bestRttNs = best->first;
+        m_clockOffsetNs = best->second;
+        emit syncChanged();
+        return;
+    }
+
+    if (type == "hello") {
+        const QString file = message.value("file").toString();
+        if (m_mpv && !file.isEmpty() && file != m_mpv->filename()) {
+            setStatus(QString("Connected - host is playing \"%1\"").arg(file));
+        }
+        return;
+    }
+
+    if (type == "state") {
+        Reference reference;
+        reference.frame = message.value("frame").toDouble();
+        reference.at = qint64(message.value("at").toDouble());
+        reference.fps = message.value("fps").toDouble(24.0);
+        reference.playing = message.value("playing").toBool();
+        const QString kind = message.value("kind").toString();
+        // 주기적 sync는 기준만 갱신하고 드리프트 보정에 맡긴다
+        applyReference(reference, kind != "sync");
+    }
+}
+
+void ReviewSession::applyReference(const Reference& reference, bool seekNow)
+{
+    const bool wasPlaying = m_reference.playing;
+    m_reference = reference;
+    if (!m_mpv) {
+        return;
+    }
+
+    if (!reference.playing) {
+        // 일시정지/정지 상태 시크 - 프레임 정확히
+        m_startTimer.stop();
+        m_pendingStartFrame = -1.0;
+        setSpeed(1.0);
+        setPause(true);
+        seekExact(reference.frame);
+        return;
+    }
+
+    if (seekNow || !wasPlaying) {
+        m_startAttempts = 0;
+        schedulePlayStart();
+    }
+}
+
+void ReviewSession::schedulePlayStart()
+{
+    // 전송 지연과 시크 시간을 고려해 조금 앞 프레임에서 대기
+    const double fps = m_reference.fps > 0 ? m_reference.fps : 24.0;
+    const qint64 hostNow = nowNs() + m_clockOffsetNs;
+    const double leadSec = kPrerollSec * (m_startAttempts + 1) + m_bestRttNs / 1e9;
+    m_pendingStartFrame = std::ceil(referenceFrameAt(hostNow) + leadSec * fps);
+
+    m_startTimer.stop();
+    setSpeed(1.0);
+    setPause(true);
+    seekExact(m_pendingStartFrame);
+}
+
+void ReviewSession::correctDrift()
+{
+    if (m_role != Peer || !m_mpv) {
+        return;
+    }
+
+    const double expected = referenceFrameAt(nowNs() + m_clockOffsetNs);
+    const double error = currentFrame() - expected;
+    if (m_pendingStartFrame < 0) {
+        m_syncErrorFrames = error;
+        emit syncChanged();
+    }
+
+    if (!m_reference.playing || m_pendingStartFrame >= 0 || m_mpv->isPaused()) {
+        return;
+    }
+
+    if (std::abs(error) > kResyncFrames) {
+        m_startAttempts = 0;
+        schedulePlayStart();
+    } else if (std::abs(error) > kLockedFrames) {
+        const double fps = m_reference.fps > 0 ? m_reference.fps : 24.0;
+        setSpeed(1.0 - std::clamp(error / (fps * kCorrectionSec), -kMaxSpeedNudge, kMaxSpeedNudge));
+    } else {
+        setSpeed(1.0);
+    }
+}
+
+// ---- 공통 ----
+
+void ReviewSession::readLines(QTcpSocket* socket, QByteArray& buffer,
+                              const std::function<void(const QJsonObject&)>& handler)
+{
+    buffer.append(socket->readAll());
+    int newline;
+    while ((newline = buffer.indexOf('\n')) >= 0) {
+        const QByteArray line = buffer.left(newline);
+        buffer.remove(0, newline + 1);
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError || !document.isObject()) {
+            qWarning() << "ReviewSession: invalid message" << line.left(80);
+            continue;
+        }
+        handler(document.object());
+    }
+}
+
+void ReviewSession::send(QTcpSocket* socket, const QJsonObject& message)
+{
+    if (socket) {
+        socket->write(encode(message));
+    }
+}
+
+void ReviewSession::setRole(Role role)
+{
+    if (m_role == role) {
+        return;
+    }
+    m_role = role;
+    emit roleChanged(m_role);
+}
+
+void ReviewSession::setStatus(const QString& status)
+{
+    if (m_status == status) {
+        return;
+    }
+    m_status = status;
+    qDebug() << "ReviewSession:" << status;
+    emit statusChanged(m_status);
+}
+
+double ReviewSession::currentFrame() const
+{
+    double position = 0.0;
+    if (m_mpv && m_mpv->handle()) {
+        mpv_get_property(m_mpv->handle(), "time-pos", MPV_FORMAT_DOUBLE, &position);
+    }
+    return position * currentFps();
+}
+
+double ReviewSession::currentFps() const
+{
+    return m_mpv && m_mpv->fps() > 0 ? m_mpv->fps() : 24.0;
+}
+
+double ReviewSession::referenceFrameAt(qint64 hostNs) const
+{
+    if (!m_reference.playing) {
+        return m_reference.frame;
+    }
+    return m_reference.frame + (hostNs - m_reference.at) / 1e9 * m_reference.fps;
+}
+
+void ReviewSession::seekExact(double frame)
+{
+    if (!m_mpv || !m_mpv->handle()) {
+        return;
+    }
+    // 프레임 경계 바로 뒤로 시크해 부동소수점 오차로 앞 프레임이 표시되지 않게 함
+    const double position = std::max(0.0, (std::round(frame) + 0.001) / currentFps());
+    const QByteArray target = QByteArray::number(position, 'f', 6);
+    const char* cmd[] = {"seek", target.constData(), "absolute+exact", nullptr};
+    m_mpv->ensureForwardPlayback();
+    mpv_command_async(m_mpv->handle(), 0, cmd);
+}
+
+void ReviewSession::setPause(bool pause)
+{
+    if (m_mpv && m_mpv->handle()) {
+        int flag = pause ? 1 : 0;
+        mpv_set_property(m_mpv->handle(), "pause", MPV_FORMAT_FLAG, &flag);
+    }
+}
+
+void ReviewSession::setSpeed(double speed)
+{
+    if (std::abs(m_speed - speed) < 0.001) {
+        return;
+    }
+    m_speed = speed;
+    if (m_mpv && m_mpv->handle()) {
+        mpv_set_property(m_mpv->handle(), "speed", MPV_FORMAT_DOUBLE, &speed);
+    }
+}
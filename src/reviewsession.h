@@ -0,0 +1,147 @@
+#ifndef REVIEWSESSION_H
+#define REVIEWSESSION_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantList>
+#include <functional>
+
+class QTcpServer;
+class QTcpSocket;
+class MpvObject;
+
+// 여러 플레이어 동기 리뷰 세션
+// 진행자(host)의 재생/일시정지/시크/스크럽을 TCP로 참가자(peer)에게 보낸다. 한 줄에 JSON 메시지 하나.
+// - 시계 차이: 참가자가 ping/pong 왕복으로 진행자 시계와의 차이를 추정 (왕복 시간이 가장 짧은 표본 사용)
+// - 재생: 진행자 시계 기준 "이 시각에 이 프레임"을 보내고, 참가자는 조금 앞 프레임에 미리 시크한 뒤
+//   진행자가 그 프레임에 도달하는 시각에 맞춰 재생을 시작한다
+// - 시크: 프레임 번호로 보내고 참가자는 정확(exact) 시크
+// - 동기 오차: 참가자가 1초마다 자신의 프레임을 보고하고, 진행자 기준 프레임과의 차이를 프레임 단위로 표시
+class ReviewSession : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int role READ role NOTIFY roleChanged)
+    Q_PROPERTY(QString status READ status NOTIFY statusChanged)
+    Q_PROPERTY(QVariantList peers READ peers NOTIFY peersChanged)
+    Q_PROPERTY(double syncErrorFrames READ syncErrorFrames NOTIFY syncChanged)
+    Q_PROPERTY(double clockOffsetMs READ clockOffsetMs NOTIFY syncChanged)
+    Q_PROPERTY(double roundTripMs READ roundTripMs NOTIFY syncChanged)
+
+public:
+    enum Role {
+        Idle = 0,
+        Host = 1,
+        Peer = 2
+    };
+    Q_ENUM(Role)
+
+    static const quint16 kDefaultPort = 47800;
+
+    explicit ReviewSession(QObject *parent = nullptr);
+    ~ReviewSession();
+
+    int role() const { return m_role; }
+    QString status() const { return m_status; }
+    QVariantList peers() const;
+    double syncErrorFrames() const { return m_syncErrorFrames; }
+    double clockOffsetMs() const { return m_clockOffsetNs / 1e6; }
+    double roundTripMs() const { return m_bestRttNs / 1e6; }
+
+    Q_INVOKABLE void connectMpv(MpvObject* mpv);
+
+    // 진행자로 세션 시작 / 참가 ("host:port" 또는 "host")
+    Q_INVOKABLE bool host(int port = kDefaultPort);
+    Q_INVOKABLE void join(const QString& address);
+    Q_INVOKABLE void leave();
+
+signals:
+    void roleChanged(int role);
+    void statusChanged(const QString& status);
+    void peersChanged();
+    void syncChanged();
+
+private:
+    struct PeerState {
+        QPointer<QTcpSocket> socket;
+        QByteArray buffer;
+        QString name;
+        double rttMs = 0.0;
+        double offsetMs = 0.0;
+        double errorFrames = 0.0;
+        bool hasReport = false;
+    };
+
+    // 진행자 재생 기준 - playing이면 frame + (시각 - at) * fps
+    struct Reference {
+        double frame = 0.0;
+        qint64 at = 0;
+        double fps = 24.0;
+        bool playing = false;
+    };
+
+    static qint64 nowNs();
+
+    // 진행자
+    void onNewConnection();
+    void onHostPaused(bool paused);
+    void onPlaybackRestarted();
+    void broadcastState(const char* kind);
+    void broadcast(const QJsonObject& message);
+    void sendState(QTcpSocket* socket);
+    void handleHostMessage(QTcpSocket* socket, const QJsonObject& message);
+
+    // 참가자
+    void onPeerConnected();
+    void handlePeerMessage(const QJsonObject& message);
+    void sendPing();
+    void sendReport();
+    void applyReference(const Reference& reference, bool seekNow);
+    void schedulePlayStart();
+    void correctDrift();
+
+    // 공통
+    void readLines(QTcpSocket* socket, QByteArray& buffer, const std::function<void(const QJsonObject&)>& handler);
+    void send(QTcpSocket* socket, const QJsonObject& message);
+    void setRole(Role role);
+    void setStatus(const QString& status);
+    double currentFrame() const;
+    double currentFps() const;
+    double referenceFrameAt(qint64 hostNs) const;
+    void seekExact(double frame);
+    void setPause(bool pause);
+    void setSpeed(double speed);
+
+    QPointer<MpvObject> m_mpv;
+    Role m_role = Idle;
+    QString m_status;
+
+    QTcpServer* m_server = nullptr;
+    QList<PeerState> m_peers;
+
+    QTcpSocket* m_socket = nullptr;
+    QByteArray m_buffer;
+
+    Reference m_reference;
+    qint64 m_referenceSeq = 0;
+
+    // 시계 차이 추정 (진행자 시각 = 로컬 시각 + offset)
+    qint64 m_clockOffsetNs = 0;
+    qint64 m_bestRttNs = 0;
+    QList<QPair<qint64, qint64>> m_clockSamples; // (rtt, offset)
+
+    // 참가자 재생 시작 예약
+    QTimer m_startTimer;
+    double m_pendingStartFrame = -1.0;
+    int m_startAttempts = 0;
+    double m_speed = 1.0;
+
+    QTimer m_pingTimer;
+    QTimer m_reportTimer;
+    QTimer m_driftTimer;
+    double m_syncErrorFrames = 0.0;
+};
+
+#endif // REVIEWSESSION_H
@@ -0,0 +1,194 @@
+#include "singleinstance.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+
+// 연속 실행(여러 파일 동시 열기) 시 요청을 모으는 시간
+constexpr int kBurstWindowMs = 30;
+
+// 요청 하나에 허용하는 최대 크기 (비정상 클라이언트 방어)
+constexpr qint64 kMaxRequestBytes = 1 << 20;
+
+} // namespace
+
+SingleInstance::SingleInstance(QObject *parent)
+    : QObject(parent)
+{
+    m_burstTimer.setSingleShot(true);
+    m_burstTimer.setInterval(kBurstWindowMs);
+    connect(&m_burstTimer, &QTimer::timeout, this, &SingleInstance::flushPending);
+}
+
+SingleInstance::~SingleInstance()
+{
+    if (m_server) {
+        m_server->close();
+    }
+}
+
+QString SingleInstance::serverName()
+{
+    // Windows 명명 파이프는 세션 간에 공유되므로 사용자 이름을 포함
+    QString user = qEnvironmentVariable("USERNAME");
+    if (user.isEmpty()) {
+        user = qEnvironmentVariable("USER");
+    }
+    const QByteArray hash = QCryptographicHash::hash(user.toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+    return QStringLiteral("HyperPlayer-") + QString::fromLatin1(hash);
+}
+
+bool SingleInstance::forwardToPrimary(const QStringList& files, int connectTimeoutMs, int replyTimeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if (!socket.waitForConnected(connectTimeoutMs)) {
+        return false;
+    }
+
+#ifdef _WIN32
+    // 주 인스턴스가 창을 앞으로 가져올 수 있도록 포그라운드 권한 양보
+    AllowSetForegroundWindow(ASFW_ANY);
+#endif
+
+    QByteArray request;
+    for (const QString& file : files) {
+        request += file.toUtf8();
+        request += '\n';
+    }
+    request += '\n';
+    socket.write(request);
+
+    timer.restart();
+    if (!socket.waitForBytesWritten(replyTimeoutMs)) {
+        qWarning() << "SingleInstance: primary instance did not accept request";
+        return false;
+    }
+
+    // 주 인스턴스가 요청을 처리했다는 응답까지 확인해야 종료할 수 있다
+    while (!socket.canReadLine()) {
+        const int left = replyTimeoutMs - static_cast<int>(timer.elapsed());
+        if (left <= 0 || !socket.waitForReadyRead(left)) {
+            qWarning() << "SingleInstance: primary instance is not responding";
+            return false;
+        }
+    }
+    if (socket.readLine().trimmed() != "OK") {
+        return false;
+    }
+
+    qDebug() << "SingleInstance: forwarded" << files.size() << "file(s), reply after" << timer.elapsed() << "ms";
+    socket.disconnectFromServer();
+    return true;
+}
+
+bool SingleInstance::listen()
+{
+    if (m_server) {
+        return true;
+    }
+
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &SingleInstance::onNewConnection);
+
+    const QString name = serverName();
+    if (m_server->listen(name)) {
+        qDebug() << "SingleInstance: listening on" << m_server->fullServerName();
+        return true;
+    }
+
+    // 이름이 이미 사용 중 - 동시에 실행된 다른 프로세스가 먼저 등록했거나, 비정상 종료로 남은 소켓 파일
+    if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+        QLocalSocket probe;
+        probe.connectToServer(name);
+        if (probe.waitForConnected(100)) {
+            probe.disconnectFromServer();
+            qDebug() << "SingleInstance: another instance became primary";
+            delete m_server;
+            m_server = nullptr;
+            return false;
+        }
+
+        QLocalServer::removeServer(name);
+        if (m_server->listen(name)) {
+            qDebug() << "SingleInstance: removed stale server, listening on" << m_server->fullServerName();
+            return true;
+        }
+    }
+
+    qWarning() << "SingleInstance: failed to listen:" << m_server->errorString();
+    delete m_server;
+    m_server = nullptr;
+    return false;
+}
+
+void SingleInstance::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readRequest(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        // 연결 직후 이미 데이터가 도착해 있을 수 있음
+        if (socket->bytesAvailable() > 0) {
+            readRequest(socket);
+        }
+    }
+}
+
+void SingleInstance::readRequest(QLocalSocket* socket)
+{
+    if (socket->bytesAvailable() > kMaxRequestBytes) {
+        qWarning() << "SingleInstance: request too large, dropping connection";
+        socket->abort();
+        return;
+    }
+
+    // 빈 줄(요청 끝)이 도착할 때까지 대기
+    const QByteArray data = socket->peek(socket->bytesAvailable());
+    if (!data.endsWith("\n\n") && data != "\n") {
+        return;
+    }
+    socket->readAll();
+
+    const QList<QByteArray> lines = data.split('\n');
+    for (const QByteArray& line : lines) {
+        if (line.isEmpty()) {
+            continue;
+        }
+        const QString file = QString::fromUtf8(line);
+        if (!m_pendingFiles.contains(file)) {
+            m_pendingFiles.append(file);
+        }
+    }
+
+    m_requestPending = true;
+    socket->write("OK\n");
+    socket->flush();
+
+    if (!m_burstTimer.isActive()) {
+        m_burstTimer.start();
+    }
+}
+
+void SingleInstance::flushPending()
+{
+    // 파일 없이 실행된 경우에도 창을 앞으로 가져오기 위해 빈 목록을 전달
+    if (!m_requestPending) {
+        return;
+    }
+    m_requestPending = false;
+    const QStringList files = m_pendingFiles;
+    m_pendingFiles.clear();
+    qDebug() << "SingleInstance: received" << files;
+    emit filesReceived(files);
+}
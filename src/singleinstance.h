@@ -0,0 +1,49 @@
+#ifndef SINGLEINSTANCE_H
+#define SINGLEINSTANCE_H
+
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+class QLocalServer;
+class QLocalSocket;
+
+// 단일 인스턴스 관리
+// 이미 실행 중인 플레이어가 있으면 로컬 소켓으로 파일 목록을 넘기고 새 프로세스는 바로 종료한다.
+// 프로토콜: 클라이언트가 UTF-8 절대 경로를 한 줄씩 보내고 빈 줄로 끝내면 서버가 "OK\n"로 응답
+class SingleInstance : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SingleInstance(QObject *parent = nullptr);
+    ~SingleInstance();
+
+    // 실행 중인 인스턴스에 파일 전달 (응답까지 확인되면 true, 응답이 없으면 false - 직접 실행해야 함)
+    // 주 인스턴스가 아직 QML을 불러오는 중이면 응답이 늦으므로 응답 대기 시간은 연결 대기보다 길게 둔다
+    static bool forwardToPrimary(const QStringList& files, int connectTimeoutMs = 200, int replyTimeoutMs = 2000);
+
+    // 주 인스턴스로 등록 (다른 프로세스가 먼저 등록한 경우 false)
+    bool listen();
+
+    // 사용자별 서버 이름
+    static QString serverName();
+
+signals:
+    // 짧은 시간 안에 연달아 들어온 요청은 하나로 묶어서 전달 (파일 없이 실행된 경우 빈 목록)
+    void filesReceived(const QStringList& files);
+
+private slots:
+    void onNewConnection();
+    void flushPending();
+
+private:
+    void readRequest(QLocalSocket* socket);
+
+    QLocalServer* m_server = nullptr;
+    QStringList m_pendingFiles;
+    bool m_requestPending = false;
+    QTimer m_burstTimer;
+};
+
+#endif // SINGLEINSTANCE_H
@@ -0,0 +1,109 @@
+#include "startuptimeline.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace StartupTimeline {
+
+namespace {
+
+struct Stage {
+    const char* name;
+    qint64 ms;
+};
+
+// 정적 초기화 시점에 시작 - main() 진입 전 단계(DLL 로드 등)도 포함됨
+QElapsedTimer& processTimer()
+{
+    static QElapsedTimer timer = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+const bool g_timerStarted = (processTimer(), true);
+
+std::mutex g_mutex;
+std::vector<Stage> g_stages;
+std::atomic<bool> g_firstFrameSeen{false};
+
+} // namespace
+
+qint64 elapsedMs()
+{
+    return processTimer().elapsed();
+}
+
+void mark(const char* stage)
+{
+    const qint64 ms = elapsedMs();
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (const Stage& existing : g_stages) {
+            if (std::strcmp(existing.name, stage) == 0) {
+                return;
+            }
+        }
+        g_stages.push_back({stage, ms});
+    }
+    qInfo().nospace() << "Startup: " << stage << " +" << ms << " ms";
+}
+
+bool hasStage(const char* stage)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    for (const Stage& existing : g_stages) {
+        if (std::strcmp(existing.name, stage) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QByteArray toJson()
+{
+    QJsonArray stages;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (const Stage& stage : g_stages) {
+            QJsonObject entry;
+            entry["name"] = QString::fromLatin1(stage.name);
+            entry["ms"] = stage.ms;
+            stages.append(entry);
+        }
+    }
+
+    QJsonObject root;
+    root["stages"] = stages;
+    root["totalMs"] = elapsedMs();
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+void markFirstFrame()
+{
+    if (g_firstFrameSeen.exchange(true)) {
+        return;
+    }
+    mark("first frame");
+
+    QStringList parts;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (const Stage& stage : g_stages) {
+            parts << QString("%1=%2ms").arg(stage.name).arg(stage.ms);
+        }
+    }
+    qInfo().noquote() << "Startup timeline:" << parts.join(", ");
+}
+
+} // namespace StartupTimeline
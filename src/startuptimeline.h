@@ -0,0 +1,29 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+// 시작 시간 측정
+// 프로세스 시작(정적 초기화 시점)부터 각 단계까지의 경과 시간을 기록하고,
+// 첫 프레임이 표시되면 전체 타임라인을 한 줄로 로그에 남긴다.
+namespace StartupTimeline {
+
+// 단계 기록 (같은 이름은 처음 한 번만 기록, 어느 스레드에서나 호출 가능)
+void mark(const char* stage);
+
+// 첫 프레임 표시 - 렌더 스레드에서 매 프레임 호출해도 최초 한 번만 처리
+void markFirstFrame();
+
+// 프로세스 시작 후 경과 시간 (ms)
+qint64 elapsedMs();
+
+// 해당 단계가 기록되었는지 확인
+bool hasStage(const char* stage);
+
+// 시작 벤치마크 출력용 JSON ({"stages":[{"name":..., "ms":...}], "totalMs":...})
+QByteArray toJson();
+
+} // namespace StartupTimeline
+
+#endif // STARTUPTIMELINE_H
@@ -0,0 +1,137 @@
+#include "testclip.h"
+#include "mpvheadless.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+QString TestClip::Spec::fileName() const
+{
+    return QString("%1.%2").arg(name, container);
+}
+
+QList<TestClip::Spec> TestClip::defaultSpecs()
+{
+    // 이름, 코덱, 컨테이너, 크기, 프레임레이트, GOP, 길이
+    return {
+        {"h264_gop12_23976", "libx264", "mp4", 640, 360, 24000, 1001, 12, 20.0},
+        {"h264_gop120_2997", "libx264", "mp4", 640, 360, 30000, 1001, 120, 20.0},
+        {"h264_gop60_5994", "libx264", "mkv", 640, 360, 60000, 1001, 60, 20.0},
+        {"mpeg2_gop15_25", "mpeg2video", "mkv", 640, 360, 25, 1, 15, 20.0},
+        {"mjpeg_intra_24", "mjpeg", "mkv", 640, 360, 24, 1, 1, 20.0},
+    };
+}
+
+QString TestClip::sourceGraph(const Spec& spec)
+{
+    // 상단 1/8 띠를 24칸으로 나누고, N(프레임 번호)의 k번째 비트가 1이면 k번째 칸을 흰색으로 칠함
+    const QString band = "lt(Y,H/8)";
+    const QString lum = QString("if(%1,if(bitand(N,pow(2,floor(X*%2/W))),235,16),lum(X,Y))")
+                            .arg(band).arg(kBarcodeBits);
+
+    return QString("testsrc2=size=%1x%2:rate=%3/%4:duration=%5,format=yuv420p,"
+                   "geq=lum='%6':cb='if(%7,128,cb(X,Y))':cr='if(%7,128,cr(X,Y))'")
+        .arg(spec.width).arg(spec.height)
+        .arg(spec.rateNum).arg(spec.rateDen)
+        .arg(spec.seconds, 0, 'f', 3)
+        .arg(lum, band);
+}
+
+QString TestClip::ensure(const Spec& spec, const QString& outputDir, QString* error)
+{
+    QDir dir(outputDir);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        if (error) *error = QString("Cannot create directory %1").arg(outputDir);
+        return QString();
+    }
+
+    const QString path = dir.filePath(spec.fileName());
+    if (QFileInfo(path).size() > 0) {
+        return path;
+    }
+
+    return generate(spec, path, error) ? path : QString();
+}
+
+bool TestClip::generate(const Spec& spec, const QString& path, QString* error)
+{
+    mpv_handle* mpv = createHeadlessMpv();
+    if (!mpv) {
+        if (error) *error = "Failed to create MPV instance";
+        return false;
+    }
+
+    QString codecOptions = QString("g=%1").arg(spec.gop);
+    if (spec.codec == "libx264") {
+        codecOptions += ",preset=veryfast";
+    }
+
+    mpv_set_option_string(mpv, "o", QDir::toNativeSeparators(path).toUtf8().constData());
+    mpv_set_option_string(mpv, "ovc", spec.codec.toUtf8().constData());
+    mpv_set_option_string(mpv, "ovcopts", codecOptions.toUtf8().constData());
+    mpv_set_option_string(mpv, "aid", "no");
+
+    if (mpv_initialize(mpv) < 0) {
+        if (error) *error = "Failed to initialize MPV encoder";
+        mpv_terminate_destroy(mpv);
+        return false;
+    }
+
+    const QByteArray url = ("av://lavfi:" + sourceGraph(spec)).toUtf8();
+    const char* cmd[] = {"loadfile", url.constData(), nullptr};
+    if (mpv_command(mpv, cmd) < 0) {
+        if (error) *error = "loadfile failed for test source";
+        mpv_terminate_destroy(mpv);
+        return false;
+    }
+
+    qDebug() << "TestClip: encoding" << spec.name << "->" << path;
+
+    bool success = false;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < 300000) {
+        mpv_event* event = mpv_wait_event(mpv, 1.0);
+        if (event->event_id == MPV_EVENT_END_FILE) {
+            mpv_event_end_file* endFile = static_cast<mpv_event_end_file*>(event->data);
+            success = endFile->reason == MPV_END_FILE_REASON_EOF;
+            if (!success && error) {
+                *error = QString("Encoding failed: %1").arg(mpv_error_string(endFile->error));
+            }
+            break;
+        }
+        if (event->event_id == MPV_EVENT_SHUTDOWN) {
+            break;
+        }
+    }
+
+    // 종료 시 먹서가 파일을 마무리한다
+    mpv_terminate_destroy(mpv);
+
+    if (!success) {
+        QFile::remove(path);
+        qWarning() << "TestClip: failed to encode" << spec.name;
+    }
+    return success;
+}
+
+int TestClip::decodeFrameIndex(const unsigned char* pixels, int width, int height, int stride)
+{
+    if (!pixels || width < kBarcodeBits || height < 16) {
+        return -1;
+    }
+
+    // 띠의 세로 중앙 줄에서 각 칸의 중앙 픽셀 밝기를 읽음
+    const unsigned char* row = pixels + size_t(height / 16) * size_t(stride);
+    int index = 0;
+    for (int bit = 0; bit < kBarcodeBits; ++bit) {
+        const int x = int((bit + 0.5) * width / kBarcodeBits);
+        const unsigned char* pixel = row + x * 4;
+        const int luma = (pixel[0] + pixel[1] * 2 + pixel[2]) / 4;
+        if (luma > 128) {
+            index |= 1 << bit;
+        }
+    }
+    return index;
+}
@@ -0,0 +1,45 @@
+#ifndef TESTCLIP_H
+#define TESTCLIP_H
+
+#include <QList>
+#include <QString>
+
+// 벤치마크/튜닝용 테스트 클립 생성기
+// libmpv로 av://lavfi:testsrc2 영상을 인코딩하면서 화면 상단 띠에 프레임 번호를 24비트 바코드로 새겨 넣는다.
+// 디코딩된 프레임에서 바코드를 읽으면 실제로 표시된 프레임 번호를 확인할 수 있다.
+class TestClip
+{
+public:
+    struct Spec {
+        QString name;          // 파일 이름에 쓰이는 식별자
+        QString codec;         // ovc 값 (libx264, mpeg2video, mjpeg, ...)
+        QString container;     // 확장자 (mp4, mkv, mov, ...)
+        int width = 640;
+        int height = 360;
+        int rateNum = 24000;   // 프레임레이트 (분수)
+        int rateDen = 1001;
+        int gop = 24;          // 키프레임 간격 (1 = 인트라 전용)
+        double seconds = 20.0;
+
+        double fps() const { return double(rateNum) / rateDen; }
+        int frameCount() const { return int(seconds * rateNum / rateDen); }
+        QString fileName() const;
+    };
+
+    static const int kBarcodeBits = 24;
+
+    // 코덱, GOP 길이, 프레임레이트 조합의 기본 클립 목록
+    static QList<Spec> defaultSpecs();
+
+    // outputDir에 클립 생성 (이미 있으면 재사용), 생성된 파일 경로 반환 - 실패 시 빈 문자열
+    static QString ensure(const Spec& spec, const QString& outputDir, QString* error = nullptr);
+    static bool generate(const Spec& spec, const QString& path, QString* error = nullptr);
+
+    // lavfi 소스 그래프 (프레임 번호 바코드 포함)
+    static QString sourceGraph(const Spec& spec);
+
+    // RGB0/RGBA 버퍼에서 바코드를 읽어 프레임 번호 반환 (읽을 수 없으면 -1)
+    static int decodeFrameIndex(const unsigned char* pixels, int width, int height, int stride);
+};
+
+#endif // TESTCLIP_H
@@ -0,0 +1,402 @@
+#include "timelineitem.h"
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QVariantMap>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+static_assert(sizeof(TimelineLayout::Point) == sizeof(QSGGeometry::Point2D),
+              "TimelineLayout::Point must match QSGGeometry::Point2D");
+
+// 자식 노드 순서 (뒤에서 앞으로)
+enum NodeIndex {
+    WaveformRangeNode = 0,
+    WaveformRmsNode,
+    HeatmapLowNode,
+    HeatmapMidNode,
+    HeatmapHighNode,
+    MinorTickNode,
+    MajorTickNode,
+    KeyframeNode,
+    CachedRangeNode,
+    NodeCount
+};
+
+// 파형 표시 투명도 (최소~최대 / RMS)
+constexpr double kWaveformRangeAlpha = 0.35;
+constexpr double kWaveformRmsAlpha = 0.6;
+constexpr double kRangeAlpha = 0.6;
+
+// 키프레임 지도 시크 비용 단계별 투명도 (키프레임 근처 / 중간 / 1초 이상 디코딩)
+constexpr int kHeatmapLevels = 3;
+constexpr double kHeatmapAlpha[kHeatmapLevels] = {0.2, 0.5, 0.9};
+
+QSGGeometryNode* createNode(QSGGeometry::DrawingMode mode)
+{
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+    geometry->setLineWidth(1.0f);
+
+    auto* node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGFlatColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+void setVertices(QSGGeometryNode* node, const std::vector<TimelineLayout::Point>& points)
+{
+    QSGGeometry* geometry = node->geometry();
+    geometry->allocate(int(points.size()));
+    if (!points.empty()) {
+        std::memcpy(geometry->vertexDataAsPoint2D(), points.data(), points.size() * sizeof(TimelineLayout::Point));
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void setColor(QSGGeometryNode* node, QColor color, double alpha)
+{
+    color.setAlphaF(color.alphaF() * alpha);
+    auto* material = static_cast<QSGFlatColorMaterial*>(node->material());
+    if (material->color() != color) {
+        material->setColor(color);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+} // namespace
+
+TimelineItem::TimelineItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void TimelineItem::setTotalFrames(int frames)
+{
+    if (m_totalFrames == frames) {
+        return;
+    }
+    m_totalFrames = frames;
+    emit totalFramesChanged();
+    markDirty(TicksDirty | RangesDirty | WaveformDirty | HeatmapDirty);
+}
+
+void TimelineItem::setFps(double fps)
+{
+    if (qFuzzyCompare(m_fps, fps)) {
+        return;
+    }
+    m_fps = fps;
+    emit fpsChanged();
+    markDirty(TicksDirty | RangesDirty | WaveformDirty);
+}
+
+void TimelineItem::setTickTopMargin(double margin)
+{
+    if (qFuzzyCompare(m_tickTopMargin, margin)) {
+        return;
+    }
+    m_tickTopMargin = margin;
+    emit layoutChanged();
+    markDirty(TicksDirty | WaveformDirty | HeatmapDirty);
+}
+
+void TimelineItem::setTickBottomMargin(double margin)
+{
+    if (qFuzzyCompare(m_tickBottomMargin, margin)) {
+        return;
+    }
+    m_tickBottomMargin = margin;
+    emit layoutChanged();
+    markDirty(TicksDirty | WaveformDirty);
+}
+
+void TimelineItem::setRangeHeight(double height)
+{
+    if (qFuzzyCompare(m_rangeHeight, height)) {
+        return;
+    }
+    m_rangeHeight = height;
+    emit layoutChanged();
+    markDirty(RangesDirty);
+}
+
+void TimelineItem::setHeatmapHeight(double height)
+{
+    if (qFuzzyCompare(m_heatmapHeight, height)) {
+        return;
+    }
+    m_heatmapHeight = height;
+    emit layoutChanged();
+    markDirty(HeatmapDirty);
+}
+
+void TimelineItem::setFrameColor(const QColor& color)
+{
+    if (m_frameColor != color) {
+        m_frameColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setMajorFrameColor(const QColor& color)
+{
+    if (m_majorFrameColor != color) {
+        m_majorFrameColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setRangeColor(const QColor& color)
+{
+    if (m_rangeColor != color) {
+        m_rangeColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setWaveformColor(const QColor& color)
+{
+    if (m_waveformColor != color) {
+        m_waveformColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setHeatmapColor(const QColor& color)
+{
+    if (m_heatmapColor != color) {
+        m_heatmapColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setKeyframeColor(const QColor& color)
+{
+    if (m_keyframeColor != color) {
+        m_keyframeColor = color;
+        emit colorsChanged();
+        markDirty(ColorsDirty);
+    }
+}
+
+void TimelineItem::setCachedRanges(const QVariantList& ranges)
+{
+    if (m_cachedRanges == ranges) {
+        return;
+    }
+    m_cachedRanges = ranges;
+    emit cachedRangesChanged();
+    markDirty(RangesDirty);
+}
+
+void TimelineItem::setWaveform(QObject* waveform)
+{
+    if (m_waveform == waveform) {
+        return;
+    }
+    if (m_waveform) {
+        disconnect(m_waveform, nullptr, this, nullptr);
+    }
+    m_waveform = waveform;
+    if (m_waveform) {
+        // 분석기 타입을 알 필요 없이 peaksChanged() 시그널만 있으면 연결
+        connect(m_waveform, SIGNAL(peaksChanged()), this, SLOT(onPeaksChanged()));
+    }
+    emit waveformChanged();
+    markDirty(WaveformDirty);
+}
+
+void TimelineItem::onPeaksChanged()
+{
+    markDirty(WaveformDirty);
+}
+
+void TimelineItem::setKeyframeMap(QObject* map)
+{
+    if (m_keyframeMap == map) {
+        return;
+    }
+    if (m_keyframeMap) {
+        disconnect(m_keyframeMap, nullptr, this, nullptr);
+    }
+    m_keyframeMap = map;
+    if (m_keyframeMap) {
+        connect(m_keyframeMap, SIGNAL(mapChanged()), this, SLOT(onMapChanged()));
+    }
+    emit keyframeMapChanged();
+    markDirty(HeatmapDirty);
+}
+
+void TimelineItem::onMapChanged()
+{
+    markDirty(HeatmapDirty);
+}
+
+void TimelineItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        markDirty(TicksDirty | RangesDirty | WaveformDirty | HeatmapDirty);
+    }
+}
+
+void TimelineItem::markDirty(int flags)
+{
+    m_dirty |= flags;
+    polish();
+}
+
+void TimelineItem::updatePolish()
+{
+    // 눈금 간격과 라벨 위치 (QML 라벨 Repeater에 알려야 하므로 GUI 스레드에서 계산)
+    if (m_dirty & TicksDirty) {
+        m_steps = TimelineLayout::chooseSteps(m_totalFrames, m_fps, width());
+
+        QVariantList labels;
+        const QVector<int> frames = TimelineLayout::labelFrames(m_steps, m_totalFrames);
+        labels.reserve(frames.size());
+        for (int frame : frames) {
+            labels.append(frame);
+        }
+        if (labels != m_labelFrames) {
+            m_labelFrames = labels;
+            emit labelFramesChanged();
+        }
+    }
+
+    if (m_dirty & RangesDirty) {
+        m_ranges.clear();
+        for (const QVariant& value : m_cachedRanges) {
+            const QVariantMap range = value.toMap();
+            m_ranges.append(qMakePair(range.value("start").toDouble(), range.value("end").toDouble()));
+        }
+    }
+
+    // 파형 피크는 화면 폭만큼만 요청
+    if (m_dirty & WaveformDirty) {
+        m_peaks.clear();
+        const int columns = int(width());
+        if (m_waveform && m_waveform->property("ready").toBool() && m_totalFrames > 0 && m_fps > 0 && columns > 0) {
+            QVariantList peaks;
+            QMetaObject::invokeMethod(m_waveform, "peaks", Q_RETURN_ARG(QVariantList, peaks),
+                                      Q_ARG(double, 0.0), Q_ARG(double, m_totalFrames / m_fps),
+                                      Q_ARG(int, columns));
+            if (peaks.size() >= columns * 3) {
+                m_peaks.resize(size_t(columns) * 3);
+                for (int i = 0; i < columns * 3; ++i) {
+                    m_peaks[i] = peaks[i].toFloat();
+                }
+            }
+        }
+    }
+
+    // 키프레임 지도도 화면 폭만큼만 (프레임 번호는 눈금과 같은 0..totalFrames)
+    if (m_dirty & HeatmapDirty) {
+        m_heatmap.clear();
+        const int columns = int(width());
+        if (m_keyframeMap && m_heatmapHeight > 0 && m_keyframeMap->property("ready").toBool()
+            && m_totalFrames > 0 && columns > 0) {
+            QVariantList cells;
+            QMetaObject::invokeMethod(m_keyframeMap, "heatmap", Q_RETURN_ARG(QVariantList, cells),
+                                      Q_ARG(int, 0), Q_ARG(int, m_totalFrames), Q_ARG(int, columns));
+            if (cells.size() >= columns * 3) {
+                m_heatmap.resize(size_t(columns) * 3);
+                for (int i = 0; i < columns * 3; ++i) {
+                    m_heatmap[i] = cells[i].toFloat();
+                }
+            }
+        }
+    }
+
+    update();
+}
+
+QSGNode* TimelineItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+    QSGNode* root = oldNode;
+    if (!root) {
+        root = new QSGNode;
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // WaveformRangeNode
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // WaveformRmsNode
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // HeatmapLowNode
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // HeatmapMidNode
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // HeatmapHighNode
+        root->appendChildNode(createNode(QSGGeometry::DrawLines));     // MinorTickNode
+        root->appendChildNode(createNode(QSGGeometry::DrawLines));     // MajorTickNode
+        root->appendChildNode(createNode(QSGGeometry::DrawLines));     // KeyframeNode
+        root->appendChildNode(createNode(QSGGeometry::DrawTriangles)); // CachedRangeNode
+        // 새 노드에는 polish에서 준비해 둔 눈금/구간/피크/지도를 모두 채움
+        m_dirty |= TicksDirty | RangesDirty | WaveformDirty | ColorsDirty | HeatmapDirty;
+    }
+
+    QSGGeometryNode* nodes[NodeCount];
+    for (int i = 0; i < NodeCount; ++i) {
+        nodes[i] = static_cast<QSGGeometryNode*>(root->childAtIndex(i));
+    }
+
+    const double tickHeight = std::max(0.0, height() - m_tickTopMargin - m_tickBottomMargin);
+
+    if (m_dirty & TicksDirty) {
+        std::vector<TimelineLayout::Point> minorLines;
+        std::vector<TimelineLayout::Point> majorLines;
+        TimelineLayout::appendTicks(minorLines, majorLines, m_steps, m_totalFrames, width(),
+                                    m_tickTopMargin, tickHeight);
+        setVertices(nodes[MinorTickNode], minorLines);
+        setVertices(nodes[MajorTickNode], majorLines);
+    }
+
+    if (m_dirty & RangesDirty) {
+        std::vector<TimelineLayout::Point> triangles;
+        TimelineLayout::appendRanges(triangles, m_ranges, m_fps, m_totalFrames, width(),
+                                     height() - m_rangeHeight, m_rangeHeight);
+        setVertices(nodes[CachedRangeNode], triangles);
+    }
+
+    if (m_dirty & WaveformDirty) {
+        std::vector<TimelineLayout::Point> range;
+        std::vector<TimelineLayout::Point> rms;
+        TimelineLayout::appendWaveform(range, rms, m_peaks.empty() ? nullptr : m_peaks.data(),
+                                       int(m_peaks.size() / 3), m_tickTopMargin, tickHeight);
+        setVertices(nodes[WaveformRangeNode], range);
+        setVertices(nodes[WaveformRmsNode], rms);
+    }
+
+    if (m_dirty & HeatmapDirty) {
+        // 지도 띠는 눈금 위 여백(tickTopMargin)의 아래쪽에 그림 - 눈금과 겹치지 않음
+        const double heatmapHeight = std::min(m_heatmapHeight, m_tickTopMargin);
+        std::vector<TimelineLayout::Point> levels[kHeatmapLevels];
+        std::vector<TimelineLayout::Point> keyframes;
+        TimelineLayout::appendHeatmap(levels, kHeatmapLevels, keyframes,
+                                      m_heatmap.empty() ? nullptr : m_heatmap.data(),
+                                      int(m_heatmap.size() / 3),
+                                      m_tickTopMargin - heatmapHeight, heatmapHeight);
+        for (int i = 0; i < kHeatmapLevels; ++i) {
+            setVertices(nodes[HeatmapLowNode + i], levels[i]);
+        }
+        setVertices(nodes[KeyframeNode], keyframes);
+    }
+
+    if (m_dirty & ColorsDirty) {
+        setColor(nodes[WaveformRangeNode], m_waveformColor, kWaveformRangeAlpha);
+        setColor(nodes[WaveformRmsNode], m_waveformColor, kWaveformRmsAlpha);
+        for (int i = 0; i < kHeatmapLevels; ++i) {
+            setColor(nodes[HeatmapLowNode + i], m_heatmapColor, kHeatmapAlpha[i]);
+        }
+        setColor(nodes[KeyframeNode], m_keyframeColor, 1.0);
+        setColor(nodes[MinorTickNode], m_frameColor, 1.0);
+        setColor(nodes[MajorTickNode], m_majorFrameColor, 1.0);
+        setColor(nodes[CachedRangeNode], m_rangeColor, kRangeAlpha);
+    }
+
+    m_dirty = 0;
+    return root;
+}
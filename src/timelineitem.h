@@ -0,0 +1,136 @@
+#ifndef TIMELINEITEM_H
+#define TIMELINEITEM_H
+
+#include "timelinelayout.h"
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QVariantList>
+#include <vector>
+
+// 타임라인 눈금/캐시 구간/오디오 파형/키프레임 지도를 씬 그래프 정점으로 그리는 아이템 (FrameTimelineBar 배경)
+// - 프레임 수, fps, 크기, 구간, 파형, 지도가 바뀔 때만 정점을 다시 만든다 (재생 중 프레임마다 다시 그리지 않음)
+// - 눈금 간격은 TimelineLayout이 화면 폭에 맞춰 고르므로 정점 수가 클립 길이와 관계없이 일정
+// - 라벨 텍스트는 labelFrames를 QML Repeater로 표시
+class TimelineItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(int totalFrames READ totalFrames WRITE setTotalFrames NOTIFY totalFramesChanged)
+    Q_PROPERTY(double fps READ fps WRITE setFps NOTIFY fpsChanged)
+    Q_PROPERTY(double tickTopMargin READ tickTopMargin WRITE setTickTopMargin NOTIFY layoutChanged)
+    Q_PROPERTY(double tickBottomMargin READ tickBottomMargin WRITE setTickBottomMargin NOTIFY layoutChanged)
+    Q_PROPERTY(double rangeHeight READ rangeHeight WRITE setRangeHeight NOTIFY layoutChanged)
+    Q_PROPERTY(double heatmapHeight READ heatmapHeight WRITE setHeatmapHeight NOTIFY layoutChanged)
+    Q_PROPERTY(QColor frameColor READ frameColor WRITE setFrameColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor majorFrameColor READ majorFrameColor WRITE setMajorFrameColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor rangeColor READ rangeColor WRITE setRangeColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor waveformColor READ waveformColor WRITE setWaveformColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor heatmapColor READ heatmapColor WRITE setHeatmapColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor keyframeColor READ keyframeColor WRITE setKeyframeColor NOTIFY colorsChanged)
+    Q_PROPERTY(QVariantList cachedRanges READ cachedRanges WRITE setCachedRanges NOTIFY cachedRangesChanged)
+    Q_PROPERTY(QObject* waveform READ waveform WRITE setWaveform NOTIFY waveformChanged)
+    Q_PROPERTY(QObject* keyframeMap READ keyframeMap WRITE setKeyframeMap NOTIFY keyframeMapChanged)
+    Q_PROPERTY(QVariantList labelFrames READ labelFrames NOTIFY labelFramesChanged)
+
+public:
+    explicit TimelineItem(QQuickItem *parent = nullptr);
+
+    int totalFrames() const { return m_totalFrames; }
+    void setTotalFrames(int frames);
+    double fps() const { return m_fps; }
+    void setFps(double fps);
+
+    double tickTopMargin() const { return m_tickTopMargin; }
+    void setTickTopMargin(double margin);
+    double tickBottomMargin() const { return m_tickBottomMargin; }
+    void setTickBottomMargin(double margin);
+    double rangeHeight() const { return m_rangeHeight; }
+    void setRangeHeight(double height);
+    // 눈금 영역 위쪽 키프레임 지도 띠 높이 (0이면 표시하지 않음)
+    double heatmapHeight() const { return m_heatmapHeight; }
+    void setHeatmapHeight(double height);
+
+    QColor frameColor() const { return m_frameColor; }
+    void setFrameColor(const QColor& color);
+    QColor majorFrameColor() const { return m_majorFrameColor; }
+    void setMajorFrameColor(const QColor& color);
+    QColor rangeColor() const { return m_rangeColor; }
+    void setRangeColor(const QColor& color);
+    QColor waveformColor() const { return m_waveformColor; }
+    void setWaveformColor(const QColor& color);
+    QColor heatmapColor() const { return m_heatmapColor; }
+    void setHeatmapColor(const QColor& color);
+    QColor keyframeColor() const { return m_keyframeColor; }
+    void setKeyframeColor(const QColor& color);
+
+    // 캐시된 구간 [{start, end}] (초)
+    QVariantList cachedRanges() const { return m_cachedRanges; }
+    void setCachedRanges(const QVariantList& ranges);
+
+    // AudioWaveformAnalyzer (ready, peaks(start, end, count), peaksChanged())
+    QObject* waveform() const { return m_waveform; }
+    void setWaveform(QObject* waveform);
+
+    // KeyframeMap (ready, heatmap(startFrame, endFrame, count), mapChanged())
+    QObject* keyframeMap() const { return m_keyframeMap; }
+    void setKeyframeMap(QObject* map);
+
+    QVariantList labelFrames() const { return m_labelFrames; }
+
+signals:
+    void totalFramesChanged();
+    void fpsChanged();
+    void layoutChanged();
+    void colorsChanged();
+    void cachedRangesChanged();
+    void waveformChanged();
+    void keyframeMapChanged();
+    void labelFramesChanged();
+
+protected:
+    void updatePolish() override;
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private slots:
+    void onPeaksChanged();
+    void onMapChanged();
+
+private:
+    enum Dirty {
+        TicksDirty = 0x1,
+        RangesDirty = 0x2,
+        WaveformDirty = 0x4,
+        ColorsDirty = 0x8,
+        HeatmapDirty = 0x10
+    };
+
+    void markDirty(int flags);
+
+    int m_totalFrames = 0;
+    double m_fps = 24.0;
+    double m_tickTopMargin = 3.0;
+    double m_tickBottomMargin = 12.0;
+    double m_rangeHeight = 2.0;
+    // 키프레임 지도 띠 높이 (tickTopMargin 안, 눈금 바로 위)
+    double m_heatmapHeight = 0.0;
+    QColor m_frameColor = QColor(0x55, 0x55, 0x55);
+    QColor m_majorFrameColor = QColor(0x88, 0x88, 0x88);
+    QColor m_rangeColor = QColor(0x00, 0xB8, 0xFF);
+    QColor m_waveformColor = QColor(0x00, 0xB8, 0xFF);
+    QColor m_heatmapColor = QColor(0xFF, 0x9F, 0x0A);
+    QColor m_keyframeColor = QColor(0xE0, 0xE0, 0xE0);
+    QVariantList m_cachedRanges;
+    QPointer<QObject> m_waveform;
+    QPointer<QObject> m_keyframeMap;
+    QVariantList m_labelFrames;
+
+    // updatePolish(GUI 스레드)에서 준비하고 updatePaintNode(렌더 스레드, GUI 대기 중)에서 정점으로 변환
+    int m_dirty = TicksDirty | RangesDirty | WaveformDirty | ColorsDirty | HeatmapDirty;
+    TimelineLayout::Steps m_steps;
+    QVector<QPair<double, double>> m_ranges;
+    std::vector<float> m_peaks;
+    std::vector<float> m_heatmap;
+};
+
+#endif // TIMELINEITEM_H
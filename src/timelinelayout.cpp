@@ -0,0 +1,207 @@
+#include "timelinelayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace TimelineLayout {
+
+namespace {
+
+// 초 단위 후보 (초)
+const int kSecondSteps[] = {1, 2, 5, 10, 15, 30, 60, 120, 300, 600, 900, 1800, 3600};
+
+// 후보 간격 목록을 작은 순서로 돌며 조건에 맞는 첫 값을 반환 (없으면 0)
+template <typename Predicate>
+int firstCandidate(int totalFrames, double fps, Predicate accept)
+{
+    const int frameSteps[] = {1, 2, 5, 10};
+    for (int step : frameSteps) {
+        if (accept(step)) {
+            return step;
+        }
+    }
+
+    const int framesPerSecond = std::max(1, int(std::lround(fps)));
+    int last = 10;
+    for (int seconds : kSecondSteps) {
+        const int step = framesPerSecond * seconds;
+        if (step > last && accept(step)) {
+            return step;
+        }
+        last = std::max(last, step);
+    }
+
+    // 한 시간보다 긴 간격은 두 배씩
+    for (qint64 step = qint64(last) * 2; step <= qint64(totalFrames) * 2 && step < (qint64(1) << 30); step *= 2) {
+        if (accept(int(step))) {
+            return int(step);
+        }
+    }
+    return 0;
+}
+
+// base의 배수 중 minimum 이상인 가장 작은 값 (배수는 1, 2, 4, 5, 10, 20, 40, 50, ...)
+int niceMultiple(int base, double minimum)
+{
+    const int factors[] = {1, 2, 4, 5};
+    for (qint64 scale = 1; scale < (qint64(1) << 30); scale *= 10) {
+        for (int factor : factors) {
+            const qint64 step = qint64(base) * factor * scale;
+            if (step >= minimum || step >= (qint64(1) << 30)) {
+                return int(std::min<qint64>(step, qint64(1) << 30));
+            }
+        }
+    }
+    return base;
+}
+
+} // namespace
+
+Steps chooseSteps(int totalFrames, double fps, double width)
+{
+    Steps steps;
+    if (totalFrames <= 0 || width <= 0) {
+        return steps;
+    }
+    const double scale = width / totalFrames;
+
+    steps.minor = firstCandidate(totalFrames, fps, [&](int step) {
+        return step * scale >= kMinTickSpacing;
+    });
+    if (steps.minor <= 0) {
+        steps.minor = niceMultiple(1, kMinTickSpacing / scale);
+    }
+
+    // 긴 눈금은 짧은 눈금 4~10개마다 (후보가 맞지 않으면 5개마다)
+    steps.major = firstCandidate(totalFrames, fps, [&](int step) {
+        return step % steps.minor == 0 && step >= steps.minor * 4 && step <= steps.minor * 10;
+    });
+    if (steps.major <= 0) {
+        steps.major = steps.minor * 5;
+    }
+
+    // 라벨은 긴 눈금 위에만 - 후보가 너무 멀면 긴 눈금 간격의 배수로
+    steps.label = firstCandidate(totalFrames, fps, [&](int step) {
+        return step % steps.major == 0 && step * scale >= kMinLabelSpacing
+            && step * scale <= kMinLabelSpacing * 4;
+    });
+    if (steps.label <= 0) {
+        steps.label = niceMultiple(steps.major, kMinLabelSpacing / scale);
+    }
+    return steps;
+}
+
+void appendTicks(std::vector<Point>& minorLines, std::vector<Point>& majorLines,
+                 const Steps& steps, int totalFrames, double width, double top, double height)
+{
+    if (totalFrames <= 0 || width <= 0 || steps.minor <= 0) {
+        return;
+    }
+    const double scale = width / totalFrames;
+    const size_t count = size_t(totalFrames / steps.minor) + 1;
+    minorLines.reserve(minorLines.size() + count * 2);
+    majorLines.reserve(majorLines.size() + (count / std::max(1, steps.major / steps.minor) + 1) * 2);
+
+    const float minorBottom = float(top + height * 0.4);
+    const float majorBottom = float(top + height * 0.75);
+    for (int frame = 0; frame < totalFrames; frame += steps.minor) {
+        // 픽셀 중앙에 맞춰 1픽셀 선이 흐려지지 않게 함
+        const float x = float(std::floor(frame * scale) + 0.5);
+        if (frame % steps.major == 0) {
+            majorLines.push_back({x, float(top)});
+            majorLines.push_back({x, majorBottom});
+        } else {
+            minorLines.push_back({x, float(top)});
+            minorLines.push_back({x, minorBottom});
+        }
+    }
+}
+
+QVector<int> labelFrames(const Steps& steps, int totalFrames)
+{
+    QVector<int> frames;
+    if (totalFrames <= 0 || steps.label <= 0) {
+        return frames;
+    }
+    frames.reserve(totalFrames / steps.label + 1);
+    for (int frame = 0; frame < totalFrames; frame += steps.label) {
+        frames.append(frame);
+    }
+    return frames;
+}
+
+void appendRect(std::vector<Point>& triangles, double x, double y, double w, double h)
+{
+    const float left = float(x);
+    const float right = float(x + w);
+    const float top = float(y);
+    const float bottom = float(y + h);
+    triangles.push_back({left, top});
+    triangles.push_back({right, top});
+    triangles.push_back({left, bottom});
+    triangles.push_back({right, top});
+    triangles.push_back({right, bottom});
+    triangles.push_back({left, bottom});
+}
+
+void appendRanges(std::vector<Point>& triangles, const QVector<QPair<double, double>>& ranges,
+                  double fps, int totalFrames, double width, double y, double height)
+{
+    if (totalFrames <= 0 || fps <= 0 || width <= 0) {
+        return;
+    }
+    const double pixelsPerSecond = fps * width / totalFrames;
+    for (const auto& range : ranges) {
+        const double left = std::max(0.0, range.first * pixelsPerSecond);
+        const double right = std::min(width, range.second * pixelsPerSecond);
+        if (left >= width || right <= 0.0) {
+            continue;
+        }
+        appendRect(triangles, left, y, std::max(1.0, right - left), height);
+    }
+}
+
+void appendWaveform(std::vector<Point>& range, std::vector<Point>& rms,
+                    const float* peaks, int columns, double top, double height)
+{
+    if (!peaks || columns <= 0) {
+        return;
+    }
+    range.reserve(range.size() + size_t(columns) * 6);
+    rms.reserve(rms.size() + size_t(columns) * 6);
+
+    const double mid = top + height / 2.0;
+    const double half = height / 2.0;
+    for (int i = 0; i < columns; ++i) {
+        const float* peak = peaks + i * 3;
+        const double upper = mid - peak[1] * half;
+        const double lower = mid - peak[0] * half;
+        appendRect(range, i, upper, 1.0, std::max(1.0, lower - upper));
+
+        const double level = peak[2] * half;
+        appendRect(rms, i, mid - level, 1.0, std::max(1.0, level * 2.0));
+    }
+}
+
+void appendHeatmap(std::vector<Point>* levels, int levelCount, std::vector<Point>& keyframeLines,
+                   const float* cells, int columns, double top, double height)
+{
+    if (!levels || levelCount <= 0 || !cells || columns <= 0) {
+        return;
+    }
+
+    const double bottom = top + height;
+    for (int i = 0; i < columns; ++i) {
+        const float* cell = cells + i * 3;
+        // 비트레이트가 낮아도 시크 비용은 보이도록 최소 1/4 높이
+        const double barHeight = height * std::max(0.25, double(cell[0]));
+        const int level = std::clamp(int(cell[2] * levelCount), 0, levelCount - 1);
+        appendRect(levels[level], i, bottom - barHeight, 1.0, barHeight);
+
+        if (cell[1] > 0.0f) {
+            keyframeLines.push_back({float(i + 0.5), float(top)});
+            keyframeLines.push_back({float(i + 0.5), float(bottom)});
+        }
+    }
+}
+
+} // namespace TimelineLayout
@@ -0,0 +1,58 @@
+#ifndef TIMELINELAYOUT_H
+#define TIMELINELAYOUT_H
+
+#include <QPair>
+#include <QVector>
+#include <vector>
+
+// 타임라인 눈금/구간/파형/키프레임 지도 정점 계산
+// Qt Quick 씬 그래프에 의존하지 않는 순수 계산이라 TimelineItem과 벤치마크에서 함께 사용한다.
+// 눈금 간격은 화면 폭에 맞춰 고르므로 만드는 정점 수가 클립 길이(프레임 수)와 관계없이 폭에 비례한다.
+namespace TimelineLayout {
+
+// QSGGeometry::Point2D와 같은 배치
+struct Point {
+    float x;
+    float y;
+};
+
+// 눈금 간격 (프레임 단위) - major는 minor의 배수, label은 major의 배수
+struct Steps {
+    int minor = 1;
+    int major = 5;
+    int label = 10;
+};
+
+// 눈금 사이 최소 간격 / 라벨 사이 최소 간격 (픽셀)
+constexpr double kMinTickSpacing = 4.0;
+constexpr double kMinLabelSpacing = 60.0;
+
+// 프레임 단위(1, 2, 5, 10)와 초 단위(1초, 2초, 5초, ... 1시간) 후보 중 화면 폭에 맞는 간격 선택
+Steps chooseSteps(int totalFrames, double fps, double width);
+
+// 눈금 선분 (두 점씩) - 짧은 눈금은 높이의 40%, 긴 눈금은 75%
+void appendTicks(std::vector<Point>& minorLines, std::vector<Point>& majorLines,
+                 const Steps& steps, int totalFrames, double width, double top, double height);
+
+// 라벨을 표시할 프레임 번호
+QVector<int> labelFrames(const Steps& steps, int totalFrames);
+
+// 사각형 -> 삼각형 두 개 (6점)
+void appendRect(std::vector<Point>& triangles, double x, double y, double w, double h);
+
+// 시간 구간 [(시작, 끝)] (초) -> 타임라인 아래 띠
+void appendRanges(std::vector<Point>& triangles, const QVector<QPair<double, double>>& ranges,
+                  double fps, int totalFrames, double width, double y, double height);
+
+// 파형 [min, max, rms] x columns (-1..1) -> 열마다 최소~최대 / RMS 사각형
+void appendWaveform(std::vector<Point>& range, std::vector<Point>& rms,
+                    const float* peaks, int columns, double top, double height);
+
+// 키프레임 지도 [bitrate, keyframe, cost] x columns (0..1) -> 열마다 비트레이트 높이의 사각형을
+// cost 단계(levels[0..levelCount))로 나누어 담고, 키프레임이 있는 열은 세로선
+void appendHeatmap(std::vector<Point>* levels, int levelCount, std::vector<Point>& keyframeLines,
+                   const float* cells, int columns, double top, double height);
+
+} // namespace TimelineLayout
+
+#endif // TIMELINELAYOUT_H
@@ -1,6 +1,16 @@
 #include "timelinesync.h"
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
+#include "logger.h"
+#include "tracing.h"
+#include "framemath.h"
+#include "keyframemap.h"
+#include "playbackstatemachine.h"
+
+namespace {
+
+// 드래그 중 이 프레임 수 이하로 디코딩하면 되는 위치는 정확 시크 (그보다 멀면 앞 키프레임으로)
+constexpr int kMaxScrubDecodeFrames = 8;
+
+} // namespace
 
 TimelineSync::TimelineSync(QObject *parent)
     : QObject(parent)
@@ -9,18 +19,6 @@ TimelineSync::TimelineSync(QObject *parent)
     m_syncTimer = new QTimer(this);
     m_syncTimer->setInterval(16);  // 약 60fps로 동기화 (16ms)
     connect(m_syncTimer, &QTimer::timeout, this, &TimelineSync::handleSyncTimer);
-    
-    // 검증 타이머 초기화 - 시크 동작 후 위치 확인
-    m_verifyTimer = new QTimer(this);
-    m_verifyTimer->setSingleShot(true);
-    m_verifyTimer->setInterval(100);
-    connect(m_verifyTimer, &QTimer::timeout, this, &TimelineSync::handleVerificationTimer);
-    
-    // 시크 완료 타이머 - 시크 완료 후 상태 정리
-    m_seekTimer = new QTimer(this);
-    m_seekTimer->setSingleShot(true);
-    m_seekTimer->setInterval(150);
-    connect(m_seekTimer, &QTimer::timeout, this, &TimelineSync::completeSeek);
 }
 
 TimelineSync::~TimelineSync()
@@ -51,6 +49,11 @@ void TimelineSync::connectMpv(MpvObject* mpv)
     connect(m_mpv, &MpvObject::endReached, this, &TimelineSync::onMpvEndReached);
     connect(m_mpv, &MpvObject::frameCountChanged, this, &TimelineSync::onMpvFrameCountChanged);
     
+    // 시크는 재생 상태 머신이 보내고 도착을 확인 - 끝나면 실제 표시된 프레임으로 맞춤
+    if (PlaybackStateMachine* state = qobject_cast<PlaybackStateMachine*>(m_mpv->playbackState())) {
+        connect(state, &PlaybackStateMachine::seekFinished, this, &TimelineSync::completeSeek);
+    }
+    
     // 초기 상태 업데이트
     m_position = m_mpv->position();
     m_duration = m_mpv->duration();
@@ -80,46 +83,49 @@ void TimelineSync::connectMpv(MpvObject* mpv)
 // 특정 프레임으로 시크
 void TimelineSync::seekToFrame(int frame, bool exact)
 {
+    HP_TRACE_SCOPE("TimelineSync::seekToFrame");
     if (!m_mpv || m_duration <= 0) return;
     
     // 프레임 범위 검증
     frame = qBound(0, frame, m_totalFrames - 1);
     
+    // 빠른 시크 - 키프레임 지도가 있으면 MPV가 고를 키프레임을 추측하지 않고 직접 고름
+    //   앞 키프레임에서 가까우면 정확 시크도 몇 프레임만 디코딩하므로 그대로,
+    //   멀면 앞 키프레임으로 시크해 실제로 표시될 프레임을 타임라인에 알림
+    //   지도가 없으면(MKV, MXF 등) 기존처럼 정확 시크
+    bool keyframeSeek = false;
+    if (!exact) {
+        m_dragTargetFrame = frame;
+        KeyframeMap* map = qobject_cast<KeyframeMap*>(m_mpv->keyframeMap());
+        if (map && map->isReady() && map->decodeDistance(frame) > kMaxScrubDecodeFrames) {
+            const int keyframe = map->previousKeyframe(frame);
+            if (keyframe >= 0) {
+                frame = keyframe;
+                keyframeSeek = true;
+            }
+        }
+    }
+    
+    PlaybackStateMachine* state = qobject_cast<PlaybackStateMachine*>(m_mpv->playbackState());
+    if (!state) return;
+    
     // 프레임을 시간 위치로 변환
     double targetPos = calculatePositionFromFrame(frame);
     
-    // 재생 중이면 일시 정지
-    bool wasPlaying = m_isPlaying;
-    if (wasPlaying) {
-        m_mpv->pause();
-    }
-    
-    // 시크 진행 중 플래그 설정
+    // 시크 진행 중 플래그 설정 (상태 머신의 seekFinished에서 해제)
     m_seekInProgress = true;
     
     // 현재 프레임 즉시 업데이트(UI 반응성)
     m_currentFrame = frame;
     emit currentFrameChanged(m_currentFrame);
     
-    // MPV 명령 실행
-    if (exact) {
-        // 정확한 프레임 위치 지정
-        m_mpv->command(QVariantList() << "seek" << targetPos << "absolute" << "exact");
-        m_mpv->setProperty("time-pos", targetPos);
-    } else {
-        // 빠른 키프레임 시크
-        m_mpv->command(QVariantList() << "seek" << targetPos << "absolute" << "keyframes");
-    }
+    // 상태 머신이 일시정지 후 시크 (시크 중이면 마지막 요청만 남겼다가 보냄)
+    //   키프레임 가까이(또는 지도 없음)는 정확 시크, 멀면 앞 키프레임 시크
+    state->seekToFrame(frame, !keyframeSeek);
     
     // 위치 정보 업데이트
     m_position = targetPos;
     emit positionChanged(m_position);
-    
-    // 검증 타이머 시작
-    m_verifyTimer->start();
-    
-    // 시크 완료 타이머 시작
-    m_seekTimer->start();
 }
 
 // 특정 시간 위치로 시크
@@ -141,6 +147,7 @@ void TimelineSync::seekToPosition(double position, bool exact)
 void TimelineSync::beginDragging()
 {
     m_isDragging = true;
+    m_dragTargetFrame = -1;
     emit draggingChanged(m_isDragging);
     
     // 자동 동기화 일시 중지
@@ -148,13 +155,15 @@ void TimelineSync::beginDragging()
 }
 
 // 드래그 종료
-void TimelineSync::endDragging()
+void TimelineSync::endDragging(int frame)
 {
     m_isDragging = false;
     emit draggingChanged(m_isDragging);
     
-    // 마지막 프레임 위치 확인
-    int currentFrame = m_currentFrame;
+    // 마지막으로 요청된 프레임 (드래그 중 앞 키프레임에 머물렀을 수 있음)
+    int currentFrame = frame >= 0 ? frame
+                     : (m_dragTargetFrame >= 0 ? m_dragTargetFrame : m_currentFrame);
+    m_dragTargetFrame = -1;
     
     // 정확한 프레임으로 시크
     seekToFrame(currentFrame, true);
@@ -308,74 +317,18 @@ void TimelineSync::handleSyncTimer()
     }
 }
 
-// 검증 타이머 핸들러 - 시크 후 위치 검증
-void TimelineSync::handleVerificationTimer()
-{
-    if (!m_mpv) return;
-    
-    QMutexLocker locker(&m_syncMutex);
-    
-    try {
-        // 정확한 현재 위치 가져오기
-        QVariant posVar = m_mpv->getProperty("time-pos");
-        if (!posVar.isValid()) return;
-        
-        double verifiedPos = posVar.toDouble();
-        
-        // 이전 위치와 비교하여 업데이트
-        if (std::abs(verifiedPos - m_position) > 0.01) {
-            // 위치 업데이트
-            m_position = verifiedPos;
-            emit positionChanged(m_position);
-            
-            // 프레임 업데이트
-            int verifiedFrame = calculateFrameFromPosition(verifiedPos);
-            
-            // 현재 프레임 업데이트 (필요한 경우)
-            if (verifiedFrame != m_currentFrame) {
-                m_currentFrame = verifiedFrame;
-                emit currentFrameChanged(m_currentFrame);
-            }
-            
-            // 위치가 크게 다른 경우, 직접 다시 시크
-            if (m_isDragging && m_mpv->isPaused()) {
-                // 드래그 중이면 MPV 위치를 정확하게 동기화
-                double targetPos = calculatePositionFromFrame(m_currentFrame);
-                m_mpv->seekToPosition(targetPos);
-            }
-        }
-        
-        // 드래그 중이 아니면 시크 완료로 표시
-        if (!m_isDragging) {
-            m_seekInProgress = false;
-        }
-    } catch (...) {
-        qWarning() << "Error in verification timer handler";
-        m_seekInProgress = false;
-    }
-}
-
-// 시크 완료 처리
-void TimelineSync::completeSeek()
+// 시크 완료 처리 - 상태 머신이 확인한 실제 표시 프레임으로 맞춤
+void TimelineSync::completeSeek(int frame)
 {
     QMutexLocker locker(&m_syncMutex);
     
-    // 최종 위치 확인
     if (m_mpv) {
-        QVariant posVar = m_mpv->getProperty("time-pos");
-        if (posVar.isValid()) {
-            double finalPos = posVar.toDouble();
-            m_position = finalPos;
-            
-            // 최종 프레임 계산
-            int finalFrame = calculateFrameFromPosition(finalPos);
-            if (finalFrame != m_currentFrame) {
-                m_currentFrame = finalFrame;
-                emit currentFrameChanged(m_currentFrame);
-            }
-            
-            emit positionChanged(m_position);
+        m_position = calculatePositionFromFrame(frame);
+        if (frame != m_currentFrame) {
+            m_currentFrame = frame;
+            emit currentFrameChanged(m_currentFrame);
         }
+        emit positionChanged(m_position);
     }
     
     // 시크 완료 표시
@@ -411,16 +364,16 @@ void TimelineSync::calculateTotalFrames()
     QVariant frameCountVar = m_mpv->getProperty("estimated-frame-count");
     if (frameCountVar.isValid() && frameCountVar.toInt() > 0) {
         frames = frameCountVar.toInt();
-        qDebug() << "TimelineSync: Using MPV estimated-frame-count:" << frames;
+        hpVerbose(lcSync) << "TimelineSync: Using MPV estimated-frame-count:" << frames;
     } else {
         // 2. MPV 객체의 frameCount() 메서드 사용
         frames = m_mpv->frameCount();
         if (frames > 0) {
-            qDebug() << "TimelineSync: Using MPV frameCount():" << frames;
+            hpVerbose(lcSync) << "TimelineSync: Using MPV frameCount():" << frames;
         } else {
             // 3. 계산 방식 (fallback)
             frames = std::ceil(m_duration * m_fps);
-            qDebug() << "TimelineSync: Using calculated frames:" << frames;
+            hpVerbose(lcSync) << "TimelineSync: Using calculated frames:" << frames;
         }
     }
     
@@ -428,71 +381,32 @@ void TimelineSync::calculateTotalFrames()
     if (m_totalFrames != frames) {
         m_totalFrames = frames;
         emit totalFramesChanged(m_totalFrames);
-        qDebug() << "TimelineSync: Total frames updated to:" << m_totalFrames;
+        qCDebug(lcSync) << "TimelineSync: Total frames updated to:" << m_totalFrames;
     }
 }
 
 // 시간 위치에서 프레임 번호 계산
 int TimelineSync::calculateFrameFromPosition(double pos) const
 {
-    if (m_fps <= 0) return 0;
-    
-    return qBound(0, qRound(pos * m_fps), m_totalFrames - 1);
+    return FrameMath::frameFromPosition(pos, m_fps, m_totalFrames);
 }
 
 // 프레임 번호에서 시간 위치 계산
 double TimelineSync::calculatePositionFromFrame(int frame) const
 {
-    if (m_fps <= 0) return 0.0;
-    
-    return frame / m_fps;
+    return FrameMath::positionFromFrame(frame, m_fps);
 }
 
 // 프레임을 타임코드 문자열로 변환 (HH:MM:SS:FF)
 QString TimelineSync::frameToTimecode(int frame) const
 {
-    if (m_fps <= 0) return "00:00:00:00";
-    
-    // 프레임을 초로 변환
-    double seconds = frame / m_fps;
-    
-    // 시, 분, 초, 프레임 계산
-    int hours = int(seconds / 3600);
-    int minutes = int((seconds - hours * 3600) / 60);
-    int secs = int(seconds) % 60;
-    int frames = int(frame % int(m_fps));
-    
-    // 타임코드 형식으로 조합
-    return QString("%1:%2:%3:%4")
-            .arg(hours, 2, 10, QChar('0'))
-            .arg(minutes, 2, 10, QChar('0'))
-            .arg(secs, 2, 10, QChar('0'))
-            .arg(frames, 2, 10, QChar('0'));
+    return FrameMath::frameToSimpleTimecode(frame, m_fps);
 }
 
 // 타임코드 문자열을 프레임 번호로 변환
 int TimelineSync::timecodeToFrame(const QString& timecode) const
 {
-    if (m_fps <= 0) return 0;
-    
-    // 타임코드 형식 확인 (HH:MM:SS:FF)
-    QRegularExpression regex("(\\d{2}):(\\d{2}):(\\d{2}):(\\d{2})");
-    QRegularExpressionMatch match = regex.match(timecode);
-    
-    if (!match.hasMatch())
-        return 0;
-    
-    // 각 부분 추출
-    int hours = match.captured(1).toInt();
-    int minutes = match.captured(2).toInt();
-    int seconds = match.captured(3).toInt();
-    int frames = match.captured(4).toInt();
-    
-    // 프레임 계산
-    int totalSeconds = hours * 3600 + minutes * 60 + seconds;
-    int totalFrames = totalSeconds * m_fps + frames;
-    
-    return qBound(0, totalFrames, m_totalFrames - 1);
+    return FrameMath::simpleTimecodeToFrame(timecode, m_fps, m_totalFrames);
 }
 
 // 프레임을 시간 위치로 변환
@@ -33,7 +33,8 @@ public:
     Q_INVOKABLE void seekToFrame(int frame, bool exact = true);
     Q_INVOKABLE void seekToPosition(double position, bool exact = true);
     Q_INVOKABLE void beginDragging();
-    Q_INVOKABLE void endDragging();
+    // frame: 놓은 위치 (-1이면 드래그 중 마지막으로 요청된 프레임)
+    Q_INVOKABLE void endDragging(int frame = -1);
     Q_INVOKABLE void forceUpdate();
     
     // 속성 접근자
@@ -79,8 +80,7 @@ private slots:
     
     // 내부 동기화 핸들러
     void handleSyncTimer();
-    void handleVerificationTimer();
-    void completeSeek();
+    void completeSeek(int frame);
     
 private:
     // 프레임 계산 유틸리티
@@ -100,12 +100,12 @@ private:
     double m_position = 0.0;
     double m_duration = 0.0;
     bool m_isDragging = false;
+    // 드래그 중 마지막으로 요청된 프레임 (키프레임으로 시크했을 때 드래그가 끝나면 이 프레임으로)
+    int m_dragTargetFrame = -1;
     bool m_seekInProgress = false;
     
     // 동기화 타이머
     QTimer* m_syncTimer = nullptr;
-    QTimer* m_verifyTimer = nullptr;
-    QTimer* m_seekTimer = nullptr;
     
     // 스레드 안전성을 위한 뮤텍스
     QMutex m_syncMutex;
@@ -0,0 +1,211 @@
+#include "tracing.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QStandardPaths>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Tracing {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+struct SpanEvent {
+    const char* name;
+    qint64 startNs;
+    qint64 durationNs;
+};
+
+// 스레드별 링 버퍼 - 가득 차면 가장 오래된 스팬부터 덮어씀
+struct ThreadBuffer {
+    static constexpr size_t kCapacity = 16384;
+
+    std::mutex mutex;   // 덤프할 때만 경합 발생
+    std::vector<SpanEvent> events;
+    size_t next = 0;
+    bool wrapped = false;
+    quint64 threadId = 0;
+
+    ThreadBuffer() { events.resize(kCapacity); }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+
+quint64 currentThreadId()
+{
+#ifdef _WIN32
+    return quint64(GetCurrentThreadId());
+#else
+    return quint64(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0x7fffffff);
+#endif
+}
+
+ThreadBuffer& localBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->threadId = currentThreadId();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+// JSON 문자열 이스케이프 (스팬 이름은 리터럴이라 간단히 처리)
+QByteArray escapeJson(const char* text)
+{
+    QByteArray result;
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            result += '\\';
+        }
+        result += *p;
+    }
+    return result;
+}
+
+} // namespace
+
+void setEnabled(bool enabled)
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_origin).count();
+}
+
+void recordSpan(const char* name, qint64 startNs, qint64 durationNs)
+{
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events[buffer.next] = SpanEvent{name, startNs, durationNs};
+    if (++buffer.next == ThreadBuffer::kCapacity) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+bool dumpChromeJson(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open trace file:" << path;
+        return false;
+    }
+
+#ifdef _WIN32
+    const qint64 pid = qint64(GetCurrentProcessId());
+#else
+    const qint64 pid = qint64(getpid());
+#endif
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    int spanCount = 0;
+
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        const size_t count = buffer->wrapped ? ThreadBuffer::kCapacity : buffer->next;
+        const size_t begin = buffer->wrapped ? buffer->next : 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            const SpanEvent& event = buffer->events[(begin + i) % ThreadBuffer::kCapacity];
+            if (!first) {
+                json += ",\n";
+            }
+            first = false;
+
+            // Chrome trace 형식은 마이크로초 단위
+            json += "{\"name\":\"" + escapeJson(event.name) + "\",\"cat\":\"player\",\"ph\":\"X\",\"ts\":"
+                    + QByteArray::number(event.startNs / 1000.0, 'f', 3)
+                    + ",\"dur\":" + QByteArray::number(event.durationNs / 1000.0, 'f', 3)
+                    + ",\"pid\":" + QByteArray::number(pid)
+                    + ",\"tid\":" + QByteArray::number(buffer->threadId) + "}";
+            ++spanCount;
+        }
+    }
+
+    json += "\n]}\n";
+    file.write(json);
+
+    qDebug() << "Trace written:" << path << "spans:" << spanCount;
+    return true;
+}
+
+void clear()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+} // namespace Tracing
+
+TraceController::TraceController(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TraceController::setEnabled(bool enabled)
+{
+    if (Tracing::isEnabled() == enabled) {
+        return;
+    }
+    Tracing::setEnabled(enabled);
+    emit enabledChanged(enabled);
+}
+
+QString TraceController::dump(const QString& path)
+{
+    QString target = path;
+    if (target.isEmpty()) {
+        target = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+                 + "/hyper-player-trace-"
+                 + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".json";
+    }
+    return Tracing::dumpChromeJson(target) ? target : QString();
+}
+
+void TraceController::clear()
+{
+    Tracing::clear();
+}
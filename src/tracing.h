@@ -0,0 +1,85 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QObject>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// 핫패스 트레이싱
+// 스팬은 스레드별 버퍼(고정 크기 링)에 기록되고, 요청 시 Chrome/Perfetto JSON(chrome://tracing)으로 덤프된다.
+// 비활성 상태에서는 원자 변수 하나를 읽는 비용만 들기 때문에 릴리즈 빌드에서도 켜둔 채로 배포한다.
+namespace Tracing {
+
+extern std::atomic<bool> g_enabled;
+
+inline bool isEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+void setEnabled(bool enabled);
+
+// 프로세스 시작 기준 단조 시간 (ns)
+qint64 nowNs();
+
+// name은 정적 문자열(리터럴)이어야 함 - 포인터만 저장
+void recordSpan(const char* name, qint64 startNs, qint64 durationNs);
+
+// 모든 스레드 버퍼의 내용을 JSON 파일로 저장
+bool dumpChromeJson(const QString& path);
+void clear();
+
+} // namespace Tracing
+
+// 스코프 단위 RAII 스팬
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name)
+        : m_name(Tracing::isEnabled() ? name : nullptr)
+        , m_startNs(m_name ? Tracing::nowNs() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_name) {
+            Tracing::recordSpan(m_name, m_startNs, Tracing::nowNs() - m_startNs);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_startNs;
+};
+
+#define HP_TRACE_CONCAT_INNER(a, b) a##b
+#define HP_TRACE_CONCAT(a, b) HP_TRACE_CONCAT_INNER(a, b)
+
+#ifdef PLAYER_ENABLE_TRACING
+#define HP_TRACE_SCOPE(name) TraceScope HP_TRACE_CONCAT(hpTraceScope_, __LINE__)(name)
+#else
+#define HP_TRACE_SCOPE(name) do {} while (0)
+#endif
+
+// QML에서 트레이싱을 제어하기 위한 객체 (컨텍스트 속성 "tracing")
+class TraceController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+
+public:
+    explicit TraceController(QObject *parent = nullptr);
+
+    bool isEnabled() const { return Tracing::isEnabled(); }
+    void setEnabled(bool enabled);
+
+    // 경로를 비워두면 문서 폴더에 타임스탬프 이름으로 저장, 저장된 경로 반환
+    Q_INVOKABLE QString dump(const QString& path = QString());
+    Q_INVOKABLE void clear();
+
+signals:
+    void enabledChanged(bool enabled);
+};
+
+#endif // TRACING_H